@@ -36,6 +36,60 @@ public:
     }
 };
 
+// python callable kept alive until extract_async calls it back
+struct ExtractAsyncCallback
+{
+    py::function func;
+};
+
+static void extract_async_callback(int ret, Mat& feat, void* userdata)
+{
+    py::gil_scoped_acquire acquire;
+
+    ExtractAsyncCallback* cb = (ExtractAsyncCallback*)userdata;
+    try
+    {
+        cb->func(ret, feat.clone());
+    }
+    catch (py::error_already_set& e)
+    {
+        e.discard_as_unraisable("extract_async callback");
+    }
+
+    delete cb;
+}
+
+// blob is the blob name or index
+template<typename T>
+static int extract_async(Extractor& ex, T blob, py::function func, int type)
+{
+    ExtractAsyncCallback* cb = new ExtractAsyncCallback;
+    cb->func = func;
+
+    int ret;
+    {
+        // a previous extract_async may need the gil to finish
+        py::gil_scoped_release release;
+        ret = ex.extract_async(blob, extract_async_callback, cb, type);
+    }
+
+    if (ret != 0)
+        delete cb;
+
+    return ret;
+}
+
+// the async thread takes the gil for the callback, never wait for it while holding the gil
+template<typename T>
+struct GilReleaseDeleter
+{
+    void operator()(T* p) const
+    {
+        py::gil_scoped_release release;
+        delete p;
+    }
+};
+
 struct LayerFactory
 {
     std::string name;
@@ -191,6 +245,7 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("use_winograd43_convolution", &Option::use_winograd43_convolution)
     .def_readwrite("use_winograd63_convolution", &Option::use_winograd63_convolution)
     .def_readwrite("use_sgemm_convolution", &Option::use_sgemm_convolution)
+    .def_readwrite("use_sparse_weight", &Option::use_sparse_weight)
     .def_readwrite("use_int8_inference", &Option::use_int8_inference)
     .def_readwrite("use_vulkan_compute", &Option::use_vulkan_compute)
     .def_readwrite("use_bf16_storage", &Option::use_bf16_storage)
@@ -203,7 +258,9 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("use_packing_layout", &Option::use_packing_layout)
     .def_readwrite("use_shader_pack8", &Option::use_shader_pack8)
     .def_readwrite("use_subgroup_ops", &Option::use_subgroup_ops)
-    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage);
+    .def_readwrite("use_tensor_storage", &Option::use_tensor_storage)
+    .def_readwrite("memory_plan_cache_size", &Option::memory_plan_cache_size)
+    .def_readwrite("async_extract_threads", &Option::async_extract_threads);
 
     py::class_<Mat> mat(m, "Mat", py::buffer_protocol());
     mat.def(py::init<>())
@@ -833,9 +890,11 @@ PYBIND11_MODULE(ncnn, m)
     .value("PIXEL_BGRA2GRAY", ncnn::Mat::PixelType::PIXEL_BGRA2GRAY)
     .value("PIXEL_BGRA2RGBA", ncnn::Mat::PixelType::PIXEL_BGRA2RGBA);
 
-    py::class_<Extractor>(m, "Extractor")
+    py::class_<Extractor, std::unique_ptr<Extractor, GilReleaseDeleter<Extractor> > >(m, "Extractor")
     .def("__enter__", [](Extractor& ex) -> Extractor& { return ex; })
     .def("__exit__", [](Extractor& ex, pybind11::args) {
+        py::gil_scoped_release release;
+        ex.wait();
         ex.clear();
     })
     .def("clear", &Extractor::clear)
@@ -843,26 +902,45 @@ PYBIND11_MODULE(ncnn, m)
     .def("set_num_threads", &Extractor::set_num_threads, py::arg("num_threads"))
     .def("set_blob_allocator", &Extractor::set_blob_allocator, py::arg("allocator"))
     .def("set_workspace_allocator", &Extractor::set_workspace_allocator, py::arg("allocator"))
+    .def("set_streaming", &Extractor::set_streaming, py::arg("enable"))
+    .def("reset_state", &Extractor::reset_state)
+    .def("save_state", [](Extractor& ex) {
+        std::vector<Mat> states;
+        ex.save_state(states);
+        return states;
+    })
+    .def("restore_state", &Extractor::restore_state, py::arg("states"))
 #if NCNN_STRING
     .def("input", (int (Extractor::*)(const char*, const Mat&)) & Extractor::input, py::arg("blob_name"), py::arg("in"))
-    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0)
+    .def("extract", (int (Extractor::*)(const char*, Mat&, int)) & Extractor::extract, py::arg("blob_name"), py::arg("feat"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, const char* blob_name, int type) {
         ncnn::Mat feat;
-        int ret = ex.extract(blob_name, feat, type);
+        int ret;
+        {
+            py::gil_scoped_release release;
+            ret = ex.extract(blob_name, feat, type);
+        }
         return py::make_tuple(ret, feat.clone());
     },
     py::arg("blob_name"), py::arg("type") = 0)
+    .def("extract_async", &extract_async<const char*>, py::arg("blob_name"), py::arg("callback"), py::arg("type") = 0)
 #endif
     .def("input", (int (Extractor::*)(int, const Mat&)) & Extractor::input)
-    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0)
+    .def("extract", (int (Extractor::*)(int, Mat&, int)) & Extractor::extract, py::arg("blob_index"), py::arg("feat"), py::arg("type") = 0, py::call_guard<py::gil_scoped_release>())
     .def(
     "extract", [](Extractor& ex, int blob_index, int type) {
         ncnn::Mat feat;
-        int ret = ex.extract(blob_index, feat, type);
+        int ret;
+        {
+            py::gil_scoped_release release;
+            ret = ex.extract(blob_index, feat, type);
+        }
         return py::make_tuple(ret, feat.clone());
     },
-    py::arg("blob_index"), py::arg("type") = 0);
+    py::arg("blob_index"), py::arg("type") = 0)
+    .def("extract_async", &extract_async<int>, py::arg("blob_index"), py::arg("callback"), py::arg("type") = 0)
+    .def("wait", &Extractor::wait, py::call_guard<py::gil_scoped_release>());
 
     py::class_<Layer, PyLayer>(m, "Layer")
     .def(py::init<>())
@@ -894,7 +972,7 @@ PYBIND11_MODULE(ncnn, m)
     .def_readwrite("bottom_shapes", &Layer::bottom_shapes)
     .def_readwrite("top_shapes", &Layer::top_shapes);
 
-    py::class_<Net>(m, "Net")
+    py::class_<Net, std::unique_ptr<Net, GilReleaseDeleter<Net> > >(m, "Net")
     .def(py::init<>())
     .def_readwrite("opt", &Net::opt)
     .def("__enter__", [](Net& net) -> Net& { return net; })
@@ -73,3 +73,38 @@ def test_extractor_index():
 
     # not use with sentence, call clear manually to ensure ex destruct before net
     ex.clear()
+
+
+def test_extractor_async():
+    dr = ncnn.DataReaderFromEmpty()
+
+    net = ncnn.Net()
+    net.load_param("tests/test.param")
+    net.load_model(dr)
+
+    results = []
+
+    def on_done(ret, out_mat):
+        results.append((ret, out_mat))
+
+    in_mat = ncnn.Mat((227, 227, 3))
+    with net.create_extractor() as ex:
+        ex.input("data", in_mat)
+        assert ex.extract_async("output", on_done) == 0
+        ex.wait()
+
+        assert len(results) == 1
+        ret, out_mat = results[0]
+        assert ret == 0 and out_mat.dims == 1 and out_mat.w == 1
+
+        assert ex.extract_async(1, on_done) == 0
+        ex.wait()
+
+        ret, out_mat = results[1]
+        assert (
+            ret == 0
+            and out_mat.dims == 3
+            and out_mat.w == 225
+            and out_mat.h == 225
+            and out_mat.c == 3
+        )
@@ -346,6 +346,309 @@ void UnlockedPoolAllocator::fastFree(void* ptr)
     ncnn::fastFree(ptr);
 }
 
+class PlannedAllocatorPrivate
+{
+public:
+    void plan();
+    void drop_plan();
+
+    Mutex lock;
+
+    // recorded trace of one pass
+    // event >= 0 allocates block event, event < 0 frees block -event-1
+    std::vector<size_t> block_sizes;
+    std::vector<int> events;
+
+    // planned layout
+    std::vector<size_t> block_offsets;
+    unsigned char* arena;
+    size_t arena_size;
+
+    // current pass state
+    bool recording;
+    bool diverged;
+    size_t event_cursor;
+
+    // live pointer and block id, -1 for heap fallback
+    std::vector<std::pair<void*, int> > payouts;
+    int arena_payout_count;
+};
+
+void PlannedAllocatorPrivate::plan()
+{
+    const int block_count = (int)block_sizes.size();
+    const int event_count = (int)events.size();
+
+    // lifetime of each block as [alloc event, free event)
+    // blocks never freed in this pass live until the end
+    std::vector<int> block_starts(block_count, event_count);
+    std::vector<int> block_ends(block_count, event_count);
+    for (int i = 0; i < event_count; i++)
+    {
+        const int e = events[i];
+        if (e >= 0)
+            block_starts[e] = i;
+        else
+            block_ends[-e - 1] = i;
+    }
+
+    // place large blocks first, each at the lowest offset
+    // not overlapping any placed block alive at the same time
+    std::vector<std::pair<size_t, int> > order(block_count);
+    for (int i = 0; i < block_count; i++)
+    {
+        order[i] = std::make_pair(alignSize(block_sizes[i], NCNN_MALLOC_ALIGN), i);
+    }
+    std::partial_sort(order.begin(), order.end(), order.end(), std::greater<std::pair<size_t, int> >());
+
+    block_offsets.resize(block_count);
+    arena_size = 0;
+
+    std::vector<std::pair<size_t, size_t> > conflicts;
+    for (int i = 0; i < block_count; i++)
+    {
+        const size_t size = order[i].first;
+        const int id = order[i].second;
+
+        conflicts.clear();
+        for (int j = 0; j < i; j++)
+        {
+            const int pid = order[j].second;
+            if (block_starts[pid] < block_ends[id] && block_starts[id] < block_ends[pid])
+            {
+                conflicts.push_back(std::make_pair(block_offsets[pid], order[j].first));
+            }
+        }
+        std::partial_sort(conflicts.begin(), conflicts.end(), conflicts.end(), std::less<std::pair<size_t, size_t> >());
+
+        size_t offset = 0;
+        for (size_t j = 0; j < conflicts.size(); j++)
+        {
+            if (offset + size <= conflicts[j].first)
+                break;
+
+            offset = std::max(offset, conflicts[j].first + conflicts[j].second);
+        }
+
+        block_offsets[id] = offset;
+        arena_size = std::max(arena_size, offset + size);
+    }
+
+    arena = (unsigned char*)ncnn::fastMalloc(arena_size);
+    if (!arena)
+    {
+        NCNN_LOGE("planned allocator arena %zu bytes malloc failed", arena_size);
+        drop_plan();
+    }
+}
+
+void PlannedAllocatorPrivate::drop_plan()
+{
+    if (arena)
+    {
+        ncnn::fastFree(arena);
+        arena = 0;
+    }
+    arena_size = 0;
+
+    block_sizes.clear();
+    events.clear();
+    block_offsets.clear();
+
+    recording = true;
+}
+
+PlannedAllocator::PlannedAllocator()
+    : Allocator(), d(new PlannedAllocatorPrivate)
+{
+    d->arena = 0;
+    d->arena_size = 0;
+    d->recording = true;
+    d->diverged = false;
+    d->event_cursor = 0;
+    d->arena_payout_count = 0;
+}
+
+PlannedAllocator::~PlannedAllocator()
+{
+    if (!d->payouts.empty())
+    {
+        NCNN_LOGE("FATAL ERROR! planned allocator destroyed too early");
+#if NCNN_STDIO
+        for (size_t i = 0; i < d->payouts.size(); i++)
+        {
+            NCNN_LOGE("%p still in use", d->payouts[i].first);
+        }
+#endif
+    }
+
+    if (d->arena_payout_count == 0)
+    {
+        d->drop_plan();
+    }
+
+    delete d;
+}
+
+PlannedAllocator::PlannedAllocator(const PlannedAllocator&)
+    : d(0)
+{
+}
+
+PlannedAllocator& PlannedAllocator::operator=(const PlannedAllocator&)
+{
+    return *this;
+}
+
+void PlannedAllocator::begin()
+{
+    d->lock.lock();
+
+    if (d->arena_payout_count > 0)
+    {
+        // arena still referenced by previous pass, serve this pass from heap
+        d->diverged = true;
+        d->event_cursor = 0;
+
+        d->lock.unlock();
+        return;
+    }
+
+    if (d->recording)
+    {
+        if (!d->events.empty())
+        {
+            d->plan();
+            d->recording = d->arena == 0;
+        }
+    }
+    else if (d->diverged)
+    {
+        // allocation sequence changed, record again
+        d->drop_plan();
+    }
+
+    if (d->recording)
+    {
+        d->block_sizes.clear();
+        d->events.clear();
+
+        // payouts left from previous pass do not belong to the new trace
+        for (size_t i = 0; i < d->payouts.size(); i++)
+        {
+            d->payouts[i].second = -1;
+        }
+    }
+
+    d->diverged = false;
+    d->event_cursor = 0;
+
+    d->lock.unlock();
+}
+
+void PlannedAllocator::clear()
+{
+    d->lock.lock();
+
+    if (d->arena_payout_count > 0)
+    {
+        NCNN_LOGE("planned allocator arena still in use, clear ignored");
+    }
+    else
+    {
+        d->drop_plan();
+    }
+
+    d->lock.unlock();
+}
+
+size_t PlannedAllocator::peak_size() const
+{
+    return d->arena_size;
+}
+
+void* PlannedAllocator::fastMalloc(size_t size)
+{
+    d->lock.lock();
+
+    void* ptr = 0;
+    int id = -1;
+
+    if (d->recording)
+    {
+        ptr = ncnn::fastMalloc(size);
+        id = (int)d->block_sizes.size();
+
+        d->block_sizes.push_back(size);
+        d->events.push_back(id);
+    }
+    else if (!d->diverged && d->event_cursor < d->events.size() && d->events[d->event_cursor] >= 0 && d->block_sizes[d->events[d->event_cursor]] == size)
+    {
+        id = d->events[d->event_cursor++];
+        ptr = d->arena + d->block_offsets[id];
+
+        d->arena_payout_count++;
+    }
+    else
+    {
+        d->diverged = true;
+
+        ptr = ncnn::fastMalloc(size);
+    }
+
+    d->payouts.push_back(std::make_pair(ptr, id));
+
+    d->lock.unlock();
+
+    return ptr;
+}
+
+void PlannedAllocator::fastFree(void* ptr)
+{
+    d->lock.lock();
+
+    for (size_t i = 0; i < d->payouts.size(); i++)
+    {
+        if (d->payouts[i].first != ptr)
+            continue;
+
+        const int id = d->payouts[i].second;
+
+        d->payouts[i] = d->payouts.back();
+        d->payouts.pop_back();
+
+        if (d->arena && ptr >= d->arena && ptr < d->arena + d->arena_size)
+        {
+            d->arena_payout_count--;
+
+            if (!d->diverged)
+            {
+                if (d->event_cursor < d->events.size() && d->events[d->event_cursor] == -id - 1)
+                    d->event_cursor++;
+                else
+                    d->diverged = true;
+            }
+        }
+        else
+        {
+            if (d->recording && id >= 0)
+            {
+                d->events.push_back(-id - 1);
+            }
+
+            ncnn::fastFree(ptr);
+        }
+
+        d->lock.unlock();
+        return;
+    }
+
+    d->lock.unlock();
+
+    NCNN_LOGE("FATAL ERROR! planned allocator get wild %p", ptr);
+    ncnn::fastFree(ptr);
+}
+
 #if NCNN_VULKAN
 VkAllocator::VkAllocator(const VulkanDevice* _vkdev)
     : vkdev(_vkdev)
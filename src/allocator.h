@@ -205,6 +205,37 @@ private:
     UnlockedPoolAllocatorPrivate* const d;
 };
 
+class PlannedAllocatorPrivate;
+class NCNN_EXPORT PlannedAllocator : public Allocator
+{
+public:
+    PlannedAllocator();
+    ~PlannedAllocator();
+
+    // mark the start of one forward pass
+    // the first pass records every allocation lifetime and serves them from heap
+    // the recorded trace is then planned into one arena with lifetime-disjoint blocks sharing memory
+    // the following passes with identical allocation sequence are served from the arena
+    // any mismatch falls back to heap allocation and triggers a new recording
+    void begin();
+
+    // drop the plan and arena, the next pass records again
+    void clear();
+
+    // arena size in bytes of the current plan, 0 if not planned yet
+    size_t peak_size() const;
+
+    virtual void* fastMalloc(size_t size);
+    virtual void fastFree(void* ptr);
+
+private:
+    PlannedAllocator(const PlannedAllocator&);
+    PlannedAllocator& operator=(const PlannedAllocator&);
+
+private:
+    PlannedAllocatorPrivate* const d;
+};
+
 #if NCNN_VULKAN
 
 class VulkanDevice;
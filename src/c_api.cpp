@@ -1390,6 +1390,16 @@ void ncnn_extractor_set_option(ncnn_extractor_t ex, const ncnn_option_t opt)
 #endif
 }
 
+void ncnn_extractor_set_streaming(ncnn_extractor_t ex, int enable)
+{
+    ((Extractor*)ex)->set_streaming(enable);
+}
+
+void ncnn_extractor_reset_state(ncnn_extractor_t ex)
+{
+    ((Extractor*)ex)->reset_state();
+}
+
 #if NCNN_STRING
 int ncnn_extractor_input(ncnn_extractor_t ex, const char* name, const ncnn_mat_t mat)
 {
@@ -1418,6 +1428,58 @@ int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat
     return ret;
 }
 
+struct __ncnn_extract_async_t
+{
+    ncnn_extract_callback_t callback;
+    void* userdata;
+};
+
+static void __ncnn_extract_async_callback(int ret, Mat& feat, void* userdata)
+{
+    __ncnn_extract_async_t* h = (__ncnn_extract_async_t*)userdata;
+    h->callback(ret, (ncnn_mat_t)(new Mat(feat)), h->userdata);
+    delete h;
+}
+
+static __ncnn_extract_async_t* __ncnn_extract_async_create(ncnn_extract_callback_t callback, void* userdata)
+{
+    __ncnn_extract_async_t* h = new __ncnn_extract_async_t;
+    h->callback = callback;
+    h->userdata = userdata;
+    return h;
+}
+
+#if NCNN_STRING
+int ncnn_extractor_extract_async(ncnn_extractor_t ex, const char* name, ncnn_extract_callback_t callback, void* userdata)
+{
+    if (!callback)
+        return -1;
+
+    __ncnn_extract_async_t* h = __ncnn_extract_async_create(callback, userdata);
+    int ret = ((Extractor*)ex)->extract_async(name, __ncnn_extract_async_callback, h);
+    if (ret != 0)
+        delete h;
+    return ret;
+}
+#endif /* NCNN_STRING */
+
+int ncnn_extractor_extract_index_async(ncnn_extractor_t ex, int index, ncnn_extract_callback_t callback, void* userdata)
+{
+    if (!callback)
+        return -1;
+
+    __ncnn_extract_async_t* h = __ncnn_extract_async_create(callback, userdata);
+    int ret = ((Extractor*)ex)->extract_async(index, __ncnn_extract_async_callback, h);
+    if (ret != 0)
+        delete h;
+    return ret;
+}
+
+void ncnn_extractor_wait(ncnn_extractor_t ex)
+{
+    ((Extractor*)ex)->wait();
+}
+
 void ncnn_copy_make_border(const ncnn_mat_t src, ncnn_mat_t dst, int top, int bottom, int left, int right, int type, float v, const ncnn_option_t opt)
 {
     const Option _opt = opt ? *((const Option*)opt) : Option();
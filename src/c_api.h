@@ -312,6 +312,9 @@ NCNN_EXPORT void ncnn_extractor_destroy(ncnn_extractor_t ex);
 
 NCNN_EXPORT void ncnn_extractor_set_option(ncnn_extractor_t ex, const ncnn_option_t opt);
 
+NCNN_EXPORT void ncnn_extractor_set_streaming(ncnn_extractor_t ex, int enable);
+NCNN_EXPORT void ncnn_extractor_reset_state(ncnn_extractor_t ex);
+
 #if NCNN_STRING
 NCNN_EXPORT int ncnn_extractor_input(ncnn_extractor_t ex, const char* name, const ncnn_mat_t mat);
 NCNN_EXPORT int ncnn_extractor_extract(ncnn_extractor_t ex, const char* name, ncnn_mat_t* mat);
@@ -319,6 +322,15 @@ NCNN_EXPORT int ncnn_extractor_extract(ncnn_extractor_t ex, const char* name, nc
 NCNN_EXPORT int ncnn_extractor_input_index(ncnn_extractor_t ex, int index, const ncnn_mat_t mat);
 NCNN_EXPORT int ncnn_extractor_extract_index(ncnn_extractor_t ex, int index, ncnn_mat_t* mat);
 
+/* runs on an async thread, mat is owned by the callee and released with ncnn_mat_destroy */
+typedef void (*ncnn_extract_callback_t)(int ret, ncnn_mat_t mat, void* userdata);
+
+#if NCNN_STRING
+NCNN_EXPORT int ncnn_extractor_extract_async(ncnn_extractor_t ex, const char* name, ncnn_extract_callback_t callback, void* userdata);
+#endif /* NCNN_STRING */
+NCNN_EXPORT int ncnn_extractor_extract_index_async(ncnn_extractor_t ex, int index, ncnn_extract_callback_t callback, void* userdata);
+NCNN_EXPORT void ncnn_extractor_wait(ncnn_extractor_t ex);
+
 /* mat process api */
 #define NCNN_BORDER_CONSTANT    0
 #define NCNN_BORDER_REPLICATE   1
@@ -512,6 +512,92 @@ Layer* create_layer_cpu(int index)
     return layer;
 }
 
+const char* layer_cpu_impl_name(int index)
+{
+    if (index < 0 || index >= layer_registry_entry_count)
+        return "";
+
+    // follow the dispatch in create_layer_cpu
+    // clang-format off
+    // *INDENT-OFF*
+#if NCNN_RUNTIME_CPU && NCNN_AVX512
+    if (ncnn::cpu_support_x86_avx512())
+    {
+        return layer_registry_avx512[index].creator ? "x86_avx512" : "naive";
+    }
+    else
+#endif// NCNN_RUNTIME_CPU && NCNN_AVX512
+#if NCNN_RUNTIME_CPU && NCNN_FMA
+    if (ncnn::cpu_support_x86_fma())
+    {
+        return layer_registry_fma[index].creator ? "x86_fma" : "naive";
+    }
+    else
+#endif// NCNN_RUNTIME_CPU && NCNN_FMA
+#if NCNN_RUNTIME_CPU && NCNN_AVX
+    if (ncnn::cpu_support_x86_avx())
+    {
+        return layer_registry_avx[index].creator ? "x86_avx" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_AVX
+#if NCNN_RUNTIME_CPU && NCNN_LASX
+    if (ncnn::cpu_support_loongarch_lasx())
+    {
+        return layer_registry_lasx[index].creator ? "loongarch_lasx" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_LASX
+#if NCNN_RUNTIME_CPU && NCNN_LSX
+    if (ncnn::cpu_support_loongarch_lsx())
+    {
+        return layer_registry_lsx[index].creator ? "loongarch_lsx" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_LSX
+#if NCNN_RUNTIME_CPU && NCNN_MSA
+    if (ncnn::cpu_support_mips_msa())
+    {
+        return layer_registry_msa[index].creator ? "mips_msa" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_MSA
+#if NCNN_RUNTIME_CPU && NCNN_XTHEADVECTOR
+    if (ncnn::cpu_support_riscv_xtheadvector())
+    {
+        return layer_registry_xtheadvector[index].creator ? "riscv_xtheadvector" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_XTHEADVECTOR
+#if NCNN_RUNTIME_CPU && NCNN_RVV
+    if (ncnn::cpu_support_riscv_v())
+    {
+        return layer_registry_rvv[index].creator ? "riscv_rvv" : "naive";
+    }
+    else
+#endif // NCNN_RUNTIME_CPU && NCNN_RVV
+    if (layer_registry_arch[index].creator)
+    {
+#if defined(__i386__) || defined(__x86_64__) || defined(_M_IX86) || defined(_M_X64)
+        return "x86";
+#elif defined(__arm__) || defined(__aarch64__) || defined(_M_ARM) || defined(_M_ARM64)
+        return "arm";
+#elif defined(__mips__)
+        return "mips";
+#elif defined(__riscv)
+        return "riscv";
+#elif defined(__loongarch64)
+        return "loongarch";
+#else
+        return "arch";
+#endif
+    }
+    // *INDENT-ON*
+    // clang-format on
+
+    return "naive";
+}
+
 #if NCNN_VULKAN
 Layer* create_layer_vulkan(int index)
 {
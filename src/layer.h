@@ -190,6 +190,9 @@ NCNN_EXPORT Layer* create_layer_cpu(int index);
 #if NCNN_VULKAN
 NCNN_EXPORT Layer* create_layer_vulkan(int index);
 #endif // NCNN_VULKAN
+// name of the implementation create_layer_cpu picks for layer type on this cpu
+// such as "x86_avx512", "x86_fma", "x86" or "naive"
+NCNN_EXPORT const char* layer_cpu_impl_name(int index);
 
 #define DEFINE_LAYER_CREATOR(name)                          \
     ::ncnn::Layer* name##_layer_creator(void* /*userdata*/) \
@@ -41,6 +41,17 @@ int Deconvolution_arm::create_pipeline(const Option& opt)
     if (dynamic_weight)
         return 0;
 
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        // int8 model runs the reference implementation
+        support_packing = false;
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        return 0;
+    }
+#endif
+
     activation = create_activation_layer(activation_type, activation_params, opt);
 
 #if NCNN_ARM82
@@ -227,6 +238,13 @@ int Deconvolution_arm::destroy_pipeline(const Option& opt)
 
 int Deconvolution_arm::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return Deconvolution::forward(bottom_blob, top_blob, opt);
+    }
+#endif
+
     int elembits = bottom_blob.elembits();
 
 #if NCNN_ARM82
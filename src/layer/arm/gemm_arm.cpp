@@ -4235,6 +4235,15 @@ static int gemm_AT_BT_arm(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
 
 int Gemm_arm::create_pipeline(const Option& opt)
 {
+    if (weight_quant_bits)
+    {
+        // weight only quantized model runs the reference implementation
+        support_packing = false;
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        return 0;
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -4389,6 +4398,11 @@ int Gemm_arm::create_pipeline(const Option& opt)
 
 int Gemm_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return Gemm::forward(bottom_blobs, top_blobs, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
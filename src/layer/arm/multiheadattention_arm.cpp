@@ -300,12 +300,56 @@ int MultiHeadAttention_arm::destroy_pipeline(const Option& _opt)
     return 0;
 }
 
+// append the projected k or v of new tokens to the cache of past tokens
+// cache w = past_seqlen, h = embed_dim, empty for the first step
+static int concat_kv_cache(const Mat& cache_blob, const Mat& affine, Mat& out_cache, const Option& opt)
+{
+    Mat cache = cache_blob;
+    if (!cache_blob.empty() && cache_blob.elempack != 1)
+    {
+        convert_packing(cache_blob, cache, 1, opt);
+        if (cache.empty())
+            return -100;
+    }
+
+    const int past_seqlen = cache.empty() ? 0 : cache.w;
+    const int cur_seqlen = affine.w;
+    const size_t elemsize = affine.elemsize;
+
+    if (past_seqlen > 0 && (cache.h != affine.h || cache.elemsize != elemsize))
+    {
+        NCNN_LOGE("kv cache shape %d x %d elemsize %d mismatch with %d x %d elemsize %d", cache.w, cache.h, (int)cache.elemsize, affine.w, affine.h, (int)elemsize);
+        return -1;
+    }
+
+    out_cache.create(past_seqlen + cur_seqlen, affine.h, elemsize, opt.blob_allocator);
+    if (out_cache.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < affine.h; i++)
+    {
+        unsigned char* outptr = out_cache.row<unsigned char>(i);
+
+        if (past_seqlen > 0)
+        {
+            memcpy(outptr, cache.row<const unsigned char>(i), past_seqlen * elemsize);
+        }
+        memcpy(outptr + past_seqlen * elemsize, affine.row<const unsigned char>(i), cur_seqlen * elemsize);
+    }
+
+    return 0;
+}
+
 int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    // cached k and v come last
+    const size_t input_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
 
     Option opt = _opt;
     opt.use_fp16_storage &= support_fp16_storage;
@@ -325,7 +369,8 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
 
     const int embed_dim_per_head = embed_dim / num_heads;
     const int src_seqlen = q_blob.h * q_blob.elempack;
-    const int dst_seqlen = k_blob.h * k_blob.elempack;
+    const int past_seqlen = kv_cache && !bottom_blobs[input_count].empty() ? bottom_blobs[input_count].w : 0;
+    const int dst_seqlen = past_seqlen + k_blob.h * k_blob.elempack;
 
     // const int elembits = q_blob.elembits();
 
@@ -341,6 +386,16 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (kv_cache)
+    {
+        // attend over past and new tokens, the updated cache is the k_affine of all of them
+        int retc = concat_kv_cache(bottom_blobs[input_count], k_affine, top_blobs[1], opt);
+        if (retc != 0)
+            return retc;
+
+        k_affine = top_blobs[1];
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, elemsize, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
@@ -382,6 +437,15 @@ int MultiHeadAttention_arm::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retv != 0)
         return retv;
 
+    if (kv_cache)
+    {
+        int retc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+        if (retc != 0)
+            return retc;
+
+        v_affine = top_blobs[2];
+    }
+
     Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, elemsize, opt.blob_allocator);
     if (qkv_cross.empty())
         return -100;
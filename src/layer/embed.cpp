@@ -3,6 +3,8 @@
 
 #include "embed.h"
 
+#include "weight_quant.h"
+
 #include <string.h>
 
 namespace ncnn {
@@ -20,15 +22,46 @@ int Embed::load_param(const ParamDict& pd)
     bias_term = pd.get(2, 0);
     weight_data_size = pd.get(3, 0);
     int8_scale_term = pd.get(18, 0);
+    weight_quant_bits = pd.get(16, 0);
+    weight_quant_group_size = pd.get(17, 0);
+
+    if (weight_quant_bits != 0 && weight_quant_bits != 4 && weight_quant_bits != 8)
+    {
+        NCNN_LOGE("unsupported weight_quant_bits %d", weight_quant_bits);
+        return -1;
+    }
+
+    if (weight_quant_bits && int8_scale_term)
+    {
+        NCNN_LOGE("weight_quant_bits and int8_scale_term can not be enabled together");
+        return -1;
+    }
 
     return 0;
 }
 
 int Embed::load_model(const ModelBin& mb)
 {
-    weight_data = mb.load(weight_data_size, 0);
-    if (weight_data.empty())
-        return -100;
+    if (weight_quant_bits)
+    {
+        // one packed row of num_output weights per word
+        weight_data = mb.load(input_dim * weight_quant_row_bytes(num_output, weight_quant_bits), 0);
+        if (weight_data.empty())
+            return -100;
+
+        if (weight_data.elemsize != 1)
+        {
+            NCNN_LOGE("weight only quantized weight must be stored in int8");
+            return -1;
+        }
+    }
+    else
+    {
+        // fp16 table stays fp16, only the gathered rows are converted
+        weight_data = mb.load(weight_data_size, 2);
+        if (weight_data.empty())
+            return -100;
+    }
 
     if (bias_term)
     {
@@ -37,6 +70,13 @@ int Embed::load_model(const ModelBin& mb)
             return -100;
     }
 
+    if (weight_quant_bits)
+    {
+        weight_data_quant_scales = mb.load(input_dim * weight_quant_group_count(num_output, weight_quant_group_size), 1);
+        if (weight_data_quant_scales.empty())
+            return -100;
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -82,6 +122,79 @@ static void embed(const Mat& bottom_blob, const Mat& weight_data, const Mat& bia
     }
 }
 
+static void embed_fp16(const Mat& bottom_blob, const Mat& weight_data, const Mat& bias_data, Mat& top_blob, int input_dim, const Option& opt)
+{
+    const int num_output = top_blob.w;
+    const int words = top_blob.h;
+
+    const float* bias_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < words; q++)
+    {
+        float* outptr = top_blob.row(q);
+
+        int word_index = ((const int*)bottom_blob)[q];
+
+        if (word_index < 0)
+            word_index = 0;
+        if (word_index >= input_dim)
+            word_index = input_dim - 1;
+
+        const unsigned short* em = (const unsigned short*)weight_data + num_output * word_index;
+
+        for (int p = 0; p < num_output; p++)
+        {
+            outptr[p] = float16_to_float32(em[p]);
+        }
+
+        if (bias_ptr)
+        {
+            for (int p = 0; p < num_output; p++)
+            {
+                outptr[p] += bias_ptr[p];
+            }
+        }
+    }
+}
+
+static void embed_weight_quant(const Mat& bottom_blob, const Mat& weight_data, const Mat& weight_data_quant_scales, const Mat& bias_data, Mat& top_blob, int input_dim, int bits, int group_size, const Option& opt)
+{
+    const int num_output = top_blob.w;
+    const int words = top_blob.h;
+
+    const int row_bytes = weight_quant_row_bytes(num_output, bits);
+    const int groups = weight_quant_group_count(num_output, group_size);
+    const int gs = group_size > 0 ? group_size : num_output;
+
+    const float* bias_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < words; q++)
+    {
+        float* outptr = top_blob.row(q);
+
+        int word_index = ((const int*)bottom_blob)[q];
+
+        if (word_index < 0)
+            word_index = 0;
+        if (word_index >= input_dim)
+            word_index = input_dim - 1;
+
+        const signed char* em = (const signed char*)weight_data + (size_t)row_bytes * word_index;
+        const float* scales = (const float*)weight_data_quant_scales + groups * word_index;
+
+        for (int p = 0; p < num_output; p++)
+        {
+            float v = weight_quant_value(em, p, bits) * scales[p / gs];
+            if (bias_ptr)
+                v += bias_ptr[p];
+
+            outptr[p] = v;
+        }
+    }
+}
+
 #if NCNN_INT8
 static void embed_int8(const Mat& bottom_blob, const Mat& weight_data, float weight_data_int8_scale, const Mat& bias_data, Mat& top_blob, int input_dim, const Option& opt)
 {
@@ -132,6 +245,11 @@ int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) con
     if (top_blob.empty())
         return -100;
 
+    if (weight_quant_bits)
+    {
+        embed_weight_quant(bottom_blob, weight_data, weight_data_quant_scales, bias_data, top_blob, input_dim, weight_quant_bits, weight_quant_group_size, opt);
+    }
+    else
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -139,6 +257,11 @@ int Embed::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) con
     }
     else
 #endif // NCNN_INT8
+    if (weight_data.elemsize == 2)
+    {
+        embed_fp16(bottom_blob, weight_data, bias_data, top_blob, input_dim, opt);
+    }
+    else
     {
         embed(bottom_blob, weight_data, bias_data, top_blob, input_dim, opt);
     }
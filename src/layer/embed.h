@@ -29,10 +29,18 @@ public:
 
     int int8_scale_term;
 
+    // weight only quantized table, 0=off 8=int8 4=int4
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     // model
+    // fp32, fp16 or quantized [input_dim][num_output]
     Mat weight_data;
     Mat bias_data;
 
+    // [input_dim][groups] with weight only quantization
+    Mat weight_data_quant_scales;
+
 #if NCNN_INT8
     float weight_data_int8_scale;
 #endif
@@ -0,0 +1,297 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef FFT_H
+#define FFT_H
+
+#include <math.h>
+
+// mixed radix fft shared by spectrogram and inversespectrogram
+// n is split into radix 4 first, then 2, 3 and whatever primes are left, which go through a generic radix pass
+// the twiddle table holds cos(2pi k/n) and -sin(2pi k/n) for k in [0, n), built once in load_param
+// the transform is a self-sorting stockham chain over a batch of independent sequences,
+// element i of sequence b lives at re[i * Op::lanes + b] and im[i * Op::lanes + b]
+// Op::lanes sequences go through every butterfly together, Op supplies load store set1 add sub mul on its vector type
+
+#define FFT_MAX_FACTORS 32
+
+static inline int fft_factorize(int n, int* factors)
+{
+    int nstages = 0;
+
+    while (n % 4 == 0 && nstages < FFT_MAX_FACTORS)
+    {
+        factors[nstages++] = 4;
+        n /= 4;
+    }
+
+    for (int p = 2; n > 1 && nstages < FFT_MAX_FACTORS;)
+    {
+        if (n % p == 0)
+        {
+            factors[nstages++] = p;
+            n /= p;
+            continue;
+        }
+
+        p = p == 2 ? 3 : p + 2;
+        if (p * p > n)
+            p = n;
+    }
+
+    return nstages;
+}
+
+static inline void fft_make_twiddles(int n, float* twiddles)
+{
+    for (int k = 0; k < n; k++)
+    {
+        const double angle = 2 * 3.14159265358979323846 * k / n;
+        twiddles[k * 2] = (float)cos(angle);
+        twiddles[k * 2 + 1] = (float)-sin(angle);
+    }
+}
+
+struct fft_op_float
+{
+    typedef float V;
+    enum
+    {
+        lanes = 1
+    };
+
+    static V load(const float* p)
+    {
+        return *p;
+    }
+    static void store(float* p, V v)
+    {
+        *p = v;
+    }
+    static V set1(float v)
+    {
+        return v;
+    }
+    static V add(V a, V b)
+    {
+        return a + b;
+    }
+    static V sub(V a, V b)
+    {
+        return a - b;
+    }
+    static V mul(V a, V b)
+    {
+        return a * b;
+    }
+};
+
+// forward dft of the batch, the spectrum overwrites re im, tmpre tmpim are scratch of the same size
+// the inverse transform is conj(fft(conj(x))) scaled by 1/n
+template<typename Op>
+static void fft_forward(int n, const int* factors, int nstages, const float* twiddles, float* re, float* im, float* tmpre, float* tmpim)
+{
+    typedef typename Op::V V;
+    const int L = Op::lanes;
+
+    float* xr = re;
+    float* xi = im;
+    float* yr = tmpre;
+    float* yi = tmpim;
+
+    // stage with radix p maps the len point sequences interleaved by stride s
+    // y[q + s * (p * i + t)] = w^(i*t) * sum_r x[q + s * (i + r * m)] * W_p^(r*t)
+    int s = 1;
+    int len = n;
+    for (int st = 0; st < nstages; st++)
+    {
+        const int p = factors[st];
+        const int m = len / p;
+
+        const int xstep = s * m * L;
+        const int ystep = s * L;
+
+        for (int i = 0; i < m; i++)
+        {
+            for (int q = 0; q < s; q++)
+            {
+                const float* x0r = xr + (q + s * i) * L;
+                const float* x0i = xi + (q + s * i) * L;
+                float* y0r = yr + (q + s * p * i) * L;
+                float* y0i = yi + (q + s * p * i) * L;
+
+                if (p == 2)
+                {
+                    V a0r = Op::load(x0r);
+                    V a0i = Op::load(x0i);
+                    V a1r = Op::load(x0r + xstep);
+                    V a1i = Op::load(x0i + xstep);
+
+                    Op::store(y0r, Op::add(a0r, a1r));
+                    Op::store(y0i, Op::add(a0i, a1i));
+
+                    V cr = Op::sub(a0r, a1r);
+                    V ci = Op::sub(a0i, a1i);
+
+                    if (i == 0)
+                    {
+                        Op::store(y0r + ystep, cr);
+                        Op::store(y0i + ystep, ci);
+                    }
+                    else
+                    {
+                        V wr = Op::set1(twiddles[i * s * 2]);
+                        V wi = Op::set1(twiddles[i * s * 2 + 1]);
+                        Op::store(y0r + ystep, Op::sub(Op::mul(cr, wr), Op::mul(ci, wi)));
+                        Op::store(y0i + ystep, Op::add(Op::mul(cr, wi), Op::mul(ci, wr)));
+                    }
+                }
+                else if (p == 4)
+                {
+                    V a0r = Op::load(x0r);
+                    V a0i = Op::load(x0i);
+                    V a1r = Op::load(x0r + xstep);
+                    V a1i = Op::load(x0i + xstep);
+                    V a2r = Op::load(x0r + xstep * 2);
+                    V a2i = Op::load(x0i + xstep * 2);
+                    V a3r = Op::load(x0r + xstep * 3);
+                    V a3i = Op::load(x0i + xstep * 3);
+
+                    V b0r = Op::add(a0r, a2r);
+                    V b0i = Op::add(a0i, a2i);
+                    V b1r = Op::sub(a0r, a2r);
+                    V b1i = Op::sub(a0i, a2i);
+                    V b2r = Op::add(a1r, a3r);
+                    V b2i = Op::add(a1i, a3i);
+                    V b3r = Op::sub(a1r, a3r);
+                    V b3i = Op::sub(a1i, a3i);
+
+                    // W_4 = -i
+                    V cr[4];
+                    V ci[4];
+                    cr[0] = Op::add(b0r, b2r);
+                    ci[0] = Op::add(b0i, b2i);
+                    cr[1] = Op::add(b1r, b3i);
+                    ci[1] = Op::sub(b1i, b3r);
+                    cr[2] = Op::sub(b0r, b2r);
+                    ci[2] = Op::sub(b0i, b2i);
+                    cr[3] = Op::sub(b1r, b3i);
+                    ci[3] = Op::add(b1i, b3r);
+
+                    Op::store(y0r, cr[0]);
+                    Op::store(y0i, ci[0]);
+                    for (int t = 1; t < 4; t++)
+                    {
+                        if (i == 0)
+                        {
+                            Op::store(y0r + ystep * t, cr[t]);
+                            Op::store(y0i + ystep * t, ci[t]);
+                            continue;
+                        }
+
+                        V wr = Op::set1(twiddles[i * s * t * 2]);
+                        V wi = Op::set1(twiddles[i * s * t * 2 + 1]);
+                        Op::store(y0r + ystep * t, Op::sub(Op::mul(cr[t], wr), Op::mul(ci[t], wi)));
+                        Op::store(y0i + ystep * t, Op::add(Op::mul(cr[t], wi), Op::mul(ci[t], wr)));
+                    }
+                }
+                else if (p == 3)
+                {
+                    V a0r = Op::load(x0r);
+                    V a0i = Op::load(x0i);
+                    V a1r = Op::load(x0r + xstep);
+                    V a1i = Op::load(x0i + xstep);
+                    V a2r = Op::load(x0r + xstep * 2);
+                    V a2i = Op::load(x0i + xstep * 2);
+
+                    V sr = Op::add(a1r, a2r);
+                    V si = Op::add(a1i, a2i);
+                    V dr = Op::mul(Op::sub(a1r, a2r), Op::set1(0.86602540378443864676f));
+                    V di = Op::mul(Op::sub(a1i, a2i), Op::set1(0.86602540378443864676f));
+                    V hr = Op::sub(a0r, Op::mul(sr, Op::set1(0.5f)));
+                    V hi = Op::sub(a0i, Op::mul(si, Op::set1(0.5f)));
+
+                    // W_3 = -1/2 - i sqrt(3)/2
+                    V cr[3];
+                    V ci[3];
+                    cr[0] = Op::add(a0r, sr);
+                    ci[0] = Op::add(a0i, si);
+                    cr[1] = Op::add(hr, di);
+                    ci[1] = Op::sub(hi, dr);
+                    cr[2] = Op::sub(hr, di);
+                    ci[2] = Op::add(hi, dr);
+
+                    Op::store(y0r, cr[0]);
+                    Op::store(y0i, ci[0]);
+                    for (int t = 1; t < 3; t++)
+                    {
+                        if (i == 0)
+                        {
+                            Op::store(y0r + ystep * t, cr[t]);
+                            Op::store(y0i + ystep * t, ci[t]);
+                            continue;
+                        }
+
+                        V wr = Op::set1(twiddles[i * s * t * 2]);
+                        V wi = Op::set1(twiddles[i * s * t * 2 + 1]);
+                        Op::store(y0r + ystep * t, Op::sub(Op::mul(cr[t], wr), Op::mul(ci[t], wi)));
+                        Op::store(y0i + ystep * t, Op::add(Op::mul(cr[t], wi), Op::mul(ci[t], wr)));
+                    }
+                }
+                else
+                {
+                    // generic radix, W_p^(r*t) is twiddle (r*t % p) * (n / p)
+                    const int pstep = n / p;
+                    for (int t = 0; t < p; t++)
+                    {
+                        V cr = Op::load(x0r);
+                        V ci = Op::load(x0i);
+                        for (int r = 1; r < p; r++)
+                        {
+                            const float* tw = twiddles + (r * t % p) * pstep * 2;
+                            V ar = Op::load(x0r + xstep * r);
+                            V ai = Op::load(x0i + xstep * r);
+                            V wr = Op::set1(tw[0]);
+                            V wi = Op::set1(tw[1]);
+                            cr = Op::add(cr, Op::sub(Op::mul(ar, wr), Op::mul(ai, wi)));
+                            ci = Op::add(ci, Op::add(Op::mul(ar, wi), Op::mul(ai, wr)));
+                        }
+
+                        if (i == 0 || t == 0)
+                        {
+                            Op::store(y0r + ystep * t, cr);
+                            Op::store(y0i + ystep * t, ci);
+                            continue;
+                        }
+
+                        V wr = Op::set1(twiddles[i * s * t * 2]);
+                        V wi = Op::set1(twiddles[i * s * t * 2 + 1]);
+                        Op::store(y0r + ystep * t, Op::sub(Op::mul(cr, wr), Op::mul(ci, wi)));
+                        Op::store(y0i + ystep * t, Op::add(Op::mul(cr, wi), Op::mul(ci, wr)));
+                    }
+                }
+            }
+        }
+
+        float* tr = xr;
+        float* ti = xi;
+        xr = yr;
+        xi = yi;
+        yr = tr;
+        yi = ti;
+
+        s *= p;
+        len = m;
+    }
+
+    if (xr != re)
+    {
+        for (int i = 0; i < n * L; i++)
+        {
+            re[i] = xr[i];
+            im[i] = xi[i];
+        }
+    }
+}
+
+#endif // FFT_H
@@ -3,6 +3,8 @@
 
 #include "gemm.h"
 
+#include "weight_quant.h"
+
 namespace ncnn {
 
 Gemm::Gemm()
@@ -28,6 +30,8 @@ int Gemm::load_param(const ParamDict& pd)
     output_elempack = pd.get(12, 0);
     output_elemtype = pd.get(13, 0);
     output_transpose = pd.get(14, 0);
+    weight_quant_bits = pd.get(16, 0);
+    weight_quant_group_size = pd.get(17, 0);
     int8_scale_term = pd.get(18, 0);
     constant_TILE_M = pd.get(20, 0);
     constant_TILE_N = pd.get(21, 0);
@@ -59,6 +63,18 @@ int Gemm::load_param(const ParamDict& pd)
         return -1;
     }
 
+    if (weight_quant_bits != 0 && weight_quant_bits != 4 && weight_quant_bits != 8)
+    {
+        NCNN_LOGE("unsupported weight_quant_bits %d", weight_quant_bits);
+        return -1;
+    }
+
+    if (weight_quant_bits && (constantA == 1 || constantB == 0 || transB == 0 || int8_scale_term))
+    {
+        NCNN_LOGE("weight_quant_bits requires dynamic A, constant B with transB and no int8_scale_term");
+        return -1;
+    }
+
     if (constantA == 0 && constantB == 1 && constantC == 1)
         one_blob_only = true;
 
@@ -83,7 +99,20 @@ int Gemm::load_model(const ModelBin& mb)
             return -100;
     }
 
-    if (constantB == 1)
+    if (constantB == 1 && weight_quant_bits)
+    {
+        // one packed row of K weights per output column
+        B_data = mb.load(weight_quant_row_bytes(constantK, weight_quant_bits), constantN, 0);
+        if (B_data.empty())
+            return -100;
+
+        if (B_data.elemsize != 1)
+        {
+            NCNN_LOGE("weight only quantized B must be stored in int8");
+            return -1;
+        }
+    }
+    else if (constantB == 1)
     {
         if (transB == 0)
             B_data = mb.load(constantN, constantK, 0);
@@ -109,6 +138,13 @@ int Gemm::load_model(const ModelBin& mb)
             return -100;
     }
 
+    if (weight_quant_bits)
+    {
+        B_data_quant_scales = mb.load(constantN * weight_quant_group_count(constantK, weight_quant_group_size), 1);
+        if (B_data_quant_scales.empty())
+            return -100;
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -194,6 +230,71 @@ static void gemm_transB(const Mat& A, const Mat& BT, const Mat& C, Mat& top_blob
     }
 }
 
+static void gemm_transB_weight_quant(const Mat& A, const Mat& BT_quant, const Mat& BT_quant_scales, const Mat& C, Mat& top_blob, float alpha, float beta, int broadcast_type_C, int output_transpose, int bits, int group_size, const Option& opt)
+{
+    const int M = A.dims == 3 ? A.c : A.h;
+    const int N = BT_quant.h;
+    const int K = A.w;
+
+    const int groups = weight_quant_group_count(K, group_size);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        const int out_hstep = top_blob.dims == 3 ? (int)top_blob.cstep : top_blob.w;
+
+        const int A_hstep = A.dims == 3 ? (int)A.cstep : A.w;
+
+        const float* ptrA = (const float*)A + i * A_hstep;
+        const float* ptrC = C;
+
+        for (int j = 0; j < N; j++)
+        {
+            const signed char* ptrBT = BT_quant.row<const signed char>(j);
+
+            float sum = 0.f;
+            if (ptrC)
+            {
+                if (broadcast_type_C == 0)
+                {
+                    sum = ptrC[0];
+                }
+                if (broadcast_type_C == 1)
+                {
+                    sum = ptrC[i];
+                }
+                if (broadcast_type_C == 2)
+                {
+                    sum = ptrC[i];
+                }
+                if (broadcast_type_C == 3)
+                {
+                    sum = ptrC[i * N + j];
+                }
+                if (broadcast_type_C == 4)
+                {
+                    sum = ptrC[j];
+                }
+
+                sum *= beta;
+            }
+
+            sum += weight_quant_dot(ptrA, ptrBT, (const float*)BT_quant_scales + j * groups, K, bits, group_size);
+
+            sum *= alpha;
+
+            if (output_transpose)
+            {
+                top_blob[j * out_hstep + i] = sum;
+            }
+            else
+            {
+                top_blob[i * out_hstep + j] = sum;
+            }
+        }
+    }
+}
+
 #if NCNN_INT8
 static inline signed char float2int8(float v)
 {
@@ -319,7 +420,12 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     }
 
     Mat BT;
-    if (transB == 0)
+    if (weight_quant_bits)
+    {
+        // quantized rows stay packed
+        BT = B0;
+    }
+    else if (transB == 0)
     {
         // transpose B to col-major
         BT.create((B0.dims == 3 ? B0.c : B0.h), B0.w, elemsize, opt.workspace_allocator);
@@ -419,7 +525,10 @@ int Gemm::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_bl
     if (top_blob.empty())
         return -100;
 
-    gemm_transB(A, BT, C, top_blob, alpha, beta, broadcast_type_C, output_transpose, opt);
+    if (weight_quant_bits)
+        gemm_transB_weight_quant(A, BT, B_data_quant_scales, C, top_blob, alpha, beta, broadcast_type_C, output_transpose, weight_quant_bits, weight_quant_group_size, opt);
+    else
+        gemm_transB(A, BT, C, top_blob, alpha, beta, broadcast_type_C, output_transpose, opt);
 
     return 0;
 }
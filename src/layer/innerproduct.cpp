@@ -6,6 +6,7 @@
 #include "layer_type.h"
 
 #include "fused_activation.h"
+#include "weight_quant.h"
 
 namespace ncnn {
 
@@ -23,6 +24,20 @@ int InnerProduct::load_param(const ParamDict& pd)
     int8_scale_term = pd.get(8, 0);
     activation_type = pd.get(9, 0);
     activation_params = pd.get(10, Mat());
+    weight_quant_bits = pd.get(16, 0);
+    weight_quant_group_size = pd.get(17, 0);
+
+    if (weight_quant_bits != 0 && weight_quant_bits != 4 && weight_quant_bits != 8)
+    {
+        NCNN_LOGE("unsupported weight_quant_bits %d", weight_quant_bits);
+        return -1;
+    }
+
+    if (weight_quant_bits && int8_scale_term)
+    {
+        NCNN_LOGE("weight_quant_bits and int8_scale_term can not be enabled together");
+        return -1;
+    }
 
     if (int8_scale_term)
     {
@@ -39,6 +54,34 @@ int InnerProduct::load_param(const ParamDict& pd)
 
 int InnerProduct::load_model(const ModelBin& mb)
 {
+    if (weight_quant_bits)
+    {
+        const int num_input = weight_data_size / num_output;
+
+        weight_data = mb.load(num_output * weight_quant_row_bytes(num_input, weight_quant_bits), 0);
+        if (weight_data.empty())
+            return -100;
+
+        if (weight_data.elemsize != 1)
+        {
+            NCNN_LOGE("weight only quantized weight must be stored in int8");
+            return -1;
+        }
+
+        if (bias_term)
+        {
+            bias_data = mb.load(num_output, 1);
+            if (bias_data.empty())
+                return -100;
+        }
+
+        weight_data_quant_scales = mb.load(num_output * weight_quant_group_count(num_input, weight_quant_group_size), 1);
+        if (weight_data_quant_scales.empty())
+            return -100;
+
+        return 0;
+    }
+
     weight_data = mb.load(weight_data_size, 0);
     if (weight_data.empty())
         return -100;
@@ -83,6 +126,11 @@ int InnerProduct::load_model(const ModelBin& mb)
 
 int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
     {
@@ -163,6 +211,54 @@ int InnerProduct::forward(const Mat& bottom_blob, Mat& top_blob, const Option& o
     return 0;
 }
 
+int InnerProduct::forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    const int row_bytes = weight_quant_row_bytes(num_input, weight_quant_bits);
+    const int groups = weight_quant_group_count(num_input, weight_quant_group_size);
+
+    Mat bottom_blob_flattened = bottom_blob;
+    int h = 1;
+    if (bottom_blob.dims == 2 && bottom_blob.w == num_input)
+    {
+        // gemm
+        h = bottom_blob.h;
+        top_blob.create(num_output, h, bottom_blob.elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        bottom_blob_flattened = bottom_blob.reshape(num_input, opt.workspace_allocator);
+        if (bottom_blob_flattened.empty())
+            return -100;
+
+        top_blob.create(num_output, bottom_blob.elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < num_output; p++)
+    {
+        const signed char* kptr = (const signed char*)weight_data + row_bytes * p;
+        const float* scales = (const float*)weight_data_quant_scales + groups * p;
+
+        for (int j = 0; j < h; j++)
+        {
+            const float* m = (const float*)bottom_blob_flattened + num_input * j;
+
+            float sum = weight_quant_dot(m, kptr, scales, num_input, weight_quant_bits, weight_quant_group_size);
+
+            if (bias_term)
+                sum += bias_data[p];
+
+            top_blob.row(j)[p] = activation_ss(sum, activation_type, activation_params);
+        }
+    }
+
+    return 0;
+}
+
 #if NCNN_INT8
 int InnerProduct::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
@@ -20,6 +20,7 @@ public:
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
 protected:
+    int forward_weight_quant(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #if NCNN_INT8
     int forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
@@ -33,6 +34,10 @@ public:
 
     int int8_scale_term;
 
+    // weight only quantization, 0=off 8=int8 4=int4
+    int weight_quant_bits;
+    int weight_quant_group_size;
+
     // 0=none 1=relu 2=leakyrelu 3=clip 4=sigmoid
     int activation_type;
     Mat activation_params;
@@ -41,6 +46,9 @@ public:
     Mat weight_data;
     Mat bias_data;
 
+    // [num_output][groups] weight = q * scale
+    Mat weight_data_quant_scales;
+
 #if NCNN_INT8
     Mat weight_data_int8_scales;
     Mat bottom_blob_int8_scales;
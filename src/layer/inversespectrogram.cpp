@@ -3,6 +3,9 @@
 
 #include "inversespectrogram.h"
 
+#include "cpu.h"
+#include "fft.h"
+
 namespace ncnn {
 
 InverseSpectrogram::InverseSpectrogram()
@@ -71,6 +74,11 @@ int InverseSpectrogram::load_param(const ParamDict& pd)
         }
     }
 
+    fft_nstages = fft_factorize(n_fft, fft_factors);
+
+    fft_twiddles.create(n_fft * 2);
+    fft_make_twiddles(n_fft, fft_twiddles);
+
     return 0;
 }
 
@@ -224,4 +232,165 @@ int InverseSpectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Opt
     return 0;
 }
 
+int InverseSpectrogram::forward_fft(const Mat& bottom_blob, Mat& top_blob, int lanes, fft_func fft, const Option& opt) const
+{
+    // https://github.com/librosa/librosa/blob/main/librosa/core/spectrum.py#L630
+
+    // TODO custom window
+    // TODO output length
+
+    const int frames = bottom_blob.h;
+    const int freqs = bottom_blob.c;
+    // assert freqs == n_fft or freqs == n_fft / 2 + 1
+
+    const int onesided = freqs == n_fft / 2 + 1 ? 1 : 0;
+
+    const int outsize = center ? (frames - 1) * hoplen + (n_fft - n_fft / 2 * 2) : (frames - 1) * hoplen + n_fft;
+
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (returns == 0)
+    {
+        top_blob.create(2, outsize, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(outsize, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    Mat window_sumsquare(outsize + n_fft, elemsize, opt.workspace_allocator);
+    if (window_sumsquare.empty())
+        return -100;
+
+    top_blob.fill(0.f);
+    window_sumsquare.fill(0.f);
+
+    const float norm = normalized == 1 ? sqrt(n_fft) : normalized == 2 ? window_data[n_fft] : 1.f;
+
+    // windowed inverse dft of every frame, interleaved complex
+    Mat frames_data(n_fft * 2, frames, (size_t)4u, opt.workspace_allocator);
+    if (frames_data.empty())
+        return -100;
+
+    // lanes frames go through the fft together
+    const int nn_batch = (frames + lanes - 1) / lanes;
+
+    Mat fft_buffer(n_fft * lanes * 4, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+    if (fft_buffer.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_batch; jj++)
+    {
+        const int j0 = jj * lanes;
+
+        float* re = fft_buffer.row(get_omp_thread_num());
+        float* im = re + n_fft * lanes;
+        float* tmpre = im + n_fft * lanes;
+        float* tmpim = tmpre + n_fft * lanes;
+
+        // collect conjugated complex, ifft(x) = conj(fft(conj(x))) / n
+        for (int k = 0; k < n_fft; k++)
+        {
+            for (int b = 0; b < lanes; b++)
+            {
+                const int j = j0 + b;
+                if (j >= frames)
+                {
+                    re[k * lanes + b] = 0.f;
+                    im[k * lanes + b] = 0.f;
+                    continue;
+                }
+
+                if (onesided == 1 && k >= n_fft / 2 + 1)
+                {
+                    const float* ptr = bottom_blob.channel(n_fft - k).row(j);
+                    re[k * lanes + b] = ptr[0] * norm;
+                    im[k * lanes + b] = ptr[1] * norm;
+                }
+                else
+                {
+                    const float* ptr = bottom_blob.channel(k).row(j);
+                    re[k * lanes + b] = ptr[0] * norm;
+                    im[k * lanes + b] = -ptr[1] * norm;
+                }
+            }
+        }
+
+        fft(n_fft, fft_factors, fft_nstages, fft_twiddles, re, im, tmpre, tmpim);
+
+        for (int b = 0; b < lanes && j0 + b < frames; b++)
+        {
+            float* outptr = frames_data.row(j0 + b);
+
+            for (int i = 0; i < n_fft; i++)
+            {
+                // apply window
+                outptr[0] = re[i * lanes + b] / n_fft * window_data[i];
+                outptr[1] = -im[i * lanes + b] / n_fft * window_data[i];
+                outptr += 2;
+            }
+        }
+    }
+
+    // overlap add
+    for (int j = 0; j < frames; j++)
+    {
+        const float* ptr = frames_data.row(j);
+
+        for (int i = 0; i < n_fft; i++)
+        {
+            int output_index = j * hoplen + i;
+            if (center == 1)
+            {
+                output_index -= n_fft / 2;
+            }
+            if (output_index >= 0 && output_index < outsize)
+            {
+                // square window
+                window_sumsquare[output_index] += window_data[i] * window_data[i];
+
+                if (returns == 0)
+                {
+                    top_blob.row(output_index)[0] += ptr[i * 2];
+                    top_blob.row(output_index)[1] += ptr[i * 2 + 1];
+                }
+                if (returns == 1)
+                {
+                    top_blob[output_index] += ptr[i * 2];
+                }
+                if (returns == 2)
+                {
+                    top_blob[output_index] += ptr[i * 2 + 1];
+                }
+            }
+        }
+    }
+
+    // square window norm
+    if (returns == 0)
+    {
+        for (int i = 0; i < outsize; i++)
+        {
+            if (window_sumsquare[i] != 0.f)
+            {
+                top_blob.row(i)[0] /= window_sumsquare[i];
+                top_blob.row(i)[1] /= window_sumsquare[i];
+            }
+        }
+    }
+    else
+    {
+        for (int i = 0; i < outsize; i++)
+        {
+            if (window_sumsquare[i] != 0.f)
+                top_blob[i] /= window_sumsquare[i];
+        }
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -17,6 +17,12 @@ public:
 
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
+protected:
+    typedef void (*fft_func)(int n, const int* factors, int nstages, const float* twiddles, float* re, float* im, float* tmpre, float* tmpim);
+
+    // forward stays the plain dft as reference, fft runs lanes sequences at once, see fft.h
+    int forward_fft(const Mat& bottom_blob, Mat& top_blob, int lanes, fft_func fft, const Option& opt) const;
+
 public:
     int n_fft;
     int returns; // 0=complex 1=real 2=imag
@@ -27,6 +33,11 @@ public:
     int normalized; // 0=disabled 1=sqrt(n_fft) 2=window-l2-energy
 
     Mat window_data;
+
+    // radix of each fft stage and the twiddle table for n_fft
+    int fft_nstages;
+    int fft_factors[32];
+    Mat fft_twiddles;
 };
 
 } // namespace ncnn
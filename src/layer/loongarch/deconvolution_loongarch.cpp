@@ -32,6 +32,17 @@ int Deconvolution_loongarch::create_pipeline(const Option& opt)
     if (dynamic_weight)
         return 0;
 
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        // int8 model runs the reference implementation
+        support_packing = false;
+        support_bf16_storage = false;
+        support_fp16_storage = false;
+        return 0;
+    }
+#endif
+
     const int maxk = kernel_w * kernel_h;
     int num_input = weight_data_size / maxk / num_output;
 
@@ -128,6 +139,13 @@ int Deconvolution_loongarch::destroy_pipeline(const Option& opt)
 
 int Deconvolution_loongarch::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return Deconvolution::forward(bottom_blob, top_blob, opt);
+    }
+#endif
+
     // deconvolv with NxN kernel
     // value = value + bias
 
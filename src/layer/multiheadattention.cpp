@@ -20,6 +20,7 @@ int MultiHeadAttention::load_param(const ParamDict& pd)
     vdim = pd.get(4, embed_dim);
     attn_mask = pd.get(5, 0);
     scale = pd.get(6, 1.f / sqrtf(embed_dim / num_heads));
+    kv_cache = pd.get(7, 0);
     int8_scale_term = pd.get(18, 0);
 
     return 0;
@@ -74,6 +75,85 @@ int MultiHeadAttention::load_model(const ModelBin& mb)
     return 0;
 }
 
+// kv cache blob is the projected k or v of all past tokens
+// w = past_seqlen, h = embed_dim, empty for the first step
+static void kv_cache_to_xk(const Mat& cache_k, Mat& xk, const Option& opt)
+{
+    const int past_seqlen = cache_k.empty() ? 0 : cache_k.w;
+    const int embed_dim_per_head = xk.w;
+    const int num_heads = xk.c;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        Mat outm = xk.channel(q);
+
+        for (int i = 0; i < past_seqlen; i++)
+        {
+            float* outptr = outm.row(i);
+
+            for (int j = 0; j < embed_dim_per_head; j++)
+            {
+                outptr[j] = cache_k.row(q * embed_dim_per_head + j)[i];
+            }
+        }
+    }
+}
+
+static void kv_cache_to_xv(const Mat& cache_v, Mat& xv, const Option& opt)
+{
+    const int past_seqlen = cache_v.empty() ? 0 : cache_v.w;
+    const int embed_dim_per_head = xv.h;
+    const int num_heads = xv.c;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        Mat outm = xv.channel(q);
+
+        for (int i = 0; i < embed_dim_per_head; i++)
+        {
+            memcpy(outm.row(i), cache_v.row(q * embed_dim_per_head + i), past_seqlen * sizeof(float));
+        }
+    }
+}
+
+static int xk_xv_to_kv_cache(const Mat& xk, const Mat& xv, Mat& cache_k, Mat& cache_v, const Option& opt)
+{
+    const int embed_dim_per_head = xk.w;
+    const int dst_seqlen = xk.h;
+    const int num_heads = xk.c;
+
+    cache_k.create(dst_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+    if (cache_k.empty())
+        return -100;
+
+    cache_v.create(dst_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+    if (cache_v.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < num_heads; q++)
+    {
+        const Mat xkm = xk.channel(q);
+        const Mat xvm = xv.channel(q);
+
+        for (int j = 0; j < embed_dim_per_head; j++)
+        {
+            float* outptr = cache_k.row(q * embed_dim_per_head + j);
+
+            for (int i = 0; i < dst_seqlen; i++)
+            {
+                outptr[i] = xkm.row(i)[j];
+            }
+
+            memcpy(cache_v.row(q * embed_dim_per_head + j), xvm.row(j), dst_seqlen * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
 // refers to https://pytorch.org/docs/stable/generated/torch.nn.MultiheadAttention.html
 int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
@@ -84,13 +164,19 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     }
 #endif
 
+    // cached k and v come last
+    const size_t input_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
+    const Mat& cache_k_blob = kv_cache ? bottom_blobs[input_count] : Mat();
+    const Mat& cache_v_blob = kv_cache ? bottom_blobs[input_count + 1] : Mat();
 
+    const int past_seqlen = cache_k_blob.empty() ? 0 : cache_k_blob.w;
     const int src_seqlen = q_blob.h;
-    const int dst_seqlen = k_blob.h;
+    const int dst_seqlen = past_seqlen + k_blob.h;
     const int embed_dim_per_head = embed_dim / num_heads;
     const int qdim = weight_data_size / embed_dim;
 
@@ -119,6 +205,12 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
     if (xqkv.empty())
         return -100;
 
+    if (past_seqlen > 0)
+    {
+        kv_cache_to_xk(cache_k_blob, xk, opt);
+        kv_cache_to_xv(cache_v_blob, xv, opt);
+    }
+
     #pragma omp parallel for num_threads(opt.num_threads)
     for (int q = 0; q < num_heads; q++)
     {
@@ -150,9 +242,9 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
         {
             Mat outm = xk.channel(q);
 
-            for (int i = 0; i < dst_seqlen; i++)
+            for (int i = 0; i < k_blob.h; i++)
             {
-                float* outptr = outm.row(i);
+                float* outptr = outm.row(past_seqlen + i);
 
                 for (int j = 0; j < embed_dim_per_head; j++)
                 {
@@ -176,7 +268,7 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
 
             for (int i = 0; i < embed_dim_per_head; i++)
             {
-                for (int j = 0; j < dst_seqlen; j++)
+                for (int j = 0; j < v_blob.h; j++)
                 {
                     const float* ptr = v_blob.row(j);
                     const float* kptr = (const float*)v_weight_data + vdim * (q * embed_dim_per_head + i);
@@ -189,7 +281,7 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
 
                     float* outptr = outm.row(i);
 
-                    outptr[j] = sum;
+                    outptr[past_seqlen + j] = sum;
                 }
             }
         }
@@ -298,6 +390,13 @@ int MultiHeadAttention::forward(const std::vector<Mat>& bottom_blobs, std::vecto
         }
     }
 
+    if (kv_cache)
+    {
+        int ret = xk_xv_to_kv_cache(xk, xv, top_blobs[1], top_blobs[2], opt);
+        if (ret != 0)
+            return ret;
+    }
+
     // out = affine(xqkv)
     // xqkv  (embed_dim, src_seqlen)
     #pragma omp parallel for num_threads(opt.num_threads)
@@ -394,13 +493,19 @@ static void dynamic_quantize_2d_per_h(const Mat& blob, Mat& blob_int8, Mat& scal
 
 int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    // cached k and v come last
+    const size_t input_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
+    const Mat& cache_k_blob = kv_cache ? bottom_blobs[input_count] : Mat();
+    const Mat& cache_v_blob = kv_cache ? bottom_blobs[input_count + 1] : Mat();
 
+    const int past_seqlen = cache_k_blob.empty() ? 0 : cache_k_blob.w;
     const int src_seqlen = q_blob.h;
-    const int dst_seqlen = k_blob.h;
+    const int dst_seqlen = past_seqlen + k_blob.h;
     const int embed_dim_per_head = embed_dim / num_heads;
     const int qdim = weight_data_size / embed_dim;
 
@@ -429,6 +534,12 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
     if (xqkv.empty())
         return -100;
 
+    if (past_seqlen > 0)
+    {
+        kv_cache_to_xk(cache_k_blob, xk, opt);
+        kv_cache_to_xv(cache_v_blob, xv, opt);
+    }
+
     // dynamic quantize q_blob
     Mat q_blob_int8;
     float q_blob_int8_scale;
@@ -437,7 +548,7 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
     // dynamic quantize k_blob
     Mat k_blob_int8;
     float k_blob_int8_scale;
-    if (bottom_blobs.size() == 1)
+    if (input_count == 1)
     {
         k_blob_int8 = q_blob_int8;
         k_blob_int8_scale = q_blob_int8_scale;
@@ -450,12 +561,12 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
     // dynamic quantize v_blob
     Mat v_blob_int8;
     float v_blob_int8_scale;
-    if (bottom_blobs.size() == 1)
+    if (input_count == 1)
     {
         v_blob_int8 = q_blob_int8;
         v_blob_int8_scale = q_blob_int8_scale;
     }
-    else if (bottom_blobs.size() == 2)
+    else if (input_count == 2)
     {
         v_blob_int8 = k_blob_int8;
         v_blob_int8_scale = k_blob_int8_scale;
@@ -498,7 +609,7 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
 
         // xk = affine(k)
         {
-            float* outptr = xk.channel(q);
+            float* outptr = xk.channel(q).row(past_seqlen);
 
             for (int i = 0; i < k_blob_int8.h; i++)
             {
@@ -526,7 +637,7 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
 
             for (int i = 0; i < embed_dim_per_head; i++)
             {
-                float* outptr = outm.row(i);
+                float* outptr = outm.row(i) + past_seqlen;
 
                 for (int j = 0; j < v_blob_int8.h; j++)
                 {
@@ -674,6 +785,13 @@ int MultiHeadAttention::forward_int8(const std::vector<Mat>& bottom_blobs, std::
         }
     }
 
+    if (kv_cache)
+    {
+        int ret = xk_xv_to_kv_cache(xk, xv, top_blobs[1], top_blobs[2], opt);
+        if (ret != 0)
+            return ret;
+    }
+
     // dynamic quantize xqkv
     Mat xqkv_int8;
     Mat xqkv_int8_scales;
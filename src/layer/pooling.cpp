@@ -6,6 +6,7 @@
 #include "layer_type.h"
 
 #include <float.h>
+#include <math.h>
 
 namespace ncnn {
 
@@ -41,6 +42,11 @@ int Pooling::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) c
     // max value in NxN window
     // avg value in NxN window
 
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8 && !adaptive_pooling)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     int w = bottom_blob.w;
     int h = bottom_blob.h;
     int channels = bottom_blob.c;
@@ -357,7 +363,7 @@ void Pooling::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, co
     float pad_value = 0.f;
     if (pooling_type == PoolMethod_MAX)
     {
-        pad_value = bottom_blob.elemsize == 1 ? -128.f : -FLT_MAX;
+        pad_value = bottom_blob.elembits() == 8 ? -128.f : -FLT_MAX;
     }
     else if (pooling_type == PoolMethod_AVE)
     {
@@ -411,4 +417,157 @@ void Pooling::make_padding(const Mat& bottom_blob, Mat& bottom_blob_bordered, co
     }
 }
 
+#if NCNN_INT8
+static inline signed char float2int8(float v)
+{
+    int int32 = static_cast<int>(round(v));
+    if (int32 > 127) return 127;
+    if (int32 < -127) return -127;
+    return (signed char)int32;
+}
+
+int Pooling::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // int8 max and avg keep the scale of the input
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        const int size = bottom_blob.w * bottom_blob.h;
+
+        top_blob.create(channels, elemsize, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        signed char* outptr = top_blob;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const signed char* ptr = bottom_blob.channel(q);
+
+            if (pooling_type == PoolMethod_MAX)
+            {
+                signed char max = ptr[0];
+                for (int i = 0; i < size; i++)
+                {
+                    max = std::max(max, ptr[i]);
+                }
+                outptr[q] = max;
+            }
+            else // if (pooling_type == PoolMethod_AVE)
+            {
+                int sum = 0;
+                for (int i = 0; i < size; i++)
+                {
+                    sum += ptr[i];
+                }
+                outptr[q] = float2int8((float)sum / size);
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+
+    top_blob.create(outw, outh, channels, elemsize, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    int wtailpad = 0;
+    int htailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+        htailpad = bottom_blob_bordered.h - bottom_blob.h - pad_top - pad_bottom;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        signed char* outptr = top_blob.channel(q);
+
+        for (int i = 0; i < outh; i++)
+        {
+            for (int j = 0; j < outw; j++)
+            {
+                const int sy0 = i * stride_h;
+                const int sx0 = j * stride_w;
+
+                if (pooling_type == PoolMethod_MAX)
+                {
+                    // the border is padded with -128
+                    signed char max = m.row<const signed char>(sy0)[sx0];
+                    for (int ki = 0; ki < kernel_h; ki++)
+                    {
+                        const signed char* sptr = m.row<const signed char>(sy0 + ki) + sx0;
+                        for (int kj = 0; kj < kernel_w; kj++)
+                        {
+                            max = std::max(max, sptr[kj]);
+                        }
+                    }
+                    outptr[j] = max;
+                    continue;
+                }
+
+                int sum = 0;
+                int area = 0;
+
+                for (int ki = 0; ki < kernel_h; ki++)
+                {
+                    const int sy = sy0 + ki;
+
+                    if (avgpool_count_include_pad == 0)
+                    {
+                        if (sy < pad_top)
+                            continue;
+
+                        if (sy >= h - pad_bottom - htailpad)
+                            break;
+                    }
+
+                    const signed char* sptr = m.row<const signed char>(sy);
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        const int sx = sx0 + kj;
+
+                        if (avgpool_count_include_pad == 0)
+                        {
+                            if (sx < pad_left)
+                                continue;
+
+                            if (sx >= w - pad_right - wtailpad)
+                                break;
+                        }
+
+                        sum += sptr[sx];
+                        area += 1;
+                    }
+                }
+
+                outptr[j] = float2int8((float)sum / area);
+            }
+
+            outptr += outw;
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
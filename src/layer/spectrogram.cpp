@@ -3,6 +3,9 @@
 
 #include "spectrogram.h"
 
+#include "cpu.h"
+#include "fft.h"
+
 namespace ncnn {
 
 Spectrogram::Spectrogram()
@@ -73,6 +76,11 @@ int Spectrogram::load_param(const ParamDict& pd)
         }
     }
 
+    fft_nstages = fft_factorize(n_fft, fft_factors);
+
+    fft_twiddles.create(n_fft * 2);
+    fft_make_twiddles(n_fft, fft_twiddles);
+
     return 0;
 }
 
@@ -207,4 +215,152 @@ int Spectrogram::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
     return 0;
 }
 
+int Spectrogram::forward_fft(const Mat& bottom_blob, Mat& top_blob, int lanes, fft_func fft, const Option& opt) const
+{
+    // https://pytorch.org/audio/stable/generated/torchaudio.functional.spectrogram.html
+
+    // TODO custom window
+
+    Mat bottom_blob_bordered = bottom_blob;
+    if (center == 1)
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        if (pad_type == 0)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_CONSTANT, 0.f, opt_b);
+        if (pad_type == 1)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REPLICATE, 0.f, opt_b);
+        if (pad_type == 2)
+            copy_make_border(bottom_blob, bottom_blob_bordered, 0, 0, n_fft / 2, n_fft / 2, BORDER_REFLECT, 0.f, opt_b);
+    }
+
+    const int size = bottom_blob_bordered.w;
+
+    // const int frames = size / hoplen + 1;
+    const int frames = (size - n_fft) / hoplen + 1;
+    const int freqs_onesided = n_fft / 2 + 1;
+    const int freqs = onesided ? freqs_onesided : n_fft;
+
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    if (power == 0)
+    {
+        top_blob.create(2, frames, freqs, elemsize, opt.blob_allocator);
+    }
+    else
+    {
+        top_blob.create(frames, freqs, elemsize, opt.blob_allocator);
+    }
+    if (top_blob.empty())
+        return -100;
+
+    // two real frames ride in the real and imaginary part of one complex sequence
+    // and lanes sequences go through the fft together, one batch covers lanes * 2 frames
+    const int batch = lanes * 2;
+    const int nn_batch = (frames + batch - 1) / batch;
+
+    Mat fft_buffer(n_fft * lanes * 4, opt.num_threads, (size_t)4u, opt.workspace_allocator);
+    if (fft_buffer.empty())
+        return -100;
+
+    const float norm = normalized == 1 ? 1.f / sqrt(n_fft) : normalized == 2 ? window_data[n_fft] : 1.f;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int jj = 0; jj < nn_batch; jj++)
+    {
+        const int j0 = jj * batch;
+
+        float* re = fft_buffer.row(get_omp_thread_num());
+        float* im = re + n_fft * lanes;
+        float* tmpre = im + n_fft * lanes;
+        float* tmpim = tmpre + n_fft * lanes;
+
+        // apply window, frame j0 + b goes to the real part of sequence b and frame j0 + lanes + b to the imaginary part
+        const float* ptr = bottom_blob_bordered;
+        for (int k = 0; k < n_fft; k++)
+        {
+            const float w = window_data[k];
+            for (int b = 0; b < lanes; b++)
+            {
+                const int j = j0 + b;
+                const int j2 = j0 + lanes + b;
+                re[k * lanes + b] = j < frames ? ptr[j * hoplen + k] * w : 0.f;
+                im[k * lanes + b] = j2 < frames ? ptr[j2 * hoplen + k] * w : 0.f;
+            }
+        }
+
+        fft(n_fft, fft_factors, fft_nstages, fft_twiddles, re, im, tmpre, tmpim);
+
+        for (int b = 0; b < batch && j0 + b < frames; b++)
+        {
+            const int j = j0 + b;
+            const int lane = b % lanes;
+
+            for (int i = 0; i < freqs_onesided; i++)
+            {
+                const int i2 = (n_fft - i) % n_fft;
+                const float zr = re[i * lanes + lane];
+                const float zi = im[i * lanes + lane];
+                const float cr = re[i2 * lanes + lane];
+                const float ci = im[i2 * lanes + lane];
+
+                // real part frame (Z[i] + conj(Z[n-i])) / 2, imaginary part frame (Z[i] - conj(Z[n-i])) / 2i
+                float re0 = b < lanes ? (zr + cr) * 0.5f : (zi + ci) * 0.5f;
+                float im0 = b < lanes ? (zi - ci) * 0.5f : (cr - zr) * 0.5f;
+
+                re0 *= norm;
+                im0 *= norm;
+
+                if (power == 0)
+                {
+                    // complex as real
+                    float* outptr = top_blob.channel(i).row(j);
+                    outptr[0] = re0;
+                    outptr[1] = im0;
+                }
+                if (power == 1)
+                {
+                    // magnitude
+                    top_blob.row(i)[j] = sqrt(re0 * re0 + im0 * im0);
+                }
+                if (power == 2)
+                {
+                    top_blob.row(i)[j] = re0 * re0 + im0 * im0;
+                }
+            }
+        }
+    }
+
+    if (!onesided)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = freqs_onesided; i < n_fft; i++)
+        {
+            if (power == 0)
+            {
+                const float* ptr = top_blob.channel(n_fft - i);
+                float* outptr = top_blob.channel(i);
+
+                for (int j = 0; j < frames; j++)
+                {
+                    // complex as real
+                    outptr[0] = ptr[0];
+                    outptr[1] = -ptr[1];
+                    ptr += 2;
+                    outptr += 2;
+                }
+            }
+            else // if (power == 1 || power == 2)
+            {
+                const float* ptr = top_blob.row(n_fft - i);
+                float* outptr = top_blob.row(i);
+
+                memcpy(outptr, ptr, frames * sizeof(float));
+            }
+        }
+    }
+
+    return 0;
+}
+
 } // namespace ncnn
@@ -0,0 +1,57 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef WEIGHT_QUANT_H
+#define WEIGHT_QUANT_H
+
+// weight only quantization keeps the weight rows of innerproduct and gemm compressed, dequantized on the fly
+// bits=8  one row of K weights is K int8 bytes
+// bits=4  one row of K weights is (K+1)/2 bytes, weight k in the low nibble for even k and the high nibble for odd k, biased by 8
+// every group_size consecutive weights of a row share one fp32 scale, weight = q * scale
+// group_size=0 makes the whole row one group
+
+static inline int weight_quant_row_bytes(int K, int bits)
+{
+    return bits == 4 ? (K + 1) / 2 : K;
+}
+
+static inline int weight_quant_group_count(int K, int group_size)
+{
+    return group_size > 0 ? (K + group_size - 1) / group_size : 1;
+}
+
+static inline int weight_quant_value(const signed char* wptr, int k, int bits)
+{
+    if (bits == 8)
+        return wptr[k];
+
+    const unsigned char v = ((const unsigned char*)wptr)[k / 2];
+    return (k % 2 == 0 ? (v & 15) : (v >> 4)) - 8;
+}
+
+// x[k] * w[k] summed over weights [k0, k1) of one row, before scaling
+static inline float weight_quant_dot_range(const float* x, const signed char* wptr, int k0, int k1, int bits)
+{
+    float sum = 0.f;
+    for (int k = k0; k < k1; k++)
+    {
+        sum += x[k] * weight_quant_value(wptr, k, bits);
+    }
+    return sum;
+}
+
+// dot product of x and one quantized weight row, scales points to the group scales of this row
+static inline float weight_quant_dot(const float* x, const signed char* wptr, const float* scales, int K, int bits, int group_size)
+{
+    const int gs = group_size > 0 ? group_size : K;
+
+    float sum = 0.f;
+    for (int k0 = 0, g = 0; k0 < K; k0 += gs, g++)
+    {
+        const int k1 = k0 + gs < K ? k0 + gs : K;
+        sum += weight_quant_dot_range(x, wptr, k0, k1, bits) * scales[g];
+    }
+    return sum;
+}
+
+#endif // WEIGHT_QUANT_H
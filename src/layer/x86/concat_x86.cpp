@@ -14,6 +14,11 @@ Concat_x86::Concat_x86()
 
 int Concat_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_INT8
+    if (bottom_blobs[0].elembits() == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+#endif
+
     int dims = bottom_blobs[0].dims;
     int positive_axis = axis < 0 ? dims + axis : axis;
 
@@ -814,4 +819,54 @@ int Concat_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>&
     return 0;
 }
 
+#if NCNN_INT8
+int Concat_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int elempack = bottom_blobs[0].elempack;
+
+    bool same_elempack = true;
+    for (size_t b = 1; b < bottom_blobs.size(); b++)
+    {
+        if (bottom_blobs[b].elempack != elempack)
+        {
+            same_elempack = false;
+            break;
+        }
+    }
+
+    if (same_elempack)
+    {
+        // int8 concat only moves bytes, run the pack1 routine over whole packed elements
+        std::vector<Mat> bottom_blobs_elem(bottom_blobs.size());
+        for (size_t b = 0; b < bottom_blobs.size(); b++)
+        {
+            bottom_blobs_elem[b] = bottom_blobs[b];
+            bottom_blobs_elem[b].elempack = 1;
+        }
+
+        int ret = Concat::forward(bottom_blobs_elem, top_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        top_blobs[0].elempack = elempack;
+
+        return 0;
+    }
+
+    // mixed packing only happens on the packed axis, concat in pack1
+    Option opt_pack1 = opt;
+    opt_pack1.blob_allocator = opt.workspace_allocator;
+
+    std::vector<Mat> bottom_blobs_unpacked(bottom_blobs.size());
+    for (size_t b = 0; b < bottom_blobs.size(); b++)
+    {
+        convert_packing(bottom_blobs[b], bottom_blobs_unpacked[b], 1, opt_pack1);
+        if (bottom_blobs_unpacked[b].empty())
+            return -100;
+    }
+
+    return Concat::forward(bottom_blobs_unpacked, top_blobs, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
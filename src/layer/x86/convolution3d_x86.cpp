@@ -0,0 +1,317 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "convolution3d_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Convolution3D_x86::Convolution3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    activation = 0;
+    gemm = 0;
+
+    in_elempack = 1;
+}
+
+int Convolution3D_x86::create_pipeline(const Option& opt)
+{
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int elempack = 1;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        elempack = num_input % 16 == 0 ? 16 : num_input % 8 == 0 ? 8 : num_input % 4 == 0 ? 4 : 1;
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        elempack = num_input % 8 == 0 ? 8 : num_input % 4 == 0 ? 4 : 1;
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        elempack = num_input % 4 == 0 ? 4 : 1;
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    in_elempack = elempack;
+
+    // im2col rows are inch/pa-maxk-pa, one gemm over all output voxels
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 0);                   // transA
+    pd.set(3, 0);                   // transB
+    pd.set(4, 1);                   // constantA
+    pd.set(5, 0);                   // constantB
+    pd.set(6, 1);                   // constantC
+    pd.set(7, num_output);          // M = outch
+    pd.set(8, 0);                   // N = outw*outh*outd
+    pd.set(9, num_input * maxk);    // K = inch*maxk
+    pd.set(10, bias_term ? 1 : -1); // constant_broadcast_type_C = per M
+    pd.set(11, 0);                  // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // maxk-inch-outch to outch/inch/pa-maxk-pa
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+        tmp.create(num_input * maxk, num_output);
+
+        for (int p = 0; p < num_output; p++)
+        {
+            float* g00 = tmp.row(p);
+
+            const Mat k0 = weight_data_r2.channel(p);
+
+            for (int q = 0; q + (elempack - 1) < num_input; q += elempack)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    for (int i = 0; i < elempack; i++)
+                    {
+                        g00[0] = k0.row(q + i)[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    if (bias_term)
+    {
+        ncnn::Mat weights[2];
+        weights[0] = tmp;
+        weights[1] = bias_data;
+
+        gemm->load_model(ModelBinFromMatArray(weights));
+    }
+    else
+    {
+        ncnn::Mat weights[1];
+        weights[0] = tmp;
+
+        gemm->load_model(ModelBinFromMatArray(weights));
+    }
+
+    gemm->create_pipeline(opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Convolution3D_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+static void im2col_copy_packed(const float* sptr, float* outptr, int outw, int elempack, int stride)
+{
+    if (stride == 1)
+    {
+        memcpy(outptr, sptr, outw * elempack * sizeof(float));
+        return;
+    }
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            _mm512_storeu_ps(outptr, _mm512_loadu_ps(sptr));
+            sptr += stride * 16;
+            outptr += 16;
+        }
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            _mm256_storeu_ps(outptr, _mm256_loadu_ps(sptr));
+            sptr += stride * 8;
+            outptr += 8;
+        }
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        for (int j = 0; j < outw; j++)
+        {
+            _mm_storeu_ps(outptr, _mm_loadu_ps(sptr));
+            sptr += stride * 4;
+            outptr += 4;
+        }
+        return;
+    }
+#endif // __SSE2__
+
+    for (int j = 0; j < outw; j++)
+    {
+        outptr[0] = sptr[0];
+        sptr += stride;
+        outptr += 1;
+    }
+}
+
+int Convolution3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != in_elempack)
+    {
+        Option opt_p = opt;
+        opt_p.blob_allocator = opt.workspace_allocator;
+        convert_packing(bottom_blob, bottom_blob_unpacked, in_elempack, opt_p);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob_unpacked, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int d = bottom_blob_bordered.d;
+    const int channels = bottom_blob_bordered.c;
+    const int elempack = bottom_blob_bordered.elempack;
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+    const int kernel_extent_d = dilation_d * (kernel_d - 1) + 1;
+
+    const int outw = (w - kernel_extent_w) / stride_w + 1;
+    const int outh = (h - kernel_extent_h) / stride_h + 1;
+    const int outd = (d - kernel_extent_d) / stride_d + 1;
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+    const int N = outw * outh * outd;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w * dilation_h - kernel_w * dilation_w;
+        int gap1 = h * w * dilation_d - w * kernel_h * dilation_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += dilation_w;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+    // im2col
+    Mat bottom_im2col(N, channels * maxk, elemsize, elempack, opt.workspace_allocator);
+    if (bottom_im2col.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int r = 0; r < channels * maxk; r++)
+    {
+        const int q = r / maxk;
+        const int k = r % maxk;
+
+        const Mat m = bottom_blob_bordered.channel(q);
+        float* outptr = bottom_im2col.row(r);
+
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                const float* sptr = m.depth(z * stride_d).row(i * stride_h) + space_ofs[k] * elempack;
+
+                im2col_copy_packed(sptr, outptr, outw, elempack, stride_w);
+
+                outptr += outw * elempack;
+            }
+        }
+    }
+
+    // sgemm
+    Mat top_col;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = gemm->forward(bottom_im2col, top_col, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    const int out_elempack = top_col.elempack;
+    const size_t out_elemsize = top_col.elemsize;
+
+    top_blob.create(outw, outh, outd, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < top_blob.c; p++)
+    {
+        memcpy(top_blob.channel(p), top_col.row(p), N * out_elemsize);
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob, opt);
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -21,6 +21,7 @@
 #include "benchmark.h"
 #include "cpu.h"
 #include "layer_type.h"
+#include "packedweightcache.h"
 
 namespace ncnn {
 
@@ -30,6 +31,7 @@ namespace ncnn {
 #include "convolution_3x3_winograd.h"
 #include "convolution_packed.h"
 #include "convolution_im2col_gemm.h"
+#include "sparse_gemm.h"
 
 #if NCNN_INT8
 #include "convolution_3x3_int8.h"
@@ -63,6 +65,7 @@ Convolution_x86::Convolution_x86()
 
     activation = 0;
     nT = 0;
+    sparse_block = 0;
     convolution_dilation1 = 0;
 }
 
@@ -271,6 +274,66 @@ int Convolution_x86::create_pipeline(const Option& opt)
     if (dynamic_weight)
         return 0;
 
+    // column index of sparse weight is stored in 16 bits
+    if (opt.use_sparse_weight && kernel_w == 1 && kernel_h == 1 && stride_w == 1 && stride_h == 1 && weight_data.elemsize == (size_t)4u && !int8_scale_term && weight_data_size / num_output <= 65536)
+    {
+        const int num_input = weight_data_size / num_output;
+
+        int out_elempack = 1;
+#if __SSE2__
+        if (opt.use_packing_layout)
+        {
+#if __AVX512F__
+            out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+            out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+        }
+#endif // __SSE2__
+
+        // a stored block costs one vector multiply-add per pixel like out_elempack outputs of dense weight
+        // take the widest block that skips at least half of them
+        for (int block = out_elempack; block >= 4; block /= 2)
+        {
+            const int nnzb = sparse_weight_count_blocks(weight_data, num_input, num_output, block);
+            if (nnzb * out_elempack * 2 <= weight_data_size)
+            {
+                sparse_block = block;
+                break;
+            }
+        }
+
+        // unstructured sparsity walks pixels of unpacked blobs
+        if (sparse_block == 0 && out_elempack == 1)
+        {
+            const int nnz = sparse_weight_count_blocks(weight_data, num_input, num_output, 1);
+            if (nnz * 4 <= weight_data_size)
+            {
+                sparse_block = 1;
+            }
+        }
+
+        if (sparse_block)
+        {
+            activation = create_activation_layer(activation_type, activation_params, opt);
+            nT = opt.num_threads;
+
+            sparse_weight_pack(weight_data, weight_sparse_data, weight_sparse_index, weight_sparse_column, num_input, num_output, sparse_block);
+
+            if (opt.lightmode)
+                weight_data.release();
+
+            return 0;
+        }
+    }
+
+    if (opt.packed_weight_cache)
+    {
+        return create_pipeline_cached(opt);
+    }
+
     activation = create_activation_layer(activation_type, activation_params, opt);
     nT = opt.num_threads;
 
@@ -482,6 +545,82 @@ int Convolution_x86::create_pipeline(const Option& opt)
     return 0;
 }
 
+int Convolution_x86::create_pipeline_cached(const Option& opt)
+{
+    PackedWeightCache* cache = opt.packed_weight_cache;
+
+    std::vector<Mat> weights;
+    weights.push_back(weight_data);
+#if NCNN_INT8
+    weights.push_back(weight_data_int8_scales);
+    weights.push_back(bottom_blob_int8_scales);
+#endif
+
+    std::vector<int> params;
+    params.push_back(num_output);
+    params.push_back(kernel_w);
+    params.push_back(kernel_h);
+    params.push_back(dilation_w);
+    params.push_back(dilation_h);
+    params.push_back(stride_w);
+    params.push_back(stride_h);
+    params.push_back(pad_left);
+    params.push_back(pad_right);
+    params.push_back(pad_top);
+    params.push_back(pad_bottom);
+    params.push_back(weight_data_size);
+    params.push_back(int8_scale_term);
+    // winograd variant is chosen by shape hint
+    params.push_back(bottom_shapes.empty() ? 0 : bottom_shapes[0].w);
+    params.push_back(bottom_shapes.empty() ? 0 : bottom_shapes[0].h);
+    params.push_back(top_shapes.empty() ? 0 : top_shapes[0].w);
+    params.push_back(top_shapes.empty() ? 0 : top_shapes[0].h);
+
+    std::vector<Mat> packed;
+    if (cache->get("Convolution_x86", weights, params, opt, packed) == 0 && packed.size() == 6)
+    {
+        activation = create_activation_layer(activation_type, activation_params, opt);
+        nT = opt.num_threads;
+
+        weight_data_tm = packed[0];
+        weight_sgemm_data = packed[1];
+        weight_winograd23_data = packed[2];
+        weight_winograd43_data = packed[3];
+        weight_winograd63_data = packed[4];
+#if NCNN_INT8
+        scale_in_data = packed[5];
+#endif
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+
+    Option opt_nocache = opt;
+    opt_nocache.packed_weight_cache = 0;
+
+    int ret = create_pipeline(opt_nocache);
+    if (ret != 0)
+        return ret;
+
+    // dilation fallback keeps its weights in the sub convolution
+    if (convolution_dilation1)
+        return 0;
+
+    packed.resize(6);
+    packed[0] = weight_data_tm;
+    packed[1] = weight_sgemm_data;
+    packed[2] = weight_winograd23_data;
+    packed[3] = weight_winograd43_data;
+    packed[4] = weight_winograd63_data;
+#if NCNN_INT8
+    packed[5] = scale_in_data;
+#endif
+
+    return cache->put("Convolution_x86", weights, params, opt, packed);
+}
+
 int Convolution_x86::destroy_pipeline(const Option& opt)
 {
     if (activation)
@@ -588,6 +727,19 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
 #endif // __SSE2__
     size_t out_elemsize = elemsize / elempack * out_elempack;
 
+    if (sparse_block)
+    {
+        int ret = forward_sparse(bottom_blob_bordered, top_blob, out_elempack, opt);
+        if (ret != 0)
+            return ret;
+
+        if (activation)
+        {
+            activation->forward_inplace(top_blob, opt);
+        }
+        return 0;
+    }
+
     top_blob.create(outw, outh, num_output / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
     if (top_blob.empty())
         return -100;
@@ -808,6 +960,75 @@ int Convolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option
     return 0;
 }
 
+int Convolution_x86::forward_sparse(const Mat& bottom_blob, Mat& top_blob, int out_elempack, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+
+    if (sparse_block > 1)
+    {
+        // output blocks are vectors inside the packed output channels
+        top_blob.create(w, h, num_output / out_elempack, (size_t)4u * out_elempack, out_elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        sparse_gemm_packed(bottom_blob, top_blob, weight_sparse_data, weight_sparse_index, weight_sparse_column, bias_data, sparse_block, opt);
+
+        return 0;
+    }
+
+    // the unstructured kernel walks pixels of one channel, work in elempack 1
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != 1)
+    {
+        Option opt_unpack = opt;
+        opt_unpack.blob_allocator = opt.workspace_allocator;
+
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_unpack);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    Mat top_blob_unpacked;
+    top_blob_unpacked.create(w, h, num_output, (size_t)4u, out_elempack == 1 ? opt.blob_allocator : opt.workspace_allocator);
+    if (top_blob_unpacked.empty())
+        return -100;
+
+    if (w * h == 1)
+    {
+        // flattened blob, one column per channel
+        std::vector<float> x(bottom_blob_unpacked.c);
+        for (int q = 0; q < bottom_blob_unpacked.c; q++)
+        {
+            x[q] = bottom_blob_unpacked.channel(q)[0];
+        }
+
+        std::vector<float> y(num_output);
+        sparse_gemv(x.data(), y.data(), weight_sparse_data, weight_sparse_index, weight_sparse_column, bias_data, num_output, 1, opt);
+
+        for (int q = 0; q < num_output; q++)
+        {
+            top_blob_unpacked.channel(q)[0] = y[q];
+        }
+    }
+    else
+    {
+        sparse_gemm(bottom_blob_unpacked, top_blob_unpacked, weight_sparse_data, weight_sparse_index, weight_sparse_column, bias_data, opt);
+    }
+
+    if (out_elempack == 1)
+    {
+        top_blob = top_blob_unpacked;
+        return 0;
+    }
+
+    convert_packing(top_blob_unpacked, top_blob, out_elempack, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
 int Convolution_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
     const Mat& bottom_blob = bottom_blobs[0];
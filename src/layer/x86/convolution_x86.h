@@ -21,11 +21,13 @@ public:
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
 protected:
+    int create_pipeline_cached(const Option& opt);
 #if NCNN_INT8
     int create_pipeline_int8_x86(const Option& opt);
     int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #endif
     int forwardDilation_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_sparse(const Mat& bottom_blob, Mat& top_blob, int out_elempack, const Option& opt) const;
 
 public:
     Layer* activation;
@@ -40,6 +42,12 @@ public:
     // forwardDilation
     Layer* convolution_dilation1;
 
+    // pruned 1x1 convolution, 1xN block sparse weight
+    int sparse_block;
+    Mat weight_sparse_data;
+    Mat weight_sparse_index;
+    Mat weight_sparse_column;
+
 #if NCNN_INT8
     Mat scale_in_data;
 #endif
@@ -94,6 +94,78 @@ static void crop_pack4_sse(const Mat& src, Mat& dst, int top, int left)
 }
 #endif // __SSE2__
 
+#if NCNN_INT8
+static int crop_pack8_int8(const Mat& bottom_blob, Mat& top_blob, int woffset, int hoffset, int doffset, int coffset, int outw, int outh, int outd, int outc, const Option& opt)
+{
+    // each int8 pack8 element is 8 bytes, crop rows with memcpy
+    const int dims = bottom_blob.dims;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (dims == 1)
+    {
+        top_blob.create(outw / 8, elemsize, 8, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        memcpy(top_blob, (const signed char*)bottom_blob + woffset, outw);
+
+        return 0;
+    }
+
+    if (dims == 2)
+    {
+        top_blob.create(outw, outh / 8, elemsize, 8, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        for (int i = 0; i < outh / 8; i++)
+        {
+            memcpy(top_blob.row<signed char>(i), bottom_blob.row<const signed char>(hoffset / 8 + i) + woffset * 8, outw * 8);
+        }
+
+        return 0;
+    }
+
+    if (dims == 3)
+        top_blob.create(outw, outh, outc / 8, elemsize, 8, opt.blob_allocator);
+    else // if (dims == 4)
+        top_blob.create(outw, outh, outd, outc / 8, elemsize, 8, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int d = dims == 4 ? outd : 1;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < top_blob.c; q++)
+    {
+        const Mat m = bottom_blob.channel(coffset / 8 + q);
+        Mat outm = top_blob.channel(q);
+
+        for (int z = 0; z < d; z++)
+        {
+            const Mat mz = dims == 4 ? m.depth(doffset + z) : m;
+            Mat outmz = dims == 4 ? outm.depth(z) : outm;
+
+            for (int i = 0; i < outh; i++)
+            {
+                memcpy(outmz.row<signed char>(i), mz.row<const signed char>(hoffset + i) + woffset * 8, outw * 8);
+            }
+        }
+    }
+
+    return 0;
+}
+
+static bool crop_pack8_int8_aligned(int dims, int woffset, int hoffset, int coffset, int outw, int outh, int outc)
+{
+    if (dims == 1)
+        return woffset % 8 == 0 && outw % 8 == 0;
+    if (dims == 2)
+        return hoffset % 8 == 0 && outh % 8 == 0;
+    return coffset % 8 == 0 && outc % 8 == 0;
+}
+#endif // NCNN_INT8
+
 int Crop_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int w = bottom_blob.w;
@@ -118,6 +190,28 @@ int Crop_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt)
         resolve_crop_roi(bottom_blob.shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
     }
 
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8)
+    {
+        if (elempack == 8 && crop_pack8_int8_aligned(dims, _woffset, _hoffset, _coffset, _outw, _outh, _outc))
+            return crop_pack8_int8(bottom_blob, top_blob, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc, opt);
+
+        // crop across the packed int8 lanes in pack1
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (elempack != 1)
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_pack1);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        return Crop::forward(bottom_blob_unpacked, top_blob, opt);
+    }
+#endif // NCNN_INT8
+
 #if __AVX__
 #if __AVX512F__
     if (elempack == 16)
@@ -559,6 +653,28 @@ int Crop_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
         resolve_crop_roi(bottom_blob.shape(), reference_blob.shape(), _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc);
     }
 
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8)
+    {
+        if (elempack == 8 && crop_pack8_int8_aligned(dims, _woffset, _hoffset, _coffset, _outw, _outh, _outc))
+            return crop_pack8_int8(bottom_blob, top_blob, _woffset, _hoffset, _doffset, _coffset, _outw, _outh, _outd, _outc, opt);
+
+        // crop across the packed int8 lanes in pack1
+        std::vector<Mat> bottom_blobs_unpacked(bottom_blobs);
+        if (elempack != 1)
+        {
+            Option opt_pack1 = opt;
+            opt_pack1.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blobs_unpacked[0], 1, opt_pack1);
+            if (bottom_blobs_unpacked[0].empty())
+                return -100;
+        }
+
+        return Crop::forward(bottom_blobs_unpacked, top_blobs, opt);
+    }
+#endif // NCNN_INT8
+
 #if __AVX__
 #if __AVX512F__
     if (elempack == 16)
@@ -0,0 +1,473 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "deconvolution1d_x86.h"
+
+#include "layer_type.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+namespace ncnn {
+
+Deconvolution1D_x86::Deconvolution1D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+
+    activation = 0;
+    gemm = 0;
+}
+
+int Deconvolution1D_x86::create_pipeline(const Option& opt)
+{
+    if (dynamic_weight)
+        return 0;
+
+    activation = create_activation_layer(activation_type, activation_params, opt);
+
+    const int maxk = kernel_w;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // every input column scatters maxk taps of every output channel,
+    // compute all of them with one gemm and accumulate with col2im
+    gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
+
+    ncnn::ParamDict pd;
+    pd.set(2, 1);                 // transA
+    pd.set(3, 0);                 // transB
+    pd.set(4, 1);                 // constantA
+    pd.set(5, 0);                 // constantB
+    pd.set(6, 1);                 // constantC
+    pd.set(7, maxk * num_output); // M = maxk*num_output
+    pd.set(8, 0);                 // N = w
+    pd.set(9, num_input);         // K = inch
+    pd.set(10, -1);               // constant_broadcast_type_C = null
+    pd.set(11, 0);                // output_N1M
+    pd.set(12, out_elempack);
+
+    gemm->load_param(pd);
+
+    // maxk-inch-outch to pa-maxk-outch/pa-inch
+    Mat tmp;
+    {
+        Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+        tmp.create(maxk * num_output, num_input);
+
+        for (int p = 0; p < num_input; p += 1)
+        {
+            float* g00 = tmp.row(p);
+
+            for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+            {
+                for (int k = 0; k < maxk; k++)
+                {
+                    for (int i = 0; i < out_elempack; i++)
+                    {
+                        const float* k00 = weight_data_r2.channel(q + i).row(p);
+                        g00[0] = k00[k];
+                        g00++;
+                    }
+                }
+            }
+        }
+    }
+
+    ncnn::Mat weights[1];
+    weights[0] = tmp;
+
+    gemm->load_model(ModelBinFromMatArray(weights));
+
+    gemm->create_pipeline(opt);
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Deconvolution1D_x86::destroy_pipeline(const Option& opt)
+{
+    if (activation)
+    {
+        activation->destroy_pipeline(opt);
+        delete activation;
+        activation = 0;
+    }
+
+    if (gemm)
+    {
+        gemm->destroy_pipeline(opt);
+        delete gemm;
+        gemm = 0;
+    }
+
+    return 0;
+}
+
+int Deconvolution1D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int elempack = bottom_blob.elempack;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    const int out_h = num_output / out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || output_w > 0)
+    {
+        top_blob_bordered.create(outw, out_h, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, out_h, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w;
+
+    // sgemm
+    Mat top_col2im;
+    {
+        Option opt_b = opt;
+        opt_b.blob_allocator = opt.workspace_allocator;
+        int ret = gemm->forward(bottom_blob, top_col2im, opt_b);
+        if (ret != 0)
+            return ret;
+    }
+
+    // col2im
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (out_elempack == 16)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < out_h; p++)
+        {
+            Mat outm = top_blob_bordered.row_range(p, 1);
+
+            if (bias_data.empty())
+            {
+                outm.fill(_mm512_setzero_ps());
+            }
+            else
+            {
+                outm.fill(_mm512_loadu_ps((const float*)bias_data + p * 16));
+            }
+
+            for (int k = 0; k < maxk; k++)
+            {
+                const float* sptr = top_col2im.row(p * maxk + k);
+                float* ptr = (float*)outm + dilation_w * k * 16;
+
+                for (int j = 0; j < w; j++)
+                {
+                    __m512 _val = _mm512_loadu_ps(ptr);
+                    __m512 _s = _mm512_loadu_ps(sptr);
+                    _val = _mm512_add_ps(_val, _s);
+                    _mm512_storeu_ps(ptr, _val);
+
+                    ptr += stride_w * 16;
+                    sptr += 16;
+                }
+            }
+        }
+    }
+#endif // __AVX512F__
+
+    if (out_elempack == 8)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < out_h; p++)
+        {
+            Mat outm = top_blob_bordered.row_range(p, 1);
+
+            if (bias_data.empty())
+            {
+                outm.fill(_mm256_setzero_ps());
+            }
+            else
+            {
+                outm.fill(_mm256_loadu_ps((const float*)bias_data + p * 8));
+            }
+
+            for (int k = 0; k < maxk; k++)
+            {
+                const float* sptr = top_col2im.row(p * maxk + k);
+                float* ptr = (float*)outm + dilation_w * k * 8;
+
+                for (int j = 0; j < w; j++)
+                {
+                    __m256 _val = _mm256_loadu_ps(ptr);
+                    __m256 _s = _mm256_loadu_ps(sptr);
+                    _val = _mm256_add_ps(_val, _s);
+                    _mm256_storeu_ps(ptr, _val);
+
+                    ptr += stride_w * 8;
+                    sptr += 8;
+                }
+            }
+        }
+    }
+#endif // __AVX__
+
+    if (out_elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < out_h; p++)
+        {
+            Mat outm = top_blob_bordered.row_range(p, 1);
+
+            if (bias_data.empty())
+            {
+                outm.fill(_mm_setzero_ps());
+            }
+            else
+            {
+                outm.fill(_mm_loadu_ps((const float*)bias_data + p * 4));
+            }
+
+            for (int k = 0; k < maxk; k++)
+            {
+                const float* sptr = top_col2im.row(p * maxk + k);
+                float* ptr = (float*)outm + dilation_w * k * 4;
+
+                for (int j = 0; j < w; j++)
+                {
+                    __m128 _val = _mm_loadu_ps(ptr);
+                    __m128 _s = _mm_loadu_ps(sptr);
+                    _val = _mm_add_ps(_val, _s);
+                    _mm_storeu_ps(ptr, _val);
+
+                    ptr += stride_w * 4;
+                    sptr += 4;
+                }
+            }
+        }
+    }
+#endif // __SSE2__
+
+    if (out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < out_h; p++)
+        {
+            Mat outm = top_blob_bordered.row_range(p, 1);
+
+            const float bias = bias_data.empty() ? 0.f : bias_data[p];
+            outm.fill(bias);
+
+            for (int k = 0; k < maxk; k++)
+            {
+                const float* sptr = top_col2im.row(p * maxk + k);
+                float* ptr = (float*)outm + dilation_w * k;
+
+                for (int j = 0; j < w; j++)
+                {
+                    ptr[0] += sptr[0];
+
+                    ptr += stride_w;
+                    sptr += 1;
+                }
+            }
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    // copy_cut_border treats h as unpacked rows, cut the packed rows here
+    int wcut_left = 0;
+    int wcut_right = 0;
+    if (pad_left > 0 || pad_right > 0)
+    {
+        wcut_left = pad_left;
+        wcut_right = pad_right;
+    }
+    else if (output_w > 0)
+    {
+        const int wcut = outw - output_w;
+
+        if (pad_left == -233 || pad_right == -233)
+        {
+            // onnx padding=SAME_UPPER
+            wcut_left = wcut / 2;
+            wcut_right = wcut - wcut / 2;
+        }
+        else if (pad_left == -234 || pad_right == -234)
+        {
+            // onnx padding=SAME_LOWER
+            wcut_left = wcut - wcut / 2;
+            wcut_right = wcut / 2;
+        }
+    }
+
+    if (wcut_left == 0 && wcut_right == 0)
+    {
+        top_blob = top_blob_bordered;
+        return 0;
+    }
+
+    const int cut_outw = outw - wcut_left - wcut_right;
+
+    top_blob.create(cut_outw, out_h, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int p = 0; p < out_h; p++)
+    {
+        const float* sptr = (const float*)top_blob_bordered.row(p) + wcut_left * out_elempack;
+        float* outptr = top_blob.row(p);
+
+        memcpy(outptr, sptr, cut_outw * out_elemsize);
+    }
+
+    return 0;
+}
+
+int Deconvolution1D_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const Mat& _weight_data = bottom_blobs[1];
+    Mat& top_blob = top_blobs[0];
+
+    const int _num_input = bottom_blob.h * bottom_blob.elempack;
+    const int _kernel_w = _weight_data.w;
+    const int _num_output = _weight_data.h * 1;
+
+    Mat weight_data_flattened;
+    flatten(_weight_data, weight_data_flattened, opt);
+    if (weight_data_flattened.empty())
+        return -100;
+
+    // weight_data_flattened as pack1
+    weight_data_flattened.w *= weight_data_flattened.elempack;
+    weight_data_flattened.elemsize /= weight_data_flattened.elempack;
+    weight_data_flattened.elempack = 1;
+
+    // transpose group-inch/group-outch/group-kw to group-outch/group-inch/group-kw
+    Mat weight_data_transposed;
+    {
+        weight_data_transposed.create(_kernel_w * _num_output * _num_input / 1, 4u, opt.workspace_allocator);
+        if (weight_data_transposed.empty())
+            return -100;
+
+        const int outch_g = _num_output / 1;
+        const int inch_g = _num_input / 1;
+        const int maxk = _kernel_w;
+
+        for (int g = 0; g < 1; g++)
+        {
+            // reorder weight from inch-outch to outch-inch
+            float* wg2 = (float*)weight_data_transposed + g * outch_g * inch_g * maxk;
+            const float* wg = (const float*)weight_data_flattened + g * inch_g * outch_g * maxk;
+            for (int i = 0; i < outch_g; i++)
+            {
+                for (int j = 0; j < inch_g; j++)
+                {
+                    for (int k = 0; k < maxk; k++)
+                    {
+                        wg2[(i * inch_g + j) * maxk + k] = wg[(j * outch_g + i) * maxk + k];
+                    }
+                }
+            }
+        }
+    }
+
+    Mat bias_data_flattened;
+    if (bias_term)
+    {
+        const Mat& _bias_data = bottom_blobs[2];
+        flatten(_bias_data, bias_data_flattened, opt);
+        if (bias_data_flattened.empty())
+            return -100;
+
+        // bias_data_flattened as pack1
+        bias_data_flattened.w *= bias_data_flattened.elempack;
+        bias_data_flattened.elemsize /= bias_data_flattened.elempack;
+        bias_data_flattened.elempack = 1;
+    }
+
+    ncnn::Layer* op = ncnn::create_layer_cpu(ncnn::LayerType::Deconvolution1D);
+
+    ncnn::ParamDict pd;
+    pd.set(0, _num_output);
+    pd.set(1, _kernel_w);
+    pd.set(2, dilation_w);
+    pd.set(3, stride_w);
+    pd.set(4, pad_left);
+    pd.set(15, pad_right);
+    pd.set(18, output_pad_right);
+    pd.set(20, output_w);
+    pd.set(5, bias_term);
+    pd.set(6, weight_data_transposed.w);
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    op->load_param(pd);
+
+    ncnn::Mat weights[2];
+    weights[0] = weight_data_transposed;
+    weights[1] = bias_data_flattened;
+
+    op->load_model(ncnn::ModelBinFromMatArray(weights));
+
+    op->create_pipeline(opt);
+
+    op->forward(bottom_blob, top_blob, opt);
+
+    op->destroy_pipeline(opt);
+
+    delete op;
+
+    return 0;
+}
+
+} // namespace ncnn
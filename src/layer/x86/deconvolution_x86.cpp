@@ -7,16 +7,28 @@
 
 #if __SSE2__
 #include <emmintrin.h>
+#if __SSSE3__
+#include <tmmintrin.h>
+#if __SSE4_1__
+#include <smmintrin.h>
 #if __AVX__
 #include <immintrin.h>
 #endif
+#endif // __SSE4_1__
+#endif // __SSSE3__
 #endif // __SSE2__
 
 #include "x86_activation.h"
 #include "x86_usability.h"
 
+#include "cpu.h"
+
 namespace ncnn {
 
+#if NCNN_INT8
+#include "convolution_im2col_gemm_int8.h"
+#endif // NCNN_INT8
+
 #if __SSE2__
 #include "deconvolution_pack4.h"
 #include "deconvolution_pack1to4.h"
@@ -49,6 +61,8 @@ Deconvolution_x86::Deconvolution_x86()
 
     activation = 0;
     gemm = 0;
+
+    nT = 0;
 }
 
 int Deconvolution_x86::create_pipeline(const Option& opt)
@@ -58,6 +72,13 @@ int Deconvolution_x86::create_pipeline(const Option& opt)
 
     activation = create_activation_layer(activation_type, activation_params, opt);
 
+#if NCNN_INT8
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    {
+        return create_pipeline_int8_x86(opt);
+    }
+#endif
+
     const int maxk = kernel_w * kernel_h;
     int num_input = weight_data_size / maxk / num_output;
 
@@ -209,6 +230,13 @@ int Deconvolution_x86::destroy_pipeline(const Option& opt)
 
 int Deconvolution_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+#if NCNN_INT8
+    if (opt.use_int8_inference && int8_scale_term)
+    {
+        return forward_int8_x86(bottom_blob, top_blob, opt);
+    }
+#endif
+
     // deconvolv with NxN kernel
     // value = value + bias
 
@@ -725,4 +753,205 @@ int Deconvolution_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector
     return 0;
 }
 
+#if NCNN_INT8
+int Deconvolution_x86::create_pipeline_int8_x86(const Option& opt)
+{
+    const int maxk = kernel_w * kernel_h;
+    const int num_input = weight_data_size / maxk / num_output;
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // every input pixel scatters maxk taps of every output channel,
+    // compute them as a 1x1 int8 convolution with maxk*outch outputs
+    // maxk-inch-outch to inch-pb-maxk-outch/pb
+    Mat weight_data_r2 = weight_data.reshape(maxk, num_input, num_output);
+
+    Mat kernel_1x1(num_input, maxk * num_output, (size_t)1u);
+    {
+        for (int q = 0; q + (out_elempack - 1) < num_output; q += out_elempack)
+        {
+            for (int k = 0; k < maxk; k++)
+            {
+                for (int i = 0; i < out_elempack; i++)
+                {
+                    signed char* g00 = kernel_1x1.row<signed char>((q * maxk) + k * out_elempack + i);
+
+                    for (int p = 0; p < num_input; p++)
+                    {
+                        g00[p] = weight_data_r2.channel(q + i).row<const signed char>(p)[k];
+                    }
+                }
+            }
+        }
+    }
+
+    convolution_im2col_gemm_transform_kernel_int8(kernel_1x1, weight_sgemm_data, num_input, maxk * num_output, 1, 1, opt);
+
+    scale_in_data.create(num_output);
+    for (int p = 0; p < num_output; p++)
+    {
+        float scale_in;
+        if (weight_data_int8_scales[p] == 0)
+            scale_in = 0;
+        else
+            scale_in = 1.f / (bottom_blob_int8_scales[0] * weight_data_int8_scales[p]);
+
+        scale_in_data[p] = scale_in;
+    }
+
+    nT = opt.num_threads;
+
+    if (opt.lightmode)
+        weight_data.release();
+
+    return 0;
+}
+
+int Deconvolution_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    Mat bottom_blob_int8 = bottom_blob;
+    if (bottom_blob.elembits() != 8)
+    {
+        Option opt_q = opt;
+        opt_q.blob_allocator = opt.workspace_allocator;
+        quantize_to_int8(bottom_blob, bottom_blob_int8, bottom_blob_int8_scales, opt_q);
+        if (bottom_blob_int8.empty())
+            return -100;
+    }
+
+    const int w = bottom_blob_int8.w;
+    const int h = bottom_blob_int8.h;
+
+    const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
+    const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
+
+    const int outw = (w - 1) * stride_w + kernel_extent_w + output_pad_right;
+    const int outh = (h - 1) * stride_h + kernel_extent_h + output_pad_bottom;
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = 4u * out_elempack;
+
+    const int out_channels = num_output / out_elempack;
+
+    Mat top_blob_bordered;
+    if (pad_left > 0 || pad_right > 0 || pad_top > 0 || pad_bottom > 0 || (output_w > 0 && output_h > 0))
+    {
+        top_blob_bordered.create(outw, outh, out_channels, out_elemsize, out_elempack, opt.workspace_allocator);
+    }
+    else
+    {
+        top_blob_bordered = top_blob;
+        top_blob_bordered.create(outw, outh, out_channels, out_elemsize, out_elempack, opt.blob_allocator);
+    }
+    if (top_blob_bordered.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h;
+
+    int _nT = nT ? nT : opt.num_threads;
+    if (nT != 0 && opt.num_threads != nT)
+    {
+        // force num_threads the same as in create_pipeline
+        // so we could use pre-packed A/B from the same tile config
+        NCNN_LOGE("opt.num_threads %d changed, deconvolution gemm will use load-time value %d", opt.num_threads, nT);
+    }
+
+    // int8 gemm, maxk taps of pb output channels per int32 channel
+    Mat top_col2im(w, h, maxk * out_channels, 4u * out_elempack, out_elempack, opt.workspace_allocator);
+    if (top_col2im.empty())
+        return -100;
+
+    int ret = convolution_im2col_gemm_int8(bottom_blob_int8, top_col2im, weight_sgemm_data, 1, 1, 1, 1, 1, 1, _nT, opt);
+    if (ret != 0)
+        return ret;
+
+    // col2im in int32 and dequantize once
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pp = 0; pp < out_channels; pp++)
+    {
+        std::vector<int> _sum(outw * outh * out_elempack, 0);
+        int* sum = &_sum[0];
+
+        for (int y = 0; y < kernel_h; y++)
+        {
+            for (int x = 0; x < kernel_w; x++)
+            {
+                const int* sptr = top_col2im.channel(pp * maxk + y * kernel_w + x);
+
+                for (int i = 0; i < h; i++)
+                {
+                    int* ptr = sum + ((i * stride_h + y * dilation_h) * outw + x * dilation_w) * out_elempack;
+
+                    for (int j = 0; j < w; j++)
+                    {
+                        for (int l = 0; l < out_elempack; l++)
+                        {
+                            ptr[l] += sptr[l];
+                        }
+
+                        ptr += stride_w * out_elempack;
+                        sptr += out_elempack;
+                    }
+                }
+            }
+        }
+
+        const float* scale_in_ptr = (const float*)scale_in_data + pp * out_elempack;
+        const float* bias_ptr = bias_term ? (const float*)bias_data + pp * out_elempack : 0;
+
+        float* outptr = top_blob_bordered.channel(pp);
+
+        for (int i = 0; i < outw * outh; i++)
+        {
+            for (int l = 0; l < out_elempack; l++)
+            {
+                float sumfp32 = sum[l] * scale_in_ptr[l];
+
+                if (bias_ptr)
+                    sumfp32 += bias_ptr[l];
+
+                outptr[l] = sumfp32;
+            }
+
+            sum += out_elempack;
+            outptr += out_elempack;
+        }
+    }
+
+    if (activation)
+    {
+        activation->forward_inplace(top_blob_bordered, opt);
+    }
+
+    cut_padding(top_blob_bordered, top_blob, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -20,11 +20,24 @@ public:
 
     virtual int forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const;
 
+protected:
+#if NCNN_INT8
+    int create_pipeline_int8_x86(const Option& opt);
+    int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
+
 public:
     Layer* activation;
     Layer* gemm;
 
     Mat weight_data_tm;
+
+#if NCNN_INT8
+    Mat weight_sgemm_data;
+    Mat scale_in_data;
+#endif
+
+    int nT;
 };
 
 } // namespace ncnn
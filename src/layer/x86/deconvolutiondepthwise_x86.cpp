@@ -32,6 +32,23 @@ int DeconvolutionDepthWise_x86::create_pipeline(const Option& opt)
     const int maxk = kernel_w * kernel_h;
     int channels = (weight_data_size / group) / maxk / (num_output / group) * group;
 
+#if NCNN_INT8
+    if (opt.use_int8_inference && weight_data.elemsize == (size_t)1u)
+    {
+        // depth-wise int8 keeps the int8 weight for the pack1 kernel
+        if (channels == group && group == num_output)
+            return 0;
+
+        // group int8 runs on Deconvolution int8 ops
+        create_group_ops(opt);
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+#endif
+
     // depth-wise
     if (channels == group && group == num_output)
     {
@@ -153,6 +170,7 @@ int DeconvolutionDepthWise_x86::create_group_ops(const Option& opt)
         pd.set(19, output_pad_bottom);
         pd.set(5, bias_term);
         pd.set(6, maxk * channels_g * num_output_g); // weight_data_size
+        pd.set(8, int8_scale_term);
         pd.set(9, activation_type);
         pd.set(10, activation_params);
 
@@ -161,17 +179,37 @@ int DeconvolutionDepthWise_x86::create_group_ops(const Option& opt)
         // set weights
         if (bias_term)
         {
-            ncnn::Mat weights[2];
+            ncnn::Mat weights[4];
             weights[0] = weight_data_g;
             weights[1] = bias_data_g;
 
+#if NCNN_INT8
+            if (int8_scale_term)
+            {
+                Mat weight_data_int8_scales_g(num_output_g);
+                weight_data_int8_scales_g.fill(weight_data_int8_scales[g]);
+                weights[2] = weight_data_int8_scales_g;
+                weights[3] = bottom_blob_int8_scales.range(g, 1);
+            }
+#endif
+
             op->load_model(ModelBinFromMatArray(weights));
         }
         else
         {
-            ncnn::Mat weights[1];
+            ncnn::Mat weights[3];
             weights[0] = weight_data_g;
 
+#if NCNN_INT8
+            if (int8_scale_term)
+            {
+                Mat weight_data_int8_scales_g(num_output_g);
+                weight_data_int8_scales_g.fill(weight_data_int8_scales[g]);
+                weights[1] = weight_data_int8_scales_g;
+                weights[2] = bottom_blob_int8_scales.range(g, 1);
+            }
+#endif
+
             op->load_model(ModelBinFromMatArray(weights));
         }
 
@@ -206,6 +244,13 @@ int DeconvolutionDepthWise_x86::forward(const Mat& bottom_blob, Mat& top_blob, c
     size_t elemsize = bottom_blob.elemsize;
     int elempack = bottom_blob.elempack;
 
+#if NCNN_INT8
+    if (opt.use_int8_inference && int8_scale_term && channels * elempack == group && group == num_output)
+    {
+        return forward_int8_x86(bottom_blob, top_blob, opt);
+    }
+#endif
+
     const int kernel_extent_w = dilation_w * (kernel_w - 1) + 1;
     const int kernel_extent_h = dilation_h * (kernel_h - 1) + 1;
 
@@ -680,4 +725,22 @@ int DeconvolutionDepthWise_x86::forward(const std::vector<Mat>& bottom_blobs, st
     return 0;
 }
 
+#if NCNN_INT8
+int DeconvolutionDepthWise_x86::forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // depth-wise int8 scatters with the pack1 kernel
+    Mat bottom_blob_unpacked = bottom_blob;
+    if (bottom_blob.elempack != 1)
+    {
+        Option opt_p = opt;
+        opt_p.blob_allocator = opt.workspace_allocator;
+        convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_p);
+        if (bottom_blob_unpacked.empty())
+            return -100;
+    }
+
+    return DeconvolutionDepthWise::forward_int8(bottom_blob_unpacked, top_blob, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -22,6 +22,9 @@ public:
 
 protected:
     int create_group_ops(const Option& opt);
+#if NCNN_INT8
+    int forward_int8_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+#endif
 
 public:
     std::vector<ncnn::Layer*> group_ops;
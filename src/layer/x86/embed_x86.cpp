@@ -0,0 +1,226 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "embed_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+#include "weight_quant.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+#include "weight_quant_gemm.h"
+
+Embed_x86::Embed_x86()
+{
+}
+
+// the table is never touched outside of forward, only the rows of the gathered words get paged in
+static void embed_row(const float* em, const float* bias, float* outptr, int num_output)
+{
+    if (!bias)
+    {
+        memcpy(outptr, em, num_output * sizeof(float));
+        return;
+    }
+
+    int p = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; p + 15 < num_output; p += 16)
+    {
+        _mm512_storeu_ps(outptr + p, _mm512_add_ps(_mm512_loadu_ps(em + p), _mm512_loadu_ps(bias + p)));
+    }
+#endif // __AVX512F__
+    for (; p + 7 < num_output; p += 8)
+    {
+        _mm256_storeu_ps(outptr + p, _mm256_add_ps(_mm256_loadu_ps(em + p), _mm256_loadu_ps(bias + p)));
+    }
+#endif // __AVX__
+    for (; p + 3 < num_output; p += 4)
+    {
+        _mm_storeu_ps(outptr + p, _mm_add_ps(_mm_loadu_ps(em + p), _mm_loadu_ps(bias + p)));
+    }
+#endif // __SSE2__
+    for (; p < num_output; p++)
+    {
+        outptr[p] = em[p] + bias[p];
+    }
+}
+
+static void embed_row_fp16(const unsigned short* em, const float* bias, float* outptr, int num_output)
+{
+    int p = 0;
+#if __F16C__
+#if __AVX512F__
+    for (; p + 15 < num_output; p += 16)
+    {
+        __m512 _v = _mm512_cvtph_ps(_mm256_loadu_si256((const __m256i*)(em + p)));
+        if (bias)
+            _v = _mm512_add_ps(_v, _mm512_loadu_ps(bias + p));
+        _mm512_storeu_ps(outptr + p, _v);
+    }
+#endif // __AVX512F__
+    for (; p + 7 < num_output; p += 8)
+    {
+        __m256 _v = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(em + p)));
+        if (bias)
+            _v = _mm256_add_ps(_v, _mm256_loadu_ps(bias + p));
+        _mm256_storeu_ps(outptr + p, _v);
+    }
+#endif // __F16C__
+    for (; p < num_output; p++)
+    {
+        float v = float16_to_float32(em[p]);
+        if (bias)
+            v += bias[p];
+        outptr[p] = v;
+    }
+}
+
+static void embed_row_weight_quant(const signed char* em, const float* scales, const float* bias, float* outptr, int num_output, int bits, int group_size)
+{
+    const int gs = group_size > 0 ? group_size : num_output;
+
+    for (int p0 = 0, g = 0; p0 < num_output; p0 += gs, g++)
+    {
+        const int p1 = std::min(p0 + gs, num_output);
+        const float scale = scales[g];
+
+        int p = p0;
+#if __SSE2__
+        // int4 bytes hold an even and an odd weight
+        if (bits == 8 || p0 % 2 == 0)
+        {
+#if __AVX512F__
+            __m512 _scale = _mm512_set1_ps(scale);
+            for (; p + 15 < p1; p += 16)
+            {
+                __m128i _w = weight_quant_load16(em, p, bits);
+                __m512 _v = _mm512_mul_ps(_mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_w)), _scale);
+                if (bias)
+                    _v = _mm512_add_ps(_v, _mm512_loadu_ps(bias + p));
+                _mm512_storeu_ps(outptr + p, _v);
+            }
+#elif __AVX__
+            __m256 _scale = _mm256_set1_ps(scale);
+            for (; p + 15 < p1; p += 16)
+            {
+                __m128i _w = weight_quant_load16(em, p, bits);
+                __m128i _w0 = _mm_cvtepi8_epi32(_w);
+                __m128i _w1 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 4));
+                __m128i _w2 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 8));
+                __m128i _w3 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 12));
+                __m256 _v0 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_w0), _w1, 1)), _scale);
+                __m256 _v1 = _mm256_mul_ps(_mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_w2), _w3, 1)), _scale);
+                if (bias)
+                {
+                    _v0 = _mm256_add_ps(_v0, _mm256_loadu_ps(bias + p));
+                    _v1 = _mm256_add_ps(_v1, _mm256_loadu_ps(bias + p + 8));
+                }
+                _mm256_storeu_ps(outptr + p, _v0);
+                _mm256_storeu_ps(outptr + p + 8, _v1);
+            }
+#else
+            __m128 _scale = _mm_set1_ps(scale);
+            for (; p + 15 < p1; p += 16)
+            {
+                __m128i _w = weight_quant_load16(em, p, bits);
+                // sign extend with arithmetic shifts
+                __m128i _w16lo = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+                __m128i _w16hi = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+                __m128 _v0 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16lo, _w16lo), 16)), _scale);
+                __m128 _v1 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16lo, _w16lo), 16)), _scale);
+                __m128 _v2 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16hi, _w16hi), 16)), _scale);
+                __m128 _v3 = _mm_mul_ps(_mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16hi, _w16hi), 16)), _scale);
+                if (bias)
+                {
+                    _v0 = _mm_add_ps(_v0, _mm_loadu_ps(bias + p));
+                    _v1 = _mm_add_ps(_v1, _mm_loadu_ps(bias + p + 4));
+                    _v2 = _mm_add_ps(_v2, _mm_loadu_ps(bias + p + 8));
+                    _v3 = _mm_add_ps(_v3, _mm_loadu_ps(bias + p + 12));
+                }
+                _mm_storeu_ps(outptr + p, _v0);
+                _mm_storeu_ps(outptr + p + 4, _v1);
+                _mm_storeu_ps(outptr + p + 8, _v2);
+                _mm_storeu_ps(outptr + p + 12, _v3);
+            }
+#endif
+        }
+#endif // __SSE2__
+        for (; p < p1; p++)
+        {
+            float v = weight_quant_value(em, p, bits) * scale;
+            if (bias)
+                v += bias[p];
+            outptr[p] = v;
+        }
+    }
+}
+
+int Embed_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int words = bottom_blob.w;
+
+    top_blob.create(num_output, words, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const size_t row_bytes = weight_quant_bits ? weight_quant_row_bytes(num_output, weight_quant_bits) : num_output * weight_data.elemsize;
+    const int groups = weight_quant_bits ? weight_quant_group_count(num_output, weight_quant_group_size) : 1;
+
+#if NCNN_INT8
+    // the legacy int8 table shares one scale
+    const float descale_em = int8_scale_term ? 1.f / weight_data_int8_scale : 1.f;
+#endif // NCNN_INT8
+
+    const float* bias_ptr = bias_data;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < words; q++)
+    {
+        float* outptr = top_blob.row(q);
+
+        int word_index = ((const int*)bottom_blob)[q];
+
+        if (word_index < 0)
+            word_index = 0;
+        if (word_index >= input_dim)
+            word_index = input_dim - 1;
+
+        const unsigned char* em = (const unsigned char*)weight_data + row_bytes * word_index;
+
+        if (weight_quant_bits)
+        {
+            const float* scales = (const float*)weight_data_quant_scales + groups * word_index;
+            embed_row_weight_quant((const signed char*)em, scales, bias_ptr, outptr, num_output, weight_quant_bits, weight_quant_group_size);
+        }
+#if NCNN_INT8
+        else if (int8_scale_term)
+        {
+            embed_row_weight_quant((const signed char*)em, &descale_em, bias_ptr, outptr, num_output, 8, 0);
+        }
+#endif // NCNN_INT8
+        else if (weight_data.elemsize == 2)
+        {
+            embed_row_fp16((const unsigned short*)em, bias_ptr, outptr, num_output);
+        }
+        else
+        {
+            embed_row((const float*)em, bias_ptr, outptr, num_output);
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,21 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef LAYER_EMBED_X86_H
+#define LAYER_EMBED_X86_H
+
+#include "embed.h"
+
+namespace ncnn {
+
+class Embed_x86 : public Embed
+{
+public:
+    Embed_x86();
+
+    virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+};
+
+} // namespace ncnn
+
+#endif // LAYER_EMBED_X86_H
@@ -0,0 +1,117 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef FFT_X86_H
+#define FFT_X86_H
+
+// vector ops for fft_forward, every lane carries one whole sequence of the batch
+
+#if __SSE2__
+struct fft_op_sse
+{
+    typedef __m128 V;
+    enum
+    {
+        lanes = 4
+    };
+
+    static NCNN_FORCEINLINE V load(const float* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, V v)
+    {
+        _mm_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE V set1(float v)
+    {
+        return _mm_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE V add(V a, V b)
+    {
+        return _mm_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V sub(V a, V b)
+    {
+        return _mm_sub_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V mul(V a, V b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+};
+
+#if __AVX__
+struct fft_op_avx
+{
+    typedef __m256 V;
+    enum
+    {
+        lanes = 8
+    };
+
+    static NCNN_FORCEINLINE V load(const float* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, V v)
+    {
+        _mm256_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE V set1(float v)
+    {
+        return _mm256_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE V add(V a, V b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V sub(V a, V b)
+    {
+        return _mm256_sub_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V mul(V a, V b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+};
+
+#if __AVX512F__
+struct fft_op_avx512
+{
+    typedef __m512 V;
+    enum
+    {
+        lanes = 16
+    };
+
+    static NCNN_FORCEINLINE V load(const float* p)
+    {
+        return _mm512_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, V v)
+    {
+        _mm512_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE V set1(float v)
+    {
+        return _mm512_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE V add(V a, V b)
+    {
+        return _mm512_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V sub(V a, V b)
+    {
+        return _mm512_sub_ps(a, b);
+    }
+    static NCNN_FORCEINLINE V mul(V a, V b)
+    {
+        return _mm512_mul_ps(a, b);
+    }
+};
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#endif // FFT_X86_H
@@ -15,14 +15,17 @@
 #endif // __AVX__
 #endif // __SSE2__
 #include "x86_usability.h"
+#include "weight_quant.h"
 
 #include "cpu.h"
+#include "packedweightcache.h"
 
 namespace ncnn {
 
 #if NCNN_INT8
 #include "gemm_int8.h"
 #endif
+#include "weight_quant_gemm.h"
 
 Gemm_x86::Gemm_x86()
 {
@@ -7220,6 +7223,12 @@ static int gemm_AT_BT_x86(const Mat& AT, const Mat& BT, const Mat& C, Mat& top_b
 
 int Gemm_x86::create_pipeline(const Option& opt)
 {
+    if (weight_quant_bits)
+    {
+        // B is used as loaded, dequantized in the gemm
+        return 0;
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -7227,6 +7236,11 @@ int Gemm_x86::create_pipeline(const Option& opt)
     }
 #endif
 
+    if (opt.packed_weight_cache && (constantA || constantB))
+    {
+        return create_pipeline_cached(opt);
+    }
+
     if (constantA)
     {
         const int M = constantM;
@@ -7358,8 +7372,80 @@ int Gemm_x86::create_pipeline(const Option& opt)
     return 0;
 }
 
+int Gemm_x86::create_pipeline_cached(const Option& opt)
+{
+    PackedWeightCache* cache = opt.packed_weight_cache;
+
+    std::vector<Mat> weights;
+    weights.push_back(A_data);
+    weights.push_back(B_data);
+    weights.push_back(C_data);
+
+    std::vector<int> params;
+    params.push_back(transA);
+    params.push_back(transB);
+    params.push_back(constantA);
+    params.push_back(constantB);
+    params.push_back(constantC);
+    params.push_back(constantM);
+    params.push_back(constantN);
+    params.push_back(constantK);
+    params.push_back(constant_broadcast_type_C);
+    params.push_back(constant_TILE_M);
+    params.push_back(constant_TILE_N);
+    params.push_back(constant_TILE_K);
+    union
+    {
+        float f;
+        int i;
+    } beta_bits;
+    beta_bits.f = beta;
+    params.push_back(beta_bits.i);
+
+    std::vector<Mat> packed;
+    if (cache->get("Gemm_x86", weights, params, opt, packed) == 0 && packed.size() == 3)
+    {
+        AT_data = packed[0];
+        BT_data = packed[1];
+        CT_data = packed[2];
+
+        if (opt.lightmode)
+        {
+            if (constantA)
+                A_data.release();
+            if (constantB)
+                B_data.release();
+            if (constantC && constant_broadcast_type_C != -1)
+                C_data.release();
+        }
+
+        nT = opt.num_threads;
+
+        return 0;
+    }
+
+    Option opt_nocache = opt;
+    opt_nocache.packed_weight_cache = 0;
+
+    int ret = create_pipeline(opt_nocache);
+    if (ret != 0)
+        return ret;
+
+    packed.resize(3);
+    packed[0] = AT_data;
+    packed[1] = BT_data;
+    packed[2] = CT_data;
+
+    return cache->put("Gemm_x86", weights, params, opt, packed);
+}
+
 int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant_x86(bottom_blobs, top_blobs, opt);
+    }
+
 #if NCNN_INT8
     if (int8_scale_term)
     {
@@ -7555,6 +7641,204 @@ int Gemm_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& to
     return 0;
 }
 
+int Gemm_x86::forward_weight_quant_x86(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const int N = constantN;
+    const int K = constantK;
+
+    Option opt_unpack = opt;
+    opt_unpack.blob_allocator = opt.workspace_allocator;
+
+    Mat A0;
+    convert_packing(bottom_blobs[0], A0, 1, opt_unpack);
+    if (A0.empty())
+        return -100;
+
+    const int A0_hstep = A0.dims == 3 ? (int)A0.cstep : A0.w;
+
+    Mat A;
+    int M;
+    int A_hstep;
+    if (transA == 0)
+    {
+        A = A0;
+        M = A0.dims == 3 ? A0.c : A0.h;
+        A_hstep = A0_hstep;
+    }
+    else
+    {
+        // transpose A to row-major
+        M = A0.w;
+        A.create(K, M, (size_t)4u, opt.workspace_allocator);
+        if (A.empty())
+            return -100;
+
+        for (int i = 0; i < M; i++)
+        {
+            float* ptr = A.row(i);
+            for (int k = 0; k < K; k++)
+            {
+                ptr[k] = A0[k * A0_hstep + i];
+            }
+        }
+        A_hstep = K;
+    }
+
+    Mat C;
+    int broadcast_type_C = 0;
+    if (constantC)
+    {
+        C = C_data;
+        broadcast_type_C = constant_broadcast_type_C;
+    }
+    else if (bottom_blobs.size() == 2)
+    {
+        convert_packing(bottom_blobs[1], C, 1, opt_unpack);
+        if (C.empty())
+            return -100;
+
+        if (C.dims == 1 && C.w == 1)
+        {
+            // scalar
+            broadcast_type_C = 0;
+        }
+        if (C.dims == 1 && C.w == M)
+        {
+            // M
+            broadcast_type_C = 1;
+        }
+        if (C.dims == 1 && C.w == N)
+        {
+            // N
+            broadcast_type_C = 4;
+        }
+        if (C.dims == 2 && C.w == 1 && C.h == M)
+        {
+            // Mx1
+            broadcast_type_C = 2;
+        }
+        if (C.dims == 2 && C.w == N && C.h == M)
+        {
+            // MxN
+            broadcast_type_C = 3;
+        }
+        if (C.dims == 2 && C.w == N && C.h == 1)
+        {
+            // 1xN
+            broadcast_type_C = 4;
+        }
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        int outh = output_transpose ? N : M;
+#if __AVX512F__
+        out_elempack = outh % 16 == 0 ? 16 : outh % 8 == 0 ? 8 : outh % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = outh % 8 == 0 ? 8 : outh % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = outh % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+    if (output_elempack)
+        out_elempack = output_elempack;
+
+    Allocator* top_allocator = out_elempack == 1 ? opt.blob_allocator : opt.workspace_allocator;
+
+    Mat top_blob_unpacked;
+    if (output_transpose)
+    {
+        if (output_N1M)
+            top_blob_unpacked.create(M, 1, N, (size_t)4u, top_allocator);
+        else
+            top_blob_unpacked.create(M, N, (size_t)4u, top_allocator);
+    }
+    else
+    {
+        if (output_N1M)
+            top_blob_unpacked.create(N, 1, M, (size_t)4u, top_allocator);
+        else
+            top_blob_unpacked.create(N, M, (size_t)4u, top_allocator);
+    }
+    if (top_blob_unpacked.empty())
+        return -100;
+
+    const int out_hstep = top_blob_unpacked.dims == 3 ? (int)top_blob_unpacked.cstep : top_blob_unpacked.w;
+
+    // row-major M x N, computed in place unless the output is transposed
+    Mat AB;
+    int AB_hstep;
+    if (output_transpose)
+    {
+        AB.create(N, M, (size_t)4u, opt.workspace_allocator);
+        if (AB.empty())
+            return -100;
+
+        AB_hstep = N;
+    }
+    else
+    {
+        AB = top_blob_unpacked;
+        AB_hstep = out_hstep;
+    }
+
+    weight_quant_gemm(A, A_hstep, M, B_data, B_data_quant_scales, K, N, weight_quant_bits, weight_quant_group_size, AB, AB_hstep, opt);
+
+    const float* ptrC = C;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < M; i++)
+    {
+        const float* ptr = (const float*)AB + i * AB_hstep;
+
+        for (int j = 0; j < N; j++)
+        {
+            float sum = ptr[j];
+            if (ptrC)
+            {
+                float c = 0.f;
+                if (broadcast_type_C == 0)
+                    c = ptrC[0];
+                if (broadcast_type_C == 1 || broadcast_type_C == 2)
+                    c = ptrC[i];
+                if (broadcast_type_C == 3)
+                    c = ptrC[i * N + j];
+                if (broadcast_type_C == 4)
+                    c = ptrC[j];
+
+                sum += c * beta;
+            }
+
+            sum *= alpha;
+
+            if (output_transpose)
+            {
+                top_blob_unpacked[j * out_hstep + i] = sum;
+            }
+            else
+            {
+                top_blob_unpacked[i * out_hstep + j] = sum;
+            }
+        }
+    }
+
+    Mat& top_blob = top_blobs[0];
+    if (out_elempack == 1)
+    {
+        top_blob = top_blob_unpacked;
+        return 0;
+    }
+
+    convert_packing(top_blob_unpacked, top_blob, out_elempack, opt);
+    if (top_blob.empty())
+        return -100;
+
+    return 0;
+}
+
 #if NCNN_INT8
 static void compute_A_tile_int8_scales(const Mat& A, Mat& scales, float B_scale, Mat& out_descales, int i, int max_ii)
 {
@@ -0,0 +1,482 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// weight_data_tm layout
+// 4 outputs per row, input pairs interleaved for madd
+//   xc RU  size2 x [R0 R1 R2 R3 U0 U1 U2 U3] x 2
+//   hc RU  num_output2 x [R0 R1 R2 R3 U0 U1 U2 U3] x 2
+//   hc N   num_output2 x [N0 N1 N2 N3] x 2
+//   xc N   size2 x [N0 N1 N2 N3] x 2
+// remaining outputs one per row
+//   xc RU  size2 x [R U]
+//   hc RU  num_output2 x [R U]
+//   hc N   num_output2
+//   xc N   size2
+static void gru_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, const Mat& bias_c, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, Mat& bias_c_tm, int size, int num_output, int num_directions, const Option& opt)
+{
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    weight_data_tm.create(size2 * 12 + num_output2 * 12, num_output / 4 + num_output % 4, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(24, num_output / 4 + num_output % 4, num_directions);
+    bias_c_tm.create(num_output, 1, num_directions, 16u, 4);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const Mat bias_c_dr = bias_c.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat bias_c_tm_dr = bias_c_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+
+        const float* bias_c_R = bias_c_dr.row(0);
+        const float* bias_c_U = bias_c_dr.row(1);
+        const float* bias_c_WN = bias_c_dr.row(2);
+        const float* bias_c_BN = bias_c_dr.row(3);
+
+        float* bias_c_RUBNWN = bias_c_tm_dr.row(0);
+
+        int q = 0;
+        for (; q + 3 < num_output; q += 4)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                bias_c_RUBNWN[j] = bias_c_R[q + j];
+                bias_c_RUBNWN[4 + j] = bias_c_U[q + j];
+                bias_c_RUBNWN[8 + j] = bias_c_BN[q + j];
+                bias_c_RUBNWN[12 + j] = bias_c_WN[q + j];
+            }
+
+            bias_c_RUBNWN += 16;
+
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q / 4);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q / 4);
+
+            // xc RU
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 8; j++)
+                {
+                    const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(num_output * (j / 4) + q + j % 4);
+                    kptr[0] = weight_xc_ptr[i];
+                    kptr[1] = i + 1 < size ? weight_xc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            // hc RU
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 8; j++)
+                {
+                    const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(num_output * (j / 4) + q + j % 4);
+                    kptr[0] = weight_hc_ptr[i];
+                    kptr[1] = i + 1 < num_output ? weight_hc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            // hc N
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(num_output * 2 + q + j);
+                    kptr[0] = weight_hc_ptr[i];
+                    kptr[1] = i + 1 < num_output ? weight_hc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            // xc N
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(num_output * 2 + q + j);
+                    kptr[0] = weight_xc_ptr[i];
+                    kptr[1] = i + 1 < size ? weight_xc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                descales_ptr[j] = 1.f / weight_xc_int8_scales_ptr[num_output * 0 + q + j];
+                descales_ptr[4 + j] = 1.f / weight_xc_int8_scales_ptr[num_output * 1 + q + j];
+                descales_ptr[8 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 0 + q + j];
+                descales_ptr[12 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 1 + q + j];
+                descales_ptr[16 + j] = 1.f / weight_hc_int8_scales_ptr[num_output * 2 + q + j];
+                descales_ptr[20 + j] = 1.f / weight_xc_int8_scales_ptr[num_output * 2 + q + j];
+            }
+        }
+        for (; q < num_output; q++)
+        {
+            bias_c_RUBNWN[0] = bias_c_R[q];
+            bias_c_RUBNWN[1] = bias_c_U[q];
+            bias_c_RUBNWN[2] = bias_c_BN[q];
+            bias_c_RUBNWN[3] = bias_c_WN[q];
+
+            bias_c_RUBNWN += 4;
+
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q / 4 + q % 4);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q / 4 + q % 4);
+
+            const signed char* weight_xc_R = weight_xc_dr.row<const signed char>(num_output * 0 + q);
+            const signed char* weight_xc_U = weight_xc_dr.row<const signed char>(num_output * 1 + q);
+            const signed char* weight_xc_N = weight_xc_dr.row<const signed char>(num_output * 2 + q);
+
+            const signed char* weight_hc_R = weight_hc_dr.row<const signed char>(num_output * 0 + q);
+            const signed char* weight_hc_U = weight_hc_dr.row<const signed char>(num_output * 1 + q);
+            const signed char* weight_hc_N = weight_hc_dr.row<const signed char>(num_output * 2 + q);
+
+            for (int i = 0; i < size2; i++)
+            {
+                kptr[0] = i < size ? weight_xc_R[i] : 0;
+                kptr[1] = i < size ? weight_xc_U[i] : 0;
+                kptr += 2;
+            }
+
+            for (int i = 0; i < num_output2; i++)
+            {
+                kptr[0] = i < num_output ? weight_hc_R[i] : 0;
+                kptr[1] = i < num_output ? weight_hc_U[i] : 0;
+                kptr += 2;
+            }
+
+            for (int i = 0; i < num_output2; i++)
+            {
+                kptr[0] = i < num_output ? weight_hc_N[i] : 0;
+                kptr += 1;
+            }
+
+            for (int i = 0; i < size2; i++)
+            {
+                kptr[0] = i < size ? weight_xc_N[i] : 0;
+                kptr += 1;
+            }
+
+            descales_ptr[0] = 1.f / weight_xc_int8_scales_ptr[num_output * 0 + q];
+            descales_ptr[1] = 1.f / weight_xc_int8_scales_ptr[num_output * 1 + q];
+            descales_ptr[2] = 1.f / weight_hc_int8_scales_ptr[num_output * 0 + q];
+            descales_ptr[3] = 1.f / weight_hc_int8_scales_ptr[num_output * 1 + q];
+            descales_ptr[4] = 1.f / weight_hc_int8_scales_ptr[num_output * 2 + q];
+            descales_ptr[5] = 1.f / weight_xc_int8_scales_ptr[num_output * 2 + q];
+        }
+    }
+}
+
+// quantize to int8 range but keep int16 for madd, zero pad to even length
+static float gru_dynamic_quantize_int16(const float* ptr, int size, short* outptr)
+{
+    float absmax = 0.f;
+    for (int i = 0; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    const int size2 = (size + 1) / 2 * 2;
+
+    if (absmax == 0.f)
+    {
+        for (int i = 0; i < size2; i++)
+        {
+            outptr[i] = 0;
+        }
+        return 1.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (int i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+    for (int i = size; i < size2; i++)
+    {
+        outptr[i] = 0;
+    }
+
+    return absmax / 127.f;
+}
+
+static void gru_dynamic_quantize(const Mat& bottom_blob, Mat& bottom_blob_int16, Mat& bottom_blob_int8_descales, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    bottom_blob_int8_descales.create(T, (size_t)4u, 1, opt.blob_allocator);
+    bottom_blob_int16.create((size + 1) / 2 * 2, T, (size_t)2u, 1, opt.blob_allocator);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        bottom_blob_int8_descales[t] = gru_dynamic_quantize_int16(bottom_blob.row(t), size, bottom_blob_int16.row<short>(t));
+    }
+}
+
+static void gru_int8(const Mat& bottom_blob_int16, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int T = bottom_blob_int16.h;
+
+    const int num_output = top_blob.w;
+    const int size2 = bottom_blob_int16.w;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    // 4 x 2 x num_output/4
+    Mat gates(4 * 2, num_output / 4 + num_output % 4, 4u, opt.workspace_allocator);
+
+    Mat hidden_state_int16(num_output2, (size_t)2u, 1, opt.workspace_allocator);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        // dynamic quantize hidden_state
+        const float descale_h = gru_dynamic_quantize_int16(hidden_state, num_output, hidden_state_int16);
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        const short* x = bottom_blob_int16.row<const short>(ti);
+        const short* hs = hidden_state_int16;
+
+        const int nn_num_output = num_output >> 2;
+        const int remain_num_output_start = nn_num_output << 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 4;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q / 4);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q / 4);
+            const float* bias_c_RUBNWN = (const float*)bias_c + q * 4;
+
+            float RU[8];
+
+#if __SSE2__
+#if __AVX2__
+            __m256i _RUx = _mm256_setzero_si256();
+            for (int i = 0; i < size2; i += 2)
+            {
+                __m256i _w = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                _RUx = _mm256_add_epi32(_RUx, _mm256_madd_epi16(_w, _mm256_set1_epi32(*(const int*)(x + i))));
+                kptr += 16;
+            }
+
+            __m256i _RUh = _mm256_setzero_si256();
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                __m256i _w = _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)kptr));
+                _RUh = _mm256_add_epi32(_RUh, _mm256_madd_epi16(_w, _mm256_set1_epi32(*(const int*)(hs + i))));
+                kptr += 16;
+            }
+
+            __m256 _RU = _mm256_loadu_ps(bias_c_RUBNWN);
+            _RU = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_RUx), _mm256_mul_ps(_mm256_set1_ps(descale_x), _mm256_loadu_ps(descales_ptr)), _RU);
+            _RU = _mm256_comp_fmadd_ps(_mm256_cvtepi32_ps(_RUh), _mm256_mul_ps(_mm256_set1_ps(descale_h), _mm256_loadu_ps(descales_ptr + 8)), _RU);
+            _mm256_storeu_ps(RU, _RU);
+#else  // __AVX2__
+            __m128i _Rx = _mm_setzero_si128();
+            __m128i _Ux = _mm_setzero_si128();
+            for (int i = 0; i < size2; i += 2)
+            {
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _extw = _mm_cmpgt_epi8(_mm_setzero_si128(), _w);
+                __m128i _xi = _mm_set1_epi32(*(const int*)(x + i));
+                _Rx = _mm_add_epi32(_Rx, _mm_madd_epi16(_mm_unpacklo_epi8(_w, _extw), _xi));
+                _Ux = _mm_add_epi32(_Ux, _mm_madd_epi16(_mm_unpackhi_epi8(_w, _extw), _xi));
+                kptr += 16;
+            }
+
+            __m128i _Rh = _mm_setzero_si128();
+            __m128i _Uh = _mm_setzero_si128();
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _extw = _mm_cmpgt_epi8(_mm_setzero_si128(), _w);
+                __m128i _hi = _mm_set1_epi32(*(const int*)(hs + i));
+                _Rh = _mm_add_epi32(_Rh, _mm_madd_epi16(_mm_unpacklo_epi8(_w, _extw), _hi));
+                _Uh = _mm_add_epi32(_Uh, _mm_madd_epi16(_mm_unpackhi_epi8(_w, _extw), _hi));
+                kptr += 16;
+            }
+
+            __m128 _descale_x = _mm_set1_ps(descale_x);
+            __m128 _descale_h = _mm_set1_ps(descale_h);
+
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rx), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Ux), _mm_mul_ps(_descale_x, _mm_loadu_ps(descales_ptr + 4)), _U);
+            _R = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Rh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 8)), _R);
+            _U = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Uh), _mm_mul_ps(_descale_h, _mm_loadu_ps(descales_ptr + 12)), _U);
+            _mm_storeu_ps(RU, _R);
+            _mm_storeu_ps(RU + 4, _U);
+#endif // __AVX2__
+
+            // sigmoid(R)
+            // sigmoid(U)
+            __m128 _R0 = sigmoid_sse(_mm_loadu_ps(RU));
+            __m128 _U0 = sigmoid_sse(_mm_loadu_ps(RU + 4));
+
+            // gate new
+            __m128i _Nh = _mm_setzero_si128();
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+                _Nh = _mm_add_epi32(_Nh, _mm_madd_epi16(_w, _mm_set1_epi32(*(const int*)(hs + i))));
+                kptr += 8;
+            }
+
+            __m128i _Nx = _mm_setzero_si128();
+            for (int i = 0; i < size2; i += 2)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+                _Nx = _mm_add_epi32(_Nx, _mm_madd_epi16(_w, _mm_set1_epi32(*(const int*)(x + i))));
+                kptr += 8;
+            }
+
+            __m128 _N0 = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nh), _mm_mul_ps(_mm_set1_ps(descale_h), _mm_loadu_ps(descales_ptr + 16)), _mm_loadu_ps(bias_c_RUBNWN + 8));
+            _N0 = _mm_comp_fmadd_ps(_R0, _N0, _mm_loadu_ps(bias_c_RUBNWN + 12));
+            _N0 = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Nx), _mm_mul_ps(_mm_set1_ps(descale_x), _mm_loadu_ps(descales_ptr + 20)), _N0);
+
+            // tanh(N)
+            _N0 = tanh_sse(_N0);
+
+            float* gates_data = gates.row(q / 4);
+
+            _mm_storeu_ps(gates_data, _U0);
+            _mm_storeu_ps(gates_data + 4, _N0);
+#else  // __SSE2__
+            int Rx[4] = {0};
+            int Ux[4] = {0};
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Rx[j] += kptr[j * 2] * x[i] + kptr[j * 2 + 1] * x[i + 1];
+                    Ux[j] += kptr[8 + j * 2] * x[i] + kptr[8 + j * 2 + 1] * x[i + 1];
+                }
+                kptr += 16;
+            }
+
+            int Rh[4] = {0};
+            int Uh[4] = {0};
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Rh[j] += kptr[j * 2] * hs[i] + kptr[j * 2 + 1] * hs[i + 1];
+                    Uh[j] += kptr[8 + j * 2] * hs[i] + kptr[8 + j * 2 + 1] * hs[i + 1];
+                }
+                kptr += 16;
+            }
+
+            int Nh[4] = {0};
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Nh[j] += kptr[j * 2] * hs[i] + kptr[j * 2 + 1] * hs[i + 1];
+                }
+                kptr += 8;
+            }
+
+            int Nx[4] = {0};
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Nx[j] += kptr[j * 2] * x[i] + kptr[j * 2 + 1] * x[i + 1];
+                }
+                kptr += 8;
+            }
+
+            float* gates_data = gates.row(q / 4);
+
+            float N[4];
+            for (int j = 0; j < 4; j++)
+            {
+                RU[j] = bias_c_RUBNWN[j] + Rx[j] * (descale_x * descales_ptr[j]) + Rh[j] * (descale_h * descales_ptr[8 + j]);
+                RU[4 + j] = bias_c_RUBNWN[4 + j] + Ux[j] * (descale_x * descales_ptr[4 + j]) + Uh[j] * (descale_h * descales_ptr[12 + j]);
+
+                float R = 1.f / (1.f + expf(-RU[j]));
+                float U = 1.f / (1.f + expf(-RU[4 + j]));
+
+                N[j] = bias_c_RUBNWN[8 + j] + Nh[j] * (descale_h * descales_ptr[16 + j]);
+                N[j] = bias_c_RUBNWN[12 + j] + R * N[j] + Nx[j] * (descale_x * descales_ptr[20 + j]);
+
+                gates_data[j] = U;
+                gates_data[4 + j] = tanhf(N[j]);
+            }
+#endif // __SSE2__
+        }
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const signed char* kptr = weight_data_tm.row<const signed char>(q / 4 + q % 4);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q / 4 + q % 4);
+            const float* bias_c_RUBNWN = (const float*)bias_c + q * 4;
+
+            int Rx = 0;
+            int Ux = 0;
+            for (int i = 0; i < size2; i++)
+            {
+                Rx += kptr[0] * x[i];
+                Ux += kptr[1] * x[i];
+                kptr += 2;
+            }
+
+            int Rh = 0;
+            int Uh = 0;
+            for (int i = 0; i < num_output2; i++)
+            {
+                Rh += kptr[0] * hs[i];
+                Uh += kptr[1] * hs[i];
+                kptr += 2;
+            }
+
+            float R = bias_c_RUBNWN[0] + Rx * (descale_x * descales_ptr[0]) + Rh * (descale_h * descales_ptr[2]);
+            float U = bias_c_RUBNWN[1] + Ux * (descale_x * descales_ptr[1]) + Uh * (descale_h * descales_ptr[3]);
+
+            // sigmoid(R)
+            // sigmoid(U)
+            R = 1.f / (1.f + expf(-R));
+            U = 1.f / (1.f + expf(-U));
+
+            // gate new
+            int Nh = 0;
+            for (int i = 0; i < num_output2; i++)
+            {
+                Nh += kptr[0] * hs[i];
+                kptr += 1;
+            }
+
+            int Nx = 0;
+            for (int i = 0; i < size2; i++)
+            {
+                Nx += kptr[0] * x[i];
+                kptr += 1;
+            }
+
+            float N = bias_c_RUBNWN[2] + Nh * (descale_h * descales_ptr[4]);
+            N = bias_c_RUBNWN[3] + R * N + Nx * (descale_x * descales_ptr[5]);
+
+            // tanh(N)
+            N = tanhf(N);
+
+            float* gates_data = gates.row(q / 4 + q % 4);
+
+            gates_data[0] = U;
+            gates_data[1] = N;
+        }
+
+        gru_gate_output(gates, hidden_state, top_blob, ti, opt);
+    }
+}
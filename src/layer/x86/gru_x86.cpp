@@ -0,0 +1,854 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "gru_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_activation.h"
+#include "x86_usability.h"
+
+#include "cpu.h"
+
+namespace ncnn {
+
+// h_t := (1 - update) .* new + update .* h_{t-1}
+static void gru_gate_output(const Mat& gates, Mat& hidden_state, Mat& top_blob, int ti, const Option& opt)
+{
+    const int num_output = top_blob.w;
+
+    float* output_data = top_blob.row(ti);
+
+    const int nn_num_output = num_output >> 2;
+    const int remain_num_output_start = nn_num_output << 2;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int qq = 0; qq < nn_num_output; qq++)
+    {
+        const int q = qq * 4;
+
+        const float* gates_data = gates.row(q / 4);
+        float* hidden_ptr = (float*)hidden_state + q;
+
+#if __SSE2__
+        __m128 _U = _mm_loadu_ps(gates_data);
+        __m128 _N = _mm_loadu_ps(gates_data + 4);
+        __m128 _H = _mm_comp_fmadd_ps(_U, _mm_sub_ps(_mm_loadu_ps(hidden_ptr), _N), _N);
+
+        _mm_storeu_ps(hidden_ptr, _H);
+        _mm_storeu_ps(output_data + q, _H);
+#else
+        for (int j = 0; j < 4; j++)
+        {
+            float U = gates_data[j];
+            float N = gates_data[4 + j];
+
+            float H = (1 - U) * N + U * hidden_ptr[j];
+
+            hidden_ptr[j] = H;
+            output_data[q + j] = H;
+        }
+#endif
+    }
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = remain_num_output_start; q < num_output; q++)
+    {
+        const float* gates_data = gates.row(q / 4 + q % 4);
+
+        float U = gates_data[0];
+        float N = gates_data[1];
+
+        float H = (1 - U) * N + U * hidden_state[q];
+
+        hidden_state[q] = H;
+        output_data[q] = H;
+    }
+}
+
+#include "gru_int8.h"
+
+GRU_x86::GRU_x86()
+{
+    one_blob_only = false;
+    support_inplace = false;
+}
+
+int GRU_x86::create_pipeline(const Option& opt)
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return create_pipeline_int8(opt);
+    }
+#endif
+
+    // weight_data_tm layout
+    // 4 outputs per row
+    //   xc RU  size x [R0 R1 R2 R3 U0 U1 U2 U3]
+    //   hc RU  num_output x [R0 R1 R2 R3 U0 U1 U2 U3]
+    //   hc N   num_output x [N0 N1 N2 N3]
+    //   xc N   size x [N0 N1 N2 N3]
+    // remaining outputs one per row
+    //   xc RU  size x [R U]
+    //   hc RU  num_output x [R U]
+    //   hc N   num_output
+    //   xc N   size
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    weight_data_tm.create(size * 12 + num_output * 12, num_output / 4 + num_output % 4, num_directions);
+    bias_c_data_packed.create(num_output, 1, num_directions, 16u, 4);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc = weight_xc_data.channel(dr);
+        const Mat bias_c = bias_c_data.channel(dr);
+        const Mat weight_hc = weight_hc_data.channel(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat bias_c_data_packed_dr = bias_c_data_packed.channel(dr);
+
+        const float* bias_c_R = bias_c.row(0);
+        const float* bias_c_U = bias_c.row(1);
+        const float* bias_c_WN = bias_c.row(2);
+        const float* bias_c_BN = bias_c.row(3);
+
+        float* bias_c_RUBNWN = bias_c_data_packed_dr.row(0);
+
+        int q = 0;
+        for (; q + 3 < num_output; q += 4)
+        {
+            for (int j = 0; j < 4; j++)
+            {
+                bias_c_RUBNWN[j] = bias_c_R[q + j];
+                bias_c_RUBNWN[4 + j] = bias_c_U[q + j];
+                bias_c_RUBNWN[8 + j] = bias_c_BN[q + j];
+                bias_c_RUBNWN[12 + j] = bias_c_WN[q + j];
+            }
+
+            bias_c_RUBNWN += 16;
+
+            float* kptr = weight_data_tm_dr.row(q / 4);
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < 8; j++)
+                {
+                    kptr[j] = weight_xc.row(num_output * (j / 4) + q + j % 4)[i];
+                }
+                kptr += 8;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int j = 0; j < 8; j++)
+                {
+                    kptr[j] = weight_hc.row(num_output * (j / 4) + q + j % 4)[i];
+                }
+                kptr += 8;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    kptr[j] = weight_hc.row(num_output * 2 + q + j)[i];
+                }
+                kptr += 4;
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    kptr[j] = weight_xc.row(num_output * 2 + q + j)[i];
+                }
+                kptr += 4;
+            }
+        }
+        for (; q < num_output; q++)
+        {
+            bias_c_RUBNWN[0] = bias_c_R[q];
+            bias_c_RUBNWN[1] = bias_c_U[q];
+            bias_c_RUBNWN[2] = bias_c_BN[q];
+            bias_c_RUBNWN[3] = bias_c_WN[q];
+
+            bias_c_RUBNWN += 4;
+
+            const float* weight_xc_R = weight_xc.row(num_output * 0 + q);
+            const float* weight_xc_U = weight_xc.row(num_output * 1 + q);
+            const float* weight_xc_N = weight_xc.row(num_output * 2 + q);
+
+            const float* weight_hc_R = weight_hc.row(num_output * 0 + q);
+            const float* weight_hc_U = weight_hc.row(num_output * 1 + q);
+            const float* weight_hc_N = weight_hc.row(num_output * 2 + q);
+
+            float* kptr = weight_data_tm_dr.row(q / 4 + q % 4);
+
+            for (int i = 0; i < size; i++)
+            {
+                kptr[0] = weight_xc_R[i];
+                kptr[1] = weight_xc_U[i];
+                kptr += 2;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                kptr[0] = weight_hc_R[i];
+                kptr[1] = weight_hc_U[i];
+                kptr += 2;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                kptr[0] = weight_hc_N[i];
+                kptr += 1;
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                kptr[0] = weight_xc_N[i];
+                kptr += 1;
+            }
+        }
+    }
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+    }
+
+    return 0;
+}
+
+static int gru(const Mat& bottom_blob, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    const int num_output = top_blob.w;
+
+    // 4 x 2 x num_output/4
+    Mat gates(4 * 2, num_output / 4 + num_output % 4, 4u, opt.workspace_allocator);
+    if (gates.empty())
+        return -100;
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        const float* x = bottom_blob.row(ti);
+        const float* hs = hidden_state;
+
+        const int nn_num_output = num_output >> 2;
+        const int remain_num_output_start = nn_num_output << 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 4;
+
+            const float* kptr = weight_data_tm.row(q / 4);
+            const float* bias_c_RUBNWN = (const float*)bias_c + q * 4;
+
+            float* gates_data = gates.row(q / 4);
+
+#if __SSE2__
+            // gate reset update
+#if __AVX__
+            __m256 _RU = _mm256_loadu_ps(bias_c_RUBNWN);
+            __m256 _sum1 = _mm256_setzero_ps();
+            __m256 _sum2 = _mm256_setzero_ps();
+            __m256 _sum3 = _mm256_setzero_ps();
+
+            int i = 0;
+            for (; i + 3 < size; i += 4)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_broadcast_ss(x + i), _RU);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_broadcast_ss(x + i + 1), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 16), _mm256_broadcast_ss(x + i + 2), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 24), _mm256_broadcast_ss(x + i + 3), _sum3);
+                kptr += 32;
+            }
+            for (; i < size; i++)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_broadcast_ss(x + i), _RU);
+                kptr += 8;
+            }
+
+            i = 0;
+            for (; i + 3 < num_output; i += 4)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_broadcast_ss(hs + i), _RU);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_broadcast_ss(hs + i + 1), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 16), _mm256_broadcast_ss(hs + i + 2), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 24), _mm256_broadcast_ss(hs + i + 3), _sum3);
+                kptr += 32;
+            }
+            for (; i < num_output; i++)
+            {
+                _RU = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_broadcast_ss(hs + i), _RU);
+                kptr += 8;
+            }
+
+            _RU = _mm256_add_ps(_RU, _sum1);
+            _sum2 = _mm256_add_ps(_sum2, _sum3);
+            _RU = _mm256_add_ps(_RU, _sum2);
+
+            // sigmoid(R)
+            // sigmoid(U)
+            _RU = sigmoid_avx(_RU);
+
+            __m128 _R = _mm256_castps256_ps128(_RU);
+            __m128 _U = _mm256_extractf128_ps(_RU, 1);
+#else  // __AVX__
+            __m128 _R = _mm_loadu_ps(bias_c_RUBNWN);
+            __m128 _U = _mm_loadu_ps(bias_c_RUBNWN + 4);
+            __m128 _sum1 = _mm_setzero_ps();
+            __m128 _sum2 = _mm_setzero_ps();
+
+            int i = 0;
+            for (; i + 1 < size; i += 2)
+            {
+                __m128 _xi0 = _mm_load1_ps(x + i);
+                __m128 _xi1 = _mm_load1_ps(x + i + 1);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _xi0, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _xi0, _U);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 8), _xi1, _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 12), _xi1, _sum2);
+                kptr += 16;
+            }
+            for (; i < size; i++)
+            {
+                __m128 _xi = _mm_load1_ps(x + i);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _xi, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _xi, _U);
+                kptr += 8;
+            }
+
+            i = 0;
+            for (; i + 1 < num_output; i += 2)
+            {
+                __m128 _h_cont0 = _mm_load1_ps(hs + i);
+                __m128 _h_cont1 = _mm_load1_ps(hs + i + 1);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _h_cont0, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _h_cont0, _U);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 8), _h_cont1, _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 12), _h_cont1, _sum2);
+                kptr += 16;
+            }
+            for (; i < num_output; i++)
+            {
+                __m128 _h_cont = _mm_load1_ps(hs + i);
+                _R = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _h_cont, _R);
+                _U = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _h_cont, _U);
+                kptr += 8;
+            }
+
+            // sigmoid(R)
+            // sigmoid(U)
+            _R = sigmoid_sse(_mm_add_ps(_R, _sum1));
+            _U = sigmoid_sse(_mm_add_ps(_U, _sum2));
+#endif // __AVX__
+
+            // gate new
+            __m128 _N = _mm_loadu_ps(bias_c_RUBNWN + 8);
+            __m128 _Nsum1 = _mm_setzero_ps();
+
+            i = 0;
+            for (; i + 1 < num_output; i += 2)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_load1_ps(hs + i), _N);
+                _Nsum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_load1_ps(hs + i + 1), _Nsum1);
+                kptr += 8;
+            }
+            for (; i < num_output; i++)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_load1_ps(hs + i), _N);
+                kptr += 4;
+            }
+
+            _N = _mm_comp_fmadd_ps(_R, _mm_add_ps(_N, _Nsum1), _mm_loadu_ps(bias_c_RUBNWN + 12));
+            _Nsum1 = _mm_setzero_ps();
+
+            i = 0;
+            for (; i + 1 < size; i += 2)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_load1_ps(x + i), _N);
+                _Nsum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_load1_ps(x + i + 1), _Nsum1);
+                kptr += 8;
+            }
+            for (; i < size; i++)
+            {
+                _N = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_load1_ps(x + i), _N);
+                kptr += 4;
+            }
+
+            // tanh(N)
+            _N = tanh_sse(_mm_add_ps(_N, _Nsum1));
+
+            _mm_storeu_ps(gates_data, _U);
+            _mm_storeu_ps(gates_data + 4, _N);
+#else  // __SSE2__
+            float R[4];
+            float U[4];
+            float N[4];
+            for (int j = 0; j < 4; j++)
+            {
+                R[j] = bias_c_RUBNWN[j];
+                U[j] = bias_c_RUBNWN[4 + j];
+                N[j] = bias_c_RUBNWN[8 + j];
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    R[j] += kptr[j] * x[i];
+                    U[j] += kptr[4 + j] * x[i];
+                }
+                kptr += 8;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    R[j] += kptr[j] * hs[i];
+                    U[j] += kptr[4 + j] * hs[i];
+                }
+                kptr += 8;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    N[j] += kptr[j] * hs[i];
+                }
+                kptr += 4;
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                R[j] = 1.f / (1.f + expf(-R[j]));
+                U[j] = 1.f / (1.f + expf(-U[j]));
+                N[j] = bias_c_RUBNWN[12 + j] + R[j] * N[j];
+            }
+
+            for (int i = 0; i < size; i++)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    N[j] += kptr[j] * x[i];
+                }
+                kptr += 4;
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                gates_data[j] = U[j];
+                gates_data[4 + j] = tanhf(N[j]);
+            }
+#endif // __SSE2__
+        }
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const float* kptr = weight_data_tm.row(q / 4 + q % 4);
+            const float* bias_c_RUBNWN = (const float*)bias_c + q * 4;
+
+            // gate reset update
+            float R = bias_c_RUBNWN[0];
+            float U = bias_c_RUBNWN[1];
+
+            for (int i = 0; i < size; i++)
+            {
+                float xi = x[i];
+
+                R += kptr[0] * xi;
+                U += kptr[1] * xi;
+                kptr += 2;
+            }
+
+            for (int i = 0; i < num_output; i++)
+            {
+                float h_cont = hs[i];
+
+                R += kptr[0] * h_cont;
+                U += kptr[1] * h_cont;
+                kptr += 2;
+            }
+
+            // sigmoid(R)
+            // sigmoid(U)
+            R = 1.f / (1.f + expf(-R));
+            U = 1.f / (1.f + expf(-U));
+
+            // gate new
+            float N = bias_c_RUBNWN[2];
+
+            for (int i = 0; i < num_output; i++)
+            {
+                N += kptr[0] * hs[i];
+                kptr += 1;
+            }
+
+            N = bias_c_RUBNWN[3] + R * N;
+
+            for (int i = 0; i < size; i++)
+            {
+                N += kptr[0] * x[i];
+                kptr += 1;
+            }
+
+            // tanh(N)
+            N = tanhf(N);
+
+            float* gates_data = gates.row(q / 4 + q % 4);
+
+            gates_data[0] = U;
+            gates_data[1] = N;
+        }
+
+        gru_gate_output(gates, hidden_state, top_blob, ti, opt);
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return forward_int8(bottom_blob, top_blob, opt);
+    }
+#endif
+
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru(bottom_blob, top_blob, direction, weight_data_tm.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        {
+            int ret = gru(bottom_blob, top_blob_forward, 0, weight_data_tm.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        hidden.fill(0.0f);
+
+        {
+            int ret = gru(bottom_blob, top_blob_reverse, 1, weight_data_tm.channel(1), bias_c_data_packed.channel(1), hidden, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+#if NCNN_INT8
+    if (int8_scale_term)
+    {
+        return forward_int8(bottom_blobs, top_blobs, opt);
+    }
+#endif
+
+    const Mat& bottom_blob = bottom_blobs[0];
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        int ret = gru(bottom_blob, top_blob, direction, weight_data_tm.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        {
+            int ret = gru(bottom_blob, top_blob_forward, 0, weight_data_tm.channel(0), bias_c_data_packed.channel(0), hidden0, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        {
+            int ret = gru(bottom_blob, top_blob_reverse, 1, weight_data_tm.channel(1), bias_c_data_packed.channel(1), hidden1, opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+
+#if NCNN_INT8
+int GRU_x86::create_pipeline_int8(const Option& opt)
+{
+    const int num_directions = direction == 2 ? 2 : 1;
+    const int size = weight_data_size / num_directions / num_output / 3;
+
+    gru_transform_weight_int8(weight_xc_data, weight_xc_data_int8_scales, weight_hc_data, weight_hc_data_int8_scales, bias_c_data, weight_data_tm, weight_data_tm_int8_descales, bias_c_data_packed, size, num_output, num_directions, opt);
+
+    if (opt.lightmode)
+    {
+        weight_xc_data.release();
+        bias_c_data.release();
+        weight_hc_data.release();
+        weight_xc_data_int8_scales.release();
+        weight_hc_data_int8_scales.release();
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    int T = bottom_blob.h;
+
+    int num_directions = direction == 2 ? 2 : 1;
+
+    // initial hidden state
+    Mat hidden(num_output, 4u, opt.workspace_allocator);
+    if (hidden.empty())
+        return -100;
+    hidden.fill(0.f);
+
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int16;
+    Mat bottom_blob_int8_descales;
+    {
+        Option opt_quant = opt;
+        opt_quant.blob_allocator = opt.workspace_allocator;
+        opt_quant.use_packing_layout = false;
+        gru_dynamic_quantize(bottom_blob, bottom_blob_int16, bottom_blob_int8_descales, opt_quant);
+        if (bottom_blob_int16.empty() || bottom_blob_int8_descales.empty())
+            return -100;
+    }
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob, direction, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+
+        hidden.fill(0.f);
+
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), hidden, opt);
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    return 0;
+}
+
+int GRU_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+
+    int T = bottom_blob.h;
+    int num_directions = direction == 2 ? 2 : 1;
+
+    Mat hidden;
+    Allocator* hidden_allocator = top_blobs.size() == 2 ? opt.blob_allocator : opt.workspace_allocator;
+    if (bottom_blobs.size() == 2)
+    {
+        hidden = bottom_blobs[1].clone(hidden_allocator);
+    }
+    else
+    {
+        hidden.create(num_output, num_directions, 4u, hidden_allocator);
+        if (hidden.empty())
+            return -100;
+        hidden.fill(0.f);
+    }
+
+    Mat& top_blob = top_blobs[0];
+    top_blob.create(num_output * num_directions, T, 4u, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // dynamic quantize bottom_blob
+    Mat bottom_blob_int16;
+    Mat bottom_blob_int8_descales;
+    {
+        Option opt_quant = opt;
+        opt_quant.blob_allocator = opt.workspace_allocator;
+        opt_quant.use_packing_layout = false;
+        gru_dynamic_quantize(bottom_blob, bottom_blob_int16, bottom_blob_int8_descales, opt_quant);
+        if (bottom_blob_int16.empty() || bottom_blob_int8_descales.empty())
+            return -100;
+    }
+
+    // Uni directional
+    if (direction == 0 || direction == 1)
+    {
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob, direction, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden, opt);
+    }
+
+    if (direction == 2)
+    {
+        Mat top_blob_forward(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_forward.empty())
+            return -100;
+
+        Mat top_blob_reverse(num_output, T, 4u, opt.workspace_allocator);
+        if (top_blob_reverse.empty())
+            return -100;
+
+        Mat hidden0 = hidden.row_range(0, 1);
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob_forward, 0, weight_data_tm.channel(0), weight_data_tm_int8_descales.channel(0), bias_c_data_packed.channel(0), hidden0, opt);
+
+        Mat hidden1 = hidden.row_range(1, 1);
+        gru_int8(bottom_blob_int16, bottom_blob_int8_descales, top_blob_reverse, 1, weight_data_tm.channel(1), weight_data_tm_int8_descales.channel(1), bias_c_data_packed.channel(1), hidden1, opt);
+
+        // concat w
+        for (int i = 0; i < T; i++)
+        {
+            const float* pf = top_blob_forward.row(i);
+            const float* pr = top_blob_reverse.row(i);
+            float* ptr = top_blob.row(i);
+
+            memcpy(ptr, pf, num_output * sizeof(float));
+            memcpy(ptr + num_output, pr, num_output * sizeof(float));
+        }
+    }
+
+    if (top_blobs.size() == 2)
+    {
+        top_blobs[1] = hidden;
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
+} // namespace ncnn
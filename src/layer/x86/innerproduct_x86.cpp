@@ -12,8 +12,10 @@
 
 #include "x86_activation.h"
 #include "x86_usability.h"
+#include "weight_quant.h"
 
 #include "layer_type.h"
+#include "packedweightcache.h"
 
 #include "cpu.h"
 
@@ -21,6 +23,8 @@ namespace ncnn {
 
 #include "innerproduct_fp.h"
 #include "innerproduct_gemm_fp.h"
+#include "sparse_gemm.h"
+#include "weight_quant_gemm.h"
 
 #if NCNN_F16C && __AVX__
 #define NCNN_IMPL_FP16S 1
@@ -36,10 +40,84 @@ InnerProduct_x86::InnerProduct_x86()
 #endif // __SSE2__
 
     flatten = 0;
+    sparse_block = 0;
 }
 
 int InnerProduct_x86::create_pipeline(const Option& opt)
 {
+    if (weight_quant_bits)
+    {
+        // the quantized weight is used as loaded, dequantized in the gemv
+
+        flatten = ncnn::create_layer_cpu(ncnn::LayerType::Flatten);
+
+        ncnn::ParamDict pd;
+
+        flatten->load_param(pd);
+
+        flatten->create_pipeline(opt);
+
+        return 0;
+    }
+
+    // column index of sparse weight is stored in 16 bits
+    if (opt.use_sparse_weight && weight_data.elemsize == (size_t)4u && !int8_scale_term && weight_data_size / num_output <= 65536)
+    {
+        const int num_input = weight_data_size / num_output;
+
+        size_t weight_bytes = 4u;
+#if NCNN_F16C && __AVX__
+        if (cpu_support_x86_f16c() && opt.use_fp16_storage)
+            weight_bytes = 2u;
+#endif
+
+        // gemv is bound by memory, take the widest block that reads at most 2/3 of the dense weight bytes
+#if __AVX512F__
+        int block = 16;
+#elif __AVX__
+        int block = 8;
+#elif __SSE2__
+        int block = 4;
+#else
+        int block = 1;
+#endif
+        for (; block >= 1; block = block == 4 ? 1 : block / 2)
+        {
+            if (num_output % block != 0)
+                continue;
+
+            const int nnzb = sparse_weight_count_blocks(weight_data, num_input, num_output, block);
+            if ((size_t)nnzb * (block * 4 + 2) * 3 <= weight_data_size * weight_bytes * 2)
+            {
+                sparse_block = block;
+                break;
+            }
+        }
+
+        if (sparse_block)
+        {
+            flatten = ncnn::create_layer_cpu(ncnn::LayerType::Flatten);
+
+            ncnn::ParamDict pd;
+
+            flatten->load_param(pd);
+
+            flatten->create_pipeline(opt);
+
+            sparse_weight_pack(weight_data, weight_sparse_data, weight_sparse_index, weight_sparse_column, num_input, num_output, sparse_block);
+
+            if (opt.lightmode)
+                weight_data.release();
+
+            return 0;
+        }
+    }
+
+    if (opt.packed_weight_cache)
+    {
+        return create_pipeline_cached(opt);
+    }
+
     //     if (opt.use_packing_layout)
     {
         flatten = ncnn::create_layer_cpu(ncnn::LayerType::Flatten);
@@ -75,6 +153,60 @@ int InnerProduct_x86::create_pipeline(const Option& opt)
     return 0;
 }
 
+int InnerProduct_x86::create_pipeline_cached(const Option& opt)
+{
+    PackedWeightCache* cache = opt.packed_weight_cache;
+
+    std::vector<Mat> weights;
+    weights.push_back(weight_data);
+#if NCNN_INT8
+    weights.push_back(weight_data_int8_scales);
+    weights.push_back(bottom_blob_int8_scales);
+#endif
+
+    std::vector<int> params;
+    params.push_back(num_output);
+    params.push_back(weight_data_size);
+    params.push_back(int8_scale_term);
+
+    std::vector<Mat> packed;
+    if (cache->get("InnerProduct_x86", weights, params, opt, packed) == 0 && packed.size() == 2)
+    {
+        flatten = ncnn::create_layer_cpu(ncnn::LayerType::Flatten);
+
+        ncnn::ParamDict pd;
+
+        flatten->load_param(pd);
+
+        flatten->create_pipeline(opt);
+
+        weight_data_tm = packed[0];
+#if NCNN_INT8
+        scale_in_data = packed[1];
+#endif
+
+        if (opt.lightmode)
+            weight_data.release();
+
+        return 0;
+    }
+
+    Option opt_nocache = opt;
+    opt_nocache.packed_weight_cache = 0;
+
+    int ret = create_pipeline(opt_nocache);
+    if (ret != 0)
+        return ret;
+
+    packed.resize(2);
+    packed[0] = weight_data_tm;
+#if NCNN_INT8
+    packed[1] = scale_in_data;
+#endif
+
+    return cache->put("InnerProduct_x86", weights, params, opt, packed);
+}
+
 int InnerProduct_x86::destroy_pipeline(const Option& opt)
 {
     if (flatten)
@@ -89,6 +221,11 @@ int InnerProduct_x86::destroy_pipeline(const Option& opt)
 
 int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+    if (weight_quant_bits)
+    {
+        return forward_weight_quant_x86(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_INT8
     if (opt.use_int8_inference && int8_scale_term)
     {
@@ -96,6 +233,11 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     }
 #endif
 
+    if (sparse_block)
+    {
+        return forward_sparse(bottom_blob, top_blob, opt);
+    }
+
 #if NCNN_F16C && __AVX__
     if (cpu_support_x86_f16c() && opt.use_fp16_storage)
     {
@@ -160,6 +302,196 @@ int InnerProduct_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Optio
     return 0;
 }
 
+int InnerProduct_x86::forward_sparse(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    if (bottom_blob.dims == 2 && bottom_blob.w == num_input)
+    {
+        // gemm, one sparse gemv per row
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (bottom_blob.elempack != 1)
+        {
+            Option opt_unpack = opt;
+            opt_unpack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_unpack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        const int h = bottom_blob_unpacked.h;
+        const int elempack = bottom_blob.elempack;
+
+        Mat top_blob_unpacked;
+        top_blob_unpacked.create(num_output, h, (size_t)4u, elempack == 1 ? opt.blob_allocator : opt.workspace_allocator);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        for (int i = 0; i < h; i++)
+        {
+            float* outptr = top_blob_unpacked.row(i);
+
+            sparse_gemv(bottom_blob_unpacked.row(i), outptr, weight_sparse_data, weight_sparse_index, weight_sparse_column, bias_data, num_output, sparse_block, opt);
+
+            for (int j = 0; j < num_output; j++)
+            {
+                outptr[j] = activation_ss(outptr[j], activation_type, activation_params);
+            }
+        }
+
+        if (elempack == 1)
+        {
+            top_blob = top_blob_unpacked;
+            return 0;
+        }
+
+        convert_packing(top_blob_unpacked, top_blob, elempack, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    // flatten
+    Mat bottom_blob_flattened = bottom_blob;
+    if (bottom_blob.dims != 1)
+    {
+        Option opt_flatten = opt;
+        opt_flatten.blob_allocator = opt.workspace_allocator;
+
+        flatten->forward(bottom_blob, bottom_blob_flattened, opt_flatten);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // elempack of a 1d blob does not change the element order
+    top_blob.create(num_output / out_elempack, (size_t)4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    float* outptr = top_blob;
+
+    sparse_gemv(bottom_blob_flattened, outptr, weight_sparse_data, weight_sparse_index, weight_sparse_column, bias_data, num_output, sparse_block, opt);
+
+    for (int j = 0; j < num_output; j++)
+    {
+        outptr[j] = activation_ss(outptr[j], activation_type, activation_params);
+    }
+
+    return 0;
+}
+
+int InnerProduct_x86::forward_weight_quant_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int num_input = weight_data_size / num_output;
+
+    if (bottom_blob.dims == 2 && bottom_blob.w == num_input)
+    {
+        // gemm, all rows share one pass over the quantized weight
+        Mat bottom_blob_unpacked = bottom_blob;
+        if (bottom_blob.elempack != 1)
+        {
+            Option opt_unpack = opt;
+            opt_unpack.blob_allocator = opt.workspace_allocator;
+
+            convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt_unpack);
+            if (bottom_blob_unpacked.empty())
+                return -100;
+        }
+
+        const int h = bottom_blob_unpacked.h;
+        const int elempack = bottom_blob.elempack;
+
+        Mat top_blob_unpacked;
+        top_blob_unpacked.create(num_output, h, (size_t)4u, elempack == 1 ? opt.blob_allocator : opt.workspace_allocator);
+        if (top_blob_unpacked.empty())
+            return -100;
+
+        weight_quant_gemm(bottom_blob_unpacked, num_input, h, weight_data, weight_data_quant_scales, num_input, num_output, weight_quant_bits, weight_quant_group_size, top_blob_unpacked, num_output, opt);
+
+        for (int i = 0; i < h; i++)
+        {
+            float* outptr = top_blob_unpacked.row(i);
+
+            for (int j = 0; j < num_output; j++)
+            {
+                float sum = bias_term ? outptr[j] + bias_data[j] : outptr[j];
+                outptr[j] = activation_ss(sum, activation_type, activation_params);
+            }
+        }
+
+        if (elempack == 1)
+        {
+            top_blob = top_blob_unpacked;
+            return 0;
+        }
+
+        convert_packing(top_blob_unpacked, top_blob, elempack, opt);
+        if (top_blob.empty())
+            return -100;
+
+        return 0;
+    }
+
+    // flatten
+    Mat bottom_blob_flattened = bottom_blob;
+    if (bottom_blob.dims != 1)
+    {
+        Option opt_flatten = opt;
+        opt_flatten.blob_allocator = opt.workspace_allocator;
+
+        flatten->forward(bottom_blob, bottom_blob_flattened, opt_flatten);
+        if (bottom_blob_flattened.empty())
+            return -100;
+    }
+
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+#if __AVX512F__
+        out_elempack = num_output % 16 == 0 ? 16 : num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#elif __AVX__
+        out_elempack = num_output % 8 == 0 ? 8 : num_output % 4 == 0 ? 4 : 1;
+#else
+        out_elempack = num_output % 4 == 0 ? 4 : 1;
+#endif
+    }
+#endif // __SSE2__
+
+    // elempack of a 1d blob does not change the element order
+    top_blob.create(num_output / out_elempack, (size_t)4u * out_elempack, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    float* outptr = top_blob;
+
+    weight_quant_gemm(bottom_blob_flattened, num_input, 1, weight_data, weight_data_quant_scales, num_input, num_output, weight_quant_bits, weight_quant_group_size, outptr, num_output, opt);
+
+    for (int j = 0; j < num_output; j++)
+    {
+        float sum = bias_term ? outptr[j] + bias_data[j] : outptr[j];
+        outptr[j] = activation_ss(sum, activation_type, activation_params);
+    }
+
+    return 0;
+}
+
 #if NCNN_F16C && __AVX__
 int InnerProduct_x86::create_pipeline_fp16s(const Option& opt)
 {
@@ -19,6 +19,9 @@ public:
     virtual int forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 
 protected:
+    int create_pipeline_cached(const Option& opt);
+    int forward_sparse(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
+    int forward_weight_quant_x86(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
 #if NCNN_F16C && __AVX__
     int create_pipeline_fp16s(const Option& opt);
     int forward_fp16s(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const;
@@ -33,6 +36,12 @@ public:
 
     Mat weight_data_tm;
 
+    // pruned weight, 1xN block sparse
+    int sparse_block;
+    Mat weight_sparse_data;
+    Mat weight_sparse_index;
+    Mat weight_sparse_column;
+
 #if NCNN_INT8
     Mat scale_in_data;
 #endif
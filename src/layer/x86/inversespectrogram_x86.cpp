@@ -0,0 +1,36 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "inversespectrogram_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "fft.h"
+#include "fft_x86.h"
+
+namespace ncnn {
+
+InverseSpectrogram_x86::InverseSpectrogram_x86()
+{
+}
+
+int InverseSpectrogram_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // every vector lane runs the fft of its own frame
+#if __AVX512F__
+    return forward_fft(bottom_blob, top_blob, fft_op_avx512::lanes, fft_forward<fft_op_avx512>, opt);
+#elif __AVX__
+    return forward_fft(bottom_blob, top_blob, fft_op_avx::lanes, fft_forward<fft_op_avx>, opt);
+#elif __SSE2__
+    return forward_fft(bottom_blob, top_blob, fft_op_sse::lanes, fft_forward<fft_op_sse>, opt);
+#else
+    return forward_fft(bottom_blob, top_blob, fft_op_float::lanes, fft_forward<fft_op_float>, opt);
+#endif
+}
+
+} // namespace ncnn
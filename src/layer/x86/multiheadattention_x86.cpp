@@ -3,6 +3,22 @@
 
 #include "multiheadattention_x86.h"
 
+#include <float.h>
+
+#if __SSE2__
+#include <emmintrin.h>
+#include "sse_mathfun.h"
+#if __AVX__
+#include <immintrin.h>
+#include "avx_mathfun.h"
+#if __AVX512F__
+#include "avx512_mathfun.h"
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+
+#include "x86_usability.h"
+#include "cpu.h"
 #include "layer_type.h"
 
 namespace ncnn {
@@ -35,6 +51,8 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         opt.use_packing_layout = false; // TODO enable packing
     }
 
+    // fp32 attention runs the fused kernel, the score matrix gemm and softmax are for int8 only
+    if (int8_scale_term)
     {
         qk_softmax = ncnn::create_layer_cpu(ncnn::LayerType::Softmax);
         ncnn::ParamDict pd;
@@ -189,6 +207,7 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         }
     }
 
+    if (int8_scale_term)
     {
         qk_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -213,6 +232,7 @@ int MultiHeadAttention_x86::create_pipeline(const Option& _opt)
         qk_gemm->create_pipeline(opt1);
     }
 
+    if (int8_scale_term)
     {
         qkv_gemm = ncnn::create_layer_cpu(ncnn::LayerType::Gemm);
         ncnn::ParamDict pd;
@@ -300,12 +320,545 @@ int MultiHeadAttention_x86::destroy_pipeline(const Option& _opt)
     return 0;
 }
 
+// append the projected k or v of new tokens to the cache of past tokens
+// cache w = past_seqlen, h = embed_dim, empty for the first step
+static int concat_kv_cache(const Mat& cache_blob, const Mat& affine, Mat& out_cache, const Option& opt)
+{
+    Mat cache = cache_blob;
+    if (!cache_blob.empty() && cache_blob.elempack != 1)
+    {
+        convert_packing(cache_blob, cache, 1, opt);
+        if (cache.empty())
+            return -100;
+    }
+
+    const int past_seqlen = cache.empty() ? 0 : cache.w;
+    const int cur_seqlen = affine.w;
+    const size_t elemsize = affine.elemsize;
+
+    if (past_seqlen > 0 && (cache.h != affine.h || cache.elemsize != elemsize))
+    {
+        NCNN_LOGE("kv cache shape %d x %d elemsize %d mismatch with %d x %d elemsize %d", cache.w, cache.h, (int)cache.elemsize, affine.w, affine.h, (int)elemsize);
+        return -1;
+    }
+
+    out_cache.create(past_seqlen + cur_seqlen, affine.h, elemsize, opt.blob_allocator);
+    if (out_cache.empty())
+        return -100;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int i = 0; i < affine.h; i++)
+    {
+        unsigned char* outptr = out_cache.row<unsigned char>(i);
+
+        if (past_seqlen > 0)
+        {
+            memcpy(outptr, cache.row<const unsigned char>(i), past_seqlen * elemsize);
+        }
+        memcpy(outptr + past_seqlen * elemsize, affine.row<const unsigned char>(i), cur_seqlen * elemsize);
+    }
+
+    return 0;
+}
+
+// fused attention tile sizes, query rows share each key block loaded into cache
+#define FLASH_ATTN_TILE_M 4
+#define FLASH_ATTN_TILE_N 64
+
+// s[r][j] = sum_d qt[d][r] * k[d][j0 + j]
+// qt holds FLASH_ATTN_TILE_M query rows interleaved, missing rows are zero
+static void flash_attn_qk(const float* qt, const Mat& k, int j0, int tile_n, float* scores)
+{
+    const int embed_dim_per_head = k.h;
+    const int kstride = k.w;
+
+    float* s0 = scores;
+    float* s1 = scores + FLASH_ATTN_TILE_N;
+    float* s2 = scores + FLASH_ATTN_TILE_N * 2;
+    float* s3 = scores + FLASH_ATTN_TILE_N * 3;
+
+    int jj = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; jj + 31 < tile_n; jj += 32)
+    {
+        const float* pq = qt;
+        const float* pk = k.row(0) + j0 + jj;
+
+        __m512 _s00 = _mm512_setzero_ps();
+        __m512 _s01 = _mm512_setzero_ps();
+        __m512 _s10 = _mm512_setzero_ps();
+        __m512 _s11 = _mm512_setzero_ps();
+        __m512 _s20 = _mm512_setzero_ps();
+        __m512 _s21 = _mm512_setzero_ps();
+        __m512 _s30 = _mm512_setzero_ps();
+        __m512 _s31 = _mm512_setzero_ps();
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            __m512 _k0 = _mm512_loadu_ps(pk);
+            __m512 _k1 = _mm512_loadu_ps(pk + 16);
+            __m512 _q0 = _mm512_set1_ps(pq[0]);
+            __m512 _q1 = _mm512_set1_ps(pq[1]);
+            __m512 _q2 = _mm512_set1_ps(pq[2]);
+            __m512 _q3 = _mm512_set1_ps(pq[3]);
+            _s00 = _mm512_fmadd_ps(_q0, _k0, _s00);
+            _s01 = _mm512_fmadd_ps(_q0, _k1, _s01);
+            _s10 = _mm512_fmadd_ps(_q1, _k0, _s10);
+            _s11 = _mm512_fmadd_ps(_q1, _k1, _s11);
+            _s20 = _mm512_fmadd_ps(_q2, _k0, _s20);
+            _s21 = _mm512_fmadd_ps(_q2, _k1, _s21);
+            _s30 = _mm512_fmadd_ps(_q3, _k0, _s30);
+            _s31 = _mm512_fmadd_ps(_q3, _k1, _s31);
+            pq += 4;
+            pk += kstride;
+        }
+        _mm512_storeu_ps(s0 + jj, _s00);
+        _mm512_storeu_ps(s0 + jj + 16, _s01);
+        _mm512_storeu_ps(s1 + jj, _s10);
+        _mm512_storeu_ps(s1 + jj + 16, _s11);
+        _mm512_storeu_ps(s2 + jj, _s20);
+        _mm512_storeu_ps(s2 + jj + 16, _s21);
+        _mm512_storeu_ps(s3 + jj, _s30);
+        _mm512_storeu_ps(s3 + jj + 16, _s31);
+    }
+    for (; jj + 15 < tile_n; jj += 16)
+    {
+        const float* pq = qt;
+        const float* pk = k.row(0) + j0 + jj;
+
+        __m512 _s0 = _mm512_setzero_ps();
+        __m512 _s1 = _mm512_setzero_ps();
+        __m512 _s2 = _mm512_setzero_ps();
+        __m512 _s3 = _mm512_setzero_ps();
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            __m512 _k = _mm512_loadu_ps(pk);
+            _s0 = _mm512_fmadd_ps(_mm512_set1_ps(pq[0]), _k, _s0);
+            _s1 = _mm512_fmadd_ps(_mm512_set1_ps(pq[1]), _k, _s1);
+            _s2 = _mm512_fmadd_ps(_mm512_set1_ps(pq[2]), _k, _s2);
+            _s3 = _mm512_fmadd_ps(_mm512_set1_ps(pq[3]), _k, _s3);
+            pq += 4;
+            pk += kstride;
+        }
+        _mm512_storeu_ps(s0 + jj, _s0);
+        _mm512_storeu_ps(s1 + jj, _s1);
+        _mm512_storeu_ps(s2 + jj, _s2);
+        _mm512_storeu_ps(s3 + jj, _s3);
+    }
+#endif // __AVX512F__
+    for (; jj + 7 < tile_n; jj += 8)
+    {
+        const float* pq = qt;
+        const float* pk = k.row(0) + j0 + jj;
+
+        __m256 _s0 = _mm256_setzero_ps();
+        __m256 _s1 = _mm256_setzero_ps();
+        __m256 _s2 = _mm256_setzero_ps();
+        __m256 _s3 = _mm256_setzero_ps();
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            __m256 _k = _mm256_loadu_ps(pk);
+            _s0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(pq[0]), _k, _s0);
+            _s1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(pq[1]), _k, _s1);
+            _s2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(pq[2]), _k, _s2);
+            _s3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(pq[3]), _k, _s3);
+            pq += 4;
+            pk += kstride;
+        }
+        _mm256_storeu_ps(s0 + jj, _s0);
+        _mm256_storeu_ps(s1 + jj, _s1);
+        _mm256_storeu_ps(s2 + jj, _s2);
+        _mm256_storeu_ps(s3 + jj, _s3);
+    }
+#endif // __AVX__
+    for (; jj + 3 < tile_n; jj += 4)
+    {
+        const float* pq = qt;
+        const float* pk = k.row(0) + j0 + jj;
+
+        __m128 _s0 = _mm_setzero_ps();
+        __m128 _s1 = _mm_setzero_ps();
+        __m128 _s2 = _mm_setzero_ps();
+        __m128 _s3 = _mm_setzero_ps();
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            __m128 _k = _mm_loadu_ps(pk);
+            _s0 = _mm_comp_fmadd_ps(_mm_set1_ps(pq[0]), _k, _s0);
+            _s1 = _mm_comp_fmadd_ps(_mm_set1_ps(pq[1]), _k, _s1);
+            _s2 = _mm_comp_fmadd_ps(_mm_set1_ps(pq[2]), _k, _s2);
+            _s3 = _mm_comp_fmadd_ps(_mm_set1_ps(pq[3]), _k, _s3);
+            pq += 4;
+            pk += kstride;
+        }
+        _mm_storeu_ps(s0 + jj, _s0);
+        _mm_storeu_ps(s1 + jj, _s1);
+        _mm_storeu_ps(s2 + jj, _s2);
+        _mm_storeu_ps(s3 + jj, _s3);
+    }
+#endif // __SSE2__
+    for (; jj < tile_n; jj++)
+    {
+        const float* pq = qt;
+        const float* pk = k.row(0) + j0 + jj;
+
+        float sum0 = 0.f;
+        float sum1 = 0.f;
+        float sum2 = 0.f;
+        float sum3 = 0.f;
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            sum0 += pq[0] * pk[0];
+            sum1 += pq[1] * pk[0];
+            sum2 += pq[2] * pk[0];
+            sum3 += pq[3] * pk[0];
+            pq += 4;
+            pk += kstride;
+        }
+        s0[jj] = sum0;
+        s1[jj] = sum1;
+        s2[jj] = sum2;
+        s3[jj] = sum3;
+    }
+}
+
+// acc[r][d] = acc[r][d] * alpha[r] + sum_j p[r][j] * vt[j0 + j][d]
+static void flash_attn_pv(const float* scores, const Mat& vt, int j0, int tile_n, const float* alpha, float* acc)
+{
+    const int embed_dim_per_head = vt.w;
+
+    const float* p0 = scores;
+    const float* p1 = scores + FLASH_ATTN_TILE_N;
+    const float* p2 = scores + FLASH_ATTN_TILE_N * 2;
+    const float* p3 = scores + FLASH_ATTN_TILE_N * 3;
+
+    float* acc0 = acc;
+    float* acc1 = acc + embed_dim_per_head;
+    float* acc2 = acc + embed_dim_per_head * 2;
+    float* acc3 = acc + embed_dim_per_head * 3;
+
+    int dd = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; dd + 31 < embed_dim_per_head; dd += 32)
+    {
+        __m512 _alpha0 = _mm512_set1_ps(alpha[0]);
+        __m512 _alpha1 = _mm512_set1_ps(alpha[1]);
+        __m512 _alpha2 = _mm512_set1_ps(alpha[2]);
+        __m512 _alpha3 = _mm512_set1_ps(alpha[3]);
+        __m512 _a00 = _mm512_mul_ps(_mm512_loadu_ps(acc0 + dd), _alpha0);
+        __m512 _a01 = _mm512_mul_ps(_mm512_loadu_ps(acc0 + dd + 16), _alpha0);
+        __m512 _a10 = _mm512_mul_ps(_mm512_loadu_ps(acc1 + dd), _alpha1);
+        __m512 _a11 = _mm512_mul_ps(_mm512_loadu_ps(acc1 + dd + 16), _alpha1);
+        __m512 _a20 = _mm512_mul_ps(_mm512_loadu_ps(acc2 + dd), _alpha2);
+        __m512 _a21 = _mm512_mul_ps(_mm512_loadu_ps(acc2 + dd + 16), _alpha2);
+        __m512 _a30 = _mm512_mul_ps(_mm512_loadu_ps(acc3 + dd), _alpha3);
+        __m512 _a31 = _mm512_mul_ps(_mm512_loadu_ps(acc3 + dd + 16), _alpha3);
+        for (int j = 0; j < tile_n; j++)
+        {
+            const float* pv = vt.row(j0 + j) + dd;
+            __m512 _v0 = _mm512_loadu_ps(pv);
+            __m512 _v1 = _mm512_loadu_ps(pv + 16);
+            __m512 _p0 = _mm512_set1_ps(p0[j]);
+            __m512 _p1 = _mm512_set1_ps(p1[j]);
+            __m512 _p2 = _mm512_set1_ps(p2[j]);
+            __m512 _p3 = _mm512_set1_ps(p3[j]);
+            _a00 = _mm512_fmadd_ps(_p0, _v0, _a00);
+            _a01 = _mm512_fmadd_ps(_p0, _v1, _a01);
+            _a10 = _mm512_fmadd_ps(_p1, _v0, _a10);
+            _a11 = _mm512_fmadd_ps(_p1, _v1, _a11);
+            _a20 = _mm512_fmadd_ps(_p2, _v0, _a20);
+            _a21 = _mm512_fmadd_ps(_p2, _v1, _a21);
+            _a30 = _mm512_fmadd_ps(_p3, _v0, _a30);
+            _a31 = _mm512_fmadd_ps(_p3, _v1, _a31);
+        }
+        _mm512_storeu_ps(acc0 + dd, _a00);
+        _mm512_storeu_ps(acc0 + dd + 16, _a01);
+        _mm512_storeu_ps(acc1 + dd, _a10);
+        _mm512_storeu_ps(acc1 + dd + 16, _a11);
+        _mm512_storeu_ps(acc2 + dd, _a20);
+        _mm512_storeu_ps(acc2 + dd + 16, _a21);
+        _mm512_storeu_ps(acc3 + dd, _a30);
+        _mm512_storeu_ps(acc3 + dd + 16, _a31);
+    }
+    for (; dd + 15 < embed_dim_per_head; dd += 16)
+    {
+        __m512 _a0 = _mm512_mul_ps(_mm512_loadu_ps(acc0 + dd), _mm512_set1_ps(alpha[0]));
+        __m512 _a1 = _mm512_mul_ps(_mm512_loadu_ps(acc1 + dd), _mm512_set1_ps(alpha[1]));
+        __m512 _a2 = _mm512_mul_ps(_mm512_loadu_ps(acc2 + dd), _mm512_set1_ps(alpha[2]));
+        __m512 _a3 = _mm512_mul_ps(_mm512_loadu_ps(acc3 + dd), _mm512_set1_ps(alpha[3]));
+        for (int j = 0; j < tile_n; j++)
+        {
+            __m512 _v = _mm512_loadu_ps(vt.row(j0 + j) + dd);
+            _a0 = _mm512_fmadd_ps(_mm512_set1_ps(p0[j]), _v, _a0);
+            _a1 = _mm512_fmadd_ps(_mm512_set1_ps(p1[j]), _v, _a1);
+            _a2 = _mm512_fmadd_ps(_mm512_set1_ps(p2[j]), _v, _a2);
+            _a3 = _mm512_fmadd_ps(_mm512_set1_ps(p3[j]), _v, _a3);
+        }
+        _mm512_storeu_ps(acc0 + dd, _a0);
+        _mm512_storeu_ps(acc1 + dd, _a1);
+        _mm512_storeu_ps(acc2 + dd, _a2);
+        _mm512_storeu_ps(acc3 + dd, _a3);
+    }
+#endif // __AVX512F__
+    for (; dd + 7 < embed_dim_per_head; dd += 8)
+    {
+        __m256 _a0 = _mm256_mul_ps(_mm256_loadu_ps(acc0 + dd), _mm256_set1_ps(alpha[0]));
+        __m256 _a1 = _mm256_mul_ps(_mm256_loadu_ps(acc1 + dd), _mm256_set1_ps(alpha[1]));
+        __m256 _a2 = _mm256_mul_ps(_mm256_loadu_ps(acc2 + dd), _mm256_set1_ps(alpha[2]));
+        __m256 _a3 = _mm256_mul_ps(_mm256_loadu_ps(acc3 + dd), _mm256_set1_ps(alpha[3]));
+        for (int j = 0; j < tile_n; j++)
+        {
+            __m256 _v = _mm256_loadu_ps(vt.row(j0 + j) + dd);
+            _a0 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p0[j]), _v, _a0);
+            _a1 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p1[j]), _v, _a1);
+            _a2 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p2[j]), _v, _a2);
+            _a3 = _mm256_comp_fmadd_ps(_mm256_set1_ps(p3[j]), _v, _a3);
+        }
+        _mm256_storeu_ps(acc0 + dd, _a0);
+        _mm256_storeu_ps(acc1 + dd, _a1);
+        _mm256_storeu_ps(acc2 + dd, _a2);
+        _mm256_storeu_ps(acc3 + dd, _a3);
+    }
+#endif // __AVX__
+    for (; dd + 3 < embed_dim_per_head; dd += 4)
+    {
+        __m128 _a0 = _mm_mul_ps(_mm_loadu_ps(acc0 + dd), _mm_set1_ps(alpha[0]));
+        __m128 _a1 = _mm_mul_ps(_mm_loadu_ps(acc1 + dd), _mm_set1_ps(alpha[1]));
+        __m128 _a2 = _mm_mul_ps(_mm_loadu_ps(acc2 + dd), _mm_set1_ps(alpha[2]));
+        __m128 _a3 = _mm_mul_ps(_mm_loadu_ps(acc3 + dd), _mm_set1_ps(alpha[3]));
+        for (int j = 0; j < tile_n; j++)
+        {
+            __m128 _v = _mm_loadu_ps(vt.row(j0 + j) + dd);
+            _a0 = _mm_comp_fmadd_ps(_mm_set1_ps(p0[j]), _v, _a0);
+            _a1 = _mm_comp_fmadd_ps(_mm_set1_ps(p1[j]), _v, _a1);
+            _a2 = _mm_comp_fmadd_ps(_mm_set1_ps(p2[j]), _v, _a2);
+            _a3 = _mm_comp_fmadd_ps(_mm_set1_ps(p3[j]), _v, _a3);
+        }
+        _mm_storeu_ps(acc0 + dd, _a0);
+        _mm_storeu_ps(acc1 + dd, _a1);
+        _mm_storeu_ps(acc2 + dd, _a2);
+        _mm_storeu_ps(acc3 + dd, _a3);
+    }
+#endif // __SSE2__
+    for (; dd < embed_dim_per_head; dd++)
+    {
+        float a0 = acc0[dd] * alpha[0];
+        float a1 = acc1[dd] * alpha[1];
+        float a2 = acc2[dd] * alpha[2];
+        float a3 = acc3[dd] * alpha[3];
+        for (int j = 0; j < tile_n; j++)
+        {
+            const float v = vt.row(j0 + j)[dd];
+            a0 += p0[j] * v;
+            a1 += p1[j] * v;
+            a2 += p2[j] * v;
+            a3 += p3[j] * v;
+        }
+        acc0[dd] = a0;
+        acc1[dd] = a1;
+        acc2[dd] = a2;
+        acc3[dd] = a3;
+    }
+}
+
+static void flash_attn_add(float* y, const float* x, int size)
+{
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    for (; i + 15 < size; i += 16)
+    {
+        _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), _mm512_loadu_ps(x + i)));
+    }
+#endif // __AVX512F__
+    for (; i + 7 < size; i += 8)
+    {
+        _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(x + i)));
+    }
+#endif // __AVX__
+    for (; i + 3 < size; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_loadu_ps(x + i)));
+    }
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        y[i] += x[i];
+    }
+}
+
+static float flash_attn_max(const float* x, int size)
+{
+    float max = -FLT_MAX;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _max_avx512 = _mm512_set1_ps(-FLT_MAX);
+    for (; i + 15 < size; i += 16)
+    {
+        _max_avx512 = _mm512_max_ps(_max_avx512, _mm512_loadu_ps(x + i));
+    }
+    max = std::max(max, _mm512_comp_reduce_max_ps(_max_avx512));
+#endif // __AVX512F__
+    __m256 _max_avx = _mm256_set1_ps(-FLT_MAX);
+    for (; i + 7 < size; i += 8)
+    {
+        _max_avx = _mm256_max_ps(_max_avx, _mm256_loadu_ps(x + i));
+    }
+    max = std::max(max, _mm256_reduce_max_ps(_max_avx));
+#endif // __AVX__
+    __m128 _max = _mm_set1_ps(-FLT_MAX);
+    for (; i + 3 < size; i += 4)
+    {
+        _max = _mm_max_ps(_max, _mm_loadu_ps(x + i));
+    }
+    max = std::max(max, _mm_reduce_max_ps(_max));
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        max = std::max(max, x[i]);
+    }
+
+    return max;
+}
+
+// x = exp(x - max), return sum
+static float flash_attn_exp_sub_sum(float* x, float max, int size)
+{
+    float sum = 0.f;
+
+    int i = 0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    __m512 _max_avx512 = _mm512_set1_ps(max);
+    __m512 _sum_avx512 = _mm512_setzero_ps();
+    for (; i + 15 < size; i += 16)
+    {
+        __m512 _p = exp512_ps(_mm512_sub_ps(_mm512_loadu_ps(x + i), _max_avx512));
+        _mm512_storeu_ps(x + i, _p);
+        _sum_avx512 = _mm512_add_ps(_sum_avx512, _p);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum_avx512);
+#endif // __AVX512F__
+    __m256 _max_avx = _mm256_set1_ps(max);
+    __m256 _sum_avx = _mm256_setzero_ps();
+    for (; i + 7 < size; i += 8)
+    {
+        __m256 _p = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(x + i), _max_avx));
+        _mm256_storeu_ps(x + i, _p);
+        _sum_avx = _mm256_add_ps(_sum_avx, _p);
+    }
+    sum += _mm256_reduce_add_ps(_sum_avx);
+#endif // __AVX__
+    __m128 _max = _mm_set1_ps(max);
+    __m128 _sum = _mm_setzero_ps();
+    for (; i + 3 < size; i += 4)
+    {
+        __m128 _p = exp_ps(_mm_sub_ps(_mm_loadu_ps(x + i), _max));
+        _mm_storeu_ps(x + i, _p);
+        _sum = _mm_add_ps(_sum, _p);
+    }
+    sum += _mm_reduce_add_ps(_sum);
+#endif // __SSE2__
+    for (; i < size; i++)
+    {
+        x[i] = expf(x[i] - max);
+        sum += x[i];
+    }
+
+    return sum;
+}
+
+// softmax(q k^T + mask) v for one head, tiled over key blocks with online softmax
+// the score matrix is never materialized, only a FLASH_ATTN_TILE_M x FLASH_ATTN_TILE_N block per thread
+// q and k w = seqlen, h = embed_dim_per_head, vt w = embed_dim_per_head, h = dst_seqlen
+// out h = embed_dim_per_head, write columns [i0, i0 + tile_m)
+static void flash_attention_tile(const Mat& q, const Mat& k, const Mat& vt, const Mat& mask, Mat& out, int i0, int tile_m, float* workspace)
+{
+    const int embed_dim_per_head = q.h;
+    const int dst_seqlen = k.w;
+
+    float* qt = workspace;
+    float* scores = qt + embed_dim_per_head * FLASH_ATTN_TILE_M;
+    float* acc = scores + FLASH_ATTN_TILE_M * FLASH_ATTN_TILE_N;
+
+    // interleave the query rows, pad the tail tile with zero
+    for (int d = 0; d < embed_dim_per_head; d++)
+    {
+        const float* ptr = q.row(d) + i0;
+        for (int r = 0; r < FLASH_ATTN_TILE_M; r++)
+        {
+            qt[d * FLASH_ATTN_TILE_M + r] = r < tile_m ? ptr[r] : 0.f;
+        }
+    }
+
+    memset(acc, 0, FLASH_ATTN_TILE_M * embed_dim_per_head * sizeof(float));
+
+    float row_max[FLASH_ATTN_TILE_M];
+    float row_sum[FLASH_ATTN_TILE_M];
+    float alpha[FLASH_ATTN_TILE_M];
+    for (int r = 0; r < FLASH_ATTN_TILE_M; r++)
+    {
+        row_max[r] = -FLT_MAX;
+        row_sum[r] = 0.f;
+    }
+
+    for (int j0 = 0; j0 < dst_seqlen; j0 += FLASH_ATTN_TILE_N)
+    {
+        const int tile_n = std::min(FLASH_ATTN_TILE_N, dst_seqlen - j0);
+
+        flash_attn_qk(qt, k, j0, tile_n, scores);
+
+        if (!mask.empty())
+        {
+            for (int r = 0; r < tile_m; r++)
+            {
+                flash_attn_add(scores + r * FLASH_ATTN_TILE_N, mask.row(i0 + r) + j0, tile_n);
+            }
+        }
+
+        // rescale the running sum and output by exp(old_max - new_max)
+        for (int r = 0; r < FLASH_ATTN_TILE_M; r++)
+        {
+            float* s = scores + r * FLASH_ATTN_TILE_N;
+
+            const float max = std::max(row_max[r], flash_attn_max(s, tile_n));
+
+            alpha[r] = expf(row_max[r] - max);
+            row_sum[r] = row_sum[r] * alpha[r] + flash_attn_exp_sub_sum(s, max, tile_n);
+            row_max[r] = max;
+        }
+
+        flash_attn_pv(scores, vt, j0, tile_n, alpha, acc);
+    }
+
+    for (int r = 0; r < tile_m; r++)
+    {
+        const float* accptr = acc + r * embed_dim_per_head;
+        const float inv_sum = 1.f / row_sum[r];
+
+        for (int d = 0; d < embed_dim_per_head; d++)
+        {
+            out.row(d)[i0 + r] = accptr[d] * inv_sum;
+        }
+    }
+}
+
 int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& _opt) const
 {
+    // cached k and v come last
+    const size_t input_count = kv_cache ? bottom_blobs.size() - 2 : bottom_blobs.size();
+
     const Mat& q_blob = bottom_blobs[0];
-    const Mat& k_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
-    const Mat& v_blob = (bottom_blobs.size() == 1 || (bottom_blobs.size() == 2 && attn_mask)) ? q_blob : (bottom_blobs.size() == 2 || (bottom_blobs.size() == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
-    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[bottom_blobs.size() - 1] : Mat();
+    const Mat& k_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : bottom_blobs[1];
+    const Mat& v_blob = (input_count == 1 || (input_count == 2 && attn_mask)) ? q_blob : (input_count == 2 || (input_count == 3 && attn_mask)) ? k_blob : bottom_blobs[2];
+    const Mat& attn_mask_blob = attn_mask ? bottom_blobs[input_count - 1] : Mat();
 
     Option opt = _opt;
     if (int8_scale_term)
@@ -327,7 +880,8 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
 
     const int embed_dim_per_head = embed_dim / num_heads;
     const int src_seqlen = q_blob.h * q_blob.elempack;
-    const int dst_seqlen = k_blob.h * k_blob.elempack;
+    const int past_seqlen = kv_cache && !bottom_blobs[input_count].empty() ? bottom_blobs[input_count].w : 0;
+    const int dst_seqlen = past_seqlen + k_blob.h * k_blob.elempack;
 
     Mat q_affine;
     int retq = q_gemm->forward(q_blob, q_affine, opt);
@@ -339,6 +893,86 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retk != 0)
         return retk;
 
+    if (kv_cache)
+    {
+        // attend over past and new tokens, the updated cache is the k_affine of all of them
+        int retc = concat_kv_cache(bottom_blobs[input_count], k_affine, top_blobs[1], opt);
+        if (retc != 0)
+            return retc;
+
+        k_affine = top_blobs[1];
+    }
+
+    if (!int8_scale_term)
+    {
+        Mat v_affine;
+        int retv = v_gemm->forward(v_blob, v_affine, opt);
+        if (retv != 0)
+            return retv;
+
+        if (kv_cache)
+        {
+            int retc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+            if (retc != 0)
+                return retc;
+
+            v_affine = top_blobs[2];
+        }
+
+        // v per head transposed, so that p v accumulates contiguous rows
+        Mat vt(embed_dim_per_head, dst_seqlen, num_heads, 4u, opt.workspace_allocator);
+        if (vt.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int i = 0; i < num_heads; i++)
+        {
+            Mat vtm = vt.channel(i);
+            for (int d = 0; d < embed_dim_per_head; d++)
+            {
+                const float* ptr = v_affine.row(i * embed_dim_per_head + d);
+                for (int j = 0; j < dst_seqlen; j++)
+                {
+                    vtm.row(j)[d] = ptr[j];
+                }
+            }
+        }
+
+        v_affine.release();
+
+        Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
+        if (qkv_cross.empty())
+            return -100;
+
+        Mat workspace(FLASH_ATTN_TILE_M * (FLASH_ATTN_TILE_N + embed_dim_per_head * 2), 1, opt.num_threads, 4u, opt.workspace_allocator);
+        if (workspace.empty())
+            return -100;
+
+        const int tile_count = (src_seqlen + FLASH_ATTN_TILE_M - 1) / FLASH_ATTN_TILE_M;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int t = 0; t < num_heads * tile_count; t++)
+        {
+            const int i = t / tile_count;
+            const int i0 = (t % tile_count) * FLASH_ATTN_TILE_M;
+            const int tile_m = std::min(FLASH_ATTN_TILE_M, src_seqlen - i0);
+
+            const Mat qm = q_affine.row_range(i * embed_dim_per_head, embed_dim_per_head);
+            const Mat km = k_affine.row_range(i * embed_dim_per_head, embed_dim_per_head);
+            const Mat vtm = vt.channel(i);
+            const Mat maskm = !attn_mask ? Mat() : attn_mask_blob_unpacked.dims == 3 ? attn_mask_blob_unpacked.channel(i) : attn_mask_blob_unpacked;
+            Mat outm = qkv_cross.row_range(i * embed_dim_per_head, embed_dim_per_head);
+
+            flash_attention_tile(qm, km, vtm, maskm, outm, i0, tile_m, workspace.channel(get_omp_thread_num()));
+        }
+
+        q_affine.release();
+        k_affine.release();
+        vt.release();
+
+        return o_gemm->forward(qkv_cross, top_blobs[0], opt);
+    }
+
     Mat qk_cross(dst_seqlen, src_seqlen * num_heads, 4u, opt.blob_allocator);
     if (qk_cross.empty())
         return -100;
@@ -380,6 +1014,15 @@ int MultiHeadAttention_x86::forward(const std::vector<Mat>& bottom_blobs, std::v
     if (retv != 0)
         return retv;
 
+    if (kv_cache)
+    {
+        int retc = concat_kv_cache(bottom_blobs[input_count + 1], v_affine, top_blobs[2], opt);
+        if (retc != 0)
+            return retc;
+
+        v_affine = top_blobs[2];
+    }
+
     Mat qkv_cross(src_seqlen, embed_dim_per_head * num_heads, 4u, opt.blob_allocator);
     if (qkv_cross.empty())
         return -100;
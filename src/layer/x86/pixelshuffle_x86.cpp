@@ -0,0 +1,281 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pixelshuffle_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+namespace ncnn {
+
+PixelShuffle_x86::PixelShuffle_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+// copy one elempack vector per pixel, input row pixel j goes to output pixel j * stride
+static void pixelshuffle_copy_packed(const float* sptr, float* outptr, int w, int elempack, int stride)
+{
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+    {
+        for (int j = 0; j < w; j++)
+        {
+            _mm512_storeu_ps(outptr, _mm512_loadu_ps(sptr));
+            sptr += 16;
+            outptr += stride * 16;
+        }
+        return;
+    }
+#endif // __AVX512F__
+    if (elempack == 8)
+    {
+        for (int j = 0; j < w; j++)
+        {
+            _mm256_storeu_ps(outptr, _mm256_loadu_ps(sptr));
+            sptr += 8;
+            outptr += stride * 8;
+        }
+        return;
+    }
+#endif // __AVX__
+    if (elempack == 4)
+    {
+        for (int j = 0; j < w; j++)
+        {
+            _mm_storeu_ps(outptr, _mm_loadu_ps(sptr));
+            sptr += 4;
+            outptr += stride * 4;
+        }
+        return;
+    }
+#endif // __SSE2__
+
+    for (int j = 0; j < w; j++)
+    {
+        for (int k = 0; k < elempack; k++)
+        {
+            outptr[k] = sptr[k];
+        }
+        sptr += elempack;
+        outptr += stride * elempack;
+    }
+}
+
+int PixelShuffle_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const int elempack = bottom_blob.elempack;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    const int outw = w * upscale_factor;
+    const int outh = h * upscale_factor;
+    const int outc = channels * elempack / (upscale_factor * upscale_factor);
+
+    // mode 1 keeps consecutive output channels consecutive in input,
+    // mode 0 with upscale 2 is a 4x4 transpose of pack4 input
+    int out_elempack = 1;
+#if __SSE2__
+    if (opt.use_packing_layout)
+    {
+        if (mode == 1 && elempack > 1 && outc % elempack == 0)
+        {
+            out_elempack = elempack;
+        }
+        else if (mode == 0 && upscale_factor == 2 && elempack == 4 && outc % 4 == 0)
+        {
+            out_elempack = 4;
+        }
+        else
+        {
+#if __AVX512F__
+            out_elempack = outc % 16 == 0 ? 16 : outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#elif __AVX__
+            out_elempack = outc % 8 == 0 ? 8 : outc % 4 == 0 ? 4 : 1;
+#else
+            out_elempack = outc % 4 == 0 ? 4 : 1;
+#endif
+        }
+    }
+#endif // __SSE2__
+    const size_t out_elemsize = elemsize / elempack * out_elempack;
+
+    top_blob.create(outw, outh, outc / out_elempack, out_elemsize, out_elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (mode == 1 && elempack > 1 && out_elempack == elempack)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc / out_elempack; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int sh = 0; sh < upscale_factor; sh++)
+            {
+                for (int sw = 0; sw < upscale_factor; sw++)
+                {
+                    const int q = (sh * upscale_factor + sw) * outc / elempack + p;
+
+                    const float* sptr = bottom_blob.channel(q);
+
+                    for (int i = 0; i < h; i++)
+                    {
+                        float* outptr = m.row(i * upscale_factor + sh) + sw * elempack;
+
+                        pixelshuffle_copy_packed(sptr, outptr, w, elempack, upscale_factor);
+
+                        sptr += w * elempack;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+
+#if __SSE2__
+    if (mode == 0 && upscale_factor == 2 && elempack == 4 && out_elempack == 4)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc / out_elempack; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            const float* sptr0 = bottom_blob.channel(p * 4);
+            const float* sptr1 = bottom_blob.channel(p * 4 + 1);
+            const float* sptr2 = bottom_blob.channel(p * 4 + 2);
+            const float* sptr3 = bottom_blob.channel(p * 4 + 3);
+
+            for (int i = 0; i < h; i++)
+            {
+                float* outptr0 = m.row(i * 2);
+                float* outptr1 = m.row(i * 2 + 1);
+
+                for (int j = 0; j < w; j++)
+                {
+                    __m128 _p0 = _mm_loadu_ps(sptr0);
+                    __m128 _p1 = _mm_loadu_ps(sptr1);
+                    __m128 _p2 = _mm_loadu_ps(sptr2);
+                    __m128 _p3 = _mm_loadu_ps(sptr3);
+
+                    _MM_TRANSPOSE4_PS(_p0, _p1, _p2, _p3);
+
+                    _mm_storeu_ps(outptr0, _p0);
+                    _mm_storeu_ps(outptr0 + 4, _p1);
+                    _mm_storeu_ps(outptr1, _p2);
+                    _mm_storeu_ps(outptr1 + 4, _p3);
+
+                    sptr0 += 4;
+                    sptr1 += 4;
+                    sptr2 += 4;
+                    sptr3 += 4;
+                    outptr0 += 8;
+                    outptr1 += 8;
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    if (upscale_factor == 2 && elempack == 1 && out_elempack == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int p = 0; p < outc; p++)
+        {
+            Mat m = top_blob.channel(p);
+
+            for (int sh = 0; sh < 2; sh++)
+            {
+                const int q0 = mode == 0 ? p * 4 + sh * 2 : (sh * 2) * outc + p;
+                const int q1 = mode == 0 ? p * 4 + sh * 2 + 1 : (sh * 2 + 1) * outc + p;
+
+                const float* sptr0 = bottom_blob.channel(q0);
+                const float* sptr1 = bottom_blob.channel(q1);
+
+                for (int i = 0; i < h; i++)
+                {
+                    float* outptr = m.row(i * 2 + sh);
+
+                    int j = 0;
+                    for (; j + 3 < w; j += 4)
+                    {
+                        __m128 _p0 = _mm_loadu_ps(sptr0);
+                        __m128 _p1 = _mm_loadu_ps(sptr1);
+                        _mm_storeu_ps(outptr, _mm_unpacklo_ps(_p0, _p1));
+                        _mm_storeu_ps(outptr + 4, _mm_unpackhi_ps(_p0, _p1));
+
+                        sptr0 += 4;
+                        sptr1 += 4;
+                        outptr += 8;
+                    }
+                    for (; j < w; j++)
+                    {
+                        outptr[0] = sptr0[0];
+                        outptr[1] = sptr1[0];
+
+                        sptr0++;
+                        sptr1++;
+                        outptr += 2;
+                    }
+                }
+            }
+        }
+
+        return 0;
+    }
+#endif // __SSE2__
+
+    // any packing, gather each output lane from its source lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pp = 0; pp < outc / out_elempack; pp++)
+    {
+        Mat m = top_blob.channel(pp);
+
+        for (int k = 0; k < out_elempack; k++)
+        {
+            const int p = pp * out_elempack + k;
+
+            for (int sh = 0; sh < upscale_factor; sh++)
+            {
+                for (int sw = 0; sw < upscale_factor; sw++)
+                {
+                    int q;
+                    if (mode == 0)
+                        q = p * upscale_factor * upscale_factor + sh * upscale_factor + sw;
+                    else // if (mode == 1)
+                        q = (sh * upscale_factor + sw) * outc + p;
+
+                    const float* sptr = (const float*)bottom_blob.channel(q / elempack) + q % elempack;
+
+                    for (int i = 0; i < h; i++)
+                    {
+                        float* outptr = m.row(i * upscale_factor + sh) + sw * out_elempack + k;
+                        for (int j = 0; j < w; j++)
+                        {
+                            outptr[0] = sptr[0];
+
+                            sptr += elempack;
+                            outptr += upscale_factor * out_elempack;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+} // namespace ncnn
@@ -0,0 +1,447 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "pooling3d_x86.h"
+
+#if __SSE2__
+#include <emmintrin.h>
+#if __AVX__
+#include <immintrin.h>
+#endif
+#endif // __SSE2__
+
+#include <float.h>
+
+namespace ncnn {
+
+Pooling3D_x86::Pooling3D_x86()
+{
+#if __SSE2__
+    support_packing = true;
+#endif // __SSE2__
+}
+
+int Pooling3D_x86::create_pipeline(const Option& /*opt*/)
+{
+    if (adaptive_pooling)
+    {
+        support_packing = false;
+    }
+    return 0;
+}
+
+namespace Pooling3D_x86_functor {
+struct pooling3d_pack1
+{
+    typedef float vec;
+    enum
+    {
+        elempack = 1
+    };
+    static NCNN_FORCEINLINE vec load(const float* p)
+    {
+        return *p;
+    }
+    static NCNN_FORCEINLINE void store(float* p, const vec& v)
+    {
+        *p = v;
+    }
+    static NCNN_FORCEINLINE vec set1(float v)
+    {
+        return v;
+    }
+    static NCNN_FORCEINLINE vec max(const vec& a, const vec& b)
+    {
+        return std::max(a, b);
+    }
+    static NCNN_FORCEINLINE vec add(const vec& a, const vec& b)
+    {
+        return a + b;
+    }
+    static NCNN_FORCEINLINE vec mul(const vec& a, const vec& b)
+    {
+        return a * b;
+    }
+};
+
+#if __SSE2__
+struct pooling3d_pack4
+{
+    typedef __m128 vec;
+    enum
+    {
+        elempack = 4
+    };
+    static NCNN_FORCEINLINE vec load(const float* p)
+    {
+        return _mm_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, const vec& v)
+    {
+        _mm_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE vec set1(float v)
+    {
+        return _mm_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE vec max(const vec& a, const vec& b)
+    {
+        return _mm_max_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec add(const vec& a, const vec& b)
+    {
+        return _mm_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec mul(const vec& a, const vec& b)
+    {
+        return _mm_mul_ps(a, b);
+    }
+};
+
+#if __AVX__
+struct pooling3d_pack8
+{
+    typedef __m256 vec;
+    enum
+    {
+        elempack = 8
+    };
+    static NCNN_FORCEINLINE vec load(const float* p)
+    {
+        return _mm256_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, const vec& v)
+    {
+        _mm256_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE vec set1(float v)
+    {
+        return _mm256_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE vec max(const vec& a, const vec& b)
+    {
+        return _mm256_max_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec add(const vec& a, const vec& b)
+    {
+        return _mm256_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec mul(const vec& a, const vec& b)
+    {
+        return _mm256_mul_ps(a, b);
+    }
+};
+
+#if __AVX512F__
+struct pooling3d_pack16
+{
+    typedef __m512 vec;
+    enum
+    {
+        elempack = 16
+    };
+    static NCNN_FORCEINLINE vec load(const float* p)
+    {
+        return _mm512_loadu_ps(p);
+    }
+    static NCNN_FORCEINLINE void store(float* p, const vec& v)
+    {
+        _mm512_storeu_ps(p, v);
+    }
+    static NCNN_FORCEINLINE vec set1(float v)
+    {
+        return _mm512_set1_ps(v);
+    }
+    static NCNN_FORCEINLINE vec max(const vec& a, const vec& b)
+    {
+        return _mm512_max_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec add(const vec& a, const vec& b)
+    {
+        return _mm512_add_ps(a, b);
+    }
+    static NCNN_FORCEINLINE vec mul(const vec& a, const vec& b)
+    {
+        return _mm512_mul_ps(a, b);
+    }
+};
+#endif // __AVX512F__
+#endif // __AVX__
+#endif // __SSE2__
+} // namespace Pooling3D_x86_functor
+
+template<typename Op>
+static void pooling3d_global(const Mat& bottom_blob, Mat& top_blob, int pooling_type, const Option& opt)
+{
+    const int channels = bottom_blob.c;
+    const int size = bottom_blob.w * bottom_blob.h * bottom_blob.d;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const float* ptr = bottom_blob.channel(q);
+        float* outptr = (float*)top_blob + q * Op::elempack;
+
+        if (pooling_type == Pooling3D::PoolMethod_MAX)
+        {
+            typename Op::vec _max = Op::load(ptr);
+            for (int i = 0; i < size; i++)
+            {
+                _max = Op::max(_max, Op::load(ptr));
+                ptr += Op::elempack;
+            }
+
+            Op::store(outptr, _max);
+        }
+        else // if (pooling_type == Pooling3D::PoolMethod_AVE)
+        {
+            typename Op::vec _sum = Op::set1(0.f);
+            for (int i = 0; i < size; i++)
+            {
+                _sum = Op::add(_sum, Op::load(ptr));
+                ptr += Op::elempack;
+            }
+
+            Op::store(outptr, Op::mul(_sum, Op::set1(1.f / size)));
+        }
+    }
+}
+
+// max, or average with padding counted in
+template<typename Op>
+static void pooling3d_window(const Mat& bottom_blob_bordered, Mat& top_blob, int pooling_type, int stride_w, int stride_h, int stride_d, const int* space_ofs, int maxk, const Option& opt)
+{
+    const int channels = top_blob.c;
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int outd = top_blob.d;
+
+    const typename Op::vec _inv_maxk = Op::set1(1.f / maxk);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        float* outptr = top_blob.channel(q);
+
+        for (int z = 0; z < outd; z++)
+        {
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const float* sptr = m.depth(z * stride_d).row(i * stride_h) + j * stride_w * Op::elempack;
+
+                    if (pooling_type == Pooling3D::PoolMethod_MAX)
+                    {
+                        typename Op::vec _max = Op::load(sptr);
+                        for (int l = 0; l < maxk; l++)
+                        {
+                            _max = Op::max(_max, Op::load(sptr + space_ofs[l] * Op::elempack));
+                        }
+
+                        Op::store(outptr, _max);
+                    }
+                    else // if (pooling_type == Pooling3D::PoolMethod_AVE)
+                    {
+                        typename Op::vec _sum = Op::set1(0.f);
+                        for (int l = 0; l < maxk; l++)
+                        {
+                            _sum = Op::add(_sum, Op::load(sptr + space_ofs[l] * Op::elempack));
+                        }
+
+                        Op::store(outptr, Op::mul(_sum, _inv_maxk));
+                    }
+
+                    outptr += Op::elempack;
+                }
+            }
+        }
+    }
+}
+
+// average over the unpadded area only
+template<typename Op>
+static void pooling3d_average_exclude_pad(const Mat& bottom_blob_bordered, Mat& top_blob, int kernel_w, int kernel_h, int kernel_d, int stride_w, int stride_h, int stride_d, int left, int right, int top, int bottom, int front, int behind, const Option& opt)
+{
+    const int channels = top_blob.c;
+    const int outw = top_blob.w;
+    const int outh = top_blob.h;
+    const int outd = top_blob.d;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int d = bottom_blob_bordered.d;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        float* outptr = top_blob.channel(q);
+
+        for (int z = 0; z < outd; z++)
+        {
+            // clip the window to the unpadded region once per axis
+            const int sz0 = std::max(z * stride_d, front);
+            const int sz1 = std::min(z * stride_d + kernel_d, d - behind);
+
+            for (int i = 0; i < outh; i++)
+            {
+                const int sy0 = std::max(i * stride_h, top);
+                const int sy1 = std::min(i * stride_h + kernel_h, h - bottom);
+
+                for (int j = 0; j < outw; j++)
+                {
+                    const int sx0 = std::max(j * stride_w, left);
+                    const int sx1 = std::min(j * stride_w + kernel_w, w - right);
+
+                    typename Op::vec _sum = Op::set1(0.f);
+                    for (int sz = sz0; sz < sz1; sz++)
+                    {
+                        for (int sy = sy0; sy < sy1; sy++)
+                        {
+                            const float* sptr = m.depth(sz).row(sy) + sx0 * Op::elempack;
+                            for (int sx = sx0; sx < sx1; sx++)
+                            {
+                                _sum = Op::add(_sum, Op::load(sptr));
+                                sptr += Op::elempack;
+                            }
+                        }
+                    }
+
+                    const int area = std::max(sz1 - sz0, 0) * std::max(sy1 - sy0, 0) * std::max(sx1 - sx0, 0);
+
+                    Op::store(outptr, Op::mul(_sum, Op::set1(1.f / area)));
+                    outptr += Op::elempack;
+                }
+            }
+        }
+    }
+}
+
+template<typename Op>
+static int pooling3d_forward(const Pooling3D* layer, const Mat& bottom_blob, Mat& top_blob, const Mat& bottom_blob_bordered, const Option& opt)
+{
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+    const int d = bottom_blob_bordered.d;
+    const int channels = bottom_blob_bordered.c;
+    const size_t elemsize = bottom_blob_bordered.elemsize;
+
+    const int kernel_w = layer->kernel_w;
+    const int kernel_h = layer->kernel_h;
+    const int kernel_d = layer->kernel_d;
+    const int stride_w = layer->stride_w;
+    const int stride_h = layer->stride_h;
+    const int stride_d = layer->stride_d;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+    const int outd = (d - kernel_d) / stride_d + 1;
+
+    top_blob.create(outw, outh, outd, channels, elemsize, Op::elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    if (layer->pooling_type == Pooling3D::PoolMethod_AVE && layer->avgpool_count_include_pad == 0)
+    {
+        int wtailpad = 0;
+        int htailpad = 0;
+        int dtailpad = 0;
+
+        if (layer->pad_mode == 0) // full padding
+        {
+            wtailpad = bottom_blob_bordered.w - bottom_blob.w - layer->pad_left - layer->pad_right;
+            htailpad = bottom_blob_bordered.h - bottom_blob.h - layer->pad_top - layer->pad_bottom;
+            dtailpad = bottom_blob_bordered.d - bottom_blob.d - layer->pad_front - layer->pad_behind;
+        }
+
+        pooling3d_average_exclude_pad<Op>(bottom_blob_bordered, top_blob, kernel_w, kernel_h, kernel_d, stride_w, stride_h, stride_d, layer->pad_left, layer->pad_right + wtailpad, layer->pad_top, layer->pad_bottom + htailpad, layer->pad_front, layer->pad_behind + dtailpad, opt);
+
+        return 0;
+    }
+
+    const int maxk = kernel_w * kernel_h * kernel_d;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap0 = w - kernel_w;
+        int gap1 = h * w - w * kernel_h;
+        for (int z = 0; z < kernel_d; z++)
+        {
+            for (int i = 0; i < kernel_h; i++)
+            {
+                for (int j = 0; j < kernel_w; j++)
+                {
+                    space_ofs[p1] = p2;
+                    p1++;
+                    p2 += 1;
+                }
+                p2 += gap0;
+            }
+            p2 += gap1;
+        }
+    }
+
+    pooling3d_window<Op>(bottom_blob_bordered, top_blob, layer->pooling_type, stride_w, stride_h, stride_d, space_ofs, maxk, opt);
+
+    return 0;
+}
+
+int Pooling3D_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    using namespace Pooling3D_x86_functor;
+
+    if (adaptive_pooling)
+    {
+        return Pooling3D::forward(bottom_blob, top_blob, opt);
+    }
+
+    const int elempack = bottom_blob.elempack;
+
+    if (global_pooling)
+    {
+        top_blob.create(bottom_blob.c, bottom_blob.elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (elempack == 16) pooling3d_global<pooling3d_pack16>(bottom_blob, top_blob, pooling_type, opt);
+#endif // __AVX512F__
+        if (elempack == 8) pooling3d_global<pooling3d_pack8>(bottom_blob, top_blob, pooling_type, opt);
+#endif // __AVX__
+        if (elempack == 4) pooling3d_global<pooling3d_pack4>(bottom_blob, top_blob, pooling_type, opt);
+#endif // __SSE2__
+        if (elempack == 1) pooling3d_global<pooling3d_pack1>(bottom_blob, top_blob, pooling_type, opt);
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+    if (elempack == 16)
+        return pooling3d_forward<pooling3d_pack16>(this, bottom_blob, top_blob, bottom_blob_bordered, opt);
+#endif // __AVX512F__
+    if (elempack == 8)
+        return pooling3d_forward<pooling3d_pack8>(this, bottom_blob, top_blob, bottom_blob_bordered, opt);
+#endif // __AVX__
+    if (elempack == 4)
+        return pooling3d_forward<pooling3d_pack4>(this, bottom_blob, top_blob, bottom_blob_bordered, opt);
+#endif // __SSE2__
+
+    return pooling3d_forward<pooling3d_pack1>(this, bottom_blob, top_blob, bottom_blob_bordered, opt);
+}
+
+} // namespace ncnn
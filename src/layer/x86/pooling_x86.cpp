@@ -10,6 +10,8 @@
 #endif
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 #include <float.h>
 
 namespace ncnn {
@@ -51,6 +53,11 @@ int Pooling_x86::create_pipeline(const Option& /*opt*/)
 
 int Pooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
+#if NCNN_INT8
+    if (bottom_blob.elembits() == 8 && !adaptive_pooling)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     // max value in NxN window
     // avg value in NxN window
 
@@ -815,4 +822,213 @@ int Pooling_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& op
 #endif
 }
 
+#if NCNN_INT8
+int Pooling_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    // int8 max and avg keep the scale of the input
+    // the padding value -128 never wins the max, avg pads zero
+    const int elempack = bottom_blob.elempack;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+
+    if (global_pooling)
+    {
+        const int size = bottom_blob.w * bottom_blob.h;
+
+        top_blob.create(channels, elemsize, elempack, opt.blob_allocator);
+        if (top_blob.empty())
+            return -100;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const signed char* ptr = bottom_blob.channel(q);
+            signed char* outptr = (signed char*)top_blob + q * elempack;
+
+            for (int k = 0; k < elempack; k++)
+            {
+                if (pooling_type == PoolMethod_MAX)
+                {
+                    signed char max = ptr[k];
+                    for (int i = 0; i < size; i++)
+                    {
+                        max = std::max(max, ptr[i * elempack + k]);
+                    }
+                    outptr[k] = max;
+                }
+                else // if (pooling_type == PoolMethod_AVE)
+                {
+                    int sum = 0;
+                    for (int i = 0; i < size; i++)
+                    {
+                        sum += ptr[i * elempack + k];
+                    }
+                    outptr[k] = float2int8((float)sum / size);
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    Mat bottom_blob_bordered;
+    make_padding(bottom_blob, bottom_blob_bordered, opt);
+    if (bottom_blob_bordered.empty())
+        return -100;
+
+    const int w = bottom_blob_bordered.w;
+    const int h = bottom_blob_bordered.h;
+
+    const int outw = (w - kernel_w) / stride_w + 1;
+    const int outh = (h - kernel_h) / stride_h + 1;
+
+    top_blob.create(outw, outh, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    const int maxk = kernel_w * kernel_h;
+
+    // kernel offsets
+    std::vector<int> _space_ofs(maxk);
+    int* space_ofs = &_space_ofs[0];
+    {
+        int p1 = 0;
+        int p2 = 0;
+        int gap = w - kernel_w;
+        for (int i = 0; i < kernel_h; i++)
+        {
+            for (int j = 0; j < kernel_w; j++)
+            {
+                space_ofs[p1] = p2 * elempack;
+                p1++;
+                p2++;
+            }
+            p2 += gap;
+        }
+    }
+
+    if (pooling_type == PoolMethod_MAX)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            const Mat m = bottom_blob_bordered.channel(q);
+            signed char* outptr = top_blob.channel(q);
+
+            for (int i = 0; i < outh; i++)
+            {
+                for (int j = 0; j < outw; j++)
+                {
+                    const signed char* sptr = m.row<const signed char>(i * stride_h) + j * stride_w * elempack;
+
+#if __SSE2__
+                    if (elempack == 8)
+                    {
+                        // sign extend to int16 lanes, sse2 has no signed byte max
+                        __m128i _max = _mm_set1_epi16(-128);
+                        for (int k = 0; k < maxk; k++)
+                        {
+                            __m128i _val = _mm_loadl_epi64((const __m128i*)(sptr + space_ofs[k]));
+                            _val = _mm_srai_epi16(_mm_unpacklo_epi8(_val, _val), 8);
+                            _max = _mm_max_epi16(_max, _val);
+                        }
+                        _mm_storel_epi64((__m128i*)outptr, _mm_packs_epi16(_max, _max));
+                        outptr += 8;
+                        continue;
+                    }
+#endif // __SSE2__
+
+                    for (int k = 0; k < elempack; k++)
+                    {
+                        signed char max = sptr[k];
+                        for (int l = 0; l < maxk; l++)
+                        {
+                            max = std::max(max, sptr[space_ofs[l] + k]);
+                        }
+                        outptr[k] = max;
+                    }
+                    outptr += elempack;
+                }
+            }
+        }
+
+        return 0;
+    }
+
+    // PoolMethod_AVE
+    int wtailpad = 0;
+    int htailpad = 0;
+
+    if (pad_mode == 0) // full padding
+    {
+        wtailpad = bottom_blob_bordered.w - bottom_blob.w - pad_left - pad_right;
+        htailpad = bottom_blob_bordered.h - bottom_blob.h - pad_top - pad_bottom;
+    }
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int q = 0; q < channels; q++)
+    {
+        const Mat m = bottom_blob_bordered.channel(q);
+        signed char* outptr = top_blob.channel(q);
+
+        for (int i = 0; i < outh; i++)
+        {
+            const int sy0 = i * stride_h;
+
+            for (int j = 0; j < outw; j++)
+            {
+                const int sx0 = j * stride_w;
+
+                int sum[8] = {0};
+                int area = 0;
+
+                for (int ki = 0; ki < kernel_h; ki++)
+                {
+                    const int sy = sy0 + ki;
+
+                    if (avgpool_count_include_pad == 0)
+                    {
+                        if (sy < pad_top)
+                            continue;
+
+                        if (sy >= h - pad_bottom - htailpad)
+                            break;
+                    }
+
+                    const signed char* sptr = m.row<const signed char>(sy);
+
+                    for (int kj = 0; kj < kernel_w; kj++)
+                    {
+                        const int sx = sx0 + kj;
+
+                        if (avgpool_count_include_pad == 0)
+                        {
+                            if (sx < pad_left)
+                                continue;
+
+                            if (sx >= w - pad_right - wtailpad)
+                                break;
+                        }
+
+                        for (int k = 0; k < elempack; k++)
+                        {
+                            sum[k] += sptr[sx * elempack + k];
+                        }
+                        area += 1;
+                    }
+                }
+
+                for (int k = 0; k < elempack; k++)
+                {
+                    outptr[k] = float2int8((float)sum[k] / area);
+                }
+                outptr += elempack;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
@@ -10,6 +10,8 @@
 #endif // __AVX__
 #endif // __SSE2__
 
+#include "x86_usability.h"
+
 namespace ncnn {
 
 ReLU_x86::ReLU_x86()
@@ -178,7 +180,17 @@ int ReLU_x86::forward_inplace_int8(Mat& bottom_top_blob, const Option& opt) cons
         }
         else
         {
-            // TODO leakyrelu
+            #pragma omp parallel for num_threads(opt.num_threads)
+            for (int q = 0; q < channels; q++)
+            {
+                signed char* ptr = bottom_top_blob.channel(q);
+
+                for (int i = 0; i < size * 8; i++)
+                {
+                    if (ptr[i] < 0)
+                        ptr[i] = float2int8(ptr[i] * slope);
+                }
+            }
         }
 
         return 0;
@@ -204,7 +216,18 @@ int ReLU_x86::forward_inplace_int8(Mat& bottom_top_blob, const Option& opt) cons
     }
     else
     {
-        // TODO leakyrelu
+        // input and output share one scale
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = 0; q < channels; q++)
+        {
+            signed char* ptr = bottom_top_blob.channel(q);
+
+            for (int i = 0; i < size; i++)
+            {
+                if (ptr[i] < 0)
+                    ptr[i] = float2int8(ptr[i] * slope);
+            }
+        }
     }
 
     return 0;
@@ -0,0 +1,281 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// weight_data_tm layout
+// 4 outputs per row, input pairs interleaved for madd
+//   xc  size2 x [H0 H1 H2 H3] x 2
+//   hc  num_output2 x [H0 H1 H2 H3] x 2
+// remaining outputs one per row
+//   xc  size2
+//   hc  num_output2
+static void rnn_transform_weight_int8(const Mat& weight_xc, const Mat& weight_xc_int8_scales, const Mat& weight_hc, const Mat& weight_hc_int8_scales, Mat& weight_data_tm, Mat& weight_data_tm_int8_descales, int size, int num_output, int num_directions, const Option& opt)
+{
+    const int size2 = (size + 1) / 2 * 2;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    weight_data_tm.create((size2 + num_output2) * 4, num_output / 4 + num_output % 4, num_directions, 1u, 1);
+    weight_data_tm_int8_descales.create(8, num_output / 4 + num_output % 4, num_directions);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int dr = 0; dr < num_directions; dr++)
+    {
+        const Mat weight_xc_dr = weight_xc.channel(dr);
+        const Mat weight_hc_dr = weight_hc.channel(dr);
+        const float* weight_xc_int8_scales_ptr = weight_xc_int8_scales.row(dr);
+        const float* weight_hc_int8_scales_ptr = weight_hc_int8_scales.row(dr);
+
+        Mat weight_data_tm_dr = weight_data_tm.channel(dr);
+        Mat weight_data_tm_int8_descales_dr = weight_data_tm_int8_descales.channel(dr);
+
+        int q = 0;
+        for (; q + 3 < num_output; q += 4)
+        {
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q / 4);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q / 4);
+
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(q + j);
+                    kptr[0] = weight_xc_ptr[i];
+                    kptr[1] = i + 1 < size ? weight_xc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(q + j);
+                    kptr[0] = weight_hc_ptr[i];
+                    kptr[1] = i + 1 < num_output ? weight_hc_ptr[i + 1] : 0;
+                    kptr += 2;
+                }
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                descales_ptr[j] = 1.f / weight_xc_int8_scales_ptr[q + j];
+                descales_ptr[4 + j] = 1.f / weight_hc_int8_scales_ptr[q + j];
+            }
+        }
+        for (; q < num_output; q++)
+        {
+            signed char* kptr = weight_data_tm_dr.row<signed char>(q / 4 + q % 4);
+            float* descales_ptr = weight_data_tm_int8_descales_dr.row(q / 4 + q % 4);
+
+            const signed char* weight_xc_ptr = weight_xc_dr.row<const signed char>(q);
+            const signed char* weight_hc_ptr = weight_hc_dr.row<const signed char>(q);
+
+            for (int i = 0; i < size2; i++)
+            {
+                kptr[0] = i < size ? weight_xc_ptr[i] : 0;
+                kptr += 1;
+            }
+
+            for (int i = 0; i < num_output2; i++)
+            {
+                kptr[0] = i < num_output ? weight_hc_ptr[i] : 0;
+                kptr += 1;
+            }
+
+            descales_ptr[0] = 1.f / weight_xc_int8_scales_ptr[q];
+            descales_ptr[1] = 1.f / weight_hc_int8_scales_ptr[q];
+        }
+    }
+}
+
+// quantize to int8 range but keep int16 for madd, zero pad to even length
+static float rnn_dynamic_quantize_int16(const float* ptr, int size, short* outptr)
+{
+    float absmax = 0.f;
+    for (int i = 0; i < size; i++)
+    {
+        absmax = std::max(absmax, (float)fabs(ptr[i]));
+    }
+
+    const int size2 = (size + 1) / 2 * 2;
+
+    if (absmax == 0.f)
+    {
+        for (int i = 0; i < size2; i++)
+        {
+            outptr[i] = 0;
+        }
+        return 1.f;
+    }
+
+    const float scale = 127.f / absmax;
+    for (int i = 0; i < size; i++)
+    {
+        outptr[i] = float2int8(ptr[i] * scale);
+    }
+    for (int i = size; i < size2; i++)
+    {
+        outptr[i] = 0;
+    }
+
+    return absmax / 127.f;
+}
+
+static void rnn_dynamic_quantize(const Mat& bottom_blob, Mat& bottom_blob_int16, Mat& bottom_blob_int8_descales, const Option& opt)
+{
+    const int size = bottom_blob.w;
+    const int T = bottom_blob.h;
+
+    bottom_blob_int8_descales.create(T, (size_t)4u, 1, opt.blob_allocator);
+    bottom_blob_int16.create((size + 1) / 2 * 2, T, (size_t)2u, 1, opt.blob_allocator);
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < T; t++)
+    {
+        bottom_blob_int8_descales[t] = rnn_dynamic_quantize_int16(bottom_blob.row(t), size, bottom_blob_int16.row<short>(t));
+    }
+}
+
+static void rnn_int8(const Mat& bottom_blob_int16, const Mat& bottom_blob_int8_descales, Mat& top_blob, int reverse, const Mat& weight_data_tm, const Mat& weight_data_tm_int8_descales, const Mat& bias_c, Mat& hidden_state, const Option& opt)
+{
+    const int T = bottom_blob_int16.h;
+
+    const int num_output = top_blob.w;
+    const int size2 = bottom_blob_int16.w;
+    const int num_output2 = (num_output + 1) / 2 * 2;
+
+    // num_output
+    Mat gates(num_output, 4u, opt.workspace_allocator);
+
+    Mat hidden_state_int16(num_output2, (size_t)2u, 1, opt.workspace_allocator);
+
+    // unroll
+    for (int t = 0; t < T; t++)
+    {
+        int ti = reverse ? T - 1 - t : t;
+
+        // dynamic quantize hidden_state
+        const float descale_h = rnn_dynamic_quantize_int16(hidden_state, num_output, hidden_state_int16);
+        const float descale_x = bottom_blob_int8_descales[ti];
+
+        const short* x = bottom_blob_int16.row<const short>(ti);
+        const short* hs = hidden_state_int16;
+
+        const int nn_num_output = num_output >> 2;
+        const int remain_num_output_start = nn_num_output << 2;
+
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int qq = 0; qq < nn_num_output; qq++)
+        {
+            const int q = qq * 4;
+
+            const signed char* kptr = weight_data_tm.row<const signed char>(q / 4);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q / 4);
+
+#if __SSE2__
+            __m128i _Hx = _mm_setzero_si128();
+            __m128i _Hx1 = _mm_setzero_si128();
+            int i = 0;
+            for (; i + 3 < size2; i += 4)
+            {
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _extw = _mm_cmpgt_epi8(_mm_setzero_si128(), _w);
+                _Hx = _mm_add_epi32(_Hx, _mm_madd_epi16(_mm_unpacklo_epi8(_w, _extw), _mm_set1_epi32(*(const int*)(x + i))));
+                _Hx1 = _mm_add_epi32(_Hx1, _mm_madd_epi16(_mm_unpackhi_epi8(_w, _extw), _mm_set1_epi32(*(const int*)(x + i + 2))));
+                kptr += 16;
+            }
+            for (; i < size2; i += 2)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+                _Hx = _mm_add_epi32(_Hx, _mm_madd_epi16(_w, _mm_set1_epi32(*(const int*)(x + i))));
+                kptr += 8;
+            }
+
+            __m128i _Hh = _mm_setzero_si128();
+            __m128i _Hh1 = _mm_setzero_si128();
+            i = 0;
+            for (; i + 3 < num_output2; i += 4)
+            {
+                __m128i _w = _mm_loadu_si128((const __m128i*)kptr);
+                __m128i _extw = _mm_cmpgt_epi8(_mm_setzero_si128(), _w);
+                _Hh = _mm_add_epi32(_Hh, _mm_madd_epi16(_mm_unpacklo_epi8(_w, _extw), _mm_set1_epi32(*(const int*)(hs + i))));
+                _Hh1 = _mm_add_epi32(_Hh1, _mm_madd_epi16(_mm_unpackhi_epi8(_w, _extw), _mm_set1_epi32(*(const int*)(hs + i + 2))));
+                kptr += 16;
+            }
+            for (; i < num_output2; i += 2)
+            {
+                __m128i _w = _mm_loadl_epi64((const __m128i*)kptr);
+                _w = _mm_unpacklo_epi8(_w, _mm_cmpgt_epi8(_mm_setzero_si128(), _w));
+                _Hh = _mm_add_epi32(_Hh, _mm_madd_epi16(_w, _mm_set1_epi32(*(const int*)(hs + i))));
+                kptr += 8;
+            }
+
+            _Hx = _mm_add_epi32(_Hx, _Hx1);
+            _Hh = _mm_add_epi32(_Hh, _Hh1);
+
+            __m128 _H = _mm_loadu_ps((const float*)bias_c + q);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hx), _mm_mul_ps(_mm_set1_ps(descale_x), _mm_loadu_ps(descales_ptr)), _H);
+            _H = _mm_comp_fmadd_ps(_mm_cvtepi32_ps(_Hh), _mm_mul_ps(_mm_set1_ps(descale_h), _mm_loadu_ps(descales_ptr + 4)), _H);
+
+            _H = tanh_sse(_H);
+
+            _mm_storeu_ps((float*)gates + q, _H);
+#else  // __SSE2__
+            int Hx[4] = {0};
+            for (int i = 0; i < size2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Hx[j] += kptr[j * 2] * x[i] + kptr[j * 2 + 1] * x[i + 1];
+                }
+                kptr += 8;
+            }
+
+            int Hh[4] = {0};
+            for (int i = 0; i < num_output2; i += 2)
+            {
+                for (int j = 0; j < 4; j++)
+                {
+                    Hh[j] += kptr[j * 2] * hs[i] + kptr[j * 2 + 1] * hs[i + 1];
+                }
+                kptr += 8;
+            }
+
+            for (int j = 0; j < 4; j++)
+            {
+                float H = bias_c[q + j] + Hx[j] * (descale_x * descales_ptr[j]) + Hh[j] * (descale_h * descales_ptr[4 + j]);
+
+                gates[q + j] = tanhf(H);
+            }
+#endif // __SSE2__
+        }
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int q = remain_num_output_start; q < num_output; q++)
+        {
+            const signed char* kptr = weight_data_tm.row<const signed char>(q / 4 + q % 4);
+            const float* descales_ptr = weight_data_tm_int8_descales.row(q / 4 + q % 4);
+
+            int Hx = 0;
+            for (int i = 0; i < size2; i++)
+            {
+                Hx += kptr[0] * x[i];
+                kptr += 1;
+            }
+
+            int Hh = 0;
+            for (int i = 0; i < num_output2; i++)
+            {
+                Hh += kptr[0] * hs[i];
+                kptr += 1;
+            }
+
+            float H = bias_c[q] + Hx * (descale_x * descales_ptr[0]) + Hh * (descale_h * descales_ptr[1]);
+
+            gates[q] = tanhf(H);
+        }
+
+        float* output_data = top_blob.row(ti);
+        memcpy((float*)hidden_state, (const float*)gates, num_output * sizeof(float));
+        memcpy(output_data, (const float*)gates, num_output * sizeof(float));
+    }
+}
@@ -24,6 +24,12 @@ ShuffleChannel_x86::ShuffleChannel_x86()
 int ShuffleChannel_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
 {
     int elembits = bottom_blob.elembits();
+
+#if NCNN_INT8
+    if (elembits == 8)
+        return forward_int8(bottom_blob, top_blob, opt);
+#endif
+
     if (elembits != 32)
     {
         NCNN_LOGE("Elembits = %d is not implemented yet.", elembits);
@@ -763,4 +769,56 @@ int ShuffleChannel_x86::forward(const Mat& bottom_blob, Mat& top_blob, const Opt
     return ShuffleChannel::forward(bottom_blob, top_blob, opt);
 }
 
+#if NCNN_INT8
+int ShuffleChannel_x86::forward_int8(const Mat& bottom_blob, Mat& top_blob, const Option& opt) const
+{
+    const int elempack = bottom_blob.elempack;
+
+    if (elempack == 1)
+        return ShuffleChannel::forward(bottom_blob, top_blob, opt);
+
+    const int w = bottom_blob.w;
+    const int h = bottom_blob.h;
+    const int channels = bottom_blob.c;
+    const size_t elemsize = bottom_blob.elemsize;
+    const int size = w * h;
+
+    const int total_channels = channels * elempack;
+    if (total_channels % group != 0)
+    {
+        // reject invalid group
+        return -100;
+    }
+
+    const int _group = reverse ? total_channels / group : group;
+    const int channels_per_group = total_channels / _group;
+
+    top_blob.create(w, h, channels, elemsize, elempack, opt.blob_allocator);
+    if (top_blob.empty())
+        return -100;
+
+    // gather each output lane from its source lane
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int pp = 0; pp < channels; pp++)
+    {
+        signed char* outptr = top_blob.channel(pp);
+
+        for (int k = 0; k < elempack; k++)
+        {
+            const int dst_q = pp * elempack + k;
+            const int src_q = channels_per_group * (dst_q % _group) + dst_q / _group;
+
+            const signed char* ptr = (const signed char*)bottom_blob.channel(src_q / elempack) + src_q % elempack;
+
+            for (int i = 0; i < size; i++)
+            {
+                outptr[i * elempack + k] = ptr[i * elempack];
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
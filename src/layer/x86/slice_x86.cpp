@@ -21,6 +21,11 @@ Slice_x86::Slice_x86()
 
 int Slice_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
 {
+#if NCNN_INT8
+    if (bottom_blobs[0].elembits() == 8)
+        return forward_int8(bottom_blobs, top_blobs, opt);
+#endif
+
     const Mat& bottom_blob = bottom_blobs[0];
     int dims = bottom_blob.dims;
     size_t elemsize = bottom_blob.elemsize;
@@ -962,4 +967,44 @@ int Slice_x86::forward(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& t
     return 0;
 }
 
+#if NCNN_INT8
+int Slice_x86::forward_int8(const std::vector<Mat>& bottom_blobs, std::vector<Mat>& top_blobs, const Option& opt) const
+{
+    const Mat& bottom_blob = bottom_blobs[0];
+    const int dims = bottom_blob.dims;
+    const int elempack = bottom_blob.elempack;
+    const int positive_axis = axis < 0 ? dims + axis : axis;
+
+    if (elempack == 1 || positive_axis != 0)
+    {
+        // int8 slice off the packed axis only moves bytes, run the pack1 routine over whole packed elements
+        std::vector<Mat> bottom_blobs_elem(1);
+        bottom_blobs_elem[0] = bottom_blob;
+        bottom_blobs_elem[0].elempack = 1;
+
+        int ret = Slice::forward(bottom_blobs_elem, top_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        for (size_t i = 0; i < top_blobs.size(); i++)
+        {
+            top_blobs[i].elempack = elempack;
+        }
+
+        return 0;
+    }
+
+    // slice across the packed int8 lanes in pack1
+    Option opt_pack1 = opt;
+    opt_pack1.blob_allocator = opt.workspace_allocator;
+
+    std::vector<Mat> bottom_blobs_unpacked(1);
+    convert_packing(bottom_blob, bottom_blobs_unpacked[0], 1, opt_pack1);
+    if (bottom_blobs_unpacked[0].empty())
+        return -100;
+
+    return Slice::forward(bottom_blobs_unpacked, top_blobs, opt);
+}
+#endif // NCNN_INT8
+
 } // namespace ncnn
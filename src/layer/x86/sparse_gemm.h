@@ -0,0 +1,619 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// 1xN block sparse weight for 1x1 convolution and innerproduct
+// a block covers N consecutive outputs at the same input channel, only blocks with any nonzero weight are stored
+// weight_sparse_index  = [nblock + 1] offset of the first stored block of each block row
+// weight_sparse_column = [nnzb] input channel of each stored block
+// weight_sparse_data   = [nnzb][N] weights
+
+// number of 1xblock groups with any nonzero weight, weight_data layout [num_output][num_input]
+static int sparse_weight_count_blocks(const Mat& weight_data, int num_input, int num_output, int block)
+{
+    const float* weight = weight_data;
+
+    int nnzb = 0;
+    for (int q = 0; q + block - 1 < num_output; q += block)
+    {
+        for (int k = 0; k < num_input; k++)
+        {
+            for (int n = 0; n < block; n++)
+            {
+                if (weight[(q + n) * num_input + k] != 0.f)
+                {
+                    nnzb++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return nnzb;
+}
+
+static void sparse_weight_pack(const Mat& weight_data, Mat& weight_sparse_data, Mat& weight_sparse_index, Mat& weight_sparse_column, int num_input, int num_output, int block)
+{
+    const float* weight = weight_data;
+
+    const int nblock = num_output / block;
+    const int nnzb = sparse_weight_count_blocks(weight_data, num_input, num_output, block);
+
+    weight_sparse_index.create(nblock + 1, (size_t)4u);
+    weight_sparse_column.create(std::max(nnzb, 1), (size_t)2u);
+    weight_sparse_data.create(std::max(nnzb * block, 1));
+
+    int* rowptr = weight_sparse_index;
+    unsigned short* colidx = weight_sparse_column;
+    float* kptr = weight_sparse_data;
+
+    int j = 0;
+    for (int b = 0; b < nblock; b++)
+    {
+        rowptr[b] = j;
+
+        for (int k = 0; k < num_input; k++)
+        {
+            bool nonzero = false;
+            for (int n = 0; n < block; n++)
+            {
+                if (weight[(b * block + n) * num_input + k] != 0.f)
+                {
+                    nonzero = true;
+                    break;
+                }
+            }
+
+            if (!nonzero)
+                continue;
+
+            colidx[j] = (unsigned short)k;
+            for (int n = 0; n < block; n++)
+            {
+                kptr[j * block + n] = weight[(b * block + n) * num_input + k];
+            }
+            j++;
+        }
+    }
+    rowptr[nblock] = j;
+}
+
+// N = 4 8 16 outputs in one vector, any input elempack, out_elempack multiple of N
+// every stored block broadcasts one input value per pixel
+static void sparse_gemm_packed(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_sparse_data, const Mat& weight_sparse_index, const Mat& weight_sparse_column, const Mat& bias_data, int block, const Option& opt)
+{
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int elempack = bottom_blob.elempack;
+    const size_t cstep = bottom_blob.cstep;
+    const int out_elempack = top_blob.elempack;
+    const int num_output = top_blob.c * out_elempack;
+    const int nblock = num_output / block;
+
+    const float* bottom = bottom_blob;
+
+    const int* rowptr = weight_sparse_index;
+    const unsigned short* colidx = weight_sparse_column;
+    const int nnzb = rowptr[nblock];
+
+    // element offset of the input channel of each stored block
+    std::vector<size_t> offsets(std::max(nnzb, 1));
+    for (int j = 0; j < nnzb; j++)
+    {
+        const int c = colidx[j];
+        offsets[j] = c / elempack * cstep * elempack + c % elempack;
+    }
+
+    // the pixels of one tile stay in cache across all output blocks
+    const int tile_size = 32;
+    const int ntile = (size + tile_size - 1) / tile_size;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < ntile * nblock; t++)
+    {
+        const int ti = t / nblock;
+        const int b = t % nblock;
+
+        const int i0 = ti * tile_size;
+        const int i1 = std::min(i0 + tile_size, size);
+
+        const int nnz = rowptr[b + 1] - rowptr[b];
+        const size_t* optr = &offsets[0] + rowptr[b];
+        const float* kptr0 = (const float*)weight_sparse_data + rowptr[b] * block;
+        const float* biasptr = bias_data.empty() ? 0 : (const float*)bias_data + b * block;
+
+        float* outptr = (float*)top_blob.data + (b * block / out_elempack) * top_blob.cstep * out_elempack + (b * block % out_elempack);
+
+        int i = i0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (block == 16)
+        {
+            const __m512 _bias = biasptr ? _mm512_loadu_ps(biasptr) : _mm512_setzero_ps();
+            for (; i + 7 < i1; i += 8)
+            {
+                __m512 _sum0 = _bias;
+                __m512 _sum1 = _bias;
+                __m512 _sum2 = _bias;
+                __m512 _sum3 = _bias;
+                __m512 _sum4 = _bias;
+                __m512 _sum5 = _bias;
+                __m512 _sum6 = _bias;
+                __m512 _sum7 = _bias;
+
+                const float* kptr = kptr0;
+                for (int k = 0; k < nnz; k++)
+                {
+                    const float* p = bottom + optr[k] + i * elempack;
+                    __m512 _w = _mm512_loadu_ps(kptr);
+                    _sum0 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[0]), _sum0);
+                    _sum1 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack]), _sum1);
+                    _sum2 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 2]), _sum2);
+                    _sum3 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 3]), _sum3);
+                    _sum4 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 4]), _sum4);
+                    _sum5 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 5]), _sum5);
+                    _sum6 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 6]), _sum6);
+                    _sum7 = _mm512_fmadd_ps(_w, _mm512_set1_ps(p[elempack * 7]), _sum7);
+                    kptr += 16;
+                }
+
+                float* outp = outptr + i * out_elempack;
+                _mm512_storeu_ps(outp, _sum0);
+                _mm512_storeu_ps(outp + out_elempack, _sum1);
+                _mm512_storeu_ps(outp + out_elempack * 2, _sum2);
+                _mm512_storeu_ps(outp + out_elempack * 3, _sum3);
+                _mm512_storeu_ps(outp + out_elempack * 4, _sum4);
+                _mm512_storeu_ps(outp + out_elempack * 5, _sum5);
+                _mm512_storeu_ps(outp + out_elempack * 6, _sum6);
+                _mm512_storeu_ps(outp + out_elempack * 7, _sum7);
+            }
+            for (; i < i1; i++)
+            {
+                __m512 _sum0 = _bias;
+                __m512 _sum1 = _mm512_setzero_ps();
+
+                const float* kptr = kptr0;
+                int k = 0;
+                for (; k + 1 < nnz; k += 2)
+                {
+                    _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    _sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 16), _mm512_set1_ps(bottom[optr[k + 1] + i * elempack]), _sum1);
+                    kptr += 32;
+                }
+                for (; k < nnz; k++)
+                {
+                    _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    kptr += 16;
+                }
+
+                _mm512_storeu_ps(outptr + i * out_elempack, _mm512_add_ps(_sum0, _sum1));
+            }
+        }
+#endif // __AVX512F__
+        if (block == 8)
+        {
+            const __m256 _bias = biasptr ? _mm256_loadu_ps(biasptr) : _mm256_setzero_ps();
+            for (; i + 7 < i1; i += 8)
+            {
+                __m256 _sum0 = _bias;
+                __m256 _sum1 = _bias;
+                __m256 _sum2 = _bias;
+                __m256 _sum3 = _bias;
+                __m256 _sum4 = _bias;
+                __m256 _sum5 = _bias;
+                __m256 _sum6 = _bias;
+                __m256 _sum7 = _bias;
+
+                const float* kptr = kptr0;
+                for (int k = 0; k < nnz; k++)
+                {
+                    const float* p = bottom + optr[k] + i * elempack;
+                    __m256 _w = _mm256_loadu_ps(kptr);
+                    _sum0 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[0]), _sum0);
+                    _sum1 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack]), _sum1);
+                    _sum2 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 2]), _sum2);
+                    _sum3 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 3]), _sum3);
+                    _sum4 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 4]), _sum4);
+                    _sum5 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 5]), _sum5);
+                    _sum6 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 6]), _sum6);
+                    _sum7 = _mm256_comp_fmadd_ps(_w, _mm256_set1_ps(p[elempack * 7]), _sum7);
+                    kptr += 8;
+                }
+
+                float* outp = outptr + i * out_elempack;
+                _mm256_storeu_ps(outp, _sum0);
+                _mm256_storeu_ps(outp + out_elempack, _sum1);
+                _mm256_storeu_ps(outp + out_elempack * 2, _sum2);
+                _mm256_storeu_ps(outp + out_elempack * 3, _sum3);
+                _mm256_storeu_ps(outp + out_elempack * 4, _sum4);
+                _mm256_storeu_ps(outp + out_elempack * 5, _sum5);
+                _mm256_storeu_ps(outp + out_elempack * 6, _sum6);
+                _mm256_storeu_ps(outp + out_elempack * 7, _sum7);
+            }
+            for (; i < i1; i++)
+            {
+                __m256 _sum0 = _bias;
+                __m256 _sum1 = _mm256_setzero_ps();
+
+                const float* kptr = kptr0;
+                int k = 0;
+                for (; k + 1 < nnz; k += 2)
+                {
+                    _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_set1_ps(bottom[optr[k + 1] + i * elempack]), _sum1);
+                    kptr += 16;
+                }
+                for (; k < nnz; k++)
+                {
+                    _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    kptr += 8;
+                }
+
+                _mm256_storeu_ps(outptr + i * out_elempack, _mm256_add_ps(_sum0, _sum1));
+            }
+        }
+#endif // __AVX__
+        if (block == 4)
+        {
+            const __m128 _bias = biasptr ? _mm_loadu_ps(biasptr) : _mm_setzero_ps();
+            for (; i + 7 < i1; i += 8)
+            {
+                __m128 _sum0 = _bias;
+                __m128 _sum1 = _bias;
+                __m128 _sum2 = _bias;
+                __m128 _sum3 = _bias;
+                __m128 _sum4 = _bias;
+                __m128 _sum5 = _bias;
+                __m128 _sum6 = _bias;
+                __m128 _sum7 = _bias;
+
+                const float* kptr = kptr0;
+                for (int k = 0; k < nnz; k++)
+                {
+                    const float* p = bottom + optr[k] + i * elempack;
+                    __m128 _w = _mm_loadu_ps(kptr);
+                    _sum0 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[0]), _sum0);
+                    _sum1 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack]), _sum1);
+                    _sum2 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 2]), _sum2);
+                    _sum3 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 3]), _sum3);
+                    _sum4 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 4]), _sum4);
+                    _sum5 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 5]), _sum5);
+                    _sum6 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 6]), _sum6);
+                    _sum7 = _mm_comp_fmadd_ps(_w, _mm_set1_ps(p[elempack * 7]), _sum7);
+                    kptr += 4;
+                }
+
+                float* outp = outptr + i * out_elempack;
+                _mm_storeu_ps(outp, _sum0);
+                _mm_storeu_ps(outp + out_elempack, _sum1);
+                _mm_storeu_ps(outp + out_elempack * 2, _sum2);
+                _mm_storeu_ps(outp + out_elempack * 3, _sum3);
+                _mm_storeu_ps(outp + out_elempack * 4, _sum4);
+                _mm_storeu_ps(outp + out_elempack * 5, _sum5);
+                _mm_storeu_ps(outp + out_elempack * 6, _sum6);
+                _mm_storeu_ps(outp + out_elempack * 7, _sum7);
+            }
+            for (; i < i1; i++)
+            {
+                __m128 _sum0 = _bias;
+                __m128 _sum1 = _mm_setzero_ps();
+
+                const float* kptr = kptr0;
+                int k = 0;
+                for (; k + 1 < nnz; k += 2)
+                {
+                    _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_set1_ps(bottom[optr[k + 1] + i * elempack]), _sum1);
+                    kptr += 8;
+                }
+                for (; k < nnz; k++)
+                {
+                    _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(bottom[optr[k] + i * elempack]), _sum0);
+                    kptr += 4;
+                }
+
+                _mm_storeu_ps(outptr + i * out_elempack, _mm_add_ps(_sum0, _sum1));
+            }
+        }
+#endif // __SSE2__
+        for (; i < i1; i++)
+        {
+            for (int n = 0; n < block; n++)
+            {
+                float sum = biasptr ? biasptr[n] : 0.f;
+
+                const float* kptr = kptr0 + n;
+                for (int k = 0; k < nnz; k++)
+                {
+                    sum += kptr[0] * bottom[optr[k] + i * elempack];
+                    kptr += block;
+                }
+
+                outptr[i * out_elempack + n] = sum;
+            }
+        }
+    }
+}
+
+// N = 1 with elempack 1 input and output, the pixels of one channel run in vectors
+static void sparse_gemm(const Mat& bottom_blob, Mat& top_blob, const Mat& weight_sparse_data, const Mat& weight_sparse_index, const Mat& weight_sparse_column, const Mat& bias_data, const Option& opt)
+{
+    const int size = bottom_blob.w * bottom_blob.h;
+    const int num_output = top_blob.c;
+
+    const float* bottom = bottom_blob;
+    const size_t cstep = bottom_blob.cstep;
+
+    const int* rowptr = weight_sparse_index;
+    const unsigned short* colidx = weight_sparse_column;
+
+    const int tile_size = 64;
+    const int ntile = (size + tile_size - 1) / tile_size;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int t = 0; t < ntile * num_output; t++)
+    {
+        const int ti = t / num_output;
+        const int q = t % num_output;
+
+        const int i0 = ti * tile_size;
+        const int i1 = std::min(i0 + tile_size, size);
+
+        const int nnz = rowptr[q + 1] - rowptr[q];
+        const unsigned short* cptr = colidx + rowptr[q];
+        const float* kptr0 = (const float*)weight_sparse_data + rowptr[q];
+        const float bias = bias_data.empty() ? 0.f : bias_data[q];
+
+        float* outptr = top_blob.channel(q);
+
+        int i = i0;
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        for (; i + 63 < i1; i += 64)
+        {
+            __m512 _sum0 = _mm512_set1_ps(bias);
+            __m512 _sum1 = _mm512_set1_ps(bias);
+            __m512 _sum2 = _mm512_set1_ps(bias);
+            __m512 _sum3 = _mm512_set1_ps(bias);
+
+            for (int k = 0; k < nnz; k++)
+            {
+                const float* p = bottom + cptr[k] * cstep + i;
+                __m512 _w = _mm512_set1_ps(kptr0[k]);
+                _sum0 = _mm512_fmadd_ps(_w, _mm512_loadu_ps(p), _sum0);
+                _sum1 = _mm512_fmadd_ps(_w, _mm512_loadu_ps(p + 16), _sum1);
+                _sum2 = _mm512_fmadd_ps(_w, _mm512_loadu_ps(p + 32), _sum2);
+                _sum3 = _mm512_fmadd_ps(_w, _mm512_loadu_ps(p + 48), _sum3);
+            }
+
+            _mm512_storeu_ps(outptr + i, _sum0);
+            _mm512_storeu_ps(outptr + i + 16, _sum1);
+            _mm512_storeu_ps(outptr + i + 32, _sum2);
+            _mm512_storeu_ps(outptr + i + 48, _sum3);
+        }
+#endif // __AVX512F__
+        for (; i + 31 < i1; i += 32)
+        {
+            __m256 _sum0 = _mm256_set1_ps(bias);
+            __m256 _sum1 = _mm256_set1_ps(bias);
+            __m256 _sum2 = _mm256_set1_ps(bias);
+            __m256 _sum3 = _mm256_set1_ps(bias);
+
+            for (int k = 0; k < nnz; k++)
+            {
+                const float* p = bottom + cptr[k] * cstep + i;
+                __m256 _w = _mm256_set1_ps(kptr0[k]);
+                _sum0 = _mm256_comp_fmadd_ps(_w, _mm256_loadu_ps(p), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_w, _mm256_loadu_ps(p + 8), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_w, _mm256_loadu_ps(p + 16), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_w, _mm256_loadu_ps(p + 24), _sum3);
+            }
+
+            _mm256_storeu_ps(outptr + i, _sum0);
+            _mm256_storeu_ps(outptr + i + 8, _sum1);
+            _mm256_storeu_ps(outptr + i + 16, _sum2);
+            _mm256_storeu_ps(outptr + i + 24, _sum3);
+        }
+        for (; i + 7 < i1; i += 8)
+        {
+            __m256 _sum = _mm256_set1_ps(bias);
+
+            for (int k = 0; k < nnz; k++)
+            {
+                _sum = _mm256_comp_fmadd_ps(_mm256_set1_ps(kptr0[k]), _mm256_loadu_ps(bottom + cptr[k] * cstep + i), _sum);
+            }
+
+            _mm256_storeu_ps(outptr + i, _sum);
+        }
+#endif // __AVX__
+        for (; i + 3 < i1; i += 4)
+        {
+            __m128 _sum = _mm_set1_ps(bias);
+
+            for (int k = 0; k < nnz; k++)
+            {
+                _sum = _mm_comp_fmadd_ps(_mm_set1_ps(kptr0[k]), _mm_loadu_ps(bottom + cptr[k] * cstep + i), _sum);
+            }
+
+            _mm_storeu_ps(outptr + i, _sum);
+        }
+#endif // __SSE2__
+        for (; i < i1; i++)
+        {
+            float sum = bias;
+
+            for (int k = 0; k < nnz; k++)
+            {
+                sum += kptr0[k] * bottom[cptr[k] * cstep + i];
+            }
+
+            outptr[i] = sum;
+        }
+    }
+}
+
+// outptr[num_output] = weight * ptr[num_input] + bias
+static void sparse_gemv(const float* ptr, float* outptr, const Mat& weight_sparse_data, const Mat& weight_sparse_index, const Mat& weight_sparse_column, const Mat& bias_data, int num_output, int block, const Option& opt)
+{
+    const int nblock = num_output / block;
+
+    const int* rowptr = weight_sparse_index;
+    const unsigned short* colidx = weight_sparse_column;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int b = 0; b < nblock; b++)
+    {
+        const unsigned short* cptr = colidx + rowptr[b];
+        const float* kptr = (const float*)weight_sparse_data + rowptr[b] * block;
+        const int nnz = rowptr[b + 1] - rowptr[b];
+
+        float* outp = outptr + b * block;
+
+#if __SSE2__
+#if __AVX__
+#if __AVX512F__
+        if (block == 16)
+        {
+            __m512 _sum0 = bias_data.empty() ? _mm512_setzero_ps() : _mm512_loadu_ps((const float*)bias_data + b * 16);
+            __m512 _sum1 = _mm512_setzero_ps();
+            __m512 _sum2 = _mm512_setzero_ps();
+            __m512 _sum3 = _mm512_setzero_ps();
+            int k = 0;
+            for (; k + 3 < nnz; k += 4)
+            {
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(ptr[cptr[k]]), _sum0);
+                _sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 16), _mm512_set1_ps(ptr[cptr[k + 1]]), _sum1);
+                _sum2 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 32), _mm512_set1_ps(ptr[cptr[k + 2]]), _sum2);
+                _sum3 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 48), _mm512_set1_ps(ptr[cptr[k + 3]]), _sum3);
+                kptr += 64;
+            }
+            for (; k < nnz; k++)
+            {
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_set1_ps(ptr[cptr[k]]), _sum0);
+                kptr += 16;
+            }
+            _sum0 = _mm512_add_ps(_sum0, _sum1);
+            _sum2 = _mm512_add_ps(_sum2, _sum3);
+            _mm512_storeu_ps(outp, _mm512_add_ps(_sum0, _sum2));
+            continue;
+        }
+#endif // __AVX512F__
+        if (block == 8)
+        {
+            __m256 _sum0 = bias_data.empty() ? _mm256_setzero_ps() : _mm256_loadu_ps((const float*)bias_data + b * 8);
+            __m256 _sum1 = _mm256_setzero_ps();
+            __m256 _sum2 = _mm256_setzero_ps();
+            __m256 _sum3 = _mm256_setzero_ps();
+            int k = 0;
+            for (; k + 3 < nnz; k += 4)
+            {
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(ptr[cptr[k]]), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_set1_ps(ptr[cptr[k + 1]]), _sum1);
+                _sum2 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 16), _mm256_set1_ps(ptr[cptr[k + 2]]), _sum2);
+                _sum3 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 24), _mm256_set1_ps(ptr[cptr[k + 3]]), _sum3);
+                kptr += 32;
+            }
+            for (; k < nnz; k++)
+            {
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_set1_ps(ptr[cptr[k]]), _sum0);
+                kptr += 8;
+            }
+            _sum0 = _mm256_add_ps(_sum0, _sum1);
+            _sum2 = _mm256_add_ps(_sum2, _sum3);
+            _mm256_storeu_ps(outp, _mm256_add_ps(_sum0, _sum2));
+            continue;
+        }
+#endif // __AVX__
+        if (block == 4)
+        {
+            __m128 _sum0 = bias_data.empty() ? _mm_setzero_ps() : _mm_loadu_ps((const float*)bias_data + b * 4);
+            __m128 _sum1 = _mm_setzero_ps();
+            __m128 _sum2 = _mm_setzero_ps();
+            __m128 _sum3 = _mm_setzero_ps();
+            int k = 0;
+            for (; k + 3 < nnz; k += 4)
+            {
+                _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(ptr[cptr[k]]), _sum0);
+                _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 4), _mm_set1_ps(ptr[cptr[k + 1]]), _sum1);
+                _sum2 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 8), _mm_set1_ps(ptr[cptr[k + 2]]), _sum2);
+                _sum3 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr + 12), _mm_set1_ps(ptr[cptr[k + 3]]), _sum3);
+                kptr += 16;
+            }
+            for (; k < nnz; k++)
+            {
+                _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(kptr), _mm_set1_ps(ptr[cptr[k]]), _sum0);
+                kptr += 4;
+            }
+            _sum0 = _mm_add_ps(_sum0, _sum1);
+            _sum2 = _mm_add_ps(_sum2, _sum3);
+            _mm_storeu_ps(outp, _mm_add_ps(_sum0, _sum2));
+            continue;
+        }
+#endif // __SSE2__
+        if (block == 1)
+        {
+            float sum = bias_data.empty() ? 0.f : bias_data[b];
+            int k = 0;
+#if __AVX512F__
+            __m512 _sum0 = _mm512_setzero_ps();
+            __m512 _sum1 = _mm512_setzero_ps();
+            for (; k + 31 < nnz; k += 32)
+            {
+                __m512i _index0 = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(cptr + k)));
+                __m512i _index1 = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(cptr + k + 16)));
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_i32gather_ps(_index0, ptr, sizeof(float)), _sum0);
+                _sum1 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr + 16), _mm512_i32gather_ps(_index1, ptr, sizeof(float)), _sum1);
+                kptr += 32;
+            }
+            for (; k + 15 < nnz; k += 16)
+            {
+                __m512i _index = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i*)(cptr + k)));
+                _sum0 = _mm512_fmadd_ps(_mm512_loadu_ps(kptr), _mm512_i32gather_ps(_index, ptr, sizeof(float)), _sum0);
+                kptr += 16;
+            }
+            sum += _mm512_comp_reduce_add_ps(_mm512_add_ps(_sum0, _sum1));
+#elif __AVX2__
+            __m256 _sum0 = _mm256_setzero_ps();
+            __m256 _sum1 = _mm256_setzero_ps();
+            for (; k + 15 < nnz; k += 16)
+            {
+                __m256i _index0 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(cptr + k)));
+                __m256i _index1 = _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i*)(cptr + k + 8)));
+                _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr), _mm256_i32gather_ps(ptr, _index0, sizeof(float)), _sum0);
+                _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(kptr + 8), _mm256_i32gather_ps(ptr, _index1, sizeof(float)), _sum1);
+                kptr += 16;
+            }
+            sum += _mm256_reduce_add_ps(_mm256_add_ps(_sum0, _sum1));
+#endif
+            float sum0 = 0.f;
+            float sum1 = 0.f;
+            float sum2 = 0.f;
+            float sum3 = 0.f;
+            for (; k + 3 < nnz; k += 4)
+            {
+                sum0 += kptr[0] * ptr[cptr[k]];
+                sum1 += kptr[1] * ptr[cptr[k + 1]];
+                sum2 += kptr[2] * ptr[cptr[k + 2]];
+                sum3 += kptr[3] * ptr[cptr[k + 3]];
+                kptr += 4;
+            }
+            for (; k < nnz; k++)
+            {
+                sum0 += kptr[0] * ptr[cptr[k]];
+                kptr += 1;
+            }
+            outp[0] = sum + (sum0 + sum1) + (sum2 + sum3);
+            continue;
+        }
+
+        for (int n = 0; n < block; n++)
+        {
+            float sum = bias_data.empty() ? 0.f : bias_data[b * block + n];
+            for (int k = 0; k < nnz; k++)
+            {
+                sum += kptr[k * block + n] * ptr[cptr[k]];
+            }
+            outp[n] = sum;
+        }
+    }
+}
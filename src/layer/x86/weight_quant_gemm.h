@@ -0,0 +1,228 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// int8 and int4 weight rows are widened to fp32 in registers or in a small per-thread tile
+// the compressed weight is the only full copy in memory
+
+#if __SSE2__
+// 16 int8 weights, or 16 int4 weights from 8 bytes, as 16 signed bytes
+static NCNN_FORCEINLINE __m128i weight_quant_load16(const signed char* wptr, int k, int bits)
+{
+    if (bits == 8)
+        return _mm_loadu_si128((const __m128i*)(wptr + k));
+
+    const __m128i _b = _mm_loadl_epi64((const __m128i*)(wptr + k / 2));
+    const __m128i _mask = _mm_set1_epi8(15);
+    __m128i _lo = _mm_and_si128(_b, _mask);
+    __m128i _hi = _mm_and_si128(_mm_srli_epi16(_b, 4), _mask);
+    return _mm_sub_epi8(_mm_unpacklo_epi8(_lo, _hi), _mm_set1_epi8(8));
+}
+#endif // __SSE2__
+
+static float weight_quant_dot_group(const float* x, const signed char* wptr, int k0, int k1, int bits)
+{
+    int k = k0;
+    float sum = 0.f;
+#if __SSE2__
+    // int4 bytes hold an even and an odd weight
+    if (bits == 8 || k0 % 2 == 0)
+    {
+#if __AVX512F__
+        __m512 _sum = _mm512_setzero_ps();
+        for (; k + 15 < k1; k += 16)
+        {
+            __m128i _w = weight_quant_load16(wptr, k, bits);
+            _sum = _mm512_fmadd_ps(_mm512_loadu_ps(x + k), _mm512_cvtepi32_ps(_mm512_cvtepi8_epi32(_w)), _sum);
+        }
+        sum += _mm512_comp_reduce_add_ps(_sum);
+#elif __AVX__
+        __m256 _sum0 = _mm256_setzero_ps();
+        __m256 _sum1 = _mm256_setzero_ps();
+        for (; k + 15 < k1; k += 16)
+        {
+            __m128i _w = weight_quant_load16(wptr, k, bits);
+            __m128i _w0 = _mm_cvtepi8_epi32(_w);
+            __m128i _w1 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 4));
+            __m128i _w2 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 8));
+            __m128i _w3 = _mm_cvtepi8_epi32(_mm_srli_si128(_w, 12));
+            __m256 _w01 = _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_w0), _w1, 1));
+            __m256 _w23 = _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(_w2), _w3, 1));
+            _sum0 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k), _w01, _sum0);
+            _sum1 = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k + 8), _w23, _sum1);
+        }
+        sum += _mm256_reduce_add_ps(_mm256_add_ps(_sum0, _sum1));
+#else
+        __m128 _sum0 = _mm_setzero_ps();
+        __m128 _sum1 = _mm_setzero_ps();
+        for (; k + 15 < k1; k += 16)
+        {
+            __m128i _w = weight_quant_load16(wptr, k, bits);
+            // sign extend with arithmetic shifts
+            __m128i _w16lo = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+            __m128i _w16hi = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+            __m128 _w0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16lo, _w16lo), 16));
+            __m128 _w1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16lo, _w16lo), 16));
+            __m128 _w2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16hi, _w16hi), 16));
+            __m128 _w3 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16hi, _w16hi), 16));
+            _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k), _w0, _sum0);
+            _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k + 4), _w1, _sum1);
+            _sum0 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k + 8), _w2, _sum0);
+            _sum1 = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k + 12), _w3, _sum1);
+        }
+        sum += _mm_reduce_add_ps(_mm_add_ps(_sum0, _sum1));
+#endif
+    }
+#endif // __SSE2__
+
+    return sum + weight_quant_dot_range(x, wptr, k, k1, bits);
+}
+
+// dequantize weights [k0, k1) of one row sharing one scale into w
+static void weight_quant_decode_range(const signed char* wptr, int k0, int k1, int bits, float scale, float* w)
+{
+    int k = k0;
+#if __SSE2__
+    // int4 bytes hold an even and an odd weight
+    if (bits == 8 || k0 % 2 == 0)
+    {
+        const __m128 _scale = _mm_set1_ps(scale);
+        for (; k + 15 < k1; k += 16)
+        {
+            __m128i _w = weight_quant_load16(wptr, k, bits);
+            // sign extend with arithmetic shifts
+            __m128i _w16lo = _mm_srai_epi16(_mm_unpacklo_epi8(_w, _w), 8);
+            __m128i _w16hi = _mm_srai_epi16(_mm_unpackhi_epi8(_w, _w), 8);
+            __m128 _w0 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16lo, _w16lo), 16));
+            __m128 _w1 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16lo, _w16lo), 16));
+            __m128 _w2 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(_w16hi, _w16hi), 16));
+            __m128 _w3 = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpackhi_epi16(_w16hi, _w16hi), 16));
+            float* outptr = w + (k - k0);
+            _mm_storeu_ps(outptr, _mm_mul_ps(_w0, _scale));
+            _mm_storeu_ps(outptr + 4, _mm_mul_ps(_w1, _scale));
+            _mm_storeu_ps(outptr + 8, _mm_mul_ps(_w2, _scale));
+            _mm_storeu_ps(outptr + 12, _mm_mul_ps(_w3, _scale));
+        }
+    }
+#endif // __SSE2__
+    for (; k < k1; k++)
+    {
+        w[k - k0] = weight_quant_value(wptr, k, bits) * scale;
+    }
+}
+
+static float weight_quant_dot_fp32(const float* x, const float* w, int n)
+{
+    int k = 0;
+    float sum = 0.f;
+#if __AVX512F__
+    __m512 _sum = _mm512_setzero_ps();
+    for (; k + 15 < n; k += 16)
+    {
+        _sum = _mm512_fmadd_ps(_mm512_loadu_ps(x + k), _mm512_loadu_ps(w + k), _sum);
+    }
+    sum += _mm512_comp_reduce_add_ps(_sum);
+#elif __AVX__
+    __m256 _sum = _mm256_setzero_ps();
+    for (; k + 7 < n; k += 8)
+    {
+        _sum = _mm256_comp_fmadd_ps(_mm256_loadu_ps(x + k), _mm256_loadu_ps(w + k), _sum);
+    }
+    sum += _mm256_reduce_add_ps(_sum);
+#elif __SSE2__
+    __m128 _sum = _mm_setzero_ps();
+    for (; k + 3 < n; k += 4)
+    {
+        _sum = _mm_comp_fmadd_ps(_mm_loadu_ps(x + k), _mm_loadu_ps(w + k), _sum);
+    }
+    sum += _mm_reduce_add_ps(_sum);
+#endif
+    for (; k < n; k++)
+    {
+        sum += x[k] * w[k];
+    }
+    return sum;
+}
+
+// out[i][j] = sum_k A[i][k] * B[j][k], B rows quantized, A and out row-major fp32
+// a single row of A dots every weight row straight from the compressed bytes
+// more rows of A dequantize a tile of weight rows and inputs once and reuse it across all M rows
+static void weight_quant_gemm(const float* A, int A_hstep, int M, const Mat& B_quant, const Mat& B_quant_scales, int K, int N, int bits, int group_size, float* out, int out_hstep, const Option& opt)
+{
+    const int row_bytes = weight_quant_row_bytes(K, bits);
+    const int groups = weight_quant_group_count(K, group_size);
+    const int gs = group_size > 0 ? group_size : K;
+
+    if (M == 1)
+    {
+        #pragma omp parallel for num_threads(opt.num_threads)
+        for (int j = 0; j < N; j++)
+        {
+            const signed char* wptr = (const signed char*)B_quant + (size_t)row_bytes * j;
+            const float* scales = (const float*)B_quant_scales + groups * j;
+
+            float sum = 0.f;
+            for (int k0 = 0, g = 0; k0 < K; k0 += gs, g++)
+            {
+                sum += weight_quant_dot_group(A, wptr, k0, std::min(k0 + gs, K), bits) * scales[g];
+            }
+
+            out[j] = sum;
+        }
+
+        return;
+    }
+
+    // 8 weight rows by 256 inputs, 8KB of fp32 fits in l1 next to the input rows
+    const int TILE_N = 8;
+    const int TILE_K = 256;
+
+    const int nn_N = (N + TILE_N - 1) / TILE_N;
+
+    #pragma omp parallel for num_threads(opt.num_threads)
+    for (int ppj = 0; ppj < nn_N; ppj++)
+    {
+        const int j0 = ppj * TILE_N;
+        const int nn = std::min(TILE_N, N - j0);
+
+        float tile[TILE_N * TILE_K];
+
+        for (int i = 0; i < M; i++)
+        {
+            float* outptr = out + (size_t)out_hstep * i + j0;
+            for (int n = 0; n < nn; n++)
+            {
+                outptr[n] = 0.f;
+            }
+        }
+
+        for (int k0 = 0; k0 < K; k0 += TILE_K)
+        {
+            const int kk = std::min(TILE_K, K - k0);
+
+            for (int n = 0; n < nn; n++)
+            {
+                const signed char* wptr = (const signed char*)B_quant + (size_t)row_bytes * (j0 + n);
+                const float* scales = (const float*)B_quant_scales + groups * (j0 + n);
+
+                // split the tile row at group boundaries
+                for (int k = k0; k < k0 + kk;)
+                {
+                    const int g = k / gs;
+                    const int k1 = std::min((g + 1) * gs, k0 + kk);
+                    weight_quant_decode_range(wptr, k, k1, bits, scales[g], tile + n * TILE_K + (k - k0));
+                    k = k1;
+                }
+            }
+
+            for (int i = 0; i < M; i++)
+            {
+                const float* x = A + (size_t)A_hstep * i + k0;
+                float* outptr = out + (size_t)out_hstep * i + j0;
+                for (int n = 0; n < nn; n++)
+                {
+                    outptr[n] += weight_quant_dot_fp32(x, tile + n * TILE_K, kk);
+                }
+            }
+        }
+    }
+}
@@ -257,6 +257,8 @@ public:
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, Allocator* allocator = 0);
     // convenient construct from pixel data with stride(bytes-per-row) parameter
     static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator = 0);
+    // convenient construct from pixel data with stride(bytes-per-row) parameter, rows are split into bands across opt.num_threads
+    static Mat from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, const Option& opt);
     // convenient construct from pixel data and resize to specific size
     static Mat from_pixels_resize(const unsigned char* pixels, int type, int w, int h, int target_width, int target_height, Allocator* allocator = 0);
     // convenient construct from pixel data and resize to specific size with stride(bytes-per-row) parameter
@@ -269,11 +271,19 @@ public:
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
     // convenient construct from pixel data roi and resize to specific size with stride(bytes-per-row) parameter
     static Mat from_pixels_roi_resize(const unsigned char* pixels, int type, int w, int h, int stride, int roix, int roiy, int roiw, int roih, int target_width, int target_height, Allocator* allocator = 0);
+    // convenient construct from pixel data, resize, convert, substract mean and normalize in one pass, pass 0 to skip mean or norm
+    // elempack 1/4/8/16 must divide the channel count of the converted type
+    static Mat from_pixels_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack = 1, Allocator* allocator = 0);
+    // same as from_pixels_resize_normalize, but the image is resized to resize_width x resize_height and placed at left top of the target
+    // the border is filled with pad_value in pixel range before substracting mean and normalizing
+    static Mat from_pixels_letterbox_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, int resize_width, int resize_height, int left, int top, float pad_value, const float* mean_vals, const float* norm_vals, int elempack = 1, Allocator* allocator = 0);
 
     // convenient export to pixel data
     void to_pixels(unsigned char* pixels, int type) const;
     // convenient export to pixel data with stride(bytes-per-row) parameter
     void to_pixels(unsigned char* pixels, int type, int stride) const;
+    // convenient export to pixel data with stride(bytes-per-row) parameter, rows are split into bands across opt.num_threads
+    void to_pixels(unsigned char* pixels, int type, int stride, const Option& opt) const;
     // convenient export to pixel data and resize to specific size
     void to_pixels_resize(unsigned char* pixels, int type, int target_width, int target_height) const;
     // convenient export to pixel data and resize to specific size with stride(bytes-per-row) parameter
@@ -607,8 +617,12 @@ union vk_constant_type
 #if NCNN_PIXEL
 // convert yuv420sp(nv21) to rgb, the fast approximate version
 NCNN_EXPORT void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb);
+// convert yuv420sp(nv21) to rgb, row pairs are split into bands across opt.num_threads
+NCNN_EXPORT void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb, const Option& opt);
 // convert yuv420sp(nv12) to rgb, the fast approximate version
 NCNN_EXPORT void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb);
+// convert yuv420sp(nv12) to rgb, row pairs are split into bands across opt.num_threads
+NCNN_EXPORT void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb, const Option& opt);
 // convert yuv420sp(nv21) to rgb with half resize, the faster approximate version
 NCNN_EXPORT void yuv420sp2rgb_half(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb);
 // image pixel bilinear resize
@@ -646,6 +660,11 @@ NCNN_EXPORT void kanna_rotate_c1(const unsigned char* src, int srcw, int srch, i
 NCNN_EXPORT void kanna_rotate_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type);
 NCNN_EXPORT void kanna_rotate_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type);
 NCNN_EXPORT void kanna_rotate_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type);
+// image pixel kanna rotate with stride(bytes-per-row) parameter, source rows are split into bands across opt.num_threads
+NCNN_EXPORT void kanna_rotate_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt);
+NCNN_EXPORT void kanna_rotate_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt);
+NCNN_EXPORT void kanna_rotate_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt);
+NCNN_EXPORT void kanna_rotate_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt);
 // image pixel kanna rotate, convenient wrapper for yuv420sp(nv21/nv12)
 NCNN_EXPORT void kanna_rotate_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, int type);
 #endif // NCNN_PIXEL_ROTATE
@@ -666,6 +685,11 @@ NCNN_EXPORT void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int
 NCNN_EXPORT void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
 NCNN_EXPORT void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
 NCNN_EXPORT void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type = 0, unsigned int v = 0);
+// image pixel bilinear warpaffine inverse transform with stride(bytes-per-row) parameter, destination rows are split into bands across opt.num_threads
+NCNN_EXPORT void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
+NCNN_EXPORT void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt);
 // image pixel bilinear warpaffine, convenient wrapper for yuv420sp(nv21/nv12), set -233 for transparent border color, the color YUV_ is little-endian encoded
 NCNN_EXPORT void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type = 0, unsigned int v = 0);
 #endif // NCNN_PIXEL_AFFINE
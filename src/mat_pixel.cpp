@@ -8,11 +8,49 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include "platform.h"
 
 namespace ncnn {
 
 #if NCNN_PIXEL
+#if __SSE2__
+// 4 rgb pixels into the low 24bit of each 32bit lane, reads exactly 12 bytes
+static inline __m128i load_c3x4_sse2(const unsigned char* p)
+{
+    int tail;
+    memcpy(&tail, p + 8, 4);
+    __m128i _v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)p), _mm_cvtsi32_si128(tail));
+    __m128i _p01 = _mm_unpacklo_epi32(_v, _mm_srli_si128(_v, 3));
+    __m128i _p23 = _mm_unpacklo_epi32(_mm_srli_si128(_v, 6), _mm_srli_si128(_v, 9));
+    return _mm_unpacklo_epi64(_p01, _p23);
+}
+
+// the reverse of load_c3x4_sse2, writes exactly 12 bytes
+static inline void store_c3x4_sse2(unsigned char* p, __m128i _v)
+{
+    const __m128i _lo = _mm_set_epi32(0, 0x00ffffff, 0, 0x00ffffff);
+    const __m128i _hi = _mm_set_epi32(0x00ffffff, 0, 0x00ffffff, 0);
+    _v = _mm_or_si128(_mm_and_si128(_v, _lo), _mm_srli_epi64(_mm_and_si128(_v, _hi), 8));
+    _v = _mm_or_si128(_mm_move_epi64(_v), _mm_slli_si128(_mm_srli_si128(_v, 8), 6));
+    _mm_storel_epi64((__m128i*)p, _v);
+    int tail = _mm_cvtsi128_si32(_mm_srli_si128(_v, 8));
+    memcpy(p + 8, &tail, 4);
+}
+
+// truncate and saturate 4 pixels of 4 channels to u8, then interleave them as c0 c1 c2 c3 c0 c1 c2 c3 ...
+static inline __m128i pack_c4x4_sse2(__m128 _c0, __m128 _c1, __m128 _c2, __m128 _c3)
+{
+    __m128i _c01 = _mm_packs_epi32(_mm_cvttps_epi32(_c0), _mm_cvttps_epi32(_c1));
+    __m128i _c23 = _mm_packs_epi32(_mm_cvttps_epi32(_c2), _mm_cvttps_epi32(_c3));
+    __m128i _v = _mm_packus_epi16(_c01, _c23);
+    _v = _mm_unpacklo_epi8(_v, _mm_srli_si128(_v, 8));
+    return _mm_unpacklo_epi8(_v, _mm_srli_si128(_v, 8));
+}
+#endif // __SSE2__
+
 static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m, Allocator* allocator)
 {
     m.create(w, h, 3, 4u, allocator);
@@ -35,6 +73,9 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -107,6 +148,21 @@ static int from_rgb(const unsigned char* rgb, int w, int h, int stride, Mat& m,
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = load_c3x4_sse2(rgb);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+
+            rgb += 3 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -149,6 +205,9 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -179,6 +238,18 @@ static void to_rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr1 += 8;
             ptr2 += 8;
         }
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr0), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr2), _mm_setzero_ps());
+
+            store_c3x4_sse2(rgb, _p);
+
+            rgb += 3 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -217,6 +288,9 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 4;
         int remain = w - (nn << 4);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -272,6 +346,26 @@ static int from_gray(const unsigned char* gray, int w, int h, int stride, Mat& m
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _gray = _mm_loadu_si128((const __m128i*)gray);
+            __m128i _zero = _mm_setzero_si128();
+            __m128i _gray16_0 = _mm_unpacklo_epi8(_gray, _zero);
+            __m128i _gray16_1 = _mm_unpackhi_epi8(_gray, _zero);
+            __m128 _g0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_gray16_0, _zero));
+            __m128 _g1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_gray16_0, _zero));
+            __m128 _g2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_gray16_1, _zero));
+            __m128 _g3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_gray16_1, _zero));
+
+            _mm_storeu_ps(ptr, _g0);
+            _mm_storeu_ps(ptr + 4, _g1);
+            _mm_storeu_ps(ptr + 8, _g2);
+            _mm_storeu_ps(ptr + 12, _g3);
+
+            gray += 16;
+            ptr += 16;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -308,6 +402,9 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -327,6 +424,16 @@ static void to_gray(const Mat& m, unsigned char* gray, int stride)
             gray += 8;
             ptr += 8;
         }
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _g01 = _mm_packs_epi32(_mm_cvttps_epi32(_mm_loadu_ps(ptr)), _mm_cvttps_epi32(_mm_loadu_ps(ptr + 4)));
+            __m128i _g23 = _mm_packs_epi32(_mm_cvttps_epi32(_mm_loadu_ps(ptr + 8)), _mm_cvttps_epi32(_mm_loadu_ps(ptr + 12)));
+            _mm_storeu_si128((__m128i*)gray, _mm_packus_epi16(_g01, _g23));
+
+            gray += 16;
+            ptr += 16;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -364,6 +471,9 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -450,6 +560,23 @@ static int from_rgba(const unsigned char* rgba, int w, int h, int stride, Mat& m
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = _mm_loadu_si128((const __m128i*)rgba);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+            _mm_storeu_ps(ptr3, _mm_cvtepi32_ps(_mm_srli_epi32(_p, 24)));
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+            ptr3 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -495,6 +622,9 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -530,6 +660,19 @@ static void to_rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr2 += 8;
             ptr3 += 8;
         }
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr0), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr2), _mm_loadu_ps(ptr3));
+
+            _mm_storeu_si128((__m128i*)rgba, _p);
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+            ptr3 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -572,6 +715,9 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -644,6 +790,21 @@ static int from_rgb2bgr(const unsigned char* rgb, int w, int h, int stride, Mat&
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = load_c3x4_sse2(rgb);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+
+            rgb += 3 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -686,6 +847,9 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -716,6 +880,18 @@ static void to_bgr2rgb(const Mat& m, unsigned char* rgb, int stride)
             ptr1 += 8;
             ptr2 += 8;
         }
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr2), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr0), _mm_setzero_ps());
+
+            store_c3x4_sse2(rgb, _p);
+
+            rgb += 3 * 4;
+            ptr2 += 4;
+            ptr1 += 4;
+            ptr0 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -842,6 +1018,7 @@ static int from_rgb2rgba(const unsigned char* rgb, int w, int h, int stride, Mat
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_rgb(rgb, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -873,6 +1050,9 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -905,6 +1085,19 @@ static void to_rgb2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr1 += 8;
             ptr2 += 8;
         }
+#elif __SSE2__
+        const __m128 _v255 = _mm_set1_ps(255.f);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr0), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr2), _v255);
+
+            _mm_storeu_si128((__m128i*)rgba, _p);
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1032,6 +1225,7 @@ static int from_bgr2rgba(const unsigned char* bgr, int w, int h, int stride, Mat
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_rgb2bgr(bgr, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -1063,6 +1257,9 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1095,6 +1292,19 @@ static void to_bgr2rgba(const Mat& m, unsigned char* rgba, int stride)
             ptr1 += 8;
             ptr2 += 8;
         }
+#elif __SSE2__
+        const __m128 _v255 = _mm_set1_ps(255.f);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr2), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr0), _v255);
+
+            _mm_storeu_si128((__m128i*)rgba, _p);
+
+            rgba += 4 * 4;
+            ptr2 += 4;
+            ptr1 += 4;
+            ptr0 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1136,6 +1346,9 @@ static int from_gray2rgb(const unsigned char* gray, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 4;
         int remain = w - (nn << 4);
+#elif __SSE2__
+        int nn = w >> 4;
+        int remain = w - (nn << 4);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1211,6 +1424,36 @@ static int from_gray2rgb(const unsigned char* gray, int w, int h, int stride, Ma
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _gray = _mm_loadu_si128((const __m128i*)gray);
+            __m128i _zero = _mm_setzero_si128();
+            __m128i _gray16_0 = _mm_unpacklo_epi8(_gray, _zero);
+            __m128i _gray16_1 = _mm_unpackhi_epi8(_gray, _zero);
+            __m128 _g0 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_gray16_0, _zero));
+            __m128 _g1 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_gray16_0, _zero));
+            __m128 _g2 = _mm_cvtepi32_ps(_mm_unpacklo_epi16(_gray16_1, _zero));
+            __m128 _g3 = _mm_cvtepi32_ps(_mm_unpackhi_epi16(_gray16_1, _zero));
+
+            _mm_storeu_ps(ptr0, _g0);
+            _mm_storeu_ps(ptr0 + 4, _g1);
+            _mm_storeu_ps(ptr0 + 8, _g2);
+            _mm_storeu_ps(ptr0 + 12, _g3);
+            _mm_storeu_ps(ptr1, _g0);
+            _mm_storeu_ps(ptr1 + 4, _g1);
+            _mm_storeu_ps(ptr1 + 8, _g2);
+            _mm_storeu_ps(ptr1 + 12, _g3);
+            _mm_storeu_ps(ptr2, _g0);
+            _mm_storeu_ps(ptr2 + 4, _g1);
+            _mm_storeu_ps(ptr2 + 8, _g2);
+            _mm_storeu_ps(ptr2 + 12, _g3);
+
+            gray += 16;
+            ptr0 += 16;
+            ptr1 += 16;
+            ptr2 += 16;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1237,6 +1480,7 @@ static int from_gray2rgba(const unsigned char* gray, int w, int h, int stride, M
         return -100;
 
     Mat rgb_channels = m.channel_range(0, 3);
+    rgb_channels.cstep = m.cstep;
     from_gray2rgb(gray, w, h, stride, rgb_channels, allocator);
 
     Mat alpha_channel = m.channel(3);
@@ -1266,6 +1510,9 @@ static void to_gray2rgba(const Mat& m, unsigned char* rgba, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1292,6 +1539,18 @@ static void to_gray2rgba(const Mat& m, unsigned char* rgba, int stride)
             rgba += 4 * 8;
             ptr += 8;
         }
+#elif __SSE2__
+        const __m128 _v255 = _mm_set1_ps(255.f);
+        for (; nn > 0; nn--)
+        {
+            __m128 _g = _mm_loadu_ps(ptr);
+            __m128i _p = pack_c4x4_sse2(_g, _g, _g, _v255);
+
+            _mm_storeu_si128((__m128i*)rgba, _p);
+
+            rgba += 4 * 4;
+            ptr += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1332,6 +1591,9 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1404,6 +1666,21 @@ static int from_rgba2rgb(const unsigned char* rgba, int w, int h, int stride, Ma
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = _mm_loadu_si128((const __m128i*)rgba);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1445,6 +1722,9 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1517,6 +1797,21 @@ static int from_rgba2bgr(const unsigned char* rgba, int w, int h, int stride, Ma
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = _mm_loadu_si128((const __m128i*)rgba);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1660,6 +1955,9 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1746,6 +2044,23 @@ static int from_rgba2bgra(const unsigned char* rgba, int w, int h, int stride, M
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        const __m128i _v255 = _mm_set1_epi32(255);
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = _mm_loadu_si128((const __m128i*)rgba);
+
+            _mm_storeu_ps(ptr0, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 16), _v255)));
+            _mm_storeu_ps(ptr1, _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(_p, 8), _v255)));
+            _mm_storeu_ps(ptr2, _mm_cvtepi32_ps(_mm_and_si128(_p, _v255)));
+            _mm_storeu_ps(ptr3, _mm_cvtepi32_ps(_mm_srli_epi32(_p, 24)));
+
+            rgba += 4 * 4;
+            ptr0 += 4;
+            ptr1 += 4;
+            ptr2 += 4;
+            ptr3 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1791,6 +2106,9 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 2;
+        int remain = w - (nn << 2);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -1826,6 +2144,19 @@ static void to_rgba2bgra(const Mat& m, unsigned char* bgra, int stride)
             ptr2 += 8;
             ptr3 += 8;
         }
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _p = pack_c4x4_sse2(_mm_loadu_ps(ptr2), _mm_loadu_ps(ptr1), _mm_loadu_ps(ptr0), _mm_loadu_ps(ptr3));
+
+            _mm_storeu_si128((__m128i*)bgra, _p);
+
+            bgra += 4 * 4;
+            ptr2 += 4;
+            ptr1 += 4;
+            ptr0 += 4;
+            ptr3 += 4;
+        }
 #endif // __ARM_NEON
         for (; remain > 0; remain--)
         {
@@ -1947,10 +2278,36 @@ static int from_bgra2gray(const unsigned char* bgra, int w, int h, int stride, M
     return 0;
 }
 
-void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb)
+#if __SSE2__
+// 8 pixels of two rows sharing the same chroma, _vv and _uu are 16bit lanes already centered at zero
+static inline void yuv2rgb_8x2_sse2(const unsigned char* yptr0, const unsigned char* yptr1, __m128i _vv, __m128i _uu, unsigned char* rgb0, unsigned char* rgb1)
+{
+    __m128i _zero = _mm_setzero_si128();
+
+    __m128i _ruv = _mm_mullo_epi16(_vv, _mm_set1_epi16(90));
+    __m128i _guv = _mm_add_epi16(_mm_mullo_epi16(_vv, _mm_set1_epi16(-46)), _mm_mullo_epi16(_uu, _mm_set1_epi16(-22)));
+    __m128i _buv = _mm_mullo_epi16(_uu, _mm_set1_epi16(113));
+
+    for (int i = 0; i < 2; i++)
+    {
+        __m128i _yy = _mm_slli_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(i == 0 ? yptr0 : yptr1)), _zero), 6);
+
+        __m128i _r = _mm_srai_epi16(_mm_add_epi16(_yy, _ruv), 6);
+        __m128i _g = _mm_srai_epi16(_mm_add_epi16(_yy, _guv), 6);
+        __m128i _b = _mm_srai_epi16(_mm_add_epi16(_yy, _buv), 6);
+
+        __m128i _rg = _mm_unpacklo_epi8(_mm_packus_epi16(_r, _r), _mm_packus_epi16(_g, _g));
+        __m128i _b0 = _mm_unpacklo_epi8(_mm_packus_epi16(_b, _b), _zero);
+
+        unsigned char* rgb = i == 0 ? rgb0 : rgb1;
+        store_c3x4_sse2(rgb, _mm_unpacklo_epi16(_rg, _b0));
+        store_c3x4_sse2(rgb + 12, _mm_unpackhi_epi16(_rg, _b0));
+    }
+}
+#endif // __SSE2__
+
+static void yuv420sp2rgb_rows(const unsigned char* yptr, const unsigned char* vuptr, int w, int h, unsigned char* rgb)
 {
-    const unsigned char* yptr = yuv420sp;
-    const unsigned char* vuptr = yuv420sp + w * h;
 
 #if __ARM_NEON
     uint8x8_t _v128 = vdup_n_u8(128);
@@ -1970,6 +2327,9 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 3;
+        int remain = w - (nn << 3);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -2073,6 +2433,22 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12", "d26");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _vvuu = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)vuptr), _mm_setzero_si128()), _mm_set1_epi16(128));
+            __m128i _lo16 = _mm_set1_epi32(0xffff);
+            __m128i _vv = _mm_or_si128(_mm_and_si128(_vvuu, _lo16), _mm_slli_epi32(_vvuu, 16));
+            __m128i _uu = _mm_or_si128(_mm_srli_epi32(_vvuu, 16), _mm_andnot_si128(_lo16, _vvuu));
+
+            yuv2rgb_8x2_sse2(yptr0, yptr1, _vv, _uu, rgb0, rgb1);
+
+            yptr0 += 8;
+            yptr1 += 8;
+            vuptr += 8;
+            rgb0 += 24;
+            rgb1 += 24;
+        }
 #endif // __ARM_NEON
 
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
@@ -2138,10 +2514,33 @@ void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rg
     }
 }
 
-void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb)
+void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb)
+{
+    yuv420sp2rgb_rows(yuv420sp, yuv420sp + w * h, w, h, rgb);
+}
+
+void yuv420sp2rgb(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb, const Option& opt)
+{
+    // bands of whole row pairs, so that every band owns its chroma rows
+    const int nbands = std::min(opt.num_threads, h / 2);
+    if (nbands <= 1)
+    {
+        yuv420sp2rgb_rows(yuv420sp, yuv420sp + w * h, w, h, rgb);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        const int y0 = h / 2 * i / nbands * 2;
+        const int y1 = i + 1 == nbands ? h : h / 2 * (i + 1) / nbands * 2;
+
+        yuv420sp2rgb_rows(yuv420sp + (size_t)w * y0, yuv420sp + (size_t)w * h + (size_t)w * (y0 / 2), w, y1 - y0, rgb + (size_t)w * 3 * y0);
+    }
+}
+
+static void yuv420sp2rgb_nv12_rows(const unsigned char* yptr, const unsigned char* uvptr, int w, int h, unsigned char* rgb)
 {
-    const unsigned char* yptr = yuv420sp;
-    const unsigned char* uvptr = yuv420sp + w * h;
 
 #if __ARM_NEON
     uint8x8_t _v128 = vdup_n_u8(128);
@@ -2161,6 +2560,9 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
 #if __ARM_NEON
         int nn = w >> 3;
         int remain = w - (nn << 3);
+#elif __SSE2__
+        int nn = w >> 3;
+        int remain = w - (nn << 3);
 #else
         int remain = w;
 #endif // __ARM_NEON
@@ -2264,6 +2666,22 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
                 : "cc", "memory", "q0", "q1", "q2", "q3", "q8", "q9", "q10", "q11", "q12", "d26");
         }
 #endif // __aarch64__
+#elif __SSE2__
+        for (; nn > 0; nn--)
+        {
+            __m128i _uuvv = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)uvptr), _mm_setzero_si128()), _mm_set1_epi16(128));
+            __m128i _lo16 = _mm_set1_epi32(0xffff);
+            __m128i _uu = _mm_or_si128(_mm_and_si128(_uuvv, _lo16), _mm_slli_epi32(_uuvv, 16));
+            __m128i _vv = _mm_or_si128(_mm_srli_epi32(_uuvv, 16), _mm_andnot_si128(_lo16, _uuvv));
+
+            yuv2rgb_8x2_sse2(yptr0, yptr1, _vv, _uu, rgb0, rgb1);
+
+            yptr0 += 8;
+            yptr1 += 8;
+            uvptr += 8;
+            rgb0 += 24;
+            rgb1 += 24;
+        }
 #endif // __ARM_NEON
 
 #define SATURATE_CAST_UCHAR(X) (unsigned char)::std::min(::std::max((int)(X), 0), 255);
@@ -2329,6 +2747,31 @@ void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned cha
     }
 }
 
+void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb)
+{
+    yuv420sp2rgb_nv12_rows(yuv420sp, yuv420sp + w * h, w, h, rgb);
+}
+
+void yuv420sp2rgb_nv12(const unsigned char* yuv420sp, int w, int h, unsigned char* rgb, const Option& opt)
+{
+    // bands of whole row pairs, so that every band owns its chroma rows
+    const int nbands = std::min(opt.num_threads, h / 2);
+    if (nbands <= 1)
+    {
+        yuv420sp2rgb_nv12_rows(yuv420sp, yuv420sp + w * h, w, h, rgb);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        const int y0 = h / 2 * i / nbands * 2;
+        const int y1 = i + 1 == nbands ? h : h / 2 * (i + 1) / nbands * 2;
+
+        yuv420sp2rgb_nv12_rows(yuv420sp + (size_t)w * y0, yuv420sp + (size_t)w * h + (size_t)w * (y0 / 2), w, y1 - y0, rgb + (size_t)w * 3 * y0);
+    }
+}
+
 void yuv420sp2rgb_half(const unsigned char* yuv, int w, int h, unsigned char* rgb)
 {
     const unsigned char* puv = yuv + w * h;
@@ -2448,56 +2891,54 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, Alloca
     return Mat();
 }
 
-Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator)
+static void from_pixels_convert(const unsigned char* pixels, int type, int w, int h, int stride, Mat& m, Allocator* allocator)
 {
-    Mat m;
-
-    if (type & PIXEL_CONVERT_MASK)
+    if (type & Mat::PIXEL_CONVERT_MASK)
     {
         switch (type)
         {
-        case PIXEL_RGB2BGR:
-        case PIXEL_BGR2RGB:
+        case Mat::PIXEL_RGB2BGR:
+        case Mat::PIXEL_BGR2RGB:
             from_rgb2bgr(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGB2GRAY:
+        case Mat::PIXEL_RGB2GRAY:
             from_rgb2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGB2RGBA:
-        case PIXEL_BGR2BGRA:
+        case Mat::PIXEL_RGB2RGBA:
+        case Mat::PIXEL_BGR2BGRA:
             from_rgb2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGR2GRAY:
+        case Mat::PIXEL_BGR2GRAY:
             from_bgr2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGR2RGBA:
-        case PIXEL_RGB2BGRA:
+        case Mat::PIXEL_BGR2RGBA:
+        case Mat::PIXEL_RGB2BGRA:
             from_bgr2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_GRAY2RGB:
-        case PIXEL_GRAY2BGR:
+        case Mat::PIXEL_GRAY2RGB:
+        case Mat::PIXEL_GRAY2BGR:
             from_gray2rgb(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_GRAY2RGBA:
-        case PIXEL_GRAY2BGRA:
+        case Mat::PIXEL_GRAY2RGBA:
+        case Mat::PIXEL_GRAY2BGRA:
             from_gray2rgba(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2RGB:
-        case PIXEL_BGRA2BGR:
+        case Mat::PIXEL_RGBA2RGB:
+        case Mat::PIXEL_BGRA2BGR:
             from_rgba2rgb(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2BGR:
-        case PIXEL_BGRA2RGB:
+        case Mat::PIXEL_RGBA2BGR:
+        case Mat::PIXEL_BGRA2RGB:
             from_rgba2bgr(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2GRAY:
+        case Mat::PIXEL_RGBA2GRAY:
             from_rgba2gray(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_RGBA2BGRA:
-        case PIXEL_BGRA2RGBA:
+        case Mat::PIXEL_RGBA2BGRA:
+        case Mat::PIXEL_BGRA2RGBA:
             from_rgba2bgra(pixels, w, h, stride, m, allocator);
             break;
-        case PIXEL_BGRA2GRAY:
+        case Mat::PIXEL_BGRA2GRAY:
             from_bgra2gray(pixels, w, h, stride, m, allocator);
             break;
         default:
@@ -2508,15 +2949,22 @@ Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int st
     }
     else
     {
-        if (type == PIXEL_RGB || type == PIXEL_BGR)
+        if (type == Mat::PIXEL_RGB || type == Mat::PIXEL_BGR)
             from_rgb(pixels, w, h, stride, m, allocator);
 
-        if (type == PIXEL_GRAY)
+        if (type == Mat::PIXEL_GRAY)
             from_gray(pixels, w, h, stride, m, allocator);
 
-        if (type == PIXEL_RGBA || type == PIXEL_BGRA)
+        if (type == Mat::PIXEL_RGBA || type == Mat::PIXEL_BGRA)
             from_rgba(pixels, w, h, stride, m, allocator);
     }
+}
+
+Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, Allocator* allocator)
+{
+    Mat m;
+
+    from_pixels_convert(pixels, type, w, h, stride, m, allocator);
 
     return m;
 }
@@ -2689,6 +3137,369 @@ Mat Mat::from_pixels_roi_resize(const unsigned char* pixels, int type, int w, in
     return Mat();
 }
 
+static int pixel_type_channels(int type)
+{
+    if (type == Mat::PIXEL_RGB || type == Mat::PIXEL_BGR)
+        return 3;
+    if (type == Mat::PIXEL_GRAY)
+        return 1;
+    if (type == Mat::PIXEL_RGBA || type == Mat::PIXEL_BGRA)
+        return 4;
+    return 0;
+}
+
+// rows [y0, y0 + rows) of every channel of m, sharing its data and channel step
+static Mat pixel_rows(const Mat& m, int y0, int rows)
+{
+    Mat band(m.w, rows, m.c, (unsigned char*)m.data + (size_t)m.w * y0 * m.elemsize, m.elemsize, m.allocator);
+    band.cstep = m.cstep;
+    return band;
+}
+
+Mat Mat::from_pixels(const unsigned char* pixels, int type, int w, int h, int stride, const Option& opt)
+{
+    const int type_from = type & PIXEL_FORMAT_MASK;
+    const int type_to = (type & PIXEL_CONVERT_MASK) ? (type >> PIXEL_CONVERT_SHIFT) : type_from;
+    const int channels = pixel_type_channels(type_to);
+
+    const int nbands = std::min(opt.num_threads, h);
+    if (nbands <= 1 || channels == 0 || pixel_type_channels(type_from) == 0)
+        return Mat::from_pixels(pixels, type, w, h, stride, opt.blob_allocator);
+
+    Mat m;
+    m.create(w, h, channels, 4u, opt.blob_allocator);
+    if (m.empty())
+        return m;
+
+    // every band converts into its own rows of m
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        const int y0 = h * i / nbands;
+        const int y1 = h * (i + 1) / nbands;
+
+        Mat band = pixel_rows(m, y0, y1 - y0);
+        from_pixels_convert(pixels + (size_t)stride * y0, type, w, y1 - y0, stride, band, opt.blob_allocator);
+    }
+
+    return m;
+}
+
+void Mat::to_pixels(unsigned char* pixels, int type, int stride, const Option& opt) const
+{
+    const int nbands = std::min(opt.num_threads, h);
+    if (nbands <= 1)
+    {
+        to_pixels(pixels, type, stride);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        const int y0 = h * i / nbands;
+        const int y1 = h * (i + 1) / nbands;
+
+        pixel_rows(*this, y0, y1 - y0).to_pixels(pixels + (size_t)stride * y0, type, stride);
+    }
+}
+
+// bilinear interpolate one source row horizontally into cn float planes of dstw
+static void resize_bilinear_row_u8(const unsigned char* row, int cn, const int* xofs, const float* alpha, int dstw, float* out)
+{
+    if (cn == 1)
+    {
+        for (int dx = 0; dx < dstw; dx++)
+        {
+            const float p0 = row[xofs[dx * 2]];
+            const float p1 = row[xofs[dx * 2 + 1]];
+            out[dx] = p0 + (p1 - p0) * alpha[dx];
+        }
+    }
+    if (cn == 3)
+    {
+        float* out0 = out;
+        float* out1 = out + dstw;
+        float* out2 = out + dstw * 2;
+        for (int dx = 0; dx < dstw; dx++)
+        {
+            const unsigned char* p0 = row + xofs[dx * 2] * 3;
+            const unsigned char* p1 = row + xofs[dx * 2 + 1] * 3;
+            const float a1 = alpha[dx];
+            out0[dx] = p0[0] + (p1[0] - p0[0]) * a1;
+            out1[dx] = p0[1] + (p1[1] - p0[1]) * a1;
+            out2[dx] = p0[2] + (p1[2] - p0[2]) * a1;
+        }
+    }
+    if (cn == 4)
+    {
+        float* out0 = out;
+        float* out1 = out + dstw;
+        float* out2 = out + dstw * 2;
+        float* out3 = out + dstw * 3;
+        for (int dx = 0; dx < dstw; dx++)
+        {
+            const unsigned char* p0 = row + xofs[dx * 2] * 4;
+            const unsigned char* p1 = row + xofs[dx * 2 + 1] * 4;
+            const float a1 = alpha[dx];
+            out0[dx] = p0[0] + (p1[0] - p0[0]) * a1;
+            out1[dx] = p0[1] + (p1[1] - p0[1]) * a1;
+            out2[dx] = p0[2] + (p1[2] - p0[2]) * a1;
+            out3[dx] = p0[3] + (p1[3] - p0[3]) * a1;
+        }
+    }
+}
+
+static int from_pixels_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, int resize_width, int resize_height, int left, int top, float pad_value, const float* mean_vals, const float* norm_vals, int elempack, Mat& m, Allocator* allocator)
+{
+    const int type_from = type & Mat::PIXEL_FORMAT_MASK;
+    const int type_to = (type & Mat::PIXEL_CONVERT_MASK) ? (type >> Mat::PIXEL_CONVERT_SHIFT) : type_from;
+
+    const int cn = pixel_type_channels(type_from);
+    const int outc = pixel_type_channels(type_to);
+    if (cn == 0 || outc == 0)
+    {
+        NCNN_LOGE("unknown convert type %d", type);
+        return -1;
+    }
+
+    if (elempack != 1 && elempack != 4 && elempack != 8 && elempack != 16)
+    {
+        NCNN_LOGE("unsupported elempack %d", elempack);
+        return -1;
+    }
+
+    if (outc % elempack != 0)
+    {
+        NCNN_LOGE("elempack %d does not divide %d channels", elempack, outc);
+        return -1;
+    }
+
+    if (w <= 0 || h <= 0 || resize_width <= 0 || resize_height <= 0 || left < 0 || top < 0 || left + resize_width > target_width || top + resize_height > target_height)
+    {
+        NCNN_LOGE("resize %d %d at %d %d out of target %d %d", resize_width, resize_height, left, top, target_width, target_height);
+        return -1;
+    }
+
+    m.create(target_width, target_height, outc / elempack, (size_t)4u * elempack, elempack, allocator);
+    if (m.empty())
+        return -100;
+
+    // every output channel picks a source channel, or the gray mix of r g b, or opaque alpha
+    const bool bgr_from = type_from == Mat::PIXEL_BGR || type_from == Mat::PIXEL_BGRA;
+    const bool bgr_to = type_to == Mat::PIXEL_BGR || type_to == Mat::PIXEL_BGRA;
+
+    int cmap[4];
+    for (int c = 0; c < outc; c++)
+    {
+        if (cn == 1)
+            cmap[c] = c == 3 ? -2 : 0;
+        else if (outc == 1)
+            cmap[c] = -1;
+        else if (c == 3)
+            cmap[c] = cn == 4 ? 3 : -2;
+        else
+            cmap[c] = bgr_from == bgr_to ? c : 2 - c;
+    }
+
+    // coeffs for r g b = 0.299f, 0.587f, 0.114f, the same as from_rgb2gray
+    const int r_index = bgr_from ? 2 : 0;
+    const int b_index = bgr_from ? 0 : 2;
+    const float R2Y = 77 / 256.f;
+    const float G2Y = 150 / 256.f;
+    const float B2Y = 29 / 256.f;
+
+    // substract mean and normalize folded into one multiply add
+    float scales[4];
+    float biases[4];
+    for (int c = 0; c < outc; c++)
+    {
+        scales[c] = norm_vals ? norm_vals[c] : 1.f;
+        biases[c] = mean_vals ? -mean_vals[c] * scales[c] : 0.f;
+    }
+
+    // source columns and weights, opencv style pixel center alignment
+    std::vector<int> xofs(resize_width * 2);
+    std::vector<float> alpha(resize_width);
+    {
+        const double scale_x = (double)w / resize_width;
+        for (int dx = 0; dx < resize_width; dx++)
+        {
+            float fx = (float)((dx + 0.5) * scale_x - 0.5);
+            int sx = static_cast<int>(floor(fx));
+            fx -= sx;
+
+            if (sx < 0)
+            {
+                sx = 0;
+                fx = 0.f;
+            }
+            if (sx >= w - 1)
+            {
+                sx = w - 1;
+                fx = 0.f;
+            }
+
+            xofs[dx * 2] = sx;
+            xofs[dx * 2 + 1] = std::min(sx + 1, w - 1);
+            alpha[dx] = fx;
+        }
+    }
+
+    // two horizontally resized source rows, reused while walking down
+    std::vector<float> rowsbuf0(resize_width * cn);
+    std::vector<float> rowsbuf1(resize_width * cn);
+    float* rows0 = &rowsbuf0[0];
+    float* rows1 = &rowsbuf1[0];
+    int prev_sy0 = -1;
+    int prev_sy1 = -1;
+
+    const double scale_y = (double)h / resize_height;
+
+    for (int y = 0; y < target_height; y++)
+    {
+        const int dy = y - top;
+        const bool inside = dy >= 0 && dy < resize_height;
+
+        if (inside)
+        {
+            float fy = (float)((dy + 0.5) * scale_y - 0.5);
+            int sy = static_cast<int>(floor(fy));
+            fy -= sy;
+
+            if (sy < 0)
+            {
+                sy = 0;
+                fy = 0.f;
+            }
+            if (sy >= h - 1)
+            {
+                sy = h - 1;
+                fy = 0.f;
+            }
+
+            const int sy0 = sy;
+            const int sy1 = std::min(sy + 1, h - 1);
+
+            if (sy0 != prev_sy0 || sy1 != prev_sy1)
+            {
+                if (sy0 == prev_sy1)
+                {
+                    std::swap(rows0, rows1);
+                }
+                else
+                {
+                    resize_bilinear_row_u8(pixels + (size_t)stride * sy0, cn, &xofs[0], &alpha[0], resize_width, rows0);
+                }
+
+                resize_bilinear_row_u8(pixels + (size_t)stride * sy1, cn, &xofs[0], &alpha[0], resize_width, rows1);
+
+                prev_sy0 = sy0;
+                prev_sy1 = sy1;
+            }
+
+            // vertical blend, color conversion, mean and norm, written straight into the packed output
+            for (int c = 0; c < outc; c++)
+            {
+                float* outptr = m.channel(c / elempack).row(y);
+                outptr += (c % elempack) + left * elempack;
+
+                const float b0 = (1.f - fy) * scales[c];
+                const float b1 = fy * scales[c];
+                const float bias = biases[c];
+
+                const int s = cmap[c];
+                if (s >= 0 && elempack == 1)
+                {
+                    // contiguous, let the compiler vectorize
+                    const float* r0 = rows0 + s * resize_width;
+                    const float* r1 = rows1 + s * resize_width;
+                    for (int dx = 0; dx < resize_width; dx++)
+                    {
+                        outptr[dx] = r0[dx] * b0 + r1[dx] * b1 + bias;
+                    }
+                }
+                else if (s >= 0)
+                {
+                    const float* r0 = rows0 + s * resize_width;
+                    const float* r1 = rows1 + s * resize_width;
+                    for (int dx = 0; dx < resize_width; dx++)
+                    {
+                        outptr[dx * elempack] = r0[dx] * b0 + r1[dx] * b1 + bias;
+                    }
+                }
+                else if (s == -1)
+                {
+                    const float* r0r = rows0 + r_index * resize_width;
+                    const float* r0g = rows0 + resize_width;
+                    const float* r0b = rows0 + b_index * resize_width;
+                    const float* r1r = rows1 + r_index * resize_width;
+                    const float* r1g = rows1 + resize_width;
+                    const float* r1b = rows1 + b_index * resize_width;
+                    for (int dx = 0; dx < resize_width; dx++)
+                    {
+                        const float v0 = r0r[dx] * R2Y + r0g[dx] * G2Y + r0b[dx] * B2Y;
+                        const float v1 = r1r[dx] * R2Y + r1g[dx] * G2Y + r1b[dx] * B2Y;
+                        outptr[dx * elempack] = v0 * b0 + v1 * b1 + bias;
+                    }
+                }
+                else
+                {
+                    const float v = 255.f * scales[c] + bias;
+                    for (int dx = 0; dx < resize_width; dx++)
+                    {
+                        outptr[dx * elempack] = v;
+                    }
+                }
+            }
+        }
+
+        // letterbox border
+        for (int c = 0; c < outc; c++)
+        {
+            float* outptr = m.channel(c / elempack).row(y);
+            outptr += c % elempack;
+
+            const float pad = pad_value * scales[c] + biases[c];
+
+            if (inside)
+            {
+                for (int x = 0; x < left; x++)
+                {
+                    outptr[x * elempack] = pad;
+                }
+                for (int x = left + resize_width; x < target_width; x++)
+                {
+                    outptr[x * elempack] = pad;
+                }
+            }
+            else
+            {
+                for (int x = 0; x < target_width; x++)
+                {
+                    outptr[x * elempack] = pad;
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
+Mat Mat::from_pixels_resize_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, const float* mean_vals, const float* norm_vals, int elempack, Allocator* allocator)
+{
+    Mat m;
+    from_pixels_normalize(pixels, type, w, h, stride, target_width, target_height, target_width, target_height, 0, 0, 0.f, mean_vals, norm_vals, elempack, m, allocator);
+    return m;
+}
+
+Mat Mat::from_pixels_letterbox_normalize(const unsigned char* pixels, int type, int w, int h, int stride, int target_width, int target_height, int resize_width, int resize_height, int left, int top, float pad_value, const float* mean_vals, const float* norm_vals, int elempack, Allocator* allocator)
+{
+    Mat m;
+    from_pixels_normalize(pixels, type, w, h, stride, target_width, target_height, resize_width, resize_height, left, top, pad_value, mean_vals, norm_vals, elempack, m, allocator);
+    return m;
+}
+
 void Mat::to_pixels(unsigned char* pixels, int type) const
 {
     int type_to = (type & PIXEL_CONVERT_MASK) ? (type >> PIXEL_CONVERT_SHIFT) : (type & PIXEL_FORMAT_MASK);
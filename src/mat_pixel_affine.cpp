@@ -5,6 +5,9 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include <limits.h>
 
 #include "platform.h"
@@ -12,6 +15,52 @@
 namespace ncnn {
 
 #if NCNN_PIXEL_AFFINE
+#if __SSE2__
+// both source pixels of a bilinear pair as interleaved 16bit lanes, p0c0 p1c0 p0c1 p1c1 ...
+static inline __m128i load_pixel_pair_c2_sse2(const unsigned char* p)
+{
+    int v;
+    memcpy(&v, p, 4);
+    __m128i _v = _mm_unpacklo_epi8(_mm_cvtsi32_si128(v), _mm_setzero_si128());
+    return _mm_unpacklo_epi16(_v, _mm_srli_si128(_v, 4));
+}
+
+static inline __m128i load_pixel_pair_c3_sse2(const unsigned char* p)
+{
+    unsigned char tmp[8] = {0};
+    memcpy(tmp, p, 6);
+    __m128i _v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)tmp), _mm_setzero_si128());
+    return _mm_unpacklo_epi16(_v, _mm_srli_si128(_v, 6));
+}
+
+static inline __m128i load_pixel_pair_c4_sse2(const unsigned char* p)
+{
+    __m128i _v = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)p), _mm_setzero_si128());
+    return _mm_unpacklo_epi16(_v, _mm_srli_si128(_v, 8));
+}
+
+// weight pair 1024 - f and f as interleaved 16bit lanes
+static inline __m128i bilinear_weight_pair_sse2(__m128i _f)
+{
+    return _mm_or_si128(_mm_sub_epi32(_mm_set1_epi32(1 << 10), _f), _mm_slli_epi32(_f, 16));
+}
+
+// same rounding as the scalar path, ((a * alpha >> 5) * beta) >> 15 in every 32bit lane
+static inline __m128i bilinear_blend_sse2(__m128i _a, __m128i _b, __m128i _alpha, __m128i _beta)
+{
+    __m128i _ra = _mm_srli_epi32(_mm_madd_epi16(_a, _alpha), 5);
+    __m128i _rb = _mm_srli_epi32(_mm_madd_epi16(_b, _alpha), 5);
+    __m128i _rab = _mm_or_si128(_ra, _mm_slli_epi32(_rb, 16));
+    return _mm_srli_epi32(_mm_madd_epi16(_rab, _beta), 15);
+}
+
+static inline int bilinear_pack_u8_sse2(__m128i _v)
+{
+    _v = _mm_packs_epi32(_v, _v);
+    return _mm_cvtsi128_si32(_mm_packus_epi16(_v, _v));
+}
+#endif // __SSE2__
+
 void get_rotation_matrix(float angle, float scale, float dx, float dy, float* tm)
 {
     angle *= (float)(3.14159265358979323846 / 180);
@@ -160,13 +209,13 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, unsign
     return warpaffine_bilinear_c4(src, srcw, srch, srcw * 4, dst, w, h, w * 4, tm, type, v);
 }
 
-void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+static void warpaffine_bilinear_c1_rows(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int stride, const float* tm, int type, unsigned int v, int ystart, int yend)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
     const int wgap = stride - w;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
+    unsigned char* dst0 = dst + (size_t)stride * ystart;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -179,8 +228,8 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    int y = ystart;
+    for (; y < yend; y++)
     {
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
@@ -287,6 +336,41 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 
                 vst1_u8(dst0, _dst);
 
+                dst0 += 8;
+#elif __SSE2__
+                __m128i _Xl = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)(adelta.data() + x)));
+                __m128i _Xh = _mm_add_epi32(_mm_set1_epi32(X0), _mm_loadu_si128((const __m128i*)(adelta.data() + x + 4)));
+                __m128i _Yl = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)(bdelta.data() + x)));
+                __m128i _Yh = _mm_add_epi32(_mm_set1_epi32(Y0), _mm_loadu_si128((const __m128i*)(bdelta.data() + x + 4)));
+
+                __m128i _v1024m1 = _mm_set1_epi32((1 << 10) - 1);
+                __m128i _alphal = bilinear_weight_pair_sse2(_mm_and_si128(_Xl, _v1024m1));
+                __m128i _alphah = bilinear_weight_pair_sse2(_mm_and_si128(_Xh, _v1024m1));
+                __m128i _betal = bilinear_weight_pair_sse2(_mm_and_si128(_Yl, _v1024m1));
+                __m128i _betah = bilinear_weight_pair_sse2(_mm_and_si128(_Yh, _v1024m1));
+
+                unsigned short a0a1[8];
+                unsigned short b0b1[8];
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10);
+                    memcpy(a0a1 + xi, a0, 2);
+                    memcpy(b0b1 + xi, a0 + srcstride, 2);
+                }
+
+                __m128i _a0a1 = _mm_loadu_si128((const __m128i*)a0a1);
+                __m128i _b0b1 = _mm_loadu_si128((const __m128i*)b0b1);
+
+                __m128i _zero = _mm_setzero_si128();
+                __m128i _dstl = bilinear_blend_sse2(_mm_unpacklo_epi8(_a0a1, _zero), _mm_unpacklo_epi8(_b0b1, _zero), _alphal, _betal);
+                __m128i _dsth = bilinear_blend_sse2(_mm_unpackhi_epi8(_a0a1, _zero), _mm_unpackhi_epi8(_b0b1, _zero), _alphah, _betah);
+
+                __m128i _dst = _mm_packs_epi32(_dstl, _dsth);
+                _mm_storel_epi64((__m128i*)dst0, _mm_packus_epi16(_dst, _dst));
+
                 dst0 += 8;
 #else
                 for (int xi = 0; xi < 8; xi++)
@@ -465,13 +549,13 @@ void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int sr
 #undef SATURATE_CAST_INT
 }
 
-void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+static void warpaffine_bilinear_c2_rows(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int stride, const float* tm, int type, unsigned int v, int ystart, int yend)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
     const int wgap = stride - w * 2;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
+    unsigned char* dst0 = dst + (size_t)stride * ystart;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -484,8 +568,8 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    int y = ystart;
+    for (; y < yend; y++)
     {
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
@@ -606,6 +690,27 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
                 vst2_u8(dst0, _dst);
 
                 dst0 += 2 * 8;
+#elif __SSE2__
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    short fx = X & ((1 << 10) - 1);
+                    short fy = Y & ((1 << 10) - 1);
+
+                    __m128i _alpha = bilinear_weight_pair_sse2(_mm_set1_epi32(fx));
+                    __m128i _beta = bilinear_weight_pair_sse2(_mm_set1_epi32(fy));
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10) * 2;
+
+                    __m128i _dst = bilinear_blend_sse2(load_pixel_pair_c2_sse2(a0), load_pixel_pair_c2_sse2(a0 + srcstride), _alpha, _beta);
+
+                    int p = bilinear_pack_u8_sse2(_dst);
+                    memcpy(dst0, &p, 2);
+
+                    dst0 += 2;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -792,13 +897,13 @@ void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int sr
 #undef SATURATE_CAST_INT
 }
 
-void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+static void warpaffine_bilinear_c3_rows(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int stride, const float* tm, int type, unsigned int v, int ystart, int yend)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
     const int wgap = stride - w * 3;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
+    unsigned char* dst0 = dst + (size_t)stride * ystart;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -811,8 +916,8 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    int y = ystart;
+    for (; y < yend; y++)
     {
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
@@ -966,6 +1071,27 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
                 vst3_u8(dst0, _dst);
 
                 dst0 += 3 * 8;
+#elif __SSE2__
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    short fx = X & ((1 << 10) - 1);
+                    short fy = Y & ((1 << 10) - 1);
+
+                    __m128i _alpha = bilinear_weight_pair_sse2(_mm_set1_epi32(fx));
+                    __m128i _beta = bilinear_weight_pair_sse2(_mm_set1_epi32(fy));
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10) * 3;
+
+                    __m128i _dst = bilinear_blend_sse2(load_pixel_pair_c3_sse2(a0), load_pixel_pair_c3_sse2(a0 + srcstride), _alpha, _beta);
+
+                    int p = bilinear_pack_u8_sse2(_dst);
+                    memcpy(dst0, &p, 3);
+
+                    dst0 += 3;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -1159,13 +1285,13 @@ void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int sr
 #undef SATURATE_CAST_INT
 }
 
-void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+static void warpaffine_bilinear_c4_rows(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int stride, const float* tm, int type, unsigned int v, int ystart, int yend)
 {
     const unsigned char* border_color = (const unsigned char*)&v;
     const int wgap = stride - w * 4;
 
     const unsigned char* src0 = src;
-    unsigned char* dst0 = dst;
+    unsigned char* dst0 = dst + (size_t)stride * ystart;
 
 #define SATURATE_CAST_SHORT(X) (short)::std::min(::std::max((int)(X), SHRT_MIN), SHRT_MAX)
 #define SATURATE_CAST_INT(X)   (int)::std::min(::std::max((int)((X) + ((X) >= 0.f ? 0.5f : -0.5f)), INT_MIN), INT_MAX)
@@ -1178,8 +1304,8 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
         bdelta[x] = SATURATE_CAST_INT(tm[3] * x * (1 << 10));
     }
 
-    int y = 0;
-    for (; y < h; y++)
+    int y = ystart;
+    for (; y < yend; y++)
     {
         int X0 = SATURATE_CAST_INT((tm[1] * y + tm[2]) * (1 << 10));
         int Y0 = SATURATE_CAST_INT((tm[4] * y + tm[5]) * (1 << 10));
@@ -1368,6 +1494,27 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
                 vst4_u8(dst0, _dst);
 
                 dst0 += 4 * 8;
+#elif __SSE2__
+                for (int xi = 0; xi < 8; xi++)
+                {
+                    int X = X0 + adelta[x + xi];
+                    int Y = Y0 + bdelta[x + xi];
+
+                    short fx = X & ((1 << 10) - 1);
+                    short fy = Y & ((1 << 10) - 1);
+
+                    __m128i _alpha = bilinear_weight_pair_sse2(_mm_set1_epi32(fx));
+                    __m128i _beta = bilinear_weight_pair_sse2(_mm_set1_epi32(fy));
+
+                    const unsigned char* a0 = src0 + srcstride * (Y >> 10) + (X >> 10) * 4;
+
+                    __m128i _dst = bilinear_blend_sse2(load_pixel_pair_c4_sse2(a0), load_pixel_pair_c4_sse2(a0 + srcstride), _alpha, _beta);
+
+                    int p = bilinear_pack_u8_sse2(_dst);
+                    memcpy(dst0, &p, 4);
+
+                    dst0 += 4;
+                }
 #else
                 for (int xi = 0; xi < 8; xi++)
                 {
@@ -1568,6 +1715,64 @@ void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int sr
 #undef SATURATE_CAST_INT
 }
 
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    warpaffine_bilinear_c1_rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, 0, h);
+}
+
+void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    warpaffine_bilinear_c2_rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, 0, h);
+}
+
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    warpaffine_bilinear_c3_rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, 0, h);
+}
+
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v)
+{
+    warpaffine_bilinear_c4_rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, 0, h);
+}
+
+// every destination row is independent, so the threads take bands of rows as they are
+static void warpaffine_bilinear_parallel(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, int num_threads,
+                                         void (*rows)(const unsigned char*, int, int, int, unsigned char*, int, int, const float*, int, unsigned int, int, int))
+{
+    const int nbands = std::min(num_threads, h);
+    if (nbands <= 1)
+    {
+        rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, 0, h);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        rows(src, srcw, srch, srcstride, dst, w, stride, tm, type, v, h * i / nbands, h * (i + 1) / nbands);
+    }
+}
+
+void warpaffine_bilinear_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_parallel(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt.num_threads, warpaffine_bilinear_c1_rows);
+}
+
+void warpaffine_bilinear_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_parallel(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt.num_threads, warpaffine_bilinear_c2_rows);
+}
+
+void warpaffine_bilinear_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_parallel(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt.num_threads, warpaffine_bilinear_c3_rows);
+}
+
+void warpaffine_bilinear_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, const float* tm, int type, unsigned int v, const Option& opt)
+{
+    warpaffine_bilinear_parallel(src, srcw, srch, srcstride, dst, w, h, stride, tm, type, v, opt.num_threads, warpaffine_bilinear_c4_rows);
+}
+
 void warpaffine_bilinear_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, const float* tm, int type, unsigned int v)
 {
     // assert srcw % 2 == 0
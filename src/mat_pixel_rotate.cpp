@@ -5,6 +5,9 @@
 #if __ARM_NEON
 #include <arm_neon.h>
 #endif // __ARM_NEON
+#if __SSE2__
+#include <emmintrin.h>
+#endif // __SSE2__
 #include "platform.h"
 
 namespace ncnn {
@@ -14,6 +17,266 @@ namespace ncnn {
 // but we shall ask the original art author for permission first ...
 // https://www.reddit.com/r/anime/comments/5uxjn4/i_recreated_the_kanna_ascii_art_from_kobayashisan/
 
+#if __SSE2__
+static inline __m128i rev_u32_sse2(__m128i _v)
+{
+    return _mm_shuffle_epi32(_v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+static inline __m128i rev_u16_sse2(__m128i _v)
+{
+    _v = rev_u32_sse2(_v);
+    _v = _mm_shufflelo_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+    return _mm_shufflehi_epi16(_v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static inline __m128i rev_u8_sse2(__m128i _v)
+{
+    _v = rev_u16_sse2(_v);
+    return _mm_or_si128(_mm_slli_epi16(_v, 8), _mm_srli_epi16(_v, 8));
+}
+
+// 4 rgb pixels into the low 24bit of each 32bit lane, reads exactly 12 bytes
+static inline __m128i load_c3x4_sse2(const unsigned char* p)
+{
+    int tail;
+    memcpy(&tail, p + 8, 4);
+    __m128i _v = _mm_unpacklo_epi64(_mm_loadl_epi64((const __m128i*)p), _mm_cvtsi32_si128(tail));
+    __m128i _p01 = _mm_unpacklo_epi32(_v, _mm_srli_si128(_v, 3));
+    __m128i _p23 = _mm_unpacklo_epi32(_mm_srli_si128(_v, 6), _mm_srli_si128(_v, 9));
+    return _mm_unpacklo_epi64(_p01, _p23);
+}
+
+// the reverse of load_c3x4_sse2, writes exactly 12 bytes
+static inline void store_c3x4_sse2(unsigned char* p, __m128i _v)
+{
+    const __m128i _lo = _mm_set_epi32(0, 0x00ffffff, 0, 0x00ffffff);
+    const __m128i _hi = _mm_set_epi32(0x00ffffff, 0, 0x00ffffff, 0);
+    _v = _mm_or_si128(_mm_and_si128(_v, _lo), _mm_srli_epi64(_mm_and_si128(_v, _hi), 8));
+    _v = _mm_or_si128(_mm_move_epi64(_v), _mm_slli_si128(_mm_srli_si128(_v, 8), 6));
+    _mm_storel_epi64((__m128i*)p, _v);
+    int tail = _mm_cvtsi128_si32(_mm_srli_si128(_v, 8));
+    memcpy(p + 8, &tail, 4);
+}
+
+static inline void transpose4x4_epi32_sse2(__m128i& _r0, __m128i& _r1, __m128i& _r2, __m128i& _r3)
+{
+    __m128i _t0 = _mm_unpacklo_epi32(_r0, _r1);
+    __m128i _t1 = _mm_unpacklo_epi32(_r2, _r3);
+    __m128i _t2 = _mm_unpackhi_epi32(_r0, _r1);
+    __m128i _t3 = _mm_unpackhi_epi32(_r2, _r3);
+    _r0 = _mm_unpacklo_epi64(_t0, _t1);
+    _r1 = _mm_unpackhi_epi64(_t0, _t1);
+    _r2 = _mm_unpacklo_epi64(_t2, _t3);
+    _r3 = _mm_unpackhi_epi64(_t2, _t3);
+}
+
+// shared by rotate type 5678, which only differ in where the transposed pixels land
+// src pixel (x, y) goes to dst + y * dst_xstep + x * dst_ystep
+// dst_xstep is +-elemsize and dst_ystep is +-stride, a negative dst_xstep walks the source rows backward
+// so that every transposed row is stored forward
+// returns the number of source rows handled, the caller finishes the rest
+static int kanna_rotate_transpose_c1_sse2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int dst_xstep, int dst_ystep)
+{
+    const int src_step = dst_xstep < 0 ? -srcstride : srcstride;
+
+    int y = 0;
+    for (; y + 7 < srch; y += 8)
+    {
+        const unsigned char* src0 = dst_xstep < 0 ? src + (y + 7) * srcstride : src + y * srcstride;
+        unsigned char* dst0 = dst_xstep < 0 ? dst + (y + 7) * dst_xstep : dst + y * dst_xstep;
+
+        int x = 0;
+        for (; x + 7 < srcw; x += 8)
+        {
+            __m128i _r0 = _mm_loadl_epi64((const __m128i*)(src0 + x));
+            __m128i _r1 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step));
+            __m128i _r2 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 2));
+            __m128i _r3 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 3));
+            __m128i _r4 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 4));
+            __m128i _r5 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 5));
+            __m128i _r6 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 6));
+            __m128i _r7 = _mm_loadl_epi64((const __m128i*)(src0 + x + src_step * 7));
+
+            __m128i _t0 = _mm_unpacklo_epi8(_r0, _r1);
+            __m128i _t1 = _mm_unpacklo_epi8(_r2, _r3);
+            __m128i _t2 = _mm_unpacklo_epi8(_r4, _r5);
+            __m128i _t3 = _mm_unpacklo_epi8(_r6, _r7);
+
+            __m128i _u0 = _mm_unpacklo_epi16(_t0, _t1);
+            __m128i _u1 = _mm_unpackhi_epi16(_t0, _t1);
+            __m128i _u2 = _mm_unpacklo_epi16(_t2, _t3);
+            __m128i _u3 = _mm_unpackhi_epi16(_t2, _t3);
+
+            __m128i _c01 = _mm_unpacklo_epi32(_u0, _u2);
+            __m128i _c23 = _mm_unpackhi_epi32(_u0, _u2);
+            __m128i _c45 = _mm_unpacklo_epi32(_u1, _u3);
+            __m128i _c67 = _mm_unpackhi_epi32(_u1, _u3);
+
+            unsigned char* dstx = dst0 + x * dst_ystep;
+            _mm_storel_epi64((__m128i*)dstx, _c01);
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep), _mm_unpackhi_epi64(_c01, _c01));
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 2), _c23);
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 3), _mm_unpackhi_epi64(_c23, _c23));
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 4), _c45);
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 5), _mm_unpackhi_epi64(_c45, _c45));
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 6), _c67);
+            _mm_storel_epi64((__m128i*)(dstx + dst_ystep * 7), _mm_unpackhi_epi64(_c67, _c67));
+        }
+        for (; x < srcw; x++)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                dst0[x * dst_ystep + i] = src0[x + src_step * i];
+            }
+        }
+    }
+
+    return y;
+}
+
+static int kanna_rotate_transpose_c2_sse2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int dst_xstep, int dst_ystep)
+{
+    const int src_step = dst_xstep < 0 ? -srcstride : srcstride;
+
+    int y = 0;
+    for (; y + 7 < srch; y += 8)
+    {
+        const unsigned char* src0 = dst_xstep < 0 ? src + (y + 7) * srcstride : src + y * srcstride;
+        unsigned char* dst0 = dst_xstep < 0 ? dst + (y + 7) * dst_xstep : dst + y * dst_xstep;
+
+        int x = 0;
+        for (; x + 7 < srcw; x += 8)
+        {
+            __m128i _r0 = _mm_loadu_si128((const __m128i*)(src0 + x * 2));
+            __m128i _r1 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step));
+            __m128i _r2 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 2));
+            __m128i _r3 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 3));
+            __m128i _r4 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 4));
+            __m128i _r5 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 5));
+            __m128i _r6 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 6));
+            __m128i _r7 = _mm_loadu_si128((const __m128i*)(src0 + x * 2 + src_step * 7));
+
+            __m128i _t0 = _mm_unpacklo_epi16(_r0, _r1);
+            __m128i _t1 = _mm_unpackhi_epi16(_r0, _r1);
+            __m128i _t2 = _mm_unpacklo_epi16(_r2, _r3);
+            __m128i _t3 = _mm_unpackhi_epi16(_r2, _r3);
+            __m128i _t4 = _mm_unpacklo_epi16(_r4, _r5);
+            __m128i _t5 = _mm_unpackhi_epi16(_r4, _r5);
+            __m128i _t6 = _mm_unpacklo_epi16(_r6, _r7);
+            __m128i _t7 = _mm_unpackhi_epi16(_r6, _r7);
+
+            __m128i _u0 = _mm_unpacklo_epi32(_t0, _t2);
+            __m128i _u1 = _mm_unpackhi_epi32(_t0, _t2);
+            __m128i _u2 = _mm_unpacklo_epi32(_t1, _t3);
+            __m128i _u3 = _mm_unpackhi_epi32(_t1, _t3);
+            __m128i _u4 = _mm_unpacklo_epi32(_t4, _t6);
+            __m128i _u5 = _mm_unpackhi_epi32(_t4, _t6);
+            __m128i _u6 = _mm_unpacklo_epi32(_t5, _t7);
+            __m128i _u7 = _mm_unpackhi_epi32(_t5, _t7);
+
+            unsigned char* dstx = dst0 + x * dst_ystep;
+            _mm_storeu_si128((__m128i*)dstx, _mm_unpacklo_epi64(_u0, _u4));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep), _mm_unpackhi_epi64(_u0, _u4));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 2), _mm_unpacklo_epi64(_u1, _u5));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 3), _mm_unpackhi_epi64(_u1, _u5));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 4), _mm_unpacklo_epi64(_u2, _u6));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 5), _mm_unpackhi_epi64(_u2, _u6));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 6), _mm_unpacklo_epi64(_u3, _u7));
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 7), _mm_unpackhi_epi64(_u3, _u7));
+        }
+        for (; x < srcw; x++)
+        {
+            for (int i = 0; i < 8; i++)
+            {
+                dst0[x * dst_ystep + i * 2] = src0[x * 2 + src_step * i];
+                dst0[x * dst_ystep + i * 2 + 1] = src0[x * 2 + src_step * i + 1];
+            }
+        }
+    }
+
+    return y;
+}
+
+static int kanna_rotate_transpose_c3_sse2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int dst_xstep, int dst_ystep)
+{
+    const int src_step = dst_xstep < 0 ? -srcstride : srcstride;
+
+    int y = 0;
+    for (; y + 3 < srch; y += 4)
+    {
+        const unsigned char* src0 = dst_xstep < 0 ? src + (y + 3) * srcstride : src + y * srcstride;
+        unsigned char* dst0 = dst_xstep < 0 ? dst + (y + 3) * dst_xstep : dst + y * dst_xstep;
+
+        int x = 0;
+        for (; x + 3 < srcw; x += 4)
+        {
+            __m128i _r0 = load_c3x4_sse2(src0 + x * 3);
+            __m128i _r1 = load_c3x4_sse2(src0 + x * 3 + src_step);
+            __m128i _r2 = load_c3x4_sse2(src0 + x * 3 + src_step * 2);
+            __m128i _r3 = load_c3x4_sse2(src0 + x * 3 + src_step * 3);
+
+            transpose4x4_epi32_sse2(_r0, _r1, _r2, _r3);
+
+            unsigned char* dstx = dst0 + x * dst_ystep;
+            store_c3x4_sse2(dstx, _r0);
+            store_c3x4_sse2(dstx + dst_ystep, _r1);
+            store_c3x4_sse2(dstx + dst_ystep * 2, _r2);
+            store_c3x4_sse2(dstx + dst_ystep * 3, _r3);
+        }
+        for (; x < srcw; x++)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                dst0[x * dst_ystep + i * 3] = src0[x * 3 + src_step * i];
+                dst0[x * dst_ystep + i * 3 + 1] = src0[x * 3 + src_step * i + 1];
+                dst0[x * dst_ystep + i * 3 + 2] = src0[x * 3 + src_step * i + 2];
+            }
+        }
+    }
+
+    return y;
+}
+
+static int kanna_rotate_transpose_c4_sse2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int dst_xstep, int dst_ystep)
+{
+    const int src_step = dst_xstep < 0 ? -srcstride : srcstride;
+
+    int y = 0;
+    for (; y + 3 < srch; y += 4)
+    {
+        const unsigned char* src0 = dst_xstep < 0 ? src + (y + 3) * srcstride : src + y * srcstride;
+        unsigned char* dst0 = dst_xstep < 0 ? dst + (y + 3) * dst_xstep : dst + y * dst_xstep;
+
+        int x = 0;
+        for (; x + 3 < srcw; x += 4)
+        {
+            __m128i _r0 = _mm_loadu_si128((const __m128i*)(src0 + x * 4));
+            __m128i _r1 = _mm_loadu_si128((const __m128i*)(src0 + x * 4 + src_step));
+            __m128i _r2 = _mm_loadu_si128((const __m128i*)(src0 + x * 4 + src_step * 2));
+            __m128i _r3 = _mm_loadu_si128((const __m128i*)(src0 + x * 4 + src_step * 3));
+
+            transpose4x4_epi32_sse2(_r0, _r1, _r2, _r3);
+
+            unsigned char* dstx = dst0 + x * dst_ystep;
+            _mm_storeu_si128((__m128i*)dstx, _r0);
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep), _r1);
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 2), _r2);
+            _mm_storeu_si128((__m128i*)(dstx + dst_ystep * 3), _r3);
+        }
+        for (; x < srcw; x++)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                memcpy(dst0 + x * dst_ystep + i * 4, src0 + x * 4 + src_step * i, 4);
+            }
+        }
+    }
+
+    return y;
+}
+#endif // __SSE2__
+
 static void kanna_rotate_1_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int /*h*/, int stride)
 {
     const int srcwgap = srcstride - srcw;
@@ -575,6 +838,22 @@ static void kanna_rotate_2_c1(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 15;
+#elif __SSE2__
+        dst0 -= 15;
+
+        int nn = srcw >> 4;
+        int remain = srcw - (nn << 4);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u8_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 15;
 #else
         int remain = srcw;
@@ -656,6 +935,22 @@ static void kanna_rotate_2_c2(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 7 * 2;
+#elif __SSE2__
+        dst0 -= 7 * 2;
+
+        int nn = srcw >> 3;
+        int remain = srcw - (nn << 3);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u16_sse2(_src));
+
+            src0 += 8 * 2;
+            dst0 -= 8 * 2;
+        }
+
         dst0 += 7 * 2;
 #else
         int remain = srcw;
@@ -743,6 +1038,22 @@ static void kanna_rotate_2_c3(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 3;
+#elif __SSE2__
+        dst0 -= 3 * 3;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = load_c3x4_sse2(src0);
+            store_c3x4_sse2(dst0, rev_u32_sse2(_src));
+
+            src0 += 4 * 3;
+            dst0 -= 4 * 3;
+        }
+
+        dst0 += 3 * 3;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -834,6 +1145,22 @@ static void kanna_rotate_2_c4(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 4;
+#elif __SSE2__
+        dst0 -= 3 * 4;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u32_sse2(_src));
+
+            src0 += 4 * 4;
+            dst0 -= 4 * 4;
+        }
+
+        dst0 += 3 * 4;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -912,6 +1239,22 @@ static void kanna_rotate_3_c1(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 15;
+#elif __SSE2__
+        dst0 -= 15;
+
+        int nn = srcw >> 4;
+        int remain = srcw - (nn << 4);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u8_sse2(_src));
+
+            src0 += 16;
+            dst0 -= 16;
+        }
+
         dst0 += 15;
 #else
         int remain = srcw;
@@ -996,6 +1339,22 @@ static void kanna_rotate_3_c2(const unsigned char* src, int srcw, int srch, int
         }
 #endif // __aarch64__
 
+        dst0 += 7 * 2;
+#elif __SSE2__
+        dst0 -= 7 * 2;
+
+        int nn = srcw >> 3;
+        int remain = srcw - (nn << 3);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u16_sse2(_src));
+
+            src0 += 8 * 2;
+            dst0 -= 8 * 2;
+        }
+
         dst0 += 7 * 2;
 #else
         int remain = srcw;
@@ -1086,6 +1445,22 @@ static void kanna_rotate_3_c3(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 3;
+#elif __SSE2__
+        dst0 -= 3 * 3;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = load_c3x4_sse2(src0);
+            store_c3x4_sse2(dst0, rev_u32_sse2(_src));
+
+            src0 += 4 * 3;
+            dst0 -= 4 * 3;
+        }
+
+        dst0 += 3 * 3;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -1180,6 +1555,22 @@ static void kanna_rotate_3_c4(const unsigned char* src, int srcw, int srch, int
 #endif // __aarch64__
 
         dst0 += 7 * 4;
+#elif __SSE2__
+        dst0 -= 3 * 4;
+
+        int nn = srcw >> 2;
+        int remain = srcw - (nn << 2);
+
+        for (; nn > 0; nn--)
+        {
+            __m128i _src = _mm_loadu_si128((const __m128i*)src0);
+            _mm_storeu_si128((__m128i*)dst0, rev_u32_sse2(_src));
+
+            src0 += 4 * 4;
+            dst0 -= 4 * 4;
+        }
+
+        dst0 += 3 * 4;
 #else
         int remain = srcw;
 #endif // __ARM_NEON
@@ -1892,6 +2283,9 @@ static void kanna_rotate_5_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c1_sse2(src, srcw, srch, srcstride, dst, 1, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2133,6 +2527,9 @@ static void kanna_rotate_5_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c2_sse2(src, srcw, srch, srcstride, dst, 2, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2419,6 +2816,9 @@ static void kanna_rotate_5_c3(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c3_sse2(src, srcw, srch, srcstride, dst, 3, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2738,6 +3138,9 @@ static void kanna_rotate_5_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c4_sse2(src, srcw, srch, srcstride, dst, 4, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -2936,6 +3339,9 @@ static void kanna_rotate_6_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c1_sse2(src, srcw, srch, srcstride, dstend - 1, -1, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3180,6 +3586,9 @@ static void kanna_rotate_6_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c2_sse2(src, srcw, srch, srcstride, dstend - 2, -2, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3469,6 +3878,9 @@ static void kanna_rotate_6_c3(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c3_sse2(src, srcw, srch, srcstride, dstend - 3, -3, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3791,6 +4203,9 @@ static void kanna_rotate_6_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c4_sse2(src, srcw, srch, srcstride, dstend - 4, -4, stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -3989,6 +4404,9 @@ static void kanna_rotate_7_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c1_sse2(src, srcw, srch, srcstride, dstend - 1, -1, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4233,6 +4651,9 @@ static void kanna_rotate_7_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c2_sse2(src, srcw, srch, srcstride, dstend - 2, -2, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4522,6 +4943,9 @@ static void kanna_rotate_7_c3(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c3_sse2(src, srcw, srch, srcstride, dstend - 3, -3, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -4844,6 +5268,9 @@ static void kanna_rotate_7_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c4_sse2(src, srcw, srch, srcstride, dstend - 4, -4, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5042,6 +5469,9 @@ static void kanna_rotate_8_c1(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c1_sse2(src, srcw, srch, srcstride, dstend, 1, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5286,6 +5716,9 @@ static void kanna_rotate_8_c2(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c2_sse2(src, srcw, srch, srcstride, dstend, 2, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5575,6 +6008,9 @@ static void kanna_rotate_8_c3(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c3_sse2(src, srcw, srch, srcstride, dstend, 3, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -5897,6 +6333,9 @@ static void kanna_rotate_8_c4(const unsigned char* src, int srcw, int srch, int
 
         src0 += srcwgap + 7 * srcstride;
     }
+#elif __SSE2__
+    y = kanna_rotate_transpose_c4_sse2(src, srcw, srch, srcstride, dstend, 4, -stride);
+    src0 += y * srcstride;
 #endif // __ARM_NEON
     for (; y < srch; y++)
     {
@@ -6086,6 +6525,68 @@ void kanna_rotate_c4(const unsigned char* src, int srcw, int srch, int srcstride
     }
 }
 
+// split the source rows into bands, every band is a smaller rotate of the same type
+// the band rows stay a multiple of 8 so that the simd blocks are not cut
+static void kanna_rotate_parallel(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, int elemsize, int num_threads,
+                                  void (*rotate)(const unsigned char*, int, int, int, unsigned char*, int, int, int, int))
+{
+    const int nbands = std::min(num_threads, (srch + 7) / 8);
+    if (nbands <= 1 || type < 1 || type > 8)
+    {
+        rotate(src, srcw, srch, srcstride, dst, w, h, stride, type);
+        return;
+    }
+
+    #pragma omp parallel for num_threads(nbands)
+    for (int i = 0; i < nbands; i++)
+    {
+        const int y0 = (srch / 8 * i / nbands) * 8;
+        const int y1 = i + 1 == nbands ? srch : (srch / 8 * (i + 1) / nbands) * 8;
+        if (y0 >= y1)
+            continue;
+
+        const int bandh = y1 - y0;
+        const unsigned char* bandsrc = src + (size_t)srcstride * y0;
+
+        if (type == 1 || type == 2)
+        {
+            rotate(bandsrc, srcw, bandh, srcstride, dst + (size_t)stride * y0, w, bandh, stride, type);
+        }
+        else if (type == 3 || type == 4)
+        {
+            rotate(bandsrc, srcw, bandh, srcstride, dst + (size_t)stride * (h - y1), w, bandh, stride, type);
+        }
+        else if (type == 5 || type == 8)
+        {
+            rotate(bandsrc, srcw, bandh, srcstride, dst + y0 * elemsize, bandh, h, stride, type);
+        }
+        else // if (type == 6 || type == 7)
+        {
+            rotate(bandsrc, srcw, bandh, srcstride, dst + (w - y1) * elemsize, bandh, h, stride, type);
+        }
+    }
+}
+
+void kanna_rotate_c1(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt)
+{
+    kanna_rotate_parallel(src, srcw, srch, srcstride, dst, w, h, stride, type, 1, opt.num_threads, kanna_rotate_c1);
+}
+
+void kanna_rotate_c2(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt)
+{
+    kanna_rotate_parallel(src, srcw, srch, srcstride, dst, w, h, stride, type, 2, opt.num_threads, kanna_rotate_c2);
+}
+
+void kanna_rotate_c3(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt)
+{
+    kanna_rotate_parallel(src, srcw, srch, srcstride, dst, w, h, stride, type, 3, opt.num_threads, kanna_rotate_c3);
+}
+
+void kanna_rotate_c4(const unsigned char* src, int srcw, int srch, int srcstride, unsigned char* dst, int w, int h, int stride, int type, const Option& opt)
+{
+    kanna_rotate_parallel(src, srcw, srch, srcstride, dst, w, h, stride, type, 4, opt.num_threads, kanna_rotate_c4);
+}
+
 void kanna_rotate_yuv420sp(const unsigned char* src, int srcw, int srch, unsigned char* dst, int w, int h, int type)
 {
     // assert srcw % 2 == 0
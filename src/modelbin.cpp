@@ -83,7 +83,7 @@ Mat ModelBinFromDataReader::load(int w, int type) const
 {
     Mat m;
 
-    if (type == 0)
+    if (type == 0 || type == 2)
     {
         size_t nread;
 
@@ -112,11 +112,89 @@ Mat ModelBinFromDataReader::load(int w, int type) const
 
         unsigned int flag = (int)flag_struct.f0 + flag_struct.f1 + flag_struct.f2 + flag_struct.f3;
 
+        if (flag_struct.tag == 0x01A16A40)
+        {
+            // alignment padding before the tagged data
+            // written by ncnnoptimize so that weights start at 64-byte file offset
+            unsigned int padding_size = 0;
+            nread = d->dr.read(&padding_size, sizeof(padding_size));
+            if (nread != sizeof(padding_size))
+            {
+                NCNN_LOGE("ModelBin read padding_size failed %zd", nread);
+                return Mat();
+            }
+
+#if __BIG_ENDIAN__
+            swap_endianness_32(&padding_size);
+#endif
+
+            if (padding_size % 4 != 0 || padding_size >= 64)
+            {
+                NCNN_LOGE("ModelBin invalid padding_size %u", padding_size);
+                return Mat();
+            }
+
+            const void* refbuf = 0;
+            nread = d->dr.reference(padding_size, &refbuf);
+            if (nread != padding_size)
+            {
+                unsigned char padding[64];
+                nread = d->dr.read(padding, padding_size);
+                if (nread != padding_size)
+                {
+                    NCNN_LOGE("ModelBin read padding failed %zd", nread);
+                    return Mat();
+                }
+            }
+
+            return load(w, type);
+        }
+
         if (flag_struct.tag == 0x01306B47)
         {
             // half-precision data
             size_t align_data_size = alignSize(w * sizeof(unsigned short), 4);
 
+            if (type == 2)
+            {
+                // keep float16 for the layers that consume it directly
+#if !__BIG_ENDIAN__
+                // try reference data
+                const void* refbuf = 0;
+                nread = d->dr.reference(align_data_size, &refbuf);
+                if (nread == align_data_size)
+                {
+                    m = Mat(w, (void*)refbuf, (size_t)2u);
+                }
+                else
+#endif
+                {
+                    m.create(w, (size_t)2u);
+                    if (m.empty())
+                        return m;
+
+                    std::vector<unsigned short> float16_weights;
+                    float16_weights.resize(align_data_size);
+                    nread = d->dr.read(&float16_weights[0], align_data_size);
+                    if (nread != align_data_size)
+                    {
+                        NCNN_LOGE("ModelBin read float16_weights failed %zd", nread);
+                        return Mat();
+                    }
+
+#if __BIG_ENDIAN__
+                    for (int i = 0; i < w; i++)
+                    {
+                        swap_endianness_16(&float16_weights[i]);
+                    }
+#endif
+
+                    memcpy(m.data, &float16_weights[0], w * sizeof(unsigned short));
+                }
+
+                return m;
+            }
+
 #if !__BIG_ENDIAN__
             // try reference data
             const void* refbuf = 0;
@@ -218,6 +296,59 @@ Mat ModelBinFromDataReader::load(int w, int type) const
 
             return m;
         }
+        else if (flag_struct.tag == 0x0B5A25E0)
+        {
+            // sparse data, nonzero bitmask followed by the nonzero values
+            // written by ncnnoptimize for pruned weights
+            std::vector<unsigned int> mask((w + 31) / 32);
+            nread = d->dr.read(&mask[0], mask.size() * sizeof(unsigned int));
+            if (nread != mask.size() * sizeof(unsigned int))
+            {
+                NCNN_LOGE("ModelBin read sparse mask failed %zd", nread);
+                return Mat();
+            }
+
+#if __BIG_ENDIAN__
+            for (size_t i = 0; i < mask.size(); i++)
+            {
+                swap_endianness_32(&mask[i]);
+            }
+#endif
+
+            int nnz = 0;
+            for (int i = 0; i < w; i++)
+            {
+                nnz += (mask[i / 32] >> (i % 32)) & 1;
+            }
+
+            std::vector<float> values(nnz > 0 ? nnz : 1);
+            nread = d->dr.read(&values[0], nnz * sizeof(float));
+            if (nread != nnz * sizeof(float))
+            {
+                NCNN_LOGE("ModelBin read sparse values failed %zd", nread);
+                return Mat();
+            }
+
+#if __BIG_ENDIAN__
+            for (int i = 0; i < nnz; i++)
+            {
+                swap_endianness_32(&values[i]);
+            }
+#endif
+
+            m.create(w);
+            if (m.empty())
+                return m;
+
+            float* ptr = m;
+            int j = 0;
+            for (int i = 0; i < w; i++)
+            {
+                ptr[i] = (mask[i / 32] >> (i % 32)) & 1 ? values[j++] : 0.f;
+            }
+
+            return m;
+        }
 
         if (flag != 0)
         {
@@ -17,7 +17,7 @@ public:
     // element type
     // 0 = auto
     // 1 = float32
-    // 2 = float16
+    // 2 = float16, half-precision data is kept as is, other data loads as auto
     // 3 = int8
     // load vec
     virtual Mat load(int w, int type) const;
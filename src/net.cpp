@@ -3,19 +3,40 @@
 
 #include "net.h"
 
+#include "benchmark.h"
 #include "cpu.h"
 #include "datareader.h"
 #include "layer_type.h"
 #include "modelbin.h"
 #include "paramdict.h"
+#include "profiler.h"
+
+#include "layer/convolution.h"
+#include "layer/convolution1d.h"
+#include "layer/gru.h"
+#include "layer/innerproduct.h"
+#include "layer/lstm.h"
+#include "layer/rnn.h"
 
 #include <stdarg.h>
 #include <stdint.h>
 #include <string.h>
 
-#if NCNN_BENCHMARK
-#include "benchmark.h"
-#endif // NCNN_BENCHMARK
+#if NCNN_STDIO
+#if defined _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#elif defined __unix__ || defined __APPLE__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define NCNN_MMAP_POSIX 1
+#endif
+#endif // NCNN_STDIO
+
 
 #if NCNN_VULKAN
 #include "command.h"
@@ -24,6 +45,17 @@
 
 namespace ncnn {
 
+class StreamState
+{
+public:
+    // first state slot of each layer, -1 for layers running stateless
+    std::vector<int> layer_slots;
+    // lstm keeps hidden and cell, gru rnn keep hidden, convolution1d keeps left context
+    std::vector<Mat> states;
+};
+
+struct InterOpContext;
+
 class NetPrivate
 {
 public:
@@ -40,6 +72,40 @@ public:
     friend class Extractor;
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
 
+    // forward_layer for a layer whose bottom blobs are all ready, never recurses
+    int forward_layer_ready(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    // mark the layers in execution plan up to position end that must run to fill missing blobs
+    int mark_needed_layers(int end, const std::vector<Mat>& blob_mats, std::vector<unsigned char>& layer_needed) const;
+
+    // layer indexes that must run to compute layer_index, in execution order
+    // layer_needed is the caller owned scratch for marking layers to run
+    int collect_needed_layers(int layer_index, const std::vector<Mat>& blob_mats, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers) const;
+
+    // needed layers of an extractor holding nothing but fed_blobs, cached per requested layer
+    // null if the cache is full or the layers cannot be collected
+    const std::vector<int>* get_cached_needed_layers(int layer_index, const std::vector<int>& fed_blobs, const std::vector<Mat>& blob_mats);
+    void clear_needed_layers_cache();
+
+    // run the needed layers as a flat loop
+    int forward_plan(const std::vector<int>& needed_layers, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    // run the execution plan up to layer_index on inter_op_threads threads
+    // layers on independent branches run concurrently as soon as their bottoms are ready
+    // fed_blobs is null once the extractor has run any layer, the needed layers are collected into needed_layers then
+    int forward_plan_parallel(int layer_index, std::vector<Mat>& blob_mats, const std::vector<int>* fed_blobs, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers, int inter_op_threads, const Option& opt);
+
+    // run the execution plan for a batch of samples layer by layer
+    // pointwise layers forward all samples stacked in one call
+    int forward_plan_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, std::vector<Mat>& stacked_blob_mats, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers, const Option& opt) const;
+
+    // 0 = forward samples one by one
+    // 1 = flatten samples as rows of one 2d blob
+    // 2 = stack 3d samples along h
+    int get_batch_stack_type(const Layer* layer, const std::vector<std::vector<Mat> >& batch_blob_mats) const;
+
+    int forward_layer_stacked(int layer_index, int stack_type, std::vector<std::vector<Mat> >& batch_blob_mats, std::vector<Mat>& stacked_blob_mats, const Option& opt) const;
+
 #if NCNN_VULKAN
     int forward_layer(int layer_index, std::vector<Mat>& blob_mats, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
@@ -47,6 +113,18 @@ public:
     int convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const;
 
     int do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    // do_forward_layer with featmask applied, reported to opt.profiler
+    int do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    // number of state mats the layer carries in streaming mode, 0 for stateless
+    int get_stream_state_count(const Layer* layer) const;
+    void init_stream_state(StreamState& stream_state) const;
+
+    // do_forward_layer with featmask applied, feeding and updating the carried state
+    int do_forward_layer_streaming(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const;
+
+    const char* layer_impl_name(const Layer* layer) const;
 #if NCNN_VULKAN
     int do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const;
 #endif // NCNN_VULKAN
@@ -56,9 +134,45 @@ public:
     void update_input_output_names();
 #endif // NCNN_STRING
 
+    void update_execution_plan();
+
+    // rebuild the execution plan if the graph was handed out through mutable_layers() or mutable_blobs()
+    void check_execution_plan();
+
+    // take the memory plan recorded for shape_key out of cache, null if none
+    PlannedAllocator* acquire_planned_allocator(const std::vector<int>& shape_key);
+    // hand the memory plan back as most recently used, drop the oldest beyond opt.memory_plan_cache_size
+    void reclaim_planned_allocator(const std::vector<int>& shape_key, PlannedAllocator* allocator);
+    void clear_memory_plan_cache();
+
+    // queue one extract_async, start the async threads on first use
+    void submit_async_extract(Extractor* ex, ExtractorPrivate* exd, int blob_index, Extractor::extract_callback callback, void* userdata, int type);
+    // finish queued extracts and join the async threads
+    void stop_async_extract();
+
+    // let helper_count pooled threads work on ctx, start more pooled threads when needed
+    void submit_inter_op(InterOpContext* ctx, int helper_count);
+    // no more pooled threads join ctx, wait for the joined ones to leave
+    void withdraw_inter_op(InterOpContext* ctx);
+    // join the pooled inter-op threads
+    void stop_inter_op();
+
     std::vector<Blob> blobs;
     std::vector<Layer*> layers;
 
+    // layer indexes in topological order, producers always come before consumers
+    std::vector<int> execution_order;
+    // position of each layer in execution_order
+    std::vector<int> execution_position;
+    // every blob feeds at most one layer, required for running branches concurrently
+    bool blobs_single_consumer;
+    // mutable_layers() or mutable_blobs() was called since execution_order was built
+    bool execution_plan_dirty;
+    Mutex execution_plan_lock;
+
+    // requested layer index followed by the fed blob indexes, and the layers to run for it
+    std::vector<std::pair<std::vector<int>, std::vector<int>*> > needed_layers_cache;
+
     std::vector<int> input_blob_indexes;
     std::vector<int> output_blob_indexes;
 #if NCNN_STRING
@@ -72,6 +186,46 @@ public:
     PoolAllocator* local_blob_allocator;
     PoolAllocator* local_workspace_allocator;
 
+    // memory plans of recently seen input shapes, most recently used first
+    // a plan in use by an extractor is taken out and comes back when the extractor is done
+    std::vector<std::pair<std::vector<int>, PlannedAllocator*> > memory_plan_cache;
+    Mutex memory_plan_cache_lock;
+
+    struct AsyncExtractTask
+    {
+        Extractor* ex;
+        ExtractorPrivate* exd;
+        int blob_index;
+        int type;
+        Extractor::extract_callback callback;
+        void* userdata;
+    };
+
+    static void* async_extract_worker(void* args);
+
+    // pending extract_async in submit order
+    std::vector<AsyncExtractTask> async_queue;
+    std::vector<Thread*> async_threads;
+    bool async_stopping;
+    Mutex async_lock;
+    ConditionVariable async_condition;
+
+    static void* inter_op_pool_worker(void* args);
+
+    // pooled helper threads of forward_plan_parallel, shared by all extractors
+    // contexts still accepting helpers in submit order
+    std::vector<InterOpContext*> inter_op_queue;
+    std::vector<Thread*> inter_op_pool_threads;
+    bool inter_op_stopping;
+    Mutex inter_op_lock;
+    ConditionVariable inter_op_condition;
+
+#if NCNN_STDIO
+    // model file mapping referenced by layer weights
+    void* model_mapping;
+    size_t model_mapping_size;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     const VulkanDevice* vkdev;
 
@@ -88,6 +242,18 @@ NetPrivate::NetPrivate(Option& _opt)
     local_blob_allocator = 0;
     local_workspace_allocator = 0;
 
+    blobs_single_consumer = false;
+    execution_plan_dirty = false;
+
+    async_stopping = false;
+
+    inter_op_stopping = false;
+
+#if NCNN_STDIO
+    model_mapping = 0;
+    model_mapping_size = 0;
+#endif // NCNN_STDIO
+
 #if NCNN_VULKAN
     vkdev = 0;
     weight_vkallocator = 0;
@@ -176,6 +342,13 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         }
     }
 
+    return forward_layer_ready(layer_index, blob_mats, opt);
+}
+
+int NetPrivate::forward_layer_ready(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
 #if NCNN_BENCHMARK
     double start = get_current_time();
     Mat bottom_blob;
@@ -192,7 +365,15 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
     }
 #endif
     int ret = 0;
-    if (layer->featmask)
+    if (opt.profiler)
+    {
+        ret = do_forward_layer_profiled(layer_index, blob_mats, opt);
+    }
+    else if (opt.stream_state && opt.stream_state->layer_slots[layer_index] != -1)
+    {
+        ret = do_forward_layer_streaming(layer_index, blob_mats, opt);
+    }
+    else if (layer->featmask)
     {
         ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
     }
@@ -207,17 +388,740 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, cons
         int top_blob_index = layer->tops[0];
         benchmark(layer, bottom_blob, blob_mats[top_blob_index], start, end);
     }
-    else
+    else
+    {
+        benchmark(layer, start, end);
+    }
+#endif
+    if (ret != 0)
+        return ret;
+
+    //     NCNN_LOGE("forward_layer %d %s done", layer_index, layer->name.c_str());
+    //     const Mat& blob = blob_mats[layer->tops[0]];
+    //     NCNN_LOGE("[%-2d %-16s %-16s]  %d    blobs count = %-3d   size = %-3d x %-3d", layer_index, layer->type.c_str(), layer->name.c_str(), layer->tops[0], blob.c, blob.h, blob.w);
+
+    return 0;
+}
+
+static Mat blob_shape(const Mat& m)
+{
+    // header only, no data reference kept
+    Mat shape;
+    shape.dims = m.dims;
+    shape.w = m.w;
+    shape.h = m.h;
+    shape.d = m.d;
+    shape.c = m.c;
+    shape.elempack = m.elempack;
+    shape.elemsize = m.elemsize;
+    return shape;
+}
+
+int NetPrivate::do_forward_layer_profiled(int layer_index, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+
+    ProfilerEvent event;
+    event.layer_index = layer_index;
+    event.typeindex = layer->typeindex;
+#if NCNN_STRING
+    event.type = layer->type.c_str();
+    event.name = layer->name.c_str();
+#endif // NCNN_STRING
+    event.impl = layer_impl_name(layer);
+    event.thread_id = get_current_thread_id();
+    event.num_threads = (layer->featmask & (1 << 7)) ? 1 : opt.num_threads;
+
+    event.bottom_shapes.resize(layer->bottoms.size());
+    std::vector<const void*> bottom_datas(layer->bottoms.size());
+    for (size_t i = 0; i < layer->bottoms.size(); i++)
+    {
+        const Mat& bottom_blob = blob_mats[layer->bottoms[i]];
+        event.bottom_shapes[i] = blob_shape(bottom_blob);
+        bottom_datas[i] = bottom_blob.data;
+    }
+
+    event.start = get_current_time();
+
+    int ret = 0;
+    if (opt.stream_state && opt.stream_state->layer_slots[layer_index] != -1)
+    {
+        ret = do_forward_layer_streaming(layer_index, blob_mats, opt);
+    }
+    else if (layer->featmask)
+    {
+        ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
+    }
+    else
+    {
+        ret = do_forward_layer(layer, blob_mats, opt);
+    }
+
+    event.end = get_current_time();
+
+    if (ret != 0)
+        return ret;
+
+    event.top_shapes.resize(layer->tops.size());
+    for (size_t i = 0; i < layer->tops.size(); i++)
+    {
+        const Mat& top_blob = blob_mats[layer->tops[i]];
+        event.top_shapes[i] = blob_shape(top_blob);
+
+        // inplace forward reuses the bottom memory
+        bool inplace = false;
+        for (size_t j = 0; j < bottom_datas.size(); j++)
+        {
+            if (top_blob.data == bottom_datas[j])
+                inplace = true;
+        }
+
+        if (!inplace)
+            event.top_bytes += top_blob.total() * top_blob.elemsize;
+    }
+
+    opt.profiler->on_layer(event);
+
+    return 0;
+}
+
+const char* NetPrivate::layer_impl_name(const Layer* layer) const
+{
+    if (layer->typeindex & ncnn::LayerType::CustomBit)
+        return "custom";
+
+    for (size_t i = 0; i < overwrite_builtin_layer_registry.size(); i++)
+    {
+        if (overwrite_builtin_layer_registry[i].typeindex == layer->typeindex)
+            return "overwrite";
+    }
+
+    return layer_cpu_impl_name(layer->typeindex);
+}
+
+int NetPrivate::mark_needed_layers(int end, const std::vector<Mat>& blob_mats, std::vector<unsigned char>& layer_needed) const
+{
+    layer_needed.assign(end + 1, 0);
+    layer_needed[end] = 1;
+
+    // walk backwards and mark the producers of all missing bottom blobs
+    for (int i = end; i >= 0; i--)
+    {
+        if (!layer_needed[i])
+            continue;
+
+        const Layer* layer = layers[execution_order[i]];
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            int producer = blobs[bottom_blob_index].producer;
+            if (producer == -1)
+            {
+#if NCNN_STRING
+                NCNN_LOGE("blob %d %s has no producer and no input data", bottom_blob_index, blobs[bottom_blob_index].name.c_str());
+#else
+                NCNN_LOGE("blob %d has no producer and no input data", bottom_blob_index);
+#endif
+                return -1;
+            }
+
+            // producers come first unless the graph was rewired after the plan was built
+            const int producer_position = execution_position[producer];
+            if (producer_position < 0 || producer_position >= i)
+            {
+                NCNN_LOGE("execution plan is stale, layer %d needs layer %d planned after it", execution_order[i], producer);
+                return -1;
+            }
+
+            layer_needed[producer_position] = 1;
+        }
+    }
+
+    return 0;
+}
+
+int NetPrivate::collect_needed_layers(int layer_index, const std::vector<Mat>& blob_mats, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers) const
+{
+    needed_layers.clear();
+
+    const int end = execution_position[layer_index];
+
+    int ret = mark_needed_layers(end, blob_mats, layer_needed);
+    if (ret != 0)
+        return ret;
+
+    for (int i = 0; i <= end; i++)
+    {
+        if (layer_needed[i])
+            needed_layers.push_back(execution_order[i]);
+    }
+
+    return 0;
+}
+
+const std::vector<int>* NetPrivate::get_cached_needed_layers(int layer_index, const std::vector<int>& fed_blobs, const std::vector<Mat>& blob_mats)
+{
+    std::vector<int> key;
+    key.reserve(fed_blobs.size() + 1);
+    key.push_back(layer_index);
+    key.insert(key.end(), fed_blobs.begin(), fed_blobs.end());
+
+    const std::vector<int>* needed_layers = 0;
+
+    execution_plan_lock.lock();
+
+    for (size_t i = 0; i < needed_layers_cache.size(); i++)
+    {
+        if (needed_layers_cache[i].first == key)
+        {
+            needed_layers = needed_layers_cache[i].second;
+            break;
+        }
+    }
+
+    // a handful of outputs and input sets per net, stop caching beyond that
+    if (!needed_layers && needed_layers_cache.size() < 64)
+    {
+        std::vector<unsigned char> layer_needed;
+        std::vector<int>* collected = new std::vector<int>;
+        if (collect_needed_layers(layer_index, blob_mats, layer_needed, *collected) == 0)
+        {
+            needed_layers_cache.push_back(std::make_pair(key, collected));
+            needed_layers = collected;
+        }
+        else
+        {
+            delete collected;
+        }
+    }
+
+    execution_plan_lock.unlock();
+
+    return needed_layers;
+}
+
+void NetPrivate::clear_needed_layers_cache()
+{
+    for (size_t i = 0; i < needed_layers_cache.size(); i++)
+    {
+        delete needed_layers_cache[i].second;
+    }
+    needed_layers_cache.clear();
+}
+
+int NetPrivate::forward_plan(const std::vector<int>& needed_layers, std::vector<Mat>& blob_mats, const Option& opt) const
+{
+    for (size_t i = 0; i < needed_layers.size(); i++)
+    {
+        // bottom blobs are ready at this point, unless a blob feeding several layers
+        // was released by its first consumer in light mode and has to be recomputed
+        int ret = blobs_single_consumer ? forward_layer_ready(needed_layers[i], blob_mats, opt) : forward_layer(needed_layers[i], blob_mats, opt);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+#if NCNN_THREADS
+struct InterOpContext
+{
+    const NetPrivate* net;
+    std::vector<Mat>* blob_mats;
+    Option opt;
+
+    // ready layer indexes
+    std::vector<int> ready;
+    // missing bottoms count of each layer by plan position
+    std::vector<int> pending;
+    // layers waiting for each layer by plan position
+    std::vector<std::vector<int> > successors;
+    int remaining;
+    int ret;
+
+    // pooled threads still to join and currently joined
+    int helpers_wanted;
+    int helpers_active;
+
+    Mutex lock;
+    ConditionVariable condition;
+};
+
+static void* inter_op_worker(void* args)
+{
+    InterOpContext* ctx = (InterOpContext*)args;
+
+    // denormal flags are per thread
+    set_flush_denormals(ctx->opt.flush_denormals);
+
+    ctx->lock.lock();
+
+    for (;;)
+    {
+        while (ctx->ready.empty() && ctx->remaining > 0 && ctx->ret == 0)
+        {
+            ctx->condition.wait(ctx->lock);
+        }
+
+        if (ctx->remaining == 0 || ctx->ret != 0)
+            break;
+
+        const int layer_index = ctx->ready.back();
+        ctx->ready.pop_back();
+
+        ctx->lock.unlock();
+
+        int ret = ctx->net->forward_layer_ready(layer_index, *ctx->blob_mats, ctx->opt);
+
+        ctx->lock.lock();
+
+        if (ret != 0)
+        {
+            ctx->ret = ret;
+            ctx->condition.broadcast();
+            break;
+        }
+
+        ctx->remaining--;
+
+        const std::vector<int>& successors = ctx->successors[ctx->net->execution_position[layer_index]];
+        for (size_t i = 0; i < successors.size(); i++)
+        {
+            const int s = successors[i];
+            if (--ctx->pending[ctx->net->execution_position[s]] == 0)
+            {
+                ctx->ready.push_back(s);
+            }
+        }
+
+        if (ctx->remaining == 0 || !ctx->ready.empty())
+        {
+            ctx->condition.broadcast();
+        }
+    }
+
+    ctx->lock.unlock();
+
+    return 0;
+}
+
+void* NetPrivate::inter_op_pool_worker(void* args)
+{
+    NetPrivate* d = (NetPrivate*)args;
+
+    for (;;)
+    {
+        d->inter_op_lock.lock();
+
+        while (!d->inter_op_stopping && d->inter_op_queue.empty())
+        {
+            d->inter_op_condition.wait(d->inter_op_lock);
+        }
+
+        if (d->inter_op_stopping)
+        {
+            d->inter_op_lock.unlock();
+            break;
+        }
+
+        InterOpContext* ctx = d->inter_op_queue.front();
+
+        // join under the pool lock so withdraw_inter_op sees every joined helper
+        ctx->lock.lock();
+        ctx->helpers_active++;
+        if (--ctx->helpers_wanted == 0)
+        {
+            d->inter_op_queue.erase(d->inter_op_queue.begin());
+        }
+        ctx->lock.unlock();
+
+        d->inter_op_lock.unlock();
+
+        inter_op_worker(ctx);
+
+        ctx->lock.lock();
+        ctx->helpers_active--;
+        ctx->condition.broadcast();
+        ctx->lock.unlock();
+    }
+
+    return 0;
+}
+
+void NetPrivate::submit_inter_op(InterOpContext* ctx, int helper_count)
+{
+    inter_op_lock.lock();
+
+    for (int i = (int)inter_op_pool_threads.size(); i < helper_count; i++)
+    {
+        inter_op_pool_threads.push_back(new Thread(inter_op_pool_worker, this));
+    }
+
+    ctx->helpers_wanted = helper_count;
+    inter_op_queue.push_back(ctx);
+    inter_op_condition.broadcast();
+
+    inter_op_lock.unlock();
+}
+
+void NetPrivate::withdraw_inter_op(InterOpContext* ctx)
+{
+    inter_op_lock.lock();
+
+    for (size_t i = 0; i < inter_op_queue.size(); i++)
+    {
+        if (inter_op_queue[i] == ctx)
+        {
+            inter_op_queue.erase(inter_op_queue.begin() + i);
+            break;
+        }
+    }
+
+    inter_op_lock.unlock();
+
+    ctx->lock.lock();
+    while (ctx->helpers_active > 0)
+    {
+        ctx->condition.wait(ctx->lock);
+    }
+    ctx->lock.unlock();
+}
+#endif // NCNN_THREADS
+
+void NetPrivate::stop_inter_op()
+{
+    inter_op_lock.lock();
+    inter_op_stopping = true;
+    inter_op_condition.broadcast();
+    inter_op_lock.unlock();
+
+    for (size_t i = 0; i < inter_op_pool_threads.size(); i++)
+    {
+        inter_op_pool_threads[i]->join();
+        delete inter_op_pool_threads[i];
+    }
+    inter_op_pool_threads.clear();
+
+    inter_op_stopping = false;
+}
+
+int NetPrivate::forward_plan_parallel(int layer_index, std::vector<Mat>& blob_mats, const std::vector<int>* fed_blobs, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers, int inter_op_threads, const Option& opt)
+{
+    if (layer_index < 0 || layer_index >= (int)layers.size())
+        return -1;
+
+    if (execution_order.size() != layers.size())
+    {
+        // no valid plan for this graph, use the recursive path
+        return forward_layer(layer_index, blob_mats, opt);
+    }
+
+    const std::vector<int>* needed = fed_blobs ? get_cached_needed_layers(layer_index, *fed_blobs, blob_mats) : 0;
+    if (!needed)
+    {
+        int ret = collect_needed_layers(layer_index, blob_mats, layer_needed, needed_layers);
+        if (ret != 0)
+            return ret;
+
+        needed = &needed_layers;
+    }
+
+#if NCNN_THREADS
+    if (inter_op_threads <= 1 || !blobs_single_consumer)
+        return forward_plan(*needed, blob_mats, opt);
+
+    const int end = execution_position[layer_index];
+
+    InterOpContext ctx;
+    ctx.net = this;
+    ctx.blob_mats = &blob_mats;
+    ctx.opt = opt;
+    ctx.remaining = 0;
+    ctx.ret = 0;
+    ctx.helpers_wanted = 0;
+    ctx.helpers_active = 0;
+
+    ctx.pending.resize(end + 1, 0);
+    ctx.successors.resize(end + 1);
+    for (size_t k = 0; k < needed->size(); k++)
+    {
+        const int li = (*needed)[k];
+        const int i = execution_position[li];
+        const Layer* layer = layers[li];
+        for (size_t j = 0; j < layer->bottoms.size(); j++)
+        {
+            int bottom_blob_index = layer->bottoms[j];
+            if (blob_mats[bottom_blob_index].dims != 0)
+                continue;
+
+            ctx.pending[i]++;
+            ctx.successors[execution_position[blobs[bottom_blob_index].producer]].push_back(li);
+        }
+
+        if (ctx.pending[i] == 0)
+        {
+            ctx.ready.push_back(li);
+        }
+
+        ctx.remaining++;
+    }
+
+    // run on the calling thread plus inter_op_threads - 1 pooled helpers
+    submit_inter_op(&ctx, inter_op_threads - 1);
+
+    inter_op_worker(&ctx);
+
+    withdraw_inter_op(&ctx);
+
+    return ctx.ret;
+#else
+    (void)inter_op_threads;
+    return forward_plan(*needed, blob_mats, opt);
+#endif // NCNN_THREADS
+}
+
+int NetPrivate::forward_plan_batch(int layer_index, std::vector<std::vector<Mat> >& batch_blob_mats, std::vector<Mat>& stacked_blob_mats, std::vector<unsigned char>& layer_needed, std::vector<int>& needed_layers, const Option& opt) const
+{
+    if (layer_index < 0 || layer_index >= (int)layers.size())
+        return -1;
+
+    const int batch = (int)batch_blob_mats.size();
+
+    if (execution_order.size() != layers.size())
+    {
+        // graph changed after plan built, use the recursive path
+        for (int b = 0; b < batch; b++)
+        {
+            int ret = forward_layer(layer_index, batch_blob_mats[b], opt);
+            if (ret != 0)
+                return ret;
+        }
+
+        return 0;
+    }
+
+    // all samples are fed with the same blobs, collect on the first one
+    int ret = collect_needed_layers(layer_index, batch_blob_mats[0], layer_needed, needed_layers);
+    if (ret != 0)
+        return ret;
+
+    stacked_blob_mats.resize(blobs.size());
+
+    // forward layer by layer so that weights stay hot across samples
+    for (size_t i = 0; i < needed_layers.size(); i++)
+    {
+        const int li = needed_layers[i];
+
+        int stack_type = batch > 1 ? get_batch_stack_type(layers[li], batch_blob_mats) : 0;
+        if (stack_type != 0)
+        {
+            ret = forward_layer_stacked(li, stack_type, batch_blob_mats, stacked_blob_mats, opt);
+            if (ret != 0)
+                return ret;
+
+            continue;
+        }
+
+        for (int b = 0; b < batch; b++)
+        {
+            ret = forward_layer(li, batch_blob_mats[b], opt);
+            if (ret != 0)
+                return ret;
+        }
+    }
+
+    return 0;
+}
+
+int NetPrivate::get_batch_stack_type(const Layer* layer, const std::vector<std::vector<Mat> >& batch_blob_mats) const
+{
+    if (layer->bottoms.size() != 1 || layer->tops.size() != 1)
+        return 0;
+
+    // overwritten builtin layer may not be the class we know
+    for (size_t i = 0; i < overwrite_builtin_layer_registry.size(); i++)
+    {
+        if (overwrite_builtin_layer_registry[i].typeindex == layer->typeindex)
+            return 0;
+    }
+
+    int stack_type = 0;
+
+    if (layer->typeindex == LayerType::InnerProduct)
+    {
+        const InnerProduct* innerproduct = (const InnerProduct*)layer;
+        if (innerproduct->int8_scale_term == 0 && innerproduct->num_output > 0)
+            stack_type = 1;
+    }
+
+    if (layer->typeindex == LayerType::Convolution)
+    {
+        // 1x1 stride 1 without padding computes every pixel on its own
+        const Convolution* convolution = (const Convolution*)layer;
+        const bool no_padding = (convolution->pad_left == 0 && convolution->pad_right == 0 && convolution->pad_top == 0 && convolution->pad_bottom == 0)
+                                || convolution->pad_left == -233 || convolution->pad_left == -234;
+        if (convolution->kernel_w == 1 && convolution->kernel_h == 1 && convolution->stride_w == 1 && convolution->stride_h == 1
+                && convolution->dilation_w == 1 && convolution->dilation_h == 1 && no_padding && convolution->dynamic_weight == 0)
+            stack_type = 2;
+    }
+
+    if (stack_type == 0)
+        return 0;
+
+    // every sample should have the same shape
+    const int bottom_blob_index = layer->bottoms[0];
+    const Mat& m0 = batch_blob_mats[0][bottom_blob_index];
+    for (size_t b = 0; b < batch_blob_mats.size(); b++)
+    {
+        const Mat& m = batch_blob_mats[b][bottom_blob_index];
+        if (m.dims != m0.dims || m.w != m0.w || m.h != m0.h || m.d != m0.d || m.c != m0.c || m.elemsize != m0.elemsize || m.elempack != m0.elempack)
+            return 0;
+    }
+
+    if (stack_type == 1)
+    {
+        const InnerProduct* innerproduct = (const InnerProduct*)layer;
+        const int num_input = innerproduct->weight_data_size / innerproduct->num_output;
+        if (m0.w * m0.h * m0.d * m0.c * m0.elempack != num_input || m0.dims == 2)
+            return 0;
+    }
+
+    if (stack_type == 2)
+    {
+        if (m0.dims != 3)
+            return 0;
+
+        // large feature maps already feed gemm well, stacking only adds copies
+        // stack when the weight outweighs the spatial extent of one sample
+        const Convolution* convolution = (const Convolution*)layer;
+        if (m0.w * m0.h >= convolution->num_output)
+            return 0;
+    }
+
+    return stack_type;
+}
+
+int NetPrivate::forward_layer_stacked(int layer_index, int stack_type, std::vector<std::vector<Mat> >& batch_blob_mats, std::vector<Mat>& stacked_blob_mats, const Option& opt) const
+{
+    const Layer* layer = layers[layer_index];
+    const int batch = (int)batch_blob_mats.size();
+    const int bottom_blob_index = layer->bottoms[0];
+    const int top_blob_index = layer->tops[0];
+
+    Mat& stacked = stacked_blob_mats[bottom_blob_index];
+
+    if (stack_type == 1)
+    {
+        // num_input x batch
+        for (int b = 0; b < batch; b++)
+        {
+            Mat bottom_blob = batch_blob_mats[b][bottom_blob_index];
+            if (bottom_blob.elempack != 1)
+            {
+                Mat bottom_blob_unpacked;
+                convert_packing(bottom_blob, bottom_blob_unpacked, 1, opt);
+                bottom_blob = bottom_blob_unpacked;
+                if (bottom_blob.empty())
+                    return -100;
+            }
+
+            const int size = bottom_blob.w * bottom_blob.h * bottom_blob.d;
+            if (b == 0)
+            {
+                stacked.create(size * bottom_blob.c, batch, bottom_blob.elemsize, opt.blob_allocator);
+                if (stacked.empty())
+                    return -100;
+            }
+
+            // flatten in channel order like innerproduct does
+            unsigned char* outptr = stacked.row<unsigned char>(b);
+            for (int q = 0; q < bottom_blob.c; q++)
+            {
+                memcpy(outptr + q * size * bottom_blob.elemsize, bottom_blob.channel(q), size * bottom_blob.elemsize);
+            }
+        }
+    }
+    else
+    {
+        // w x (h * batch) x c
+        const Mat& m0 = batch_blob_mats[0][bottom_blob_index];
+        const int h = m0.h;
+        stacked.create(m0.w, h * batch, m0.c, m0.elemsize, m0.elempack, opt.blob_allocator);
+        if (stacked.empty())
+            return -100;
+
+        const size_t plane_size = (size_t)m0.w * h * m0.elemsize;
+        for (int b = 0; b < batch; b++)
+        {
+            const Mat& bottom_blob = batch_blob_mats[b][bottom_blob_index];
+            for (int q = 0; q < m0.c; q++)
+            {
+                memcpy(stacked.channel(q).row<unsigned char>(b * h), bottom_blob.channel(q), plane_size);
+            }
+        }
+    }
+
+    if (opt.lightmode)
     {
-        benchmark(layer, start, end);
+        for (int b = 0; b < batch; b++)
+        {
+            // delete after taken in light mode
+            batch_blob_mats[b][bottom_blob_index].release();
+        }
     }
-#endif
+
+    int ret = forward_layer(layer_index, stacked_blob_mats, opt);
+
+    stacked.release();
+
     if (ret != 0)
         return ret;
 
-    //     NCNN_LOGE("forward_layer %d %s done", layer_index, layer->name.c_str());
-    //     const Mat& blob = blob_mats[layer->tops[0]];
-    //     NCNN_LOGE("[%-2d %-16s %-16s]  %d    blobs count = %-3d   size = %-3d x %-3d", layer_index, layer->type.c_str(), layer->name.c_str(), layer->tops[0], blob.c, blob.h, blob.w);
+    Mat top_blob = stacked_blob_mats[top_blob_index];
+    stacked_blob_mats[top_blob_index].release();
+
+    // split back to samples
+    if (stack_type == 1)
+    {
+        if (top_blob.elempack != 1)
+        {
+            Mat top_blob_unpacked;
+            convert_packing(top_blob, top_blob_unpacked, 1, opt);
+            top_blob = top_blob_unpacked;
+            if (top_blob.empty())
+                return -100;
+        }
+
+        for (int b = 0; b < batch; b++)
+        {
+            Mat& top = batch_blob_mats[b][top_blob_index];
+            top.create(top_blob.w, top_blob.elemsize, opt.blob_allocator);
+            if (top.empty())
+                return -100;
+
+            memcpy(top.data, top_blob.row<const unsigned char>(b), top_blob.w * top_blob.elemsize);
+        }
+    }
+    else
+    {
+        const int outh = top_blob.h / batch;
+        const size_t plane_size = (size_t)top_blob.w * outh * top_blob.elemsize;
+        for (int b = 0; b < batch; b++)
+        {
+            Mat& top = batch_blob_mats[b][top_blob_index];
+            top.create(top_blob.w, outh, top_blob.c, top_blob.elemsize, top_blob.elempack, opt.blob_allocator);
+            if (top.empty())
+                return -100;
+
+            for (int q = 0; q < top_blob.c; q++)
+            {
+                memcpy(top.channel(q), top_blob.channel(q).row<const unsigned char>(b * outh), plane_size);
+            }
+        }
+    }
 
     return 0;
 }
@@ -331,7 +1235,15 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
             bottom_blob = blob_mats[bottom_blob_index].shape();
         }
 #endif
-        if (layer->featmask)
+        if (opt.profiler)
+        {
+            ret = do_forward_layer_profiled(layer_index, blob_mats, opt);
+        }
+        else if (opt.stream_state && opt.stream_state->layer_slots[layer_index] != -1)
+        {
+            ret = do_forward_layer_streaming(layer_index, blob_mats, opt);
+        }
+        else if (layer->featmask)
         {
             ret = do_forward_layer(layer, blob_mats, get_masked_option(opt, layer->featmask));
         }
@@ -363,6 +1275,10 @@ int NetPrivate::forward_layer(int layer_index, std::vector<Mat>& blob_mats, std:
 
 int NetPrivate::convert_layout(Mat& bottom_blob, const Layer* layer, const Option& opt) const
 {
+    // zero sized blob carries no data, such as the empty kv cache before the first decode step
+    if (bottom_blob.dims != 0 && bottom_blob.total() == 0)
+        return 0;
+
     if (bottom_blob.elembits() == 32)
     {
         // clang-format off
@@ -679,6 +1595,194 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<Mat>& blob_mats
     return 0;
 }
 
+int NetPrivate::get_stream_state_count(const Layer* layer) const
+{
+    // graphs wiring the state through extra blobs manage it themselves
+    if (layer->bottoms.size() != 1 || layer->tops.size() != 1)
+        return 0;
+
+    // overwritten builtin layer may not be the class we know
+    for (size_t i = 0; i < overwrite_builtin_layer_registry.size(); i++)
+    {
+        if (overwrite_builtin_layer_registry[i].typeindex == layer->typeindex)
+            return 0;
+    }
+
+    // the reverse direction depends on future frames
+    if (layer->typeindex == LayerType::LSTM)
+        return ((const LSTM*)layer)->direction == 0 ? 2 : 0;
+
+    if (layer->typeindex == LayerType::GRU)
+        return ((const GRU*)layer)->direction == 0 ? 1 : 0;
+
+    if (layer->typeindex == LayerType::RNN)
+        return ((const RNN*)layer)->direction == 0 ? 1 : 0;
+
+    if (layer->typeindex == LayerType::Convolution1D)
+    {
+        // causal convolution pads exactly the receptive field minus one with zeros on the left only
+        const Convolution1D* convolution1d = (const Convolution1D*)layer;
+        const int causal_pad = convolution1d->dilation_w * (convolution1d->kernel_w - 1);
+        if (convolution1d->stride_w == 1 && causal_pad > 0 && convolution1d->pad_left == causal_pad && convolution1d->pad_right == 0 && convolution1d->pad_value == 0.f && convolution1d->dynamic_weight == 0)
+            return 1;
+    }
+
+    return 0;
+}
+
+void NetPrivate::init_stream_state(StreamState& stream_state) const
+{
+    stream_state.layer_slots.assign(layers.size(), -1);
+    stream_state.states.clear();
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        const int state_count = get_stream_state_count(layers[i]);
+        if (state_count == 0)
+            continue;
+
+        stream_state.layer_slots[i] = (int)stream_state.states.size();
+        stream_state.states.resize(stream_state.states.size() + state_count);
+    }
+}
+
+// [a b] along w, a and b have the same h and packing
+static int concat_width(const Mat& a, const Mat& b, Mat& out, Allocator* allocator)
+{
+    out.create(a.w + b.w, a.h, a.elemsize, a.elempack, allocator);
+    if (out.empty())
+        return -100;
+
+    const size_t a_size = a.w * a.elemsize;
+    const size_t b_size = b.w * b.elemsize;
+    for (int y = 0; y < a.h; y++)
+    {
+        unsigned char* outptr = out.row<unsigned char>(y);
+        memcpy(outptr, a.row<const unsigned char>(y), a_size);
+        memcpy(outptr + a_size, b.row<const unsigned char>(y), b_size);
+    }
+
+    return 0;
+}
+
+// columns [x, x + w) of m
+static int crop_width(const Mat& m, int x, int w, Mat& out, Allocator* allocator)
+{
+    out.create(w, m.h, m.elemsize, m.elempack, allocator);
+    if (out.empty())
+        return -100;
+
+    for (int y = 0; y < m.h; y++)
+    {
+        memcpy(out.row<unsigned char>(y), m.row<const unsigned char>(y) + x * m.elemsize, w * m.elemsize);
+    }
+
+    return 0;
+}
+
+int NetPrivate::do_forward_layer_streaming(int layer_index, std::vector<Mat>& blob_mats, const Option& _opt) const
+{
+    const Layer* layer = layers[layer_index];
+    const Option opt = layer->featmask ? get_masked_option(_opt, layer->featmask) : _opt;
+
+    Mat* states = &opt.stream_state->states[opt.stream_state->layer_slots[layer_index]];
+
+    const int bottom_blob_index = layer->bottoms[0];
+    const int top_blob_index = layer->tops[0];
+
+    Mat bottom_blob = blob_mats[bottom_blob_index];
+
+    int ret = convert_layout(bottom_blob, layer, opt);
+    if (ret != 0)
+        return ret;
+
+    Mat top_blob;
+    if (layer->typeindex == LayerType::Convolution1D)
+    {
+        const int context_w = ((const Convolution1D*)layer)->pad_left;
+        Mat& context = states[0];
+
+        Mat bottom_blob_bordered;
+        if (context.empty() || context.h != bottom_blob.h || context.elemsize != bottom_blob.elemsize || context.elempack != bottom_blob.elempack)
+        {
+            // the first chunk sees zero padding like a whole sequence
+            ret = layer->forward(bottom_blob, top_blob, opt);
+            if (ret != 0)
+                return ret;
+
+            Mat zeros(context_w, bottom_blob.h, bottom_blob.elemsize, bottom_blob.elempack);
+            if (zeros.empty())
+                return -100;
+
+            memset(zeros.data, 0, zeros.total() * zeros.elemsize);
+
+            ret = concat_width(zeros, bottom_blob, bottom_blob_bordered, opt.workspace_allocator);
+            if (ret != 0)
+                return ret;
+        }
+        else
+        {
+            ret = concat_width(context, bottom_blob, bottom_blob_bordered, opt.workspace_allocator);
+            if (ret != 0)
+                return ret;
+
+            // the layer still pads context_w zeros, drop the outputs over them
+            Mat top_blob_bordered;
+            ret = layer->forward(bottom_blob_bordered, top_blob_bordered, opt);
+            if (ret != 0)
+                return ret;
+
+            ret = crop_width(top_blob_bordered, context_w, top_blob_bordered.w - context_w, top_blob, opt.blob_allocator);
+            if (ret != 0)
+                return ret;
+        }
+
+        // keep the tail for the next chunk, off the arena of memory planning
+        ret = crop_width(bottom_blob_bordered, bottom_blob_bordered.w - context_w, context_w, context, 0);
+        if (ret != 0)
+            return ret;
+    }
+    else
+    {
+        const int state_count = layer->typeindex == LayerType::LSTM ? 2 : 1;
+
+        std::vector<Mat> bottom_blobs(1);
+        bottom_blobs[0] = bottom_blob;
+        if (!states[0].empty())
+        {
+            for (int i = 0; i < state_count; i++)
+            {
+                bottom_blobs.push_back(states[i]);
+            }
+        }
+
+        // asking for the state tops makes the layer hand out its last state
+        std::vector<Mat> top_blobs(1 + state_count);
+        ret = layer->forward(bottom_blobs, top_blobs, opt);
+        if (ret != 0)
+            return ret;
+
+        top_blob = top_blobs[0];
+
+        for (int i = 0; i < state_count; i++)
+        {
+            states[i] = top_blobs[1 + i].clone();
+            if (states[i].empty())
+                return -100;
+        }
+    }
+
+    blob_mats[top_blob_index] = top_blob;
+
+    if (opt.lightmode)
+    {
+        // delete after taken in light mode
+        blob_mats[bottom_blob_index].release();
+    }
+
+    return 0;
+}
+
 #if NCNN_VULKAN
 int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_mats_gpu, VkCompute& cmd, const Option& opt) const
 {
@@ -782,73 +1886,231 @@ int NetPrivate::do_forward_layer(const Layer* layer, std::vector<VkMat>& blob_ma
             if (ret != 0)
                 return ret;
 
-            // store top blobs
-            for (size_t i = 0; i < layer->tops.size(); i++)
-            {
-                int top_blob_index = layer->tops[i];
+            // store top blobs
+            for (size_t i = 0; i < layer->tops.size(); i++)
+            {
+                int top_blob_index = layer->tops[i];
+
+                blob_mats_gpu[top_blob_index] = top_blobs[i];
+            }
+        }
+
+        if (opt.lightmode)
+        {
+            for (size_t i = 0; i < layer->bottoms.size(); i++)
+            {
+                int bottom_blob_index = layer->bottoms[i];
+
+                // delete after taken in light mode
+                blob_mats_gpu[bottom_blob_index].release();
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_VULKAN
+
+void NetPrivate::update_input_output_indexes()
+{
+    input_blob_indexes.clear();
+    output_blob_indexes.clear();
+
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->typeindex == LayerType::Input)
+        {
+            int blob_index = layers[i]->tops[0];
+            input_blob_indexes.push_back(blob_index);
+        }
+    }
+
+    for (size_t i = 0; i < blobs.size(); i++)
+    {
+        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
+        {
+            output_blob_indexes.push_back(i);
+        }
+    }
+}
+
+void NetPrivate::check_execution_plan()
+{
+    if (!execution_plan_dirty)
+        return;
+
+    execution_plan_lock.lock();
+
+    if (execution_plan_dirty)
+    {
+        update_execution_plan();
+    }
+
+    execution_plan_lock.unlock();
+}
+
+void NetPrivate::update_execution_plan()
+{
+    const int layer_count = (int)layers.size();
+
+    execution_plan_dirty = false;
+    clear_needed_layers_cache();
+
+    execution_order.clear();
+    execution_position.assign(layer_count, -1);
+
+    std::vector<int> consumer_count(blobs.size(), 0);
+    blobs_single_consumer = true;
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (!layers[i])
+            continue;
+
+        for (size_t j = 0; j < layers[i]->bottoms.size(); j++)
+        {
+            if (++consumer_count[layers[i]->bottoms[j]] > 1)
+                blobs_single_consumer = false;
+        }
+    }
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (!layers[i])
+        {
+            execution_order.clear();
+            return;
+        }
+    }
+
+    execution_order.reserve(layer_count);
+
+    // iterative post-order depth first search following bottoms in order
+    // which matches the visiting order of the recursive forward_layer
+    std::vector<unsigned char> visit_state(layer_count, 0);
+    std::vector<std::pair<int, size_t> > stack;
+    for (int i = 0; i < layer_count; i++)
+    {
+        if (visit_state[i] != 0)
+            continue;
+
+        visit_state[i] = 1;
+        stack.push_back(std::make_pair(i, (size_t)0));
+
+        while (!stack.empty())
+        {
+            const int layer_index = stack.back().first;
+            const size_t bottom_i = stack.back().second;
+            const Layer* layer = layers[layer_index];
+
+            if (bottom_i < layer->bottoms.size())
+            {
+                stack.back().second++;
+
+                int producer = blobs[layer->bottoms[bottom_i]].producer;
+                if (producer == -1 || visit_state[producer] == 2)
+                    continue;
+
+                if (visit_state[producer] == 1)
+                {
+                    NCNN_LOGE("layer %d forms a cycle in graph", producer);
+                    execution_order.clear();
+                    return;
+                }
+
+                visit_state[producer] = 1;
+                stack.push_back(std::make_pair(producer, (size_t)0));
+                continue;
+            }
+
+            visit_state[layer_index] = 2;
+            execution_position[layer_index] = (int)execution_order.size();
+            execution_order.push_back(layer_index);
+            stack.pop_back();
+        }
+    }
+}
+
+#if NCNN_STRING
+void NetPrivate::update_input_output_names()
+{
+    input_blob_names.clear();
+    output_blob_names.clear();
+
+    for (size_t i = 0; i < input_blob_indexes.size(); i++)
+    {
+        int blob_index = input_blob_indexes[i];
+        input_blob_names.push_back(blobs[blob_index].name.c_str());
+    }
+
+    for (size_t i = 0; i < output_blob_indexes.size(); i++)
+    {
+        int blob_index = output_blob_indexes[i];
+        output_blob_names.push_back(blobs[blob_index].name.c_str());
+    }
+}
+#endif // NCNN_STRING
+
+PlannedAllocator* NetPrivate::acquire_planned_allocator(const std::vector<int>& shape_key)
+{
+    PlannedAllocator* allocator = 0;
 
-                blob_mats_gpu[top_blob_index] = top_blobs[i];
-            }
-        }
+    memory_plan_cache_lock.lock();
 
-        if (opt.lightmode)
+    for (size_t i = 0; i < memory_plan_cache.size(); i++)
+    {
+        if (memory_plan_cache[i].first == shape_key)
         {
-            for (size_t i = 0; i < layer->bottoms.size(); i++)
-            {
-                int bottom_blob_index = layer->bottoms[i];
-
-                // delete after taken in light mode
-                blob_mats_gpu[bottom_blob_index].release();
-            }
+            allocator = memory_plan_cache[i].second;
+            memory_plan_cache.erase(memory_plan_cache.begin() + i);
+            break;
         }
     }
 
-    return 0;
+    memory_plan_cache_lock.unlock();
+
+    return allocator;
 }
-#endif // NCNN_VULKAN
 
-void NetPrivate::update_input_output_indexes()
+void NetPrivate::reclaim_planned_allocator(const std::vector<int>& shape_key, PlannedAllocator* allocator)
 {
-    input_blob_indexes.clear();
-    output_blob_indexes.clear();
+    memory_plan_cache_lock.lock();
 
-    for (size_t i = 0; i < layers.size(); i++)
+    for (size_t i = 0; i < memory_plan_cache.size(); i++)
     {
-        if (layers[i]->typeindex == LayerType::Input)
+        if (memory_plan_cache[i].first == shape_key)
         {
-            int blob_index = layers[i]->tops[0];
-            input_blob_indexes.push_back(blob_index);
+            // another extractor planned the same shapes concurrently, keep the cached one
+            memory_plan_cache_lock.unlock();
+
+            delete allocator;
+            return;
         }
     }
 
-    for (size_t i = 0; i < blobs.size(); i++)
+    memory_plan_cache.insert(memory_plan_cache.begin(), std::make_pair(shape_key, allocator));
+
+    const size_t capacity = (size_t)std::max(opt.memory_plan_cache_size, 0);
+    while (memory_plan_cache.size() > capacity)
     {
-        if (blobs[i].producer != -1 && blobs[i].consumer == -1)
-        {
-            output_blob_indexes.push_back(i);
-        }
+        delete memory_plan_cache.back().second;
+        memory_plan_cache.pop_back();
     }
+
+    memory_plan_cache_lock.unlock();
 }
 
-#if NCNN_STRING
-void NetPrivate::update_input_output_names()
+void NetPrivate::clear_memory_plan_cache()
 {
-    input_blob_names.clear();
-    output_blob_names.clear();
+    memory_plan_cache_lock.lock();
 
-    for (size_t i = 0; i < input_blob_indexes.size(); i++)
+    for (size_t i = 0; i < memory_plan_cache.size(); i++)
     {
-        int blob_index = input_blob_indexes[i];
-        input_blob_names.push_back(blobs[blob_index].name.c_str());
+        delete memory_plan_cache[i].second;
     }
+    memory_plan_cache.clear();
 
-    for (size_t i = 0; i < output_blob_indexes.size(); i++)
-    {
-        int blob_index = output_blob_indexes[i];
-        output_blob_names.push_back(blobs[blob_index].name.c_str());
-    }
+    memory_plan_cache_lock.unlock();
 }
-#endif // NCNN_STRING
 
 Net::Net()
     : d(new NetPrivate(opt))
@@ -857,6 +2119,9 @@ Net::Net()
 
 Net::~Net()
 {
+    d->stop_async_extract();
+    d->stop_inter_op();
+
     clear();
 
     delete d;
@@ -1245,6 +2510,7 @@ int Net::load_param(const DataReader& dr)
 
     d->update_input_output_indexes();
     d->update_input_output_names();
+    d->update_execution_plan();
 
 #undef SCAN_VALUE
     return 0;
@@ -1525,6 +2791,7 @@ int Net::load_param_bin(const DataReader& dr)
     }
 
     d->update_input_output_indexes();
+    d->update_execution_plan();
 
 #undef READ_VALUE
     return 0;
@@ -1615,6 +2882,9 @@ int Net::load_model(const DataReader& dr)
         }
     }
 
+    // graph may have been edited through mutable_layers() since load_param
+    d->update_execution_plan();
+
 #if NCNN_VULKAN
     if (ret == 0 && opt.use_vulkan_compute)
     {
@@ -1694,6 +2964,154 @@ int Net::load_model(const char* modelpath)
     fclose(fp);
     return ret;
 }
+
+// bounded reader over the whole model file mapping
+class DataReaderFromModelMapping : public DataReader
+{
+public:
+    DataReaderFromModelMapping(const unsigned char* _mem, size_t _size)
+        : mem(_mem), end(_mem + _size)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size > (size_t)(end - mem))
+            return 0;
+
+        memcpy(buf, mem, size);
+        mem += size;
+        return size;
+    }
+
+    virtual size_t reference(size_t size, const void** buf) const
+    {
+        if (size > (size_t)(end - mem))
+            return 0;
+
+        *buf = mem;
+        mem += size;
+        return size;
+    }
+
+    mutable const unsigned char* mem;
+    const unsigned char* end;
+};
+
+static void* map_model_file(const char* modelpath, size_t* size)
+{
+#if defined _WIN32
+    HANDLE file = CreateFileA(modelpath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return 0;
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        return 0;
+    }
+
+    // copy-on-write view, pages stay shared until a layer writes its weights in place
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!mapping)
+        return 0;
+
+    void* ptr = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    CloseHandle(mapping);
+    if (!ptr)
+        return 0;
+
+    *size = (size_t)file_size.QuadPart;
+    return ptr;
+#elif NCNN_MMAP_POSIX
+    int fd = open(modelpath, O_RDONLY);
+    if (fd < 0)
+        return 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0)
+    {
+        close(fd);
+        return 0;
+    }
+
+    // copy-on-write mapping, pages stay shared until a layer writes its weights in place
+    void* ptr = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+        return 0;
+
+    *size = (size_t)st.st_size;
+    return ptr;
+#else
+    // no mmap on this platform, read the whole file into aligned memory
+    FILE* fp = fopen(modelpath, "rb");
+    if (!fp)
+        return 0;
+
+    fseek(fp, 0, SEEK_END);
+    long file_size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (file_size <= 0)
+    {
+        fclose(fp);
+        return 0;
+    }
+
+    void* ptr = fastMalloc((size_t)file_size);
+    size_t nread = fread(ptr, 1, (size_t)file_size, fp);
+    fclose(fp);
+    if (nread != (size_t)file_size)
+    {
+        fastFree(ptr);
+        return 0;
+    }
+
+    *size = (size_t)file_size;
+    return ptr;
+#endif
+}
+
+static void unmap_model_file(void* ptr, size_t size)
+{
+#if defined _WIN32
+    (void)size;
+    UnmapViewOfFile(ptr);
+#elif NCNN_MMAP_POSIX
+    munmap(ptr, size);
+#else
+    (void)size;
+    fastFree(ptr);
+#endif
+}
+
+int Net::load_model_mmap(const char* modelpath)
+{
+    size_t size = 0;
+    void* mapping = map_model_file(modelpath, &size);
+    if (!mapping)
+    {
+        NCNN_LOGE("map %s failed", modelpath);
+        return -1;
+    }
+
+    DataReaderFromModelMapping dr((const unsigned char*)mapping, size);
+    int ret = load_model(dr);
+
+    // weights from a previous load_model_mmap call have been replaced by now
+    if (d->model_mapping)
+    {
+        unmap_model_file(d->model_mapping, d->model_mapping_size);
+    }
+
+    // keep the mapping even on failure, partially loaded layers may reference it
+    d->model_mapping = mapping;
+    d->model_mapping_size = size;
+
+    return ret;
+}
 #endif // NCNN_STDIO
 
 int Net::load_param(const unsigned char* _mem)
@@ -1831,6 +3249,18 @@ void Net::clear()
         }
     }
     d->layers.clear();
+    d->execution_order.clear();
+    d->execution_position.clear();
+    d->clear_needed_layers_cache();
+
+#if NCNN_STDIO
+    if (d->model_mapping)
+    {
+        unmap_model_file(d->model_mapping, d->model_mapping_size);
+        d->model_mapping = 0;
+        d->model_mapping_size = 0;
+    }
+#endif // NCNN_STDIO
 
     if (d->local_blob_allocator)
     {
@@ -1843,6 +3273,8 @@ void Net::clear()
         d->local_workspace_allocator = 0;
     }
 
+    d->clear_memory_plan_cache();
+
 #if NCNN_VULKAN
     if (d->weight_vkallocator)
     {
@@ -1865,6 +3297,9 @@ void Net::clear()
 
 Extractor Net::create_extractor() const
 {
+    // graph may have been rewired through mutable_layers() or mutable_blobs() since load_model
+    d->check_execution_plan();
+
     return Extractor(this, d->blobs.size());
 }
 
@@ -1902,11 +3337,15 @@ const std::vector<Layer*>& Net::layers() const
 
 std::vector<Blob>& Net::mutable_blobs()
 {
+    // the caller may rewire the graph, rebuild the plan on next create_extractor
+    d->execution_plan_dirty = true;
     return d->blobs;
 }
 
 std::vector<Layer*>& Net::mutable_layers()
 {
+    // the caller may rewire the graph, rebuild the plan on next create_extractor
+    d->execution_plan_dirty = true;
     return d->layers;
 }
 
@@ -2035,13 +3474,48 @@ class ExtractorPrivate
 {
 public:
     ExtractorPrivate(const Net* _net)
-        : net(_net)
+        : net(_net), forwarded(false), planned_allocator(0), planned_pass_started(false), async_pending(0), inter_op_threads(1)
     {
     }
     const Net* net;
     std::vector<Mat> blob_mats;
     Option opt;
 
+    // blobs fed through input() since clear, sorted
+    std::vector<int> fed_blobs;
+    // any layer has run since clear, blob_mats may hold more than fed_blobs
+    bool forwarded;
+
+    // scratch for execution plan
+    std::vector<unsigned char> layer_needed;
+    std::vector<int> needed_layers;
+
+    // per sample blob mats in batch mode
+    std::vector<std::vector<Mat> > batch_blob_mats;
+    std::vector<Mat> batch_stacked_blob_mats;
+
+    PlannedAllocator* planned_allocator;
+    // input shapes the memory plan of planned_allocator belongs to, empty if not bound
+    std::vector<int> planned_shape_key;
+    // planned_allocator has been bound to the input shapes of this pass
+    bool planned_pass_started;
+
+    // swap in the memory plan cached by net for the current input shapes
+    void bind_memory_plan(NetPrivate* net_d);
+
+    // mark the extract_async done and wake up wait()
+    void finish_async();
+
+    // extract_async queued or running, at most one
+    int async_pending;
+    Mutex async_lock;
+    ConditionVariable async_condition;
+
+    int inter_op_threads;
+
+    // state carried across passes, opt.stream_state points here when streaming
+    StreamState stream_state;
+
 #if NCNN_VULKAN
     VkAllocator* local_blob_vkallocator;
     VkAllocator* local_staging_vkallocator;
@@ -2050,6 +3524,249 @@ public:
 #endif // NCNN_VULKAN
 };
 
+void ExtractorPrivate::bind_memory_plan(NetPrivate* net_d)
+{
+    planned_pass_started = true;
+
+    if (net_d->opt.memory_plan_cache_size <= 0)
+        return;
+
+    // blob index and shape of every blob fed before the first forward of this pass
+    std::vector<int> shape_key;
+    for (size_t i = 0; i < blob_mats.size(); i++)
+    {
+        const Mat& m = blob_mats[i];
+        if (m.dims == 0)
+            continue;
+
+        shape_key.push_back((int)i);
+        shape_key.push_back(m.dims);
+        shape_key.push_back(m.w);
+        shape_key.push_back(m.h);
+        shape_key.push_back(m.d);
+        shape_key.push_back(m.c);
+        shape_key.push_back((int)m.elemsize);
+        shape_key.push_back(m.elempack);
+    }
+
+    if (shape_key == planned_shape_key)
+        return;
+
+    PlannedAllocator* allocator = net_d->acquire_planned_allocator(shape_key);
+    if (!allocator && planned_shape_key.empty())
+    {
+        // the fresh allocator has recorded nothing yet, use it for these shapes
+        planned_shape_key = shape_key;
+        return;
+    }
+
+    if (!allocator)
+    {
+        allocator = new PlannedAllocator;
+    }
+
+    if (planned_shape_key.empty())
+    {
+        delete planned_allocator;
+    }
+    else
+    {
+        net_d->reclaim_planned_allocator(planned_shape_key, planned_allocator);
+    }
+
+    allocator->begin();
+
+    planned_allocator = allocator;
+    planned_shape_key = shape_key;
+
+    opt.blob_allocator = planned_allocator;
+    opt.workspace_allocator = planned_allocator;
+}
+
+void ExtractorPrivate::finish_async()
+{
+    async_lock.lock();
+    async_pending = 0;
+    async_condition.broadcast();
+    async_lock.unlock();
+}
+
+void* NetPrivate::async_extract_worker(void* args)
+{
+    NetPrivate* d = (NetPrivate*)args;
+
+    for (;;)
+    {
+        d->async_lock.lock();
+
+        while (!d->async_stopping && d->async_queue.empty())
+        {
+            d->async_condition.wait(d->async_lock);
+        }
+
+        if (d->async_queue.empty())
+        {
+            // stopping and drained
+            d->async_lock.unlock();
+            break;
+        }
+
+        AsyncExtractTask task = d->async_queue.front();
+        d->async_queue.erase(d->async_queue.begin());
+
+        d->async_lock.unlock();
+
+        Mat feat;
+        int ret = task.ex->extract(task.blob_index, feat, task.type);
+        task.callback(ret, feat, task.userdata);
+
+        task.exd->finish_async();
+    }
+
+    return 0;
+}
+
+void NetPrivate::submit_async_extract(Extractor* ex, ExtractorPrivate* exd, int blob_index, Extractor::extract_callback callback, void* userdata, int type)
+{
+#if NCNN_THREADS
+    AsyncExtractTask task;
+    task.ex = ex;
+    task.exd = exd;
+    task.blob_index = blob_index;
+    task.type = type;
+    task.callback = callback;
+    task.userdata = userdata;
+
+    async_lock.lock();
+
+    if (async_threads.empty())
+    {
+        const int thread_count = std::max(opt.async_extract_threads, 1);
+        for (int i = 0; i < thread_count; i++)
+        {
+            async_threads.push_back(new Thread(async_extract_worker, this));
+        }
+    }
+
+    async_queue.push_back(task);
+    async_condition.signal();
+
+    async_lock.unlock();
+#else
+    // no threads, run in place
+    Mat feat;
+    int ret = ex->extract(blob_index, feat, type);
+    callback(ret, feat, userdata);
+
+    exd->finish_async();
+#endif // NCNN_THREADS
+}
+
+void NetPrivate::stop_async_extract()
+{
+    async_lock.lock();
+    async_stopping = true;
+    async_condition.broadcast();
+    async_lock.unlock();
+
+    for (size_t i = 0; i < async_threads.size(); i++)
+    {
+        async_threads[i]->join();
+        delete async_threads[i];
+    }
+    async_threads.clear();
+
+    async_stopping = false;
+}
+
+static int convert_output_blob(Mat& feat, int type, const Option& opt, const Allocator* local_blob_allocator, const Allocator* planned_allocator)
+{
+    // empty is valid for outputs
+    if (feat.empty())
+        return 0;
+
+    if (opt.use_packing_layout && (type == 0) && feat.elempack != 1)
+    {
+        Mat bottom_blob_unpacked;
+        convert_packing(feat, bottom_blob_unpacked, 1, opt);
+        feat = bottom_blob_unpacked;
+        if (feat.empty())
+            return -100;
+    }
+
+    // clang-format off
+    // *INDENT-OFF*
+#if NCNN_ARM82
+    if (opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_ARM82
+#if NCNN_VFPV4
+    if (opt.use_fp16_storage && !opt.use_bf16_storage && cpu_support_arm_vfpv4() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_VFPV4
+#if NCNN_ZVFH
+    if (opt.use_fp16_storage && cpu_support_riscv_zvfh() && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_float16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_ZVFH
+#if NCNN_BF16
+    if (opt.use_bf16_storage && (type == 0))
+    {
+        if (feat.elembits() == 16)
+        {
+            Mat feat_fp32;
+            cast_bfloat16_to_float32(feat, feat_fp32, opt);
+            feat = feat_fp32;
+        }
+    }
+    else
+#endif // NCNN_BF16
+    if (feat.elembits() == 8 && (type == 0))
+    {
+        Mat feat_fp32;
+        cast_int8_to_float32(feat, feat_fp32, opt);
+        feat = feat_fp32;
+    }
+    // *INDENT-ON*
+    // clang-format on
+    if (feat.empty())
+        return -100;
+
+    if (feat.allocator && (feat.allocator == local_blob_allocator || feat.allocator == planned_allocator))
+    {
+        // detach the returned mat from local pool allocator
+        // so we could destroy net instance much earlier
+        feat = feat.clone();
+        if (feat.empty())
+            return -100;
+    }
+
+    return 0;
+}
+
 Extractor::Extractor(const Net* _net, size_t blob_count)
     : d(new ExtractorPrivate(_net))
 {
@@ -2069,8 +3786,20 @@ Extractor::Extractor(const Net* _net, size_t blob_count)
 
 Extractor::~Extractor()
 {
+    wait();
+
     clear();
 
+    if (d->planned_allocator && !d->planned_shape_key.empty())
+    {
+        // keep the memory plan for the next extractor fed with the same shapes
+        d->net->d->reclaim_planned_allocator(d->planned_shape_key, d->planned_allocator);
+    }
+    else
+    {
+        delete d->planned_allocator;
+    }
+
     delete d;
 }
 
@@ -2079,7 +3808,25 @@ Extractor::Extractor(const Extractor& rhs)
 {
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->fed_blobs = rhs.d->fed_blobs;
+    d->forwarded = rhs.d->forwarded;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
+    d->inter_op_threads = rhs.d->inter_op_threads;
+
+    // fork the stream with its own copy of the state
+    d->stream_state.layer_slots = rhs.d->stream_state.layer_slots;
+    rhs.save_state(d->stream_state.states);
+    if (rhs.d->opt.stream_state)
+    {
+        d->opt.stream_state = &d->stream_state;
+    }
+
+    // never share the arena with another extractor
+    if (rhs.d->planned_allocator && rhs.d->opt.blob_allocator == rhs.d->planned_allocator)
+    {
+        set_memory_planning(true);
+    }
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2094,9 +3841,27 @@ Extractor& Extractor::operator=(const Extractor& rhs)
     if (this == &rhs)
         return *this;
 
+    wait();
+
     d->net = rhs.d->net;
     d->blob_mats = rhs.d->blob_mats;
+    d->fed_blobs = rhs.d->fed_blobs;
+    d->forwarded = rhs.d->forwarded;
+    d->batch_blob_mats = rhs.d->batch_blob_mats;
     d->opt = rhs.d->opt;
+    d->inter_op_threads = rhs.d->inter_op_threads;
+
+    d->stream_state.layer_slots = rhs.d->stream_state.layer_slots;
+    rhs.save_state(d->stream_state.states);
+    if (rhs.d->opt.stream_state)
+    {
+        d->opt.stream_state = &d->stream_state;
+    }
+
+    if (rhs.d->planned_allocator && rhs.d->opt.blob_allocator == rhs.d->planned_allocator)
+    {
+        set_memory_planning(true);
+    }
 
 #if NCNN_VULKAN
     d->local_blob_vkallocator = 0;
@@ -2110,7 +3875,22 @@ Extractor& Extractor::operator=(const Extractor& rhs)
 
 void Extractor::clear()
 {
-    d->blob_mats.clear();
+    for (size_t i = 0; i < d->blob_mats.size(); i++)
+    {
+        d->blob_mats[i].release();
+    }
+
+    d->batch_blob_mats.clear();
+    d->batch_stacked_blob_mats.clear();
+
+    d->fed_blobs.clear();
+    d->forwarded = false;
+
+    if (d->planned_allocator && d->opt.blob_allocator == d->planned_allocator)
+    {
+        d->planned_allocator->begin();
+    }
+    d->planned_pass_started = false;
 
 #if NCNN_VULKAN
     if (d->opt.use_vulkan_compute)
@@ -2152,6 +3932,98 @@ void Extractor::set_workspace_allocator(Allocator* allocator)
     d->opt.workspace_allocator = allocator;
 }
 
+void Extractor::set_memory_planning(bool enable)
+{
+    if (enable)
+    {
+        if (!d->planned_allocator)
+        {
+            d->planned_allocator = new PlannedAllocator;
+        }
+
+        d->planned_allocator->begin();
+
+        d->opt.blob_allocator = d->planned_allocator;
+        d->opt.workspace_allocator = d->planned_allocator;
+    }
+    else if (d->planned_allocator)
+    {
+        // keep the allocator alive for blobs already planned
+        d->opt.blob_allocator = d->net->opt.blob_allocator;
+        d->opt.workspace_allocator = d->net->opt.workspace_allocator;
+    }
+}
+
+size_t Extractor::memory_plan_size() const
+{
+    return d->planned_allocator ? d->planned_allocator->peak_size() : 0;
+}
+
+void Extractor::set_inter_op_threads(int inter_op_threads)
+{
+    d->inter_op_threads = std::max(inter_op_threads, 1);
+}
+
+void Extractor::set_streaming(bool enable)
+{
+    if (enable)
+    {
+        if (d->stream_state.layer_slots.empty())
+        {
+            d->net->d->init_stream_state(d->stream_state);
+        }
+
+        d->opt.stream_state = &d->stream_state;
+    }
+    else
+    {
+        d->opt.stream_state = 0;
+    }
+}
+
+void Extractor::reset_state()
+{
+    for (size_t i = 0; i < d->stream_state.states.size(); i++)
+    {
+        d->stream_state.states[i].release();
+    }
+}
+
+void Extractor::save_state(std::vector<Mat>& states) const
+{
+    states.resize(d->stream_state.states.size());
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        states[i] = d->stream_state.states[i].clone();
+    }
+}
+
+int Extractor::restore_state(const std::vector<Mat>& states)
+{
+    if (d->stream_state.layer_slots.empty())
+    {
+        d->net->d->init_stream_state(d->stream_state);
+    }
+
+    if (states.size() != d->stream_state.states.size())
+    {
+        NCNN_LOGE("restore_state expects %d state mats but got %d", (int)d->stream_state.states.size(), (int)states.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < states.size(); i++)
+    {
+        d->stream_state.states[i] = states[i].clone();
+    }
+
+    return 0;
+}
+
+void Extractor::set_profiler(Profiler* profiler)
+{
+    d->opt.profiler = profiler;
+}
+
 #if NCNN_VULKAN
 void Extractor::set_vulkan_compute(bool enable)
 {
@@ -2220,6 +4092,29 @@ int Extractor::input(int blob_index, const Mat& in)
 
     d->blob_mats[blob_index] = in;
 
+    for (size_t b = 0; b < d->batch_blob_mats.size(); b++)
+    {
+        d->batch_blob_mats[b][blob_index] = in;
+    }
+
+    // keep fed_blobs sorted, it keys the needed layers cache
+    if (in.dims != 0)
+    {
+        size_t k = d->fed_blobs.size();
+        while (k > 0 && d->fed_blobs[k - 1] > blob_index)
+            k--;
+
+        if (k == 0 || d->fed_blobs[k - 1] != blob_index)
+        {
+            d->fed_blobs.push_back(blob_index);
+            for (size_t m = d->fed_blobs.size() - 1; m > k; m--)
+            {
+                d->fed_blobs[m] = d->fed_blobs[m - 1];
+            }
+            d->fed_blobs[k] = blob_index;
+        }
+    }
+
     return 0;
 }
 
@@ -2253,6 +4148,15 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
             }
         }
 
+        // pick the memory plan of the input shapes on the first forward of this pass
+        if (d->planned_allocator && d->opt.blob_allocator == d->planned_allocator && !d->planned_pass_started)
+        {
+            d->bind_memory_plan(d->net->d);
+        }
+
+        // the memory plan replays one fixed allocation sequence, concurrent branches would reorder it
+        const int inter_op_threads = d->planned_allocator && d->opt.blob_allocator == d->planned_allocator ? 1 : d->inter_op_threads;
+
 #if NCNN_VULKAN
         if (d->opt.use_vulkan_compute)
         {
@@ -2304,101 +4208,208 @@ int Extractor::extract(int blob_index, Mat& feat, int type)
         }
         else
         {
-            ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+            ret = d->net->d->forward_plan_parallel(layer_index, d->blob_mats, d->forwarded ? 0 : &d->fed_blobs, d->layer_needed, d->needed_layers, inter_op_threads, d->opt);
         }
 #else
-        ret = d->net->d->forward_layer(layer_index, d->blob_mats, d->opt);
+        ret = d->net->d->forward_plan_parallel(layer_index, d->blob_mats, d->forwarded ? 0 : &d->fed_blobs, d->layer_needed, d->needed_layers, inter_op_threads, d->opt);
 #endif // NCNN_VULKAN
+
+        d->forwarded = true;
     }
 
     feat = d->blob_mats[blob_index];
 
-    // empty is valid for outputs
-    if (!feat.empty())
+    int cret = convert_output_blob(feat, type, d->opt, d->opt.use_local_pool_allocator ? d->net->d->local_blob_allocator : 0, d->planned_allocator);
+
+    set_kmp_blocktime(old_blocktime);
+    set_flush_denormals(old_flush_denormals);
+
+    if (cret != 0)
+        return cret;
+
+    return ret;
+}
+
+#if NCNN_STRING
+int Extractor::extract_async(const char* blob_name, extract_callback callback, void* userdata, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
     {
-        if (d->opt.use_packing_layout && (type == 0) && feat.elempack != 1)
-        {
-            Mat bottom_blob_unpacked;
-            convert_packing(feat, bottom_blob_unpacked, 1, d->opt);
-            feat = bottom_blob_unpacked;
-            if (feat.empty())
-                return -100;
-        }
+        NCNN_LOGE("extract_async blob %s not found", blob_name);
+        return -1;
+    }
 
-        // clang-format off
-        // *INDENT-OFF*
-#if NCNN_ARM82
-        if (d->opt.use_fp16_storage && cpu_support_arm_asimdhp() && (type == 0))
+    return extract_async(blob_index, callback, userdata, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::extract_async(int blob_index, extract_callback callback, void* userdata, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (!callback)
+    {
+        NCNN_LOGE("extract_async callback is null");
+        return -1;
+    }
+
+    // one in flight per extractor
+    wait();
+
+    d->async_lock.lock();
+    d->async_pending = 1;
+    d->async_lock.unlock();
+
+    d->net->d->submit_async_extract(this, d, blob_index, callback, userdata, type);
+
+    return 0;
+}
+
+void Extractor::wait()
+{
+    d->async_lock.lock();
+    while (d->async_pending)
+    {
+        d->async_condition.wait(d->async_lock);
+    }
+    d->async_lock.unlock();
+}
+
+#if NCNN_STRING
+int Extractor::input(const char* blob_name, const std::vector<Mat>& in)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& input_names = d->net->input_names();
+        for (size_t i = 0; i < input_names.size(); i++)
         {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
+            NCNN_LOGE("    ex.input(\"%s\", in%d);", input_names[i], (int)i);
         }
-        else
-#endif // NCNN_ARM82
-#if NCNN_VFPV4
-        if (d->opt.use_fp16_storage && !d->opt.use_bf16_storage && cpu_support_arm_vfpv4() && (type == 0))
+
+        return -1;
+    }
+
+    return input(blob_index, in);
+}
+
+int Extractor::extract(const char* blob_name, std::vector<Mat>& feats, int type)
+{
+    int blob_index = d->net->find_blob_index_by_name(blob_name);
+    if (blob_index == -1)
+    {
+        NCNN_LOGE("Try");
+        const std::vector<const char*>& output_names = d->net->output_names();
+        for (size_t i = 0; i < output_names.size(); i++)
         {
-            if (feat.elembits() == 16)
-            {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
-            }
+            NCNN_LOGE("    ex.extract(\"%s\", out%d);", output_names[i], (int)i);
         }
-        else
-#endif // NCNN_VFPV4
-#if NCNN_ZVFH
-        if (d->opt.use_fp16_storage && cpu_support_riscv_zvfh() && (type == 0))
+
+        return -1;
+    }
+
+    return extract(blob_index, feats, type);
+}
+#endif // NCNN_STRING
+
+int Extractor::input(int blob_index, const std::vector<Mat>& in)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size() || in.empty())
+        return -1;
+
+    if (d->batch_blob_mats.empty())
+    {
+        // enter batch mode, blobs set so far are shared by all samples
+        d->batch_blob_mats.resize(in.size(), d->blob_mats);
+    }
+    else if (d->batch_blob_mats.size() != in.size())
+    {
+        NCNN_LOGE("batch size mismatch %d vs %d", (int)in.size(), (int)d->batch_blob_mats.size());
+        return -1;
+    }
+
+    for (size_t b = 0; b < in.size(); b++)
+    {
+        d->batch_blob_mats[b][blob_index] = in[b];
+    }
+
+    return 0;
+}
+
+int Extractor::extract(int blob_index, std::vector<Mat>& feats, int type)
+{
+    if (blob_index < 0 || blob_index >= (int)d->blob_mats.size())
+        return -1;
+
+    if (d->batch_blob_mats.empty())
+    {
+        // no batch input, a batch of one
+        feats.resize(1);
+        return extract(blob_index, feats[0], type);
+    }
+
+#if NCNN_VULKAN
+    if (d->opt.use_vulkan_compute)
+    {
+        NCNN_LOGE("batch extract is not supported with vulkan compute");
+        return -1;
+    }
+#endif // NCNN_VULKAN
+
+    int old_blocktime = get_kmp_blocktime();
+    set_kmp_blocktime(d->opt.openmp_blocktime);
+
+    int old_flush_denormals = get_flush_denormals();
+    set_flush_denormals(d->opt.flush_denormals);
+
+    int ret = 0;
+
+    if (d->batch_blob_mats[0][blob_index].dims == 0)
+    {
+        int layer_index = d->net->blobs()[blob_index].producer;
+
+        // use local allocator
+        if (d->opt.use_local_pool_allocator)
         {
-            if (feat.elembits() == 16)
+            if (!d->opt.blob_allocator)
             {
-                Mat feat_fp32;
-                cast_float16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
+                d->opt.blob_allocator = d->net->d->local_blob_allocator;
             }
-        }
-        else
-#endif // NCNN_ZVFH
-#if NCNN_BF16
-        if (d->opt.use_bf16_storage && (type == 0))
-        {
-            if (feat.elembits() == 16)
+            if (!d->opt.workspace_allocator)
             {
-                Mat feat_fp32;
-                cast_bfloat16_to_float32(feat, feat_fp32, d->opt);
-                feat = feat_fp32;
+                d->opt.workspace_allocator = d->net->d->local_workspace_allocator;
             }
         }
-        else
-#endif // NCNN_BF16
-        if (feat.elembits() == 8 && (type == 0))
-        {
-            Mat feat_fp32;
-            cast_int8_to_float32(feat, feat_fp32, d->opt);
-            feat = feat_fp32;
-        }
-        // *INDENT-ON*
-        // clang-format on
-        if (feat.empty())
-            return -100;
 
-        if (d->opt.use_local_pool_allocator && feat.allocator == d->net->d->local_blob_allocator)
-        {
-            // detach the returned mat from local pool allocator
-            // so we could destroy net instance much earlier
-            feat = feat.clone();
-            if (feat.empty())
-                return -100;
-        }
+        // samples of a batch are independent sequences, carry no state across them
+        Option opt = d->opt;
+        opt.stream_state = 0;
+
+        ret = d->net->d->forward_plan_batch(layer_index, d->batch_blob_mats, d->batch_stacked_blob_mats, d->layer_needed, d->needed_layers, opt);
+    }
+
+    const size_t batch = d->batch_blob_mats.size();
+    feats.resize(batch);
+
+    int cret = 0;
+    for (size_t b = 0; b < batch; b++)
+    {
+        feats[b] = d->batch_blob_mats[b][blob_index];
+
+        cret = convert_output_blob(feats[b], type, d->opt, d->opt.use_local_pool_allocator ? d->net->d->local_blob_allocator : 0, d->planned_allocator);
+        if (cret != 0)
+            break;
     }
 
     set_kmp_blocktime(old_blocktime);
     set_flush_denormals(old_flush_denormals);
 
+    if (cret != 0)
+        return cret;
+
     return ret;
 }
 
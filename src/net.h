@@ -81,6 +81,13 @@ public:
     // return 0 if success
     int load_model(FILE* fp);
     int load_model(const char* modelpath);
+
+    // map model file into memory read-only and reference weight data from the mapping
+    // weight data is not copied and the pages are shared by all processes mapping the same file
+    // the mapping is retained until clear()
+    // weights written by ncnnoptimize with aligned flag start at 64-byte aligned address
+    // return 0 if success
+    int load_model_mmap(const char* modelpath);
 #endif // NCNN_STDIO
 
     // load network structure from external memory
@@ -129,6 +136,8 @@ public:
     const std::vector<Blob>& blobs() const;
     const std::vector<Layer*>& layers() const;
 
+    // the execution plan is rebuilt on the next create_extractor() after these are called
+    // fetch them again for every edit of the graph instead of keeping the reference around
     std::vector<Blob>& mutable_blobs();
     std::vector<Layer*>& mutable_layers();
 
@@ -164,6 +173,7 @@ public:
     Extractor& operator=(const Extractor&);
 
     // clear blob mats and alloctors
+    // the extractor can be fed with new input afterwards
     void clear();
 
     // enable light mode
@@ -181,6 +191,33 @@ public:
     // set workspace memory allocator
     void set_workspace_allocator(Allocator* allocator);
 
+    // enable memory planning
+    // blob and workspace memory of one pass are planned into a single arena
+    // the first pass records blob lifetimes, later passes with the same input shapes
+    // perform no heap allocation, call clear() to start the next pass
+    // changed input shapes fall back to dynamic allocation and record a new plan
+    // plans are kept by net keyed by input shapes, up to net.opt.memory_plan_cache_size of them
+    // so a new extractor or a return to earlier input shapes reuses the plan recorded before
+    // overrides blob and workspace allocator when enabled
+    void set_memory_planning(bool enable);
+
+    // arena size in bytes of the current memory plan, 0 if not planned yet
+    size_t memory_plan_size() const;
+
+    // run independent graph branches concurrently on inter_op_threads threads
+    // every concurrent layer still uses net.opt.num_threads for intra-op work
+    // so split the cores by setting net.opt.num_threads = cores / inter_op_threads before net.load_param()
+    // blob and workspace allocator should be thread-safe when enabled
+    // the helper threads are owned by the net and reused across extracts
+    // memory planning keeps branches serial, the plan needs one fixed allocation order
+    // default is 1, branches run one after another
+    void set_inter_op_threads(int inter_op_threads);
+
+    // record every cpu layer forward of this extractor into profiler
+    // wall time, thread, input and output shapes, output bytes and the layer implementation
+    // pass null to stop, the profiler must outlive the extractor runs
+    void set_profiler(Profiler* profiler);
+
 #if NCNN_VULKAN
     // deprecated, no-op
     // instead, set net.opt.use_vulkan_compute before net.load_param()
@@ -215,6 +252,64 @@ public:
     // type = 1, do not convert fp16/bf16 or / and packing
     int extract(int blob_index, Mat& feat, int type = 0);
 
+#if NCNN_STRING
+    // set batch input by blob name
+    // each sample goes through the graph layer by layer together with the others
+    // pointwise convolution and innerproduct forward the whole batch in one gemm
+    // blobs set by the single mat input are shared by all samples
+    // return 0 if success
+    int input(const char* blob_name, const std::vector<Mat>& in);
+
+    // get batch result by blob name
+    // return 0 if success
+    int extract(const char* blob_name, std::vector<Mat>& feats, int type = 0);
+#endif // NCNN_STRING
+
+    // set batch input by blob index
+    // return 0 if success
+    int input(int blob_index, const std::vector<Mat>& in);
+
+    // get batch result by blob index
+    // return 0 if success
+    int extract(int blob_index, std::vector<Mat>& feats, int type = 0);
+
+    // carry state across passes for chunked streaming input
+    // lstm gru rnn in forward direction keep their last hidden and cell state
+    // convolution1d with stride 1 and left padding only keeps the tail of its input as left context
+    // feed one chunk per pass and call clear() in between, the carried state survives clear()
+    void set_streaming(bool enable);
+
+    // forget the carried state, the next chunk starts a new stream
+    void reset_state();
+
+    // copy out the carried state
+    // the list is only meaningful to restore_state of an extractor from the same net
+    void save_state(std::vector<Mat>& states) const;
+
+    // bring back the carried state from save_state
+    // return 0 if success
+    int restore_state(const std::vector<Mat>& states);
+
+    // completion callback of extract_async, runs on an async thread
+    // ret is the extract return value, keep a copy of feat to use it afterwards
+    typedef void (*extract_callback)(int ret, Mat& feat, void* userdata);
+
+#if NCNN_STRING
+    // run extract by blob name on the net async threads and return at once
+    // return 0 if queued
+    int extract_async(const char* blob_name, extract_callback callback, void* userdata = 0, int type = 0);
+#endif // NCNN_STRING
+
+    // run extract by blob index on the net async threads and return at once
+    // do not touch the extractor until the callback has run, wait() blocks for it
+    // one extract in flight per extractor, a second call waits for the previous one
+    // return 0 if queued
+    int extract_async(int blob_index, extract_callback callback, void* userdata = 0, int type = 0);
+
+    // block until the extract_async of this extractor has finished its callback
+    // must not be called from the callback
+    void wait();
+
 #if NCNN_VULKAN
 #if NCNN_STRING
     // set input by blob name
@@ -67,9 +67,19 @@ Option::Option()
     use_fp16_uniform = true;
     use_int8_uniform = true;
 
-    use_reserved_9 = false;
+    use_sparse_weight = false;
     use_reserved_10 = false;
     use_reserved_11 = false;
+
+    packed_weight_cache = 0;
+
+    profiler = 0;
+
+    memory_plan_cache_size = 4;
+
+    async_extract_threads = 2;
+
+    stream_state = 0;
 }
 
 } // namespace ncnn
@@ -14,6 +14,9 @@ class PipelineCache;
 #endif // NCNN_VULKAN
 
 class Allocator;
+class PackedWeightCache;
+class Profiler;
+class StreamState;
 class NCNN_EXPORT Option
 {
 public:
@@ -141,9 +144,37 @@ public:
     bool use_fp16_uniform;
     bool use_int8_uniform;
 
-    bool use_reserved_9;
+    // run pruned 1x1 convolution and innerproduct with sparse weight kernels
+    // only takes effect when enough weights are zero for the sparse kernels to beat dense
+    // off by default, sparse layers skip the packed weight cache and change the summation order
+    bool use_sparse_weight;
+
     bool use_reserved_10;
     bool use_reserved_11;
+
+    // cache of weights packed by cpu layer create_pipeline
+    // changes should be applied before loading network weight
+    // default value is null
+    PackedWeightCache* packed_weight_cache;
+
+    // record every cpu layer forward
+    // default value is null
+    Profiler* profiler;
+
+    // number of memory plans kept by net for extractors with memory planning enabled
+    // plans are keyed by input shapes, the least recently used one is dropped first
+    // 0 = every extractor plans on its own
+    // default value is 4
+    int memory_plan_cache_size;
+
+    // number of threads running Extractor::extract_async, started on first use
+    // default value is 2
+    int async_extract_threads;
+
+    // recurrent hidden state and causal convolution context carried across passes
+    // owned by the extractor, see Extractor::set_streaming
+    // default value is null
+    StreamState* stream_state;
 };
 
 } // namespace ncnn
@@ -0,0 +1,592 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "packedweightcache.h"
+
+#include "cpu.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+// https://en.wikipedia.org/wiki/MurmurHash
+// incremental variant, trailing bytes of each feed are zero padded to a whole word
+class murmur3_32_state
+{
+public:
+    murmur3_32_state()
+        : h(0), size(0)
+    {
+    }
+
+    void feed(const void* data, size_t nbytes)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+
+        const size_t nwords = nbytes / 4;
+        for (size_t i = 0; i < nwords; i++)
+        {
+            uint32_t k;
+            memcpy(&k, p, 4);
+            p += 4;
+
+            mix(k);
+        }
+
+        const size_t remain = nbytes % 4;
+        if (remain)
+        {
+            uint32_t k = 0;
+            memcpy(&k, p, remain);
+            mix(k);
+        }
+
+        size += (uint32_t)nbytes;
+    }
+
+    uint32_t finish() const
+    {
+        uint32_t r = h;
+
+        r ^= size;
+
+        r ^= r >> 16;
+        r *= 0x85ebca6b;
+        r ^= r >> 13;
+        r *= 0xc2b2ae35;
+        r ^= r >> 16;
+
+        return r;
+    }
+
+protected:
+    void mix(uint32_t k)
+    {
+        k *= 0xcc9e2d51;
+        k = (k << 15) | (k >> (32 - 15));
+        k *= 0x1b873593;
+
+        h ^= k;
+        h = (h << 13) | (h >> (32 - 13));
+        h = (h * 5) + 0xe6546b64;
+    }
+
+    uint32_t h;
+    uint32_t size;
+};
+
+// https://github.com/aappleby/smhasher/blob/master/src/MurmurHash3.cpp MurmurHash3_x64_128
+// incremental variant, trailing bytes of each feed are zero padded to a whole block
+class murmur3_128_state
+{
+public:
+    murmur3_128_state()
+        : h1(0), h2(0), size(0)
+    {
+    }
+
+    void feed(const void* data, size_t nbytes)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+
+        const size_t nblocks = nbytes / 16;
+        for (size_t i = 0; i < nblocks; i++)
+        {
+            uint64_t k[2];
+            memcpy(k, p, 16);
+            p += 16;
+
+            mix(k[0], k[1]);
+        }
+
+        const size_t remain = nbytes % 16;
+        if (remain)
+        {
+            uint64_t k[2] = {0, 0};
+            memcpy(k, p, remain);
+            mix(k[0], k[1]);
+        }
+
+        size += nbytes;
+    }
+
+    void finish(uint64_t& r1, uint64_t& r2) const
+    {
+        r1 = h1 ^ size;
+        r2 = h2 ^ size;
+
+        r1 += r2;
+        r2 += r1;
+
+        r1 = fmix64(r1);
+        r2 = fmix64(r2);
+
+        r1 += r2;
+        r2 += r1;
+    }
+
+protected:
+    static uint64_t rotl64(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    static uint64_t fmix64(uint64_t k)
+    {
+        k ^= k >> 33;
+        k *= 0xff51afd7ed558ccdULL;
+        k ^= k >> 33;
+        k *= 0xc4ceb9fe1a85ec53ULL;
+        k ^= k >> 33;
+        return k;
+    }
+
+    void mix(uint64_t k1, uint64_t k2)
+    {
+        const uint64_t c1 = 0x87c37b91114253d5ULL;
+        const uint64_t c2 = 0x4cf5ad432745937fULL;
+
+        k1 *= c1;
+        k1 = rotl64(k1, 31);
+        k1 *= c2;
+        h1 ^= k1;
+
+        h1 = rotl64(h1, 27);
+        h1 += h2;
+        h1 = h1 * 5 + 0x52dce729;
+
+        k2 *= c2;
+        k2 = rotl64(k2, 33);
+        k2 *= c1;
+        h2 ^= k2;
+
+        h2 = rotl64(h2, 31);
+        h2 += h1;
+        h2 = h2 * 5 + 0x38495ab5;
+    }
+
+    uint64_t h1;
+    uint64_t h2;
+    uint64_t size;
+};
+
+// https://en.wikipedia.org/wiki/Fowler%E2%80%93Noll%E2%80%93Vo_hash_function#FNV-1a_hash
+static uint32_t fnv1a_32(const char* str)
+{
+    uint32_t h = 0x811c9dc5;
+
+    while (*str)
+    {
+        h ^= (uint32_t)(unsigned char)*str++;
+        h *= 0x01000193;
+    }
+
+    return h;
+}
+
+static uint32_t get_cpu_isa_bits()
+{
+    uint32_t bits = 0;
+
+    bits |= (cpu_support_x86_avx() ? 1 : 0) << 0;
+    bits |= (cpu_support_x86_fma() ? 1 : 0) << 1;
+    bits |= (cpu_support_x86_xop() ? 1 : 0) << 2;
+    bits |= (cpu_support_x86_f16c() ? 1 : 0) << 3;
+    bits |= (cpu_support_x86_avx2() ? 1 : 0) << 4;
+    bits |= (cpu_support_x86_avx_vnni() ? 1 : 0) << 5;
+    bits |= (cpu_support_x86_avx_vnni_int8() ? 1 : 0) << 6;
+    bits |= (cpu_support_x86_avx_vnni_int16() ? 1 : 0) << 7;
+    bits |= (cpu_support_x86_avx_ne_convert() ? 1 : 0) << 8;
+    bits |= (cpu_support_x86_avx512() ? 1 : 0) << 9;
+    bits |= (cpu_support_x86_avx512_vnni() ? 1 : 0) << 10;
+    bits |= (cpu_support_x86_avx512_bf16() ? 1 : 0) << 11;
+    bits |= (cpu_support_x86_avx512_fp16() ? 1 : 0) << 12;
+
+    bits |= (cpu_support_arm_asimdhp() ? 1 : 0) << 16;
+    bits |= (cpu_support_arm_asimddp() ? 1 : 0) << 17;
+    bits |= (cpu_support_arm_asimdfhm() ? 1 : 0) << 18;
+    bits |= (cpu_support_arm_bf16() ? 1 : 0) << 19;
+    bits |= (cpu_support_arm_i8mm() ? 1 : 0) << 20;
+    bits |= (cpu_support_arm_sve() ? 1 : 0) << 21;
+    bits |= (cpu_support_arm_sve2() ? 1 : 0) << 22;
+
+    return bits;
+}
+
+class PackedWeightCachePrivate
+{
+public:
+    // digest -> packed weights
+    struct packed_weight_digest
+    {
+        packed_weight_digest()
+        {
+            d0 = 0;
+            d1 = 0;
+            d2 = 0;
+            d3 = 0;
+            d4 = 0;
+            d5 = 0;
+        }
+
+        packed_weight_digest(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt);
+
+        bool operator==(const packed_weight_digest& rhs) const
+        {
+            return d0 == rhs.d0 && d1 == rhs.d1 && d2 == rhs.d2 && d3 == rhs.d3 && d4 == rhs.d4 && d5 == rhs.d5;
+        }
+
+        union
+        {
+            struct
+            {
+                // a hit reuses the packed weights without looking at the source weights again
+                // so the weight content takes a 128 bit hash to keep collisions out of reach
+                uint64_t weights_murmur3_128[2];
+                uint64_t weights_size;
+                uint32_t kind_fnv1a;
+                uint32_t params_murmur3;
+                uint32_t opt_bits;
+                uint32_t num_threads;
+                uint32_t cpu_isa_bits;
+                uint32_t cpu_cache_murmur3;
+            };
+
+            struct
+            {
+                uint64_t d0;
+                uint64_t d1;
+                uint64_t d2;
+                uint64_t d3;
+                uint64_t d4;
+                uint64_t d5;
+            };
+        };
+    };
+
+    mutable std::vector<packed_weight_digest> cache_digests;
+    mutable std::vector<std::vector<Mat> > cache_artifacts;
+    mutable Mutex cache_lock;
+};
+
+PackedWeightCachePrivate::packed_weight_digest::packed_weight_digest(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt)
+{
+    kind_fnv1a = fnv1a_32(kind);
+
+    // hash the weight content channel by channel, skipping cstep padding
+    {
+        murmur3_128_state s;
+        size_t size = 0;
+        for (size_t i = 0; i < weights.size(); i++)
+        {
+            const Mat& m = weights[i];
+
+            const int shape[7] = {m.dims, m.w, m.h, m.d, m.c, m.elempack, (int)m.elemsize};
+            s.feed(shape, sizeof(shape));
+
+            if (m.empty())
+                continue;
+
+            const size_t channel_size = (size_t)m.w * m.h * m.d * m.elemsize;
+            for (int q = 0; q < m.c; q++)
+            {
+                s.feed(m.channel(q).data, channel_size);
+            }
+
+            size += channel_size * m.c;
+        }
+
+        s.finish(weights_murmur3_128[0], weights_murmur3_128[1]);
+        weights_size = size;
+    }
+
+    {
+        murmur3_32_state s;
+        if (!params.empty())
+            s.feed(&params[0], params.size() * sizeof(int));
+        params_murmur3 = s.finish();
+    }
+
+    // only the options that affect packed weight layout
+    opt_bits = 0;
+    opt_bits |= opt.use_packing_layout << 0;
+    opt_bits |= opt.use_winograd_convolution << 1;
+    opt_bits |= opt.use_winograd23_convolution << 2;
+    opt_bits |= opt.use_winograd43_convolution << 3;
+    opt_bits |= opt.use_winograd63_convolution << 4;
+    opt_bits |= opt.use_sgemm_convolution << 5;
+    opt_bits |= opt.use_int8_inference << 6;
+    opt_bits |= opt.use_fp16_packed << 7;
+    opt_bits |= opt.use_fp16_storage << 8;
+    opt_bits |= opt.use_fp16_arithmetic << 9;
+    opt_bits |= opt.use_bf16_storage << 10;
+    opt_bits |= opt.use_a53_a55_optimized_kernel << 11;
+    opt_bits |= opt.use_sparse_weight << 12;
+
+    // tile configs depend on the thread count and cache sizes
+    num_threads = opt.num_threads;
+
+    cpu_isa_bits = get_cpu_isa_bits();
+
+    {
+        const int cache_sizes[2] = {get_cpu_level2_cache_size(), get_cpu_level3_cache_size()};
+        murmur3_32_state s;
+        s.feed(cache_sizes, sizeof(cache_sizes));
+        cpu_cache_murmur3 = s.finish();
+    }
+}
+
+PackedWeightCache::PackedWeightCache()
+    : d(new PackedWeightCachePrivate)
+{
+}
+
+PackedWeightCache::~PackedWeightCache()
+{
+    clear();
+
+    delete d;
+}
+
+PackedWeightCache::PackedWeightCache(const PackedWeightCache&)
+    : d(0)
+{
+}
+
+PackedWeightCache& PackedWeightCache::operator=(const PackedWeightCache&)
+{
+    return *this;
+}
+
+void PackedWeightCache::clear()
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    d->cache_digests.clear();
+    d->cache_artifacts.clear();
+}
+
+int PackedWeightCache::size() const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    return (int)d->cache_digests.size();
+}
+
+int PackedWeightCache::get(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt, std::vector<Mat>& packed) const
+{
+    PackedWeightCachePrivate::packed_weight_digest key(kind, weights, params, opt);
+
+    MutexLockGuard lock(d->cache_lock);
+
+    for (size_t i = 0; i < d->cache_digests.size(); i++)
+    {
+        if (d->cache_digests[i] == key)
+        {
+            // hit cache
+            packed = d->cache_artifacts[i];
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int PackedWeightCache::put(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt, const std::vector<Mat>& packed)
+{
+    PackedWeightCachePrivate::packed_weight_digest key(kind, weights, params, opt);
+
+    MutexLockGuard lock(d->cache_lock);
+
+    for (size_t i = 0; i < d->cache_digests.size(); i++)
+    {
+        if (d->cache_digests[i] == key)
+        {
+            d->cache_artifacts[i] = packed;
+            return 0;
+        }
+    }
+
+    d->cache_digests.push_back(key);
+    d->cache_artifacts.push_back(packed);
+
+    return 0;
+}
+
+#if NCNN_STDIO
+static const uint32_t packed_weight_cache_magic = 0x4357504e; // NPWC
+static const uint32_t packed_weight_cache_format = 2;
+
+int PackedWeightCache::load(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    int ret = load(fp);
+    fclose(fp);
+    return ret;
+}
+
+int PackedWeightCache::load(FILE* fp)
+{
+    uint32_t header[4];
+    if (fread(header, sizeof(uint32_t), 4, fp) != 4)
+    {
+        NCNN_LOGE("PackedWeightCache read header failed");
+        return -1;
+    }
+
+    if (header[0] != packed_weight_cache_magic || header[1] != packed_weight_cache_format || header[2] != fnv1a_32(NCNN_VERSION_STRING))
+    {
+        NCNN_LOGE("PackedWeightCache file is not written by this ncnn version");
+        return -1;
+    }
+
+    const uint32_t entry_count = header[3];
+
+    std::vector<PackedWeightCachePrivate::packed_weight_digest> digests(entry_count);
+    std::vector<std::vector<Mat> > artifacts(entry_count);
+
+    for (uint32_t i = 0; i < entry_count; i++)
+    {
+        PackedWeightCachePrivate::packed_weight_digest& key = digests[i];
+        uint32_t mat_count = 0;
+        if (fread(&key.d0, sizeof(uint64_t), 6, fp) != 6 || fread(&mat_count, sizeof(uint32_t), 1, fp) != 1)
+        {
+            NCNN_LOGE("PackedWeightCache read entry %u failed", i);
+            return -1;
+        }
+
+        artifacts[i].resize(mat_count);
+        for (uint32_t j = 0; j < mat_count; j++)
+        {
+            // dims w h d c elempack elemsize
+            int shape[7];
+            if (fread(shape, sizeof(int), 7, fp) != 7)
+            {
+                NCNN_LOGE("PackedWeightCache read mat shape failed");
+                return -1;
+            }
+
+            const int dims = shape[0];
+            const size_t elemsize = (size_t)shape[6];
+
+            Mat& m = artifacts[i][j];
+            if (dims == 1)
+                m.create(shape[1], elemsize, shape[5]);
+            if (dims == 2)
+                m.create(shape[1], shape[2], elemsize, shape[5]);
+            if (dims == 3)
+                m.create(shape[1], shape[2], shape[4], elemsize, shape[5]);
+            if (dims == 4)
+                m.create(shape[1], shape[2], shape[3], shape[4], elemsize, shape[5]);
+
+            if (dims == 0)
+                continue;
+
+            if (m.empty())
+            {
+                NCNN_LOGE("PackedWeightCache invalid mat shape %d %d %d %d %d", dims, shape[1], shape[2], shape[3], shape[4]);
+                return -100;
+            }
+
+            const size_t channel_size = (size_t)m.w * m.h * m.d * m.elemsize;
+            for (int q = 0; q < m.c; q++)
+            {
+                if (fread(m.channel(q).data, 1, channel_size, fp) != channel_size)
+                {
+                    NCNN_LOGE("PackedWeightCache read mat data failed");
+                    return -1;
+                }
+            }
+        }
+    }
+
+    MutexLockGuard lock(d->cache_lock);
+
+    for (uint32_t i = 0; i < entry_count; i++)
+    {
+        bool exists = false;
+        for (size_t k = 0; k < d->cache_digests.size(); k++)
+        {
+            if (d->cache_digests[k] == digests[i])
+            {
+                d->cache_artifacts[k] = artifacts[i];
+                exists = true;
+                break;
+            }
+        }
+
+        if (!exists)
+        {
+            d->cache_digests.push_back(digests[i]);
+            d->cache_artifacts.push_back(artifacts[i]);
+        }
+    }
+
+    return 0;
+}
+
+int PackedWeightCache::save(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    int ret = save(fp);
+    if (fclose(fp) != 0)
+        ret = -1;
+
+    return ret;
+}
+
+int PackedWeightCache::save(FILE* fp) const
+{
+    MutexLockGuard lock(d->cache_lock);
+
+    const uint32_t header[4] = {packed_weight_cache_magic, packed_weight_cache_format, fnv1a_32(NCNN_VERSION_STRING), (uint32_t)d->cache_digests.size()};
+    if (fwrite(header, sizeof(uint32_t), 4, fp) != 4)
+        return -1;
+
+    for (size_t i = 0; i < d->cache_digests.size(); i++)
+    {
+        const PackedWeightCachePrivate::packed_weight_digest& key = d->cache_digests[i];
+        const std::vector<Mat>& packed = d->cache_artifacts[i];
+
+        const uint32_t mat_count = (uint32_t)packed.size();
+        if (fwrite(&key.d0, sizeof(uint64_t), 6, fp) != 6 || fwrite(&mat_count, sizeof(uint32_t), 1, fp) != 1)
+            return -1;
+
+        for (size_t j = 0; j < packed.size(); j++)
+        {
+            const Mat& m = packed[j];
+
+            const int dims = m.empty() ? 0 : m.dims;
+            const int shape[7] = {dims, m.w, m.h, m.d, m.c, m.elempack, (int)m.elemsize};
+            if (fwrite(shape, sizeof(int), 7, fp) != 7)
+                return -1;
+
+            if (dims == 0)
+                continue;
+
+            const size_t channel_size = (size_t)m.w * m.h * m.d * m.elemsize;
+            for (int q = 0; q < m.c; q++)
+            {
+                if (fwrite(m.channel(q).data, 1, channel_size, fp) != channel_size)
+                    return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
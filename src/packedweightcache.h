@@ -0,0 +1,72 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_PACKEDWEIGHTCACHE_H
+#define NCNN_PACKEDWEIGHTCACHE_H
+
+#include "platform.h"
+
+#include "mat.h"
+#include "option.h"
+
+#if NCNN_STDIO
+#include <stdio.h>
+#endif
+
+namespace ncnn {
+
+// cache of weights transformed by layer create_pipeline for the cpu
+// set opt.packed_weight_cache before net.load_model()
+// the layers supporting the cache look up their packed weights here and skip the transform on hit
+// on miss the freshly packed weights are stored, save() them for the next start
+//
+// entries are keyed by layer kind, original weight content, layer parameters,
+// option flags affecting the layout, thread count and the cpu isa and cache sizes
+// so a cache file produced on another machine class simply misses
+class PackedWeightCachePrivate;
+class NCNN_EXPORT PackedWeightCache
+{
+public:
+    PackedWeightCache();
+
+    virtual ~PackedWeightCache();
+
+    void clear();
+
+    // number of cached entries
+    int size() const;
+
+    // look up packed weights
+    // kind identifies the layer implementation and packing routine
+    // weights are the original weights the packed ones are derived from
+    // params are any other values the packed layout depends on
+    // return 0 if found
+    int get(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt, std::vector<Mat>& packed) const;
+
+    // store packed weights, an existing entry with the same key is replaced
+    // return 0 if success
+    int put(const char* kind, const std::vector<Mat>& weights, const std::vector<int>& params, const Option& opt, const std::vector<Mat>& packed);
+
+#if NCNN_STDIO
+    // load cache file written by save(), entries are merged into this cache
+    // return 0 if success, -1 if the file is not a cache written by this ncnn version
+    int load(const char* path);
+    int load(FILE* fp);
+
+    // write all entries
+    // return 0 if success
+    int save(const char* path) const;
+    int save(FILE* fp) const;
+#endif // NCNN_STDIO
+
+private:
+    PackedWeightCache(const PackedWeightCache&);
+    PackedWeightCache& operator=(const PackedWeightCache&);
+
+private:
+    PackedWeightCachePrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_PACKEDWEIGHTCACHE_H
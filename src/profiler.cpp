@@ -0,0 +1,314 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "profiler.h"
+
+#include <string.h>
+
+namespace ncnn {
+
+ProfilerEvent::ProfilerEvent()
+{
+    layer_index = -1;
+    typeindex = -1;
+#if NCNN_STRING
+    type = "";
+    name = "";
+#endif // NCNN_STRING
+    impl = "";
+    start = 0.0;
+    end = 0.0;
+    thread_id = 0;
+    num_threads = 1;
+    top_bytes = 0;
+}
+
+unsigned long long get_current_thread_id()
+{
+#if NCNN_THREADS
+#if defined _WIN32
+    return (unsigned long long)GetCurrentThreadId();
+#else
+    // pthread_t is opaque, take its leading bytes
+    pthread_t t = pthread_self();
+    unsigned long long id = 0;
+    memcpy(&id, &t, sizeof(t) < sizeof(id) ? sizeof(t) : sizeof(id));
+    return id;
+#endif
+#else
+    return 0;
+#endif // NCNN_THREADS
+}
+
+class ProfilerPrivate
+{
+public:
+    std::vector<ProfilerEvent> events;
+    mutable Mutex events_lock;
+};
+
+Profiler::Profiler()
+    : d(new ProfilerPrivate)
+{
+}
+
+Profiler::~Profiler()
+{
+    delete d;
+}
+
+Profiler::Profiler(const Profiler&)
+    : d(0)
+{
+}
+
+Profiler& Profiler::operator=(const Profiler&)
+{
+    return *this;
+}
+
+void Profiler::on_layer(const ProfilerEvent& event)
+{
+    MutexLockGuard lock(d->events_lock);
+
+    d->events.push_back(event);
+}
+
+void Profiler::clear()
+{
+    MutexLockGuard lock(d->events_lock);
+
+    d->events.clear();
+}
+
+std::vector<ProfilerEvent> Profiler::events() const
+{
+    MutexLockGuard lock(d->events_lock);
+
+    return d->events;
+}
+
+#if NCNN_STDIO
+static void format_shape(const Mat& m, char* str)
+{
+    if (m.dims == 1)
+        sprintf(str, "[%d *%d]", m.w, m.elempack);
+    else if (m.dims == 2)
+        sprintf(str, "[%d, %d *%d]", m.w, m.h, m.elempack);
+    else if (m.dims == 3)
+        sprintf(str, "[%d, %d, %d *%d]", m.w, m.h, m.c, m.elempack);
+    else if (m.dims == 4)
+        sprintf(str, "[%d, %d, %d, %d *%d]", m.w, m.h, m.d, m.c, m.elempack);
+    else
+        sprintf(str, "[]");
+}
+
+static void format_shapes(const std::vector<Mat>& shapes, char* str, size_t size)
+{
+    str[0] = '\0';
+
+    size_t len = 0;
+    for (size_t i = 0; i < shapes.size(); i++)
+    {
+        char shape_str[64];
+        format_shape(shapes[i], shape_str);
+
+        const size_t shape_len = strlen(shape_str);
+        if (len + shape_len + 2 >= size)
+            break;
+
+        if (i != 0)
+            str[len++] = ' ';
+
+        memcpy(str + len, shape_str, shape_len + 1);
+        len += shape_len;
+    }
+}
+
+static void fprint_json_string(FILE* fp, const char* str)
+{
+    fputc('"', fp);
+    for (const char* p = str; *p; p++)
+    {
+        const unsigned char ch = (unsigned char)*p;
+        if (ch == '"' || ch == '\\')
+            fprintf(fp, "\\%c", ch);
+        else if (ch < 0x20)
+            fprintf(fp, "\\u%04x", ch);
+        else
+            fputc(ch, fp);
+    }
+    fputc('"', fp);
+}
+
+int Profiler::save_chrome_trace(const char* path) const
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp)
+    {
+        NCNN_LOGE("fopen %s failed", path);
+        return -1;
+    }
+
+    int ret = save_chrome_trace(fp);
+
+    fclose(fp);
+
+    return ret;
+}
+
+int Profiler::save_chrome_trace(FILE* fp) const
+{
+    const std::vector<ProfilerEvent> events = this->events();
+
+    double t0 = 0.0;
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        if (i == 0 || events[i].start < t0)
+            t0 = events[i].start;
+    }
+
+    // small tid by order of appearance
+    std::vector<unsigned long long> thread_ids;
+
+    fprintf(fp, "{\"traceEvents\":[\n");
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const ProfilerEvent& e = events[i];
+
+        int tid = 0;
+        for (; tid < (int)thread_ids.size(); tid++)
+        {
+            if (thread_ids[tid] == e.thread_id)
+                break;
+        }
+        if (tid == (int)thread_ids.size())
+            thread_ids.push_back(e.thread_id);
+
+        char bottom_str[256];
+        char top_str[256];
+        format_shapes(e.bottom_shapes, bottom_str, 256);
+        format_shapes(e.top_shapes, top_str, 256);
+
+        fprintf(fp, "{\"name\":");
+#if NCNN_STRING
+        fprint_json_string(fp, e.name);
+        fprintf(fp, ",\"cat\":");
+        fprint_json_string(fp, e.type);
+#else
+        fprintf(fp, "\"%d\",\"cat\":\"%d\"", e.layer_index, e.typeindex);
+#endif // NCNN_STRING
+        fprintf(fp, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d", (e.start - t0) * 1000, (e.end - e.start) * 1000, tid);
+        fprintf(fp, ",\"args\":{\"layer\":%d,\"impl\":\"%s\",\"num_threads\":%d,\"bottom\":\"%s\",\"top\":\"%s\",\"top_bytes\":%llu}}", e.layer_index, e.impl, e.num_threads, bottom_str, top_str, (unsigned long long)e.top_bytes);
+        fprintf(fp, i + 1 == events.size() ? "\n" : ",\n");
+    }
+
+    fprintf(fp, "],\"displayTimeUnit\":\"ms\"}\n");
+
+    return ferror(fp) ? -1 : 0;
+}
+
+void Profiler::print_summary(FILE* fp) const
+{
+    const std::vector<ProfilerEvent> events = this->events();
+
+    struct layer_stat
+    {
+        const ProfilerEvent* first;
+        int count;
+        double total;
+        double min;
+        double max;
+    };
+
+    struct type_stat
+    {
+        const ProfilerEvent* first;
+        int count;
+        double total;
+    };
+
+    std::vector<layer_stat> layer_stats;
+    std::vector<type_stat> type_stats;
+    double total = 0.0;
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const ProfilerEvent& e = events[i];
+        const double t = e.end - e.start;
+
+        if (e.layer_index >= (int)layer_stats.size())
+        {
+            layer_stat zero = {0, 0, 0.0, 0.0, 0.0};
+            layer_stats.resize(e.layer_index + 1, zero);
+        }
+
+        layer_stat& ls = layer_stats[e.layer_index];
+        if (ls.count == 0)
+        {
+            ls.first = &e;
+            ls.min = t;
+            ls.max = t;
+        }
+        ls.count++;
+        ls.total += t;
+        ls.min = std::min(ls.min, t);
+        ls.max = std::max(ls.max, t);
+
+        size_t j = 0;
+        for (; j < type_stats.size(); j++)
+        {
+            if (type_stats[j].first->typeindex == e.typeindex)
+                break;
+        }
+        if (j == type_stats.size())
+        {
+            type_stat ts = {&e, 0, 0.0};
+            type_stats.push_back(ts);
+        }
+        type_stats[j].count++;
+        type_stats[j].total += t;
+
+        total += t;
+    }
+
+    const double percent_scale = total > 0.0 ? 100.0 / total : 0.0;
+
+    fprintf(fp, "%-5s %-24s %-30s %-12s %6s %10s %10s %10s %7s    %s\n", "index", "type", "name", "impl", "count", "avg", "min", "max", "%", "output");
+    for (size_t i = 0; i < layer_stats.size(); i++)
+    {
+        const layer_stat& ls = layer_stats[i];
+        if (ls.count == 0)
+            continue;
+
+        const ProfilerEvent& e = *ls.first;
+
+        char top_str[256];
+        format_shapes(e.top_shapes, top_str, 256);
+
+#if NCNN_STRING
+        fprintf(fp, "%-5d %-24s %-30s", e.layer_index, e.type, e.name);
+#else
+        fprintf(fp, "%-5d %-24d %-30d", e.layer_index, e.typeindex, e.layer_index);
+#endif // NCNN_STRING
+        fprintf(fp, " %-12s %6d %8.3lfms %8.3lfms %8.3lfms %6.2lf%%    %s\n", e.impl, ls.count, ls.total / ls.count, ls.min, ls.max, ls.total * percent_scale, top_str);
+    }
+
+    fprintf(fp, "\n%-24s %6s %10s %7s\n", "type", "count", "total", "%");
+    for (size_t i = 0; i < type_stats.size(); i++)
+    {
+        const type_stat& ts = type_stats[i];
+#if NCNN_STRING
+        fprintf(fp, "%-24s", ts.first->type);
+#else
+        fprintf(fp, "%-24d", ts.first->typeindex);
+#endif // NCNN_STRING
+        fprintf(fp, " %6d %8.3lfms %6.2lf%%\n", ts.count, ts.total, ts.total * percent_scale);
+    }
+
+    fprintf(fp, "%-24s %6d %8.3lfms\n", "total", (int)events.size(), total);
+}
+#endif // NCNN_STDIO
+
+} // namespace ncnn
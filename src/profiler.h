@@ -0,0 +1,97 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_PROFILER_H
+#define NCNN_PROFILER_H
+
+#include "platform.h"
+
+#include "mat.h"
+
+#if NCNN_STDIO
+#include <stdio.h>
+#endif
+
+namespace ncnn {
+
+// one layer forward recorded by the profiler
+class NCNN_EXPORT ProfilerEvent
+{
+public:
+    ProfilerEvent();
+
+public:
+    int layer_index;
+    int typeindex;
+#if NCNN_STRING
+    // layer type and name, valid as long as the net is alive
+    const char* type;
+    const char* name;
+#endif // NCNN_STRING
+
+    // cpu implementation the layer was created from, such as "x86_avx512", "x86" or "naive"
+    const char* impl;
+
+    // wall time in milliseconds, same clock as get_current_time()
+    double start;
+    double end;
+
+    // id of the thread running the layer, differs between inter-op threads
+    unsigned long long thread_id;
+
+    // intra-op threads given to the layer
+    int num_threads;
+
+    // blob shapes without data, elempack and elemsize tell the packing and storage type used
+    std::vector<Mat> bottom_shapes;
+    std::vector<Mat> top_shapes;
+
+    // bytes of top blobs newly allocated by the layer, zero for inplace forward
+    size_t top_bytes;
+};
+
+// runtime per-layer profiler for the cpu path
+// set it with ex.set_profiler() or net.opt.profiler, every layer forward through the net is recorded
+// layers running on vulkan are not recorded
+class ProfilerPrivate;
+class NCNN_EXPORT Profiler
+{
+public:
+    Profiler();
+    virtual ~Profiler();
+
+    // called after each layer forward, from inter-op threads concurrently when enabled
+    // the default implementation appends the event to the list
+    // override to stream the events elsewhere
+    virtual void on_layer(const ProfilerEvent& event);
+
+    // drop the recorded events
+    void clear();
+
+    // copy of the recorded events in arrival order
+    std::vector<ProfilerEvent> events() const;
+
+#if NCNN_STDIO
+    // write the events as chrome trace json, open it in chrome://tracing or perfetto
+    // return 0 if success
+    int save_chrome_trace(const char* path) const;
+    int save_chrome_trace(FILE* fp) const;
+
+    // print per layer and per layer type time aggregated over all recorded runs
+    void print_summary(FILE* fp = stderr) const;
+#endif // NCNN_STDIO
+
+private:
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+private:
+    ProfilerPrivate* const d;
+};
+
+// id of the calling thread
+NCNN_EXPORT unsigned long long get_current_thread_id();
+
+} // namespace ncnn
+
+#endif // NCNN_PROFILER_H
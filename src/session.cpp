@@ -0,0 +1,327 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "session.h"
+
+#include "allocator.h"
+#include "benchmark.h"
+
+namespace ncnn {
+
+struct InferenceRequest
+{
+    InferenceSession::request_func func;
+    void* userdata;
+    double submit_time;
+};
+
+class InferenceWorker
+{
+public:
+    InferenceWorker(const Net* net)
+        : ex(net->create_extractor())
+    {
+        // private allocators, no lock contention between workers
+        ex.set_blob_allocator(&blob_allocator);
+        ex.set_workspace_allocator(&workspace_allocator);
+    }
+
+    ~InferenceWorker()
+    {
+        ex.clear();
+    }
+
+    void run(const InferenceRequest& request)
+    {
+        request.func(ex, request.userdata);
+
+        // recycle blobs into the pool for the next request
+        ex.clear();
+    }
+
+    UnlockedPoolAllocator blob_allocator;
+    UnlockedPoolAllocator workspace_allocator;
+    Extractor ex;
+};
+
+class InferenceSessionPrivate
+{
+public:
+    static void* worker_thread(void* args);
+
+    void finish_request(const InferenceRequest& request);
+
+    const Net* net;
+
+    std::vector<InferenceWorker*> workers;
+    std::vector<Thread*> threads;
+
+    // ring buffer of pending requests
+    std::vector<InferenceRequest> queue;
+    int queue_head;
+    int queue_count;
+    int busy_count;
+    bool stopping;
+
+    mutable Mutex lock;
+    ConditionVariable request_condition;
+    ConditionVariable space_condition;
+    ConditionVariable idle_condition;
+
+    // stats
+    int request_count;
+    double last_latency;
+    double total_latency;
+    double max_latency;
+};
+
+struct InferenceWorkerArgs
+{
+    InferenceSessionPrivate* d;
+    InferenceWorker* worker;
+};
+
+void* InferenceSessionPrivate::worker_thread(void* args)
+{
+    InferenceSessionPrivate* d = ((InferenceWorkerArgs*)args)->d;
+    InferenceWorker* worker = ((InferenceWorkerArgs*)args)->worker;
+    delete (InferenceWorkerArgs*)args;
+
+    for (;;)
+    {
+        d->lock.lock();
+
+        while (!d->stopping && d->queue_count == 0)
+        {
+            d->request_condition.wait(d->lock);
+        }
+
+        if (d->queue_count == 0)
+        {
+            // stopping and drained
+            d->lock.unlock();
+            break;
+        }
+
+        InferenceRequest request = d->queue[d->queue_head];
+        d->queue_head = (d->queue_head + 1) % (int)d->queue.size();
+        d->queue_count--;
+        d->busy_count++;
+
+        d->space_condition.signal();
+
+        d->lock.unlock();
+
+        worker->run(request);
+
+        d->finish_request(request);
+    }
+
+    return 0;
+}
+
+void InferenceSessionPrivate::finish_request(const InferenceRequest& request)
+{
+    const double latency = get_current_time() - request.submit_time;
+
+    lock.lock();
+
+    request_count++;
+    last_latency = latency;
+    total_latency += latency;
+    if (latency > max_latency)
+        max_latency = latency;
+
+    busy_count--;
+    if (busy_count == 0 && queue_count == 0)
+    {
+        idle_condition.broadcast();
+    }
+
+    lock.unlock();
+}
+
+InferenceSession::InferenceSession(const Net* net, int worker_count, int queue_size)
+    : d(new InferenceSessionPrivate)
+{
+    d->net = net;
+
+    d->queue.resize(queue_size > 0 ? queue_size : 1);
+    d->queue_head = 0;
+    d->queue_count = 0;
+    d->busy_count = 0;
+    d->stopping = false;
+
+    d->request_count = 0;
+    d->last_latency = 0.0;
+    d->total_latency = 0.0;
+    d->max_latency = 0.0;
+
+    if (worker_count < 1)
+        worker_count = 1;
+
+    d->workers.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        d->workers[i] = new InferenceWorker(net);
+    }
+
+#if NCNN_THREADS
+    d->threads.resize(worker_count);
+    for (int i = 0; i < worker_count; i++)
+    {
+        InferenceWorkerArgs* args = new InferenceWorkerArgs;
+        args->d = d;
+        args->worker = d->workers[i];
+        d->threads[i] = new Thread(InferenceSessionPrivate::worker_thread, args);
+    }
+#endif // NCNN_THREADS
+}
+
+InferenceSession::~InferenceSession()
+{
+    d->lock.lock();
+    d->stopping = true;
+    d->request_condition.broadcast();
+    d->lock.unlock();
+
+    for (size_t i = 0; i < d->threads.size(); i++)
+    {
+        d->threads[i]->join();
+        delete d->threads[i];
+    }
+
+    for (size_t i = 0; i < d->workers.size(); i++)
+    {
+        delete d->workers[i];
+    }
+
+    delete d;
+}
+
+InferenceSession::InferenceSession(const InferenceSession&)
+    : d(0)
+{
+}
+
+InferenceSession& InferenceSession::operator=(const InferenceSession&)
+{
+    return *this;
+}
+
+int InferenceSession::submit(request_func func, void* userdata)
+{
+    InferenceRequest request;
+    request.func = func;
+    request.userdata = userdata;
+    request.submit_time = get_current_time();
+
+#if NCNN_THREADS
+    d->lock.lock();
+
+    while (d->queue_count == (int)d->queue.size())
+    {
+        d->space_condition.wait(d->lock);
+    }
+
+    d->queue[(d->queue_head + d->queue_count) % (int)d->queue.size()] = request;
+    d->queue_count++;
+
+    d->request_condition.signal();
+
+    d->lock.unlock();
+#else
+    // no worker thread, run in place
+    d->lock.lock();
+    d->busy_count++;
+    d->lock.unlock();
+
+    d->workers[0]->run(request);
+
+    d->finish_request(request);
+#endif // NCNN_THREADS
+
+    return 0;
+}
+
+int InferenceSession::try_submit(request_func func, void* userdata)
+{
+#if NCNN_THREADS
+    d->lock.lock();
+
+    if (d->queue_count == (int)d->queue.size())
+    {
+        d->lock.unlock();
+        return -1;
+    }
+
+    InferenceRequest request;
+    request.func = func;
+    request.userdata = userdata;
+    request.submit_time = get_current_time();
+
+    d->queue[(d->queue_head + d->queue_count) % (int)d->queue.size()] = request;
+    d->queue_count++;
+
+    d->request_condition.signal();
+
+    d->lock.unlock();
+
+    return 0;
+#else
+    return submit(func, userdata);
+#endif // NCNN_THREADS
+}
+
+void InferenceSession::wait_idle()
+{
+    d->lock.lock();
+
+    while (d->busy_count != 0 || d->queue_count != 0)
+    {
+        d->idle_condition.wait(d->lock);
+    }
+
+    d->lock.unlock();
+}
+
+int InferenceSession::queue_depth() const
+{
+    MutexLockGuard g(d->lock);
+    return d->queue_count;
+}
+
+int InferenceSession::request_count() const
+{
+    MutexLockGuard g(d->lock);
+    return d->request_count;
+}
+
+double InferenceSession::last_latency() const
+{
+    MutexLockGuard g(d->lock);
+    return d->last_latency;
+}
+
+double InferenceSession::average_latency() const
+{
+    MutexLockGuard g(d->lock);
+    return d->request_count == 0 ? 0.0 : d->total_latency / d->request_count;
+}
+
+double InferenceSession::max_latency() const
+{
+    MutexLockGuard g(d->lock);
+    return d->max_latency;
+}
+
+void InferenceSession::reset_stats()
+{
+    MutexLockGuard g(d->lock);
+    d->request_count = 0;
+    d->last_latency = 0.0;
+    d->total_latency = 0.0;
+    d->max_latency = 0.0;
+}
+
+} // namespace ncnn
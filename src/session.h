@@ -0,0 +1,64 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#ifndef NCNN_SESSION_H
+#define NCNN_SESSION_H
+
+#include "net.h"
+#include "platform.h"
+
+namespace ncnn {
+
+class InferenceSessionPrivate;
+class NCNN_EXPORT InferenceSession
+{
+public:
+    // request handler
+    // runs on a worker thread with a warm extractor, set inputs and extract outputs through ex
+    // extracted mats live in the worker allocator, clone them to keep them beyond the handler
+    typedef void (*request_func)(Extractor& ex, void* userdata);
+
+    // share one loaded net among worker_count workers
+    // every worker keeps one extractor with its own unlocked pool allocators across requests
+    // at most queue_size requests wait in queue
+    // the net should outlive the session
+    InferenceSession(const Net* net, int worker_count = 1, int queue_size = 16);
+
+    // finish all queued requests and stop workers
+    virtual ~InferenceSession();
+
+    // enqueue one request, block while the queue is full
+    // return 0 if success
+    int submit(request_func func, void* userdata);
+
+    // enqueue one request without blocking
+    // return 0 if success, -1 if the queue is full
+    int try_submit(request_func func, void* userdata);
+
+    // block until every submitted request is done
+    void wait_idle();
+
+    // requests waiting in queue
+    int queue_depth() const;
+
+    // requests done since the last reset_stats()
+    int request_count() const;
+
+    // latency from submit to handler return in ms
+    double last_latency() const;
+    double average_latency() const;
+    double max_latency() const;
+
+    void reset_stats();
+
+private:
+    InferenceSession(const InferenceSession&);
+    InferenceSession& operator=(const InferenceSession&);
+
+private:
+    InferenceSessionPrivate* const d;
+};
+
+} // namespace ncnn
+
+#endif // NCNN_SESSION_H
@@ -0,0 +1,186 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+// conv3x3 and relu forward sample by sample, conv1x1 and innerproduct take the stacked batch
+static const char* param_str = "7767517\n"
+                               "6 6\n"
+                               "Input data 0 1 data\n"
+                               "Convolution conv3x3 1 1 data conv0 0=16 1=3 4=1 5=1 6=1152 9=1\n"
+                               "Convolution conv1x1 1 1 conv0 conv1 0=32 1=1 5=1 6=512\n"
+                               "ReLU relu 1 1 conv1 relu1\n"
+                               "Pooling gap 1 1 relu1 pool 0=1 4=1\n"
+                               "InnerProduct fc 1 1 pool output 0=10 1=1 2=320\n";
+
+// innerproduct flattens a 3d sample whose channels are padded to cstep
+static const char* param_str_fc = "7767517\n"
+                                  "2 2\n"
+                                  "Input data 0 1 data\n"
+                                  "InnerProduct fc 1 1 data output 0=12 1=1 2=10368\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+static int test_batch(const char* param, const char* const* blob_names, const std::vector<ncnn::Mat>& inputs, bool use_packing_layout)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.load_param_mem(param);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    const int batch = (int)inputs.size();
+
+    for (int k = 0; blob_names[k]; k++)
+    {
+        std::vector<ncnn::Mat> outs_ref(batch);
+        for (int b = 0; b < batch; b++)
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input("data", inputs[b]);
+            if (ex.extract(blob_names[k], outs_ref[b]) != 0)
+                return -1;
+        }
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", inputs);
+
+        std::vector<ncnn::Mat> outs;
+        if (ex.extract(blob_names[k], outs) != 0)
+            return -1;
+
+        if ((int)outs.size() != batch)
+        {
+            fprintf(stderr, "test_batch expect %d outputs but got %d\n", batch, (int)outs.size());
+            return -1;
+        }
+
+        for (int b = 0; b < batch; b++)
+        {
+            // type 0 unpacks like the single sample extract
+            if (outs[b].elempack != 1)
+            {
+                fprintf(stderr, "test_batch %s sample %d elempack %d\n", blob_names[k], b, outs[b].elempack);
+                return -1;
+            }
+
+            if (CompareMat(outs[b], outs_ref[b], 0.001) != 0)
+            {
+                fprintf(stderr, "test_batch %s sample %d mismatch batch=%d use_packing_layout=%d\n", blob_names[k], b, batch, use_packing_layout);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+static int test_batch(const std::vector<ncnn::Mat>& inputs, bool use_packing_layout)
+{
+    // the output and an intermediate packed blob
+    static const char* blob_names[3] = {"output", "relu1", 0};
+
+    return test_batch(param_str, blob_names, inputs, use_packing_layout);
+}
+
+static int test_batch_0()
+{
+    std::vector<ncnn::Mat> inputs(4);
+    for (int b = 0; b < 4; b++)
+    {
+        inputs[b] = RandomMat(6, 5, 8);
+    }
+
+    return 0
+           || test_batch(inputs, false)
+           || test_batch(inputs, true);
+}
+
+static int test_batch_1()
+{
+    // one sample
+    std::vector<ncnn::Mat> inputs(1);
+    inputs[0] = RandomMat(6, 5, 8);
+
+    return 0
+           || test_batch(inputs, false)
+           || test_batch(inputs, true);
+}
+
+static int test_batch_2()
+{
+    // different shapes are not stacked
+    std::vector<ncnn::Mat> inputs(3);
+    inputs[0] = RandomMat(6, 5, 8);
+    inputs[1] = RandomMat(4, 7, 8);
+    inputs[2] = RandomMat(6, 5, 8);
+
+    return 0
+           || test_batch(inputs, false)
+           || test_batch(inputs, true);
+}
+
+static int test_batch_3()
+{
+    // 3x3 channels are padded to cstep, stacking must still kick in
+    static const char* blob_names[2] = {"output", 0};
+
+    std::vector<ncnn::Mat> inputs(4);
+    for (int b = 0; b < 4; b++)
+    {
+        inputs[b] = RandomMat(3, 3, 96);
+    }
+
+    return 0
+           || test_batch(param_str_fc, blob_names, inputs, false)
+           || test_batch(param_str_fc, blob_names, inputs, true);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_batch_0()
+           || test_batch_1()
+           || test_batch_2()
+           || test_batch_3();
+}
@@ -329,7 +329,78 @@ static int test_c_api_2()
     return success ? 0 : -1;
 }
 
+struct extract_async_result
+{
+    int ret;
+    ncnn_mat_t mat;
+};
+
+static void extract_async_done(int ret, ncnn_mat_t mat, void* userdata)
+{
+    extract_async_result* r = (extract_async_result*)userdata;
+    r->ret = ret;
+    r->mat = mat;
+}
+
+static int test_c_api_3()
+{
+    ncnn_net_t net = ncnn_net_create();
+    {
+        const char param_txt[] = "7767517\n2 2\nInput input 0 1 data\nAbsVal abs 1 1 data output\n";
+
+        ncnn_net_load_param_memory(net, param_txt);
+        ncnn_net_load_model_memory(net, 0);
+    }
+
+    ncnn_mat_t a = ncnn_mat_create_1d(8, NULL);
+    {
+        float* a_data = (float*)ncnn_mat_get_data(a);
+        for (int i = 0; i < 8; i++)
+        {
+            a_data[i] = -(float)i;
+        }
+    }
+
+    extract_async_result r0 = {-1, 0};
+    extract_async_result r1 = {-1, 0};
+
+    ncnn_extractor_t ex = ncnn_extractor_create(net);
+    ncnn_extractor_input(ex, "data", a);
+
+    int ret0 = ncnn_extractor_extract_async(ex, "output", extract_async_done, &r0);
+    // the second call waits for the first one
+    int ret1 = ncnn_extractor_extract_index_async(ex, 1, extract_async_done, &r1);
+    ncnn_extractor_wait(ex);
+
+    ncnn_extractor_destroy(ex);
+    ncnn_net_destroy(net);
+
+    bool success = ret0 == 0 && ret1 == 0 && r0.ret == 0 && r1.ret == 0 && r0.mat && r1.mat;
+    if (success)
+    {
+        success = ncnn_mat_get_w(r0.mat) == 8 && ncnn_mat_get_w(r1.mat) == 8;
+
+        const float* r0_data = (const float*)ncnn_mat_get_data(r0.mat);
+        const float* r1_data = (const float*)ncnn_mat_get_data(r1.mat);
+        for (int i = 0; success && i < 8; i++)
+        {
+            success = r0_data[i] == (float)i && r1_data[i] == (float)i;
+        }
+    }
+
+    ncnn_mat_destroy(a);
+    ncnn_mat_destroy(r0.mat);
+    ncnn_mat_destroy(r1.mat);
+
+    if (!success)
+    {
+        fprintf(stderr, "test_c_api_3 failed\n");
+    }
+
+    return success ? 0 : -1;
+}
+
 int main()
 {
-    return test_c_api_0() || test_c_api_1() || test_c_api_2();
+    return test_c_api_0() || test_c_api_1() || test_c_api_2() || test_c_api_3();
 }
@@ -307,6 +307,62 @@ static int test_concat_9()
     return 0;
 }
 
+#if NCNN_INT8
+static int test_concat_int8(const std::vector<ncnn::Mat>& a, int axis)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, axis); //axis
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Concat", pd, weights, a, 1, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_concat_int8 failed a[0].dims=%d a[0]=(%d %d %d %d) axis=%d\n", a[0].dims, a[0].w, a[0].h, a[0].d, a[0].c, axis);
+    }
+
+    return ret;
+}
+
+static int test_concat_10()
+{
+    ncnn::Mat a[] = {
+        RandomS8Mat(7, 5, 8),
+        RandomS8Mat(7, 5, 13),
+        RandomS8Mat(7, 5, 16),
+        RandomS8Mat(7, 5, 24)
+    };
+
+    const int n = sizeof(a) / sizeof(a[0]);
+
+    for (int i = 0; i < n; i++)
+    {
+        for (int j = 0; j < n; j++)
+        {
+            std::vector<ncnn::Mat> as(2);
+            as[0] = a[i];
+            as[1] = a[j];
+
+            int ret = test_concat_int8(as, 0);
+            if (ret != 0)
+                return ret;
+        }
+
+        std::vector<ncnn::Mat> as(3);
+        as[0] = a[i];
+        as[1] = a[i];
+        as[2] = a[i];
+
+        int ret = test_concat_int8(as, 1) || test_concat_int8(as, 2) || test_concat_int8(as, -1);
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 int main()
 {
     SRAND(7767517);
@@ -321,5 +377,9 @@ int main()
            || test_concat_6()
            || test_concat_7()
            || test_concat_8()
-           || test_concat_9();
+           || test_concat_9()
+#if NCNN_INT8
+           || test_concat_10()
+#endif
+           ;
 }
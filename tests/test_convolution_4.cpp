@@ -0,0 +1,96 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_convolution_sparse(int w, int h, int c, int outch, int bias, int block, int keep_percent)
+{
+    ncnn::Mat a = RandomMat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, 1);     // kernel_w
+    pd.set(2, 1);     // dilation_w
+    pd.set(3, 1);     // stride_w
+    pd.set(4, 0);     // pad_w
+    pd.set(5, bias);  // bias_term
+    pd.set(6, outch * c);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomPrunedWeight(c, outch, block, keep_percent);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("Convolution", pd, weights, a, 0.001, 0, TEST_LAYER_ENABLE_SPARSE_WEIGHT);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_convolution_sparse failed w=%d h=%d c=%d outch=%d bias=%d block=%d keep_percent=%d act=%d actparams=[%f,%f]\n", w, h, c, outch, bias, block, keep_percent, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_convolution_sparse_vec(int w, int outch, int bias, int block, int keep_percent)
+{
+    ncnn::Mat a = RandomMat(w);
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, 1);     // kernel_w
+    pd.set(5, bias);  // bias_term
+    pd.set(6, outch * w);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomPrunedWeight(w, outch, block, keep_percent);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("Convolution", pd, weights, a, 0.001, 0, TEST_LAYER_ENABLE_SPARSE_WEIGHT);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_convolution_sparse_vec failed w=%d outch=%d bias=%d block=%d keep_percent=%d\n", w, outch, bias, block, keep_percent);
+    }
+
+    return ret;
+}
+
+static int test_convolution_0()
+{
+    return 0
+           || test_convolution_sparse(10, 6, 32, 48, 1, 16, 30)
+           || test_convolution_sparse(7, 7, 20, 64, 0, 16, 10)
+           || test_convolution_sparse(9, 7, 16, 32, 1, 8, 15)
+           || test_convolution_sparse(13, 11, 24, 16, 0, 8, 10)
+           || test_convolution_sparse(8, 8, 32, 12, 1, 4, 10)
+           || test_convolution_sparse(17, 5, 12, 20, 0, 4, 5)
+           || test_convolution_sparse(15, 15, 16, 7, 1, 1, 25)
+           || test_convolution_sparse(6, 9, 64, 24, 0, 1, 10)
+           || test_convolution_sparse(11, 13, 32, 16, 1, 0, 0)
+           || test_convolution_sparse(5, 4, 8, 9, 0, 0, 0);
+}
+
+static int test_convolution_1()
+{
+    return 0
+           || test_convolution_sparse_vec(48, 32, 0, 16, 20)
+           || test_convolution_sparse_vec(32, 24, 1, 8, 15)
+           || test_convolution_sparse_vec(24, 16, 0, 4, 5)
+           || test_convolution_sparse_vec(16, 13, 1, 1, 30)
+           || test_convolution_sparse_vec(64, 32, 1, 0, 0);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_convolution_0()
+           || test_convolution_1();
+}
@@ -248,6 +248,55 @@ static int test_crop_9(const ncnn::Mat& a)
            || test_crop(a, 3, 3, 3, 8, -233, -233, -233, -233, 3, 3, 3, 12);
 }
 
+#if NCNN_INT8
+static int test_crop_int8(const ncnn::Mat& a, int woffset, int hoffset, int coffset, int outw, int outh, int outc)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, woffset);
+    pd.set(1, hoffset);
+    pd.set(2, coffset);
+    pd.set(3, outw);
+    pd.set(4, outh);
+    pd.set(5, outc);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Crop", pd, weights, a, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_crop_int8 failed a.dims=%d a=(%d %d %d) woffset=%d hoffset=%d coffset=%d outw=%d outh=%d outc=%d\n", a.dims, a.w, a.h, a.c, woffset, hoffset, coffset, outw, outh, outc);
+    }
+
+    return ret;
+}
+
+static int test_crop_int8_0(const ncnn::Mat& a)
+{
+    return 0
+           || test_crop_int8(a, 0, 0, 0, -233, 0, 0)
+           || test_crop_int8(a, 8, 0, 0, 16, 0, 0)
+           || test_crop_int8(a, 11, 0, 0, 7, 0, 0);
+}
+
+static int test_crop_int8_3(const ncnn::Mat& a)
+{
+    return 0
+           || test_crop_int8(a, 5, 0, 0, -233, -233, 0)
+           || test_crop_int8(a, 2, 8, 0, 7, 16, 0)
+           || test_crop_int8(a, 3, 5, 0, 9, 11, 0);
+}
+
+static int test_crop_int8_6(const ncnn::Mat& a)
+{
+    return 0
+           || test_crop_int8(a, 0, 0, 0, -233, -233, -233)
+           || test_crop_int8(a, 1, 2, 8, 7, 6, 16)
+           || test_crop_int8(a, 3, 1, 5, 9, 11, 12)
+           || test_crop_int8(a, 2, 3, 11, -233, -233, 7);
+}
+#endif // NCNN_INT8
+
 int main()
 {
     SRAND(776757);
@@ -264,5 +313,14 @@ int main()
            || test_crop_6(RandomMat(16, 16, 33))
            || test_crop_9(RandomMat(20, 20, 20, 48))
            || test_crop_9(RandomMat(15, 15, 15, 36))
-           || test_crop_9(RandomMat(16, 16, 16, 33));
+           || test_crop_9(RandomMat(16, 16, 16, 33))
+#if NCNN_INT8
+           || test_crop_int8_0(RandomS8Mat(112))
+           || test_crop_int8_0(RandomS8Mat(127))
+           || test_crop_int8_3(RandomS8Mat(20, 48))
+           || test_crop_int8_3(RandomS8Mat(16, 33))
+           || test_crop_int8_6(RandomS8Mat(20, 20, 48))
+           || test_crop_int8_6(RandomS8Mat(16, 16, 33))
+#endif
+           ;
 }
@@ -0,0 +1,146 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "weight_quant.h"
+
+// weight only quantized table [input_dim][num_output], the fp32 table it stands for goes to weight_data_dequant
+static void RandomQuantTable(int num_output, int input_dim, int bits, int group_size, ncnn::Mat& weight_data, ncnn::Mat& weight_data_quant_scales, ncnn::Mat& weight_data_dequant)
+{
+    const int row_bytes = weight_quant_row_bytes(num_output, bits);
+    const int groups = weight_quant_group_count(num_output, group_size);
+    const int gs = group_size > 0 ? group_size : num_output;
+
+    weight_data = RandomS8Mat(row_bytes * input_dim);
+    weight_data_quant_scales = RandomMat(groups * input_dim, 0.001f, 0.02f);
+
+    weight_data_dequant.create(num_output * input_dim);
+    for (int q = 0; q < input_dim; q++)
+    {
+        const signed char* wptr = (const signed char*)weight_data + row_bytes * q;
+        for (int p = 0; p < num_output; p++)
+        {
+            weight_data_dequant[q * num_output + p] = weight_quant_value(wptr, p, bits) * weight_data_quant_scales[q * groups + p / gs];
+        }
+    }
+}
+
+static int test_embed_table(int words, int num_output, int input_dim, int bias, const std::vector<ncnn::Mat>& weights, const std::vector<ncnn::Mat>& weights_ref, int bits, int group_size)
+{
+    ncnn::ParamDict pd;
+    pd.set(0, num_output);
+    pd.set(1, input_dim);
+    pd.set(2, bias);
+    pd.set(3, num_output * input_dim);
+
+    ncnn::Mat a(words);
+    RandomizeInt(a, 0, input_dim);
+
+    // the fp32 table holding the same values is the reference
+    ncnn::Mat b_ref;
+    test_layer_naive(ncnn::layer_to_index("Embed"), pd, weights_ref, a, b_ref, 0, 0);
+
+    pd.set(16, bits);
+    pd.set(17, group_size);
+
+    ncnn::Mat b;
+    test_layer_naive(ncnn::layer_to_index("Embed"), pd, weights, a, b, 0, 0);
+
+    int ret = CompareMat(b, b_ref, 0.001);
+    if (ret == 0)
+    {
+        ret = test_layer("Embed", pd, weights, a);
+    }
+
+    return ret;
+}
+
+static int test_embed_weight_quant(int words, int num_output, int input_dim, int bias, int bits, int group_size)
+{
+    ncnn::Mat weight_data;
+    ncnn::Mat weight_data_quant_scales;
+    ncnn::Mat weight_data_dequant;
+    RandomQuantTable(num_output, input_dim, bits, group_size, weight_data, weight_data_quant_scales, weight_data_dequant);
+
+    ncnn::Mat bias_data = RandomMat(num_output);
+
+    std::vector<ncnn::Mat> weights_ref;
+    weights_ref.push_back(weight_data_dequant);
+    if (bias)
+        weights_ref.push_back(bias_data);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(weight_data);
+    if (bias)
+        weights.push_back(bias_data);
+    weights.push_back(weight_data_quant_scales);
+
+    int ret = test_embed_table(words, num_output, input_dim, bias, weights, weights_ref, bits, group_size);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_embed_weight_quant failed words=%d num_output=%d input_dim=%d bias=%d bits=%d group_size=%d\n", words, num_output, input_dim, bias, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_embed_fp16(int words, int num_output, int input_dim, int bias)
+{
+    ncnn::Mat weight_data_fp16;
+    ncnn::cast_float32_to_float16(RandomMat(num_output * input_dim), weight_data_fp16);
+
+    ncnn::Mat weight_data_fp32;
+    ncnn::cast_float16_to_float32(weight_data_fp16, weight_data_fp32);
+
+    ncnn::Mat bias_data = RandomMat(num_output);
+
+    std::vector<ncnn::Mat> weights_ref;
+    weights_ref.push_back(weight_data_fp32);
+    if (bias)
+        weights_ref.push_back(bias_data);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(weight_data_fp16);
+    if (bias)
+        weights.push_back(bias_data);
+
+    int ret = test_embed_table(words, num_output, input_dim, bias, weights, weights_ref, 0, 0);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_embed_fp16 failed words=%d num_output=%d input_dim=%d bias=%d\n", words, num_output, input_dim, bias);
+    }
+
+    return ret;
+}
+
+static int test_embed_0()
+{
+    return 0
+           || test_embed_fp16(128, 128, 128, 0)
+           || test_embed_fp16(127, 127, 127, 1)
+           || test_embed_fp16(13, 16, 200, 1)
+           || test_embed_fp16(1, 7, 3, 0);
+}
+
+static int test_embed_1(int bits)
+{
+    return 0
+           || test_embed_weight_quant(128, 128, 128, 0, bits, 0)
+           || test_embed_weight_quant(128, 128, 128, 1, bits, 32)
+           || test_embed_weight_quant(127, 127, 127, 0, bits, 16)
+           || test_embed_weight_quant(127, 127, 127, 1, bits, 0)
+           || test_embed_weight_quant(24, 100, 300, 1, bits, 17)
+           || test_embed_weight_quant(1, 15, 2, 1, bits, 0)
+           || test_embed_weight_quant(9, 64, 50, 0, bits, 7);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_embed_0()
+           || test_embed_1(8)
+           || test_embed_1(4);
+}
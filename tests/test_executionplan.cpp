@@ -0,0 +1,127 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+#include <algorithm>
+#include <math.h>
+
+// planned order is data split relu sig
+static const char* param_str = "7767517\n"
+                               "4 5\n"
+                               "Input data 0 1 data\n"
+                               "Split split 1 2 data d0 d1\n"
+                               "ReLU relu 1 1 d0 r\n"
+                               "Sigmoid sig 1 1 d1 s\n";
+
+// none of the layers has weights
+class DataReaderFromEmpty : public ncnn::DataReader
+{
+public:
+    virtual size_t read(void* buf, size_t size) const
+    {
+        memset(buf, 0, size);
+        return size;
+    }
+};
+
+static int find_layer(const ncnn::Net& net, const char* name)
+{
+    for (size_t i = 0; i < net.layers().size(); i++)
+    {
+        if (net.layers()[i]->name == name)
+            return (int)i;
+    }
+    return -1;
+}
+
+static int find_blob(const ncnn::Net& net, const char* name)
+{
+    for (size_t i = 0; i < net.blobs().size(); i++)
+    {
+        if (net.blobs()[i].name == name)
+            return (int)i;
+    }
+    return -1;
+}
+
+static int extract_and_compare(const ncnn::Net& net, const ncnn::Mat& in, const ncnn::Mat& expect, const char* tag)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    if (ex.extract("r", out) != 0)
+        return -1;
+
+    if (CompareMat(out, expect, 0.001) != 0)
+    {
+        fprintf(stderr, "test_executionplan %s output mismatch\n", tag);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_executionplan_0()
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.load_param_mem(param_str);
+
+    DataReaderFromEmpty dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(8, 6, 4);
+
+    ncnn::Mat relu_out = in.clone();
+    ncnn::Mat sigmoid_out = in.clone();
+    for (int i = 0; i < (int)in.total(); i++)
+    {
+        relu_out[i] = std::max(in[i], 0.f);
+        sigmoid_out[i] = 1.f / (1.f + expf(-in[i]));
+    }
+
+    if (extract_and_compare(net, in, relu_out, "original") != 0)
+        return -1;
+
+    // fresh extractor with the same input takes the cached needed layers
+    if (extract_and_compare(net, in, relu_out, "cached") != 0)
+        return -1;
+
+    const int relu = find_layer(net, "relu");
+    const int d0 = find_blob(net, "d0");
+    const int s = find_blob(net, "s");
+
+    // feed relu from sigmoid, now planned after relu, the plan must follow the new topology
+    net.mutable_layers()[relu]->bottoms[0] = s;
+    net.mutable_blobs()[s].consumer = relu;
+    net.mutable_blobs()[d0].consumer = -1;
+
+    if (extract_and_compare(net, in, sigmoid_out, "rewired") != 0)
+        return -1;
+
+    // and back
+    net.mutable_layers()[relu]->bottoms[0] = d0;
+    net.mutable_blobs()[d0].consumer = relu;
+    net.mutable_blobs()[s].consumer = -1;
+
+    if (extract_and_compare(net, in, relu_out, "restored") != 0)
+        return -1;
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return test_executionplan_0();
+}
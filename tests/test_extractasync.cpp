@@ -0,0 +1,195 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+static const char* param_str = "7767517\n"
+                               "5 5\n"
+                               "Input data 0 1 data\n"
+                               "Convolution conv3x3 1 1 data conv0 0=16 1=3 4=1 5=1 6=1152 9=1\n"
+                               "Pooling pool 1 1 conv0 pool0 0=0 1=2 2=2\n"
+                               "Convolution conv1x1 1 1 pool0 conv1 0=24 1=1 5=1 6=384\n"
+                               "Pooling gap 1 1 conv1 output 0=1 4=1\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+struct AsyncResult
+{
+    int ret;
+    int called;
+    ncnn::Mat out;
+};
+
+static void on_extracted(int ret, ncnn::Mat& feat, void* userdata)
+{
+    AsyncResult* r = (AsyncResult*)userdata;
+    r->ret = ret;
+    r->called++;
+    r->out = feat.clone();
+}
+
+static int load_net(ncnn::Net& net, int async_threads)
+{
+    net.opt.num_threads = 1;
+    net.opt.async_extract_threads = async_threads;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_extractasync_0(int async_threads)
+{
+    ncnn::Net net;
+    if (load_net(net, async_threads) != 0)
+        return -1;
+
+    const int count = 6;
+
+    ncnn::Mat inputs[count];
+    ncnn::Mat outs_ref[count];
+    for (int i = 0; i < count; i++)
+    {
+        inputs[i] = RandomMat(12 + i * 2, 14, 8);
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", inputs[i]);
+        if (ex.extract("output", outs_ref[i]) != 0)
+            return -1;
+    }
+
+    // several extractors of one net in flight together
+    std::vector<ncnn::Extractor> exs(count, net.create_extractor());
+    AsyncResult results[count];
+    for (int i = 0; i < count; i++)
+    {
+        results[i].ret = -1;
+        results[i].called = 0;
+
+        exs[i].input("data", inputs[i]);
+        if (exs[i].extract_async("output", on_extracted, &results[i]) != 0)
+        {
+            fprintf(stderr, "test_extractasync_0 extract_async failed async_threads=%d i=%d\n", async_threads, i);
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        exs[i].wait();
+
+        if (results[i].called != 1 || results[i].ret != 0)
+        {
+            fprintf(stderr, "test_extractasync_0 callback called=%d ret=%d async_threads=%d i=%d\n", results[i].called, results[i].ret, async_threads, i);
+            return -1;
+        }
+
+        if (CompareMat(results[i].out, outs_ref[i], 0.001) != 0)
+        {
+            fprintf(stderr, "test_extractasync_0 output mismatch async_threads=%d i=%d\n", async_threads, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_extractasync_1()
+{
+    // back to back calls on one extractor, destroyed without an explicit wait
+    ncnn::Net net;
+    if (load_net(net, 2) != 0)
+        return -1;
+
+    ncnn::Mat in = RandomMat(16, 12, 8);
+
+    ncnn::Mat out_ref;
+    ncnn::Mat conv1_ref;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        ex.extract("conv1", conv1_ref);
+        ex.extract("output", out_ref);
+    }
+
+    AsyncResult r0 = {-1, 0, ncnn::Mat()};
+    AsyncResult r1 = {-1, 0, ncnn::Mat()};
+    AsyncResult r2 = {-1, 0, ncnn::Mat()};
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+
+        ex.extract_async("conv1", on_extracted, &r1);
+        ex.extract_async("output", on_extracted, &r0);
+
+        // unknown blob fails at once without calling back
+        if (ex.extract_async("nonexistent", on_extracted, &r2) == 0)
+        {
+            fprintf(stderr, "test_extractasync_1 nonexistent blob queued\n");
+            return -1;
+        }
+    }
+
+    if (r0.called != 1 || r1.called != 1 || r2.called != 0 || r0.ret != 0 || r1.ret != 0)
+    {
+        fprintf(stderr, "test_extractasync_1 callback called=%d %d %d\n", r0.called, r1.called, r2.called);
+        return -1;
+    }
+
+    if (CompareMat(r0.out, out_ref, 0.001) != 0 || CompareMat(r1.out, conv1_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_extractasync_1 output mismatch\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_extractasync_0(1)
+           || test_extractasync_0(2)
+           || test_extractasync_0(4)
+           || test_extractasync_1();
+}
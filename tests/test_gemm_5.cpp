@@ -0,0 +1,156 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "weight_quant.h"
+
+// weight only quantized B [N][K], the fp32 B it stands for goes to B_dequant
+static void RandomQuantB(int N, int K, int bits, int group_size, ncnn::Mat& B_data, ncnn::Mat& B_data_quant_scales, ncnn::Mat& B_dequant)
+{
+    const int row_bytes = weight_quant_row_bytes(K, bits);
+    const int groups = weight_quant_group_count(K, group_size);
+    const int gs = group_size > 0 ? group_size : K;
+
+    B_data = RandomS8Mat(row_bytes * N);
+    B_data_quant_scales = RandomMat(groups * N, 0.001f, 0.02f);
+
+    B_dequant.create(K, N);
+    for (int j = 0; j < N; j++)
+    {
+        const signed char* wptr = (const signed char*)B_data + row_bytes * j;
+        for (int k = 0; k < K; k++)
+        {
+            B_dequant.row(j)[k] = weight_quant_value(wptr, k, bits) * B_data_quant_scales[j * groups + k / gs];
+        }
+    }
+}
+
+static int test_gemm_weight_quant(int M, int N, int K, const ncnn::Mat& C, float alpha, float beta, int transA, int output_transpose, int constantC, int bits, int group_size)
+{
+    int broadcast_type_C = -1;
+    if (C.dims == 1 && C.w == 1)
+        broadcast_type_C = 0;
+    if (C.dims == 1 && C.w == M)
+        broadcast_type_C = 1;
+    if (C.dims == 1 && C.w == N)
+        broadcast_type_C = 4;
+    if (C.dims == 2 && C.w == 1 && C.h == M)
+        broadcast_type_C = 2;
+    if (C.dims == 2 && C.w == N && C.h == M)
+        broadcast_type_C = 3;
+    if (C.dims == 2 && C.w == N && C.h == 1)
+        broadcast_type_C = 4;
+
+    ncnn::ParamDict pd;
+    pd.set(0, alpha);
+    pd.set(1, beta);
+    pd.set(2, transA);
+    pd.set(3, 1); // transB
+    pd.set(4, 0); // constantA
+    pd.set(5, 1); // constantB
+    pd.set(6, constantC);
+    pd.set(7, M);
+    pd.set(8, N);
+    pd.set(9, K);
+    pd.set(10, broadcast_type_C);
+    pd.set(14, output_transpose);
+
+    ncnn::Mat B_data;
+    ncnn::Mat B_data_quant_scales;
+    ncnn::Mat B_dequant;
+    RandomQuantB(N, K, bits, group_size, B_data, B_data_quant_scales, B_dequant);
+
+    std::vector<ncnn::Mat> weights_ref;
+    weights_ref.push_back(B_dequant);
+    if (constantC && !C.empty())
+        weights_ref.push_back(C);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(B_data);
+    if (constantC && !C.empty())
+        weights.push_back(C);
+    weights.push_back(B_data_quant_scales);
+
+    std::vector<ncnn::Mat> a;
+    a.push_back(transA ? RandomMat(M, K) : RandomMat(K, M));
+    if (!constantC && !C.empty())
+        a.push_back(C);
+
+    // the float gemm with the dequantized B is the reference
+    std::vector<ncnn::Mat> b_ref;
+    test_layer_naive(ncnn::layer_to_index("Gemm"), pd, weights_ref, a, 1, b_ref, 0, 0);
+
+    pd.set(16, bits);
+    pd.set(17, group_size);
+
+    std::vector<ncnn::Mat> b;
+    test_layer_naive(ncnn::layer_to_index("Gemm"), pd, weights, a, 1, b, 0, 0);
+
+    int ret = CompareMat(b, b_ref, 0.001);
+    if (ret == 0)
+    {
+        ret = test_layer("Gemm", pd, weights, a, 1, 0.001f, 0, TEST_LAYER_DISABLE_GPU_TESTING);
+    }
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_gemm_weight_quant failed M=%d N=%d K=%d C.dims=%d C=(%d %d) alpha=%f beta=%f transA=%d output_transpose=%d constantC=%d bits=%d group_size=%d\n", M, N, K, C.dims, C.w, C.h, alpha, beta, transA, output_transpose, constantC, bits, group_size);
+    }
+
+    return ret;
+}
+
+static int test_gemm_0(int M, int N, int K, int bits, int group_size)
+{
+    return 0
+           || test_gemm_weight_quant(M, N, K, ncnn::Mat(), 1.f, 1.f, 0, 0, 0, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, ncnn::Mat(), 2.1f, 1.f, 1, 0, 0, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, ncnn::Mat(), 0.8f, 1.f, 0, 1, 0, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(N), 1.f, 1.f, 0, 0, 1, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(N), 1.f, 0.5f, 1, 1, 1, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(1), 1.f, 0.7f, 0, 0, 1, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(1, M), 1.3f, 1.f, 0, 1, 1, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(N, M), 1.f, 0.6f, 0, 0, 0, bits, group_size)
+           || test_gemm_weight_quant(M, N, K, RandomMat(M), 0.5f, 2.f, 1, 0, 0, bits, group_size);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    int mnk[][3] = {
+        {1, 1, 1},
+        {1, 16, 64},
+        {1, 35, 47},
+        {4, 24, 32},
+        {8, 8, 8},
+        {7, 31, 48},
+        {12, 12, 23},
+        {16, 32, 96},
+        {23, 12, 64},
+        {28, 20, 130},
+        {5, 19, 300}
+    };
+
+    int mnk_count = sizeof(mnk) / sizeof(int) / 3;
+
+    for (int i = 0; i < mnk_count; i++)
+    {
+        int M = mnk[i][0];
+        int N = mnk[i][1];
+        int K = mnk[i][2];
+
+        int ret = 0
+                  || test_gemm_0(M, N, K, 8, 0)
+                  || test_gemm_0(M, N, K, 4, 0)
+                  || test_gemm_0(M, N, K, 8, 32)
+                  || test_gemm_0(M, N, K, 4, 16)
+                  || test_gemm_0(M, N, K, 4, 7);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
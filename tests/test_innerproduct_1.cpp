@@ -0,0 +1,69 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_innerproduct_sparse(const ncnn::Mat& a, int outch, int bias, int block, int keep_percent)
+{
+    const int num_input = a.dims == 2 ? a.w : a.w * a.h * a.c;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * num_input);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    std::vector<ncnn::Mat> weights(bias ? 2 : 1);
+    weights[0] = RandomPrunedWeight(num_input, outch, block, keep_percent);
+    if (bias)
+        weights[1] = RandomMat(outch);
+
+    int ret = test_layer("InnerProduct", pd, weights, a, 0.001, 0, TEST_LAYER_ENABLE_SPARSE_WEIGHT);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_sparse failed a.dims=%d a=(%d %d %d) outch=%d bias=%d block=%d keep_percent=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, a.c, outch, bias, block, keep_percent, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_innerproduct_0()
+{
+    return 0
+           || test_innerproduct_sparse(RandomMat(96), 64, 1, 16, 20)
+           || test_innerproduct_sparse(RandomMat(64), 32, 1, 8, 15)
+           || test_innerproduct_sparse(RandomMat(40), 24, 0, 8, 10)
+           || test_innerproduct_sparse(RandomMat(48), 12, 1, 4, 10)
+           || test_innerproduct_sparse(RandomMat(33), 20, 0, 4, 5)
+           || test_innerproduct_sparse(RandomMat(57), 7, 1, 1, 25)
+           || test_innerproduct_sparse(RandomMat(256), 10, 1, 1, 15)
+           || test_innerproduct_sparse(RandomMat(200), 6, 0, 1, 10)
+           || test_innerproduct_sparse(RandomMat(64), 16, 1, 0, 0)
+           || test_innerproduct_sparse(RandomMat(4, 3, 16), 16, 1, 8, 15)
+           || test_innerproduct_sparse(RandomMat(5, 2, 12), 9, 0, 1, 20);
+}
+
+static int test_innerproduct_1()
+{
+    return 0
+           || test_innerproduct_sparse(RandomMat(40, 6), 48, 0, 16, 20)
+           || test_innerproduct_sparse(RandomMat(64, 8), 32, 1, 8, 15)
+           || test_innerproduct_sparse(RandomMat(32, 5), 12, 0, 4, 5)
+           || test_innerproduct_sparse(RandomMat(24, 16), 7, 1, 1, 25)
+           || test_innerproduct_sparse(RandomMat(48, 12), 16, 1, 0, 0);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_innerproduct_0()
+           || test_innerproduct_1();
+}
@@ -0,0 +1,131 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "weight_quant.h"
+
+// weight only quantized [num_output][num_input], the fp32 weight it stands for goes to weight_data_dequant
+static void RandomQuantWeight(int num_input, int num_output, int bits, int group_size, ncnn::Mat& weight_data, ncnn::Mat& weight_data_quant_scales, ncnn::Mat& weight_data_dequant)
+{
+    const int row_bytes = weight_quant_row_bytes(num_input, bits);
+    const int groups = weight_quant_group_count(num_input, group_size);
+    const int gs = group_size > 0 ? group_size : num_input;
+
+    weight_data = RandomS8Mat(row_bytes * num_output);
+    weight_data_quant_scales = RandomMat(groups * num_output, 0.001f, 0.02f);
+
+    weight_data_dequant.create(num_input * num_output);
+    for (int q = 0; q < num_output; q++)
+    {
+        const signed char* wptr = (const signed char*)weight_data + row_bytes * q;
+        for (int k = 0; k < num_input; k++)
+        {
+            weight_data_dequant[q * num_input + k] = weight_quant_value(wptr, k, bits) * weight_data_quant_scales[q * groups + k / gs];
+        }
+    }
+}
+
+static int test_innerproduct_weight_quant(const ncnn::Mat& a, int outch, int bias, int bits, int group_size)
+{
+    const int num_input = a.dims == 2 ? a.w : a.w * a.h * a.c;
+
+    ncnn::ParamDict pd;
+    pd.set(0, outch); // num_output
+    pd.set(1, bias);  // bias_term
+    pd.set(2, outch * num_input);
+
+    int activation_type = RAND() % 7; // 0 1 2 3 4 5 6
+    ncnn::Mat activation_params(2);
+    activation_params[0] = (activation_type == 6) ? RandomFloat(0, 1) : RandomFloat(-1, 0); // alpha
+    activation_params[1] = RandomFloat(0, 1);                                               // beta
+    pd.set(9, activation_type);
+    pd.set(10, activation_params);
+
+    ncnn::Mat weight_data;
+    ncnn::Mat weight_data_quant_scales;
+    ncnn::Mat weight_data_dequant;
+    RandomQuantWeight(num_input, outch, bits, group_size, weight_data, weight_data_quant_scales, weight_data_dequant);
+
+    ncnn::Mat bias_data = RandomMat(outch);
+
+    std::vector<ncnn::Mat> weights_ref;
+    weights_ref.push_back(weight_data_dequant);
+    if (bias)
+        weights_ref.push_back(bias_data);
+
+    std::vector<ncnn::Mat> weights;
+    weights.push_back(weight_data);
+    if (bias)
+        weights.push_back(bias_data);
+    weights.push_back(weight_data_quant_scales);
+
+    // the float layer with the dequantized weight is the reference
+    ncnn::Mat b_ref;
+    test_layer_naive(ncnn::layer_to_index("InnerProduct"), pd, weights_ref, a, b_ref, 0, 0);
+
+    pd.set(16, bits);
+    pd.set(17, group_size);
+
+    ncnn::Mat b;
+    test_layer_naive(ncnn::layer_to_index("InnerProduct"), pd, weights, a, b, 0, 0);
+
+    int ret = CompareMat(b, b_ref, 0.001);
+    if (ret == 0)
+    {
+        ret = test_layer("InnerProduct", pd, weights, a, 0.001f, 0, TEST_LAYER_DISABLE_GPU_TESTING);
+    }
+
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_innerproduct_weight_quant failed a.dims=%d a=(%d %d %d) outch=%d bias=%d bits=%d group_size=%d act=%d actparams=[%f,%f]\n", a.dims, a.w, a.h, a.c, outch, bias, bits, group_size, activation_type, activation_params[0], activation_params[1]);
+    }
+
+    return ret;
+}
+
+static int test_innerproduct_0(int bits)
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(1), 1, 1, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(15), 8, 0, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(16), 7, 1, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(33), 16, 1, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(64), 24, 1, bits, 32)
+           || test_innerproduct_weight_quant(RandomMat(100), 12, 0, bits, 16)
+           || test_innerproduct_weight_quant(RandomMat(97), 32, 1, bits, 17)
+           || test_innerproduct_weight_quant(RandomMat(128), 5, 1, bits, 64);
+}
+
+static int test_innerproduct_1(int bits)
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(3, 2, 2), 2, 0, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(4, 3, 8), 16, 1, bits, 32)
+           || test_innerproduct_weight_quant(RandomMat(6, 2, 16), 7, 1, bits, 16)
+           || test_innerproduct_weight_quant(RandomMat(5, 5, 4), 8, 1, bits, 0);
+}
+
+static int test_innerproduct_2(int bits)
+{
+    return 0
+           || test_innerproduct_weight_quant(RandomMat(1, 5), 1, 1, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(19, 8), 7, 1, bits, 0)
+           || test_innerproduct_weight_quant(RandomMat(32, 12), 16, 0, bits, 16)
+           || test_innerproduct_weight_quant(RandomMat(48, 16), 24, 1, bits, 32)
+           || test_innerproduct_weight_quant(RandomMat(65, 3), 32, 1, bits, 13)
+           || test_innerproduct_weight_quant(RandomMat(300, 4), 11, 1, bits, 7);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_innerproduct_0(8)
+           || test_innerproduct_0(4)
+           || test_innerproduct_1(8)
+           || test_innerproduct_1(4)
+           || test_innerproduct_2(8)
+           || test_innerproduct_2(4);
+}
@@ -0,0 +1,177 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+// two branches joined by an add, every blob has a single consumer
+static const char* param_str = "7767517\n"
+                               "7 8\n"
+                               "Input data 0 1 data\n"
+                               "Split split 1 2 data d0 d1\n"
+                               "Convolution conva 1 1 d0 a0 0=16 1=3 4=1 5=1 6=1152 9=1\n"
+                               "Convolution convb 1 1 d1 b0 0=16 1=1 5=1 6=128\n"
+                               "Pooling poolb 1 1 b0 b1 0=1 1=3 2=1 3=1\n"
+                               "BinaryOp add 2 1 a0 b1 sum 0=0\n"
+                               "Convolution conv1x1 1 1 sum output 0=24 1=1 5=1 6=384\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+static int test_interop_0(int inter_op_threads)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat inputs[2] = {
+        RandomMat(16, 12, 8),
+        RandomMat(9, 13, 8)
+    };
+
+    // several passes reuse the helper threads of the net
+    for (int i = 0; i < 6; i++)
+    {
+        const ncnn::Mat& in = inputs[i % 2];
+
+        ncnn::Mat out_ref;
+        {
+            ncnn::Extractor ex = net.create_extractor();
+            ex.input("data", in);
+            if (ex.extract("output", out_ref) != 0)
+                return -1;
+        }
+
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_inter_op_threads(inter_op_threads);
+        ex.input("data", in);
+
+        // a branch first, the rest of the graph reuses it
+        ncnn::Mat a0;
+        if (ex.extract("a0", a0) != 0)
+            return -1;
+
+        ncnn::Mat out;
+        if (ex.extract("output", out) != 0)
+            return -1;
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_interop_0 output mismatch inter_op_threads=%d pass=%d\n", inter_op_threads, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_interop_1(int inter_op_threads)
+{
+    // memory planning with inter-op threads requested
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(16, 12, 8);
+
+    ncnn::Mat out_ref;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        if (ex.extract("output", out_ref) != 0)
+            return -1;
+    }
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_inter_op_threads(inter_op_threads);
+    ex.set_memory_planning(true);
+
+    size_t plan_size = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        ex.clear();
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        if (ex.extract("output", out) != 0)
+            return -1;
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_interop_1 output mismatch inter_op_threads=%d pass=%d\n", inter_op_threads, i);
+            return -1;
+        }
+
+        // the plan recorded on the first pass is replayed unchanged
+        if (i >= 2 && ex.memory_plan_size() != plan_size)
+        {
+            fprintf(stderr, "test_interop_1 plan changed %zu -> %zu inter_op_threads=%d pass=%d\n", plan_size, ex.memory_plan_size(), inter_op_threads, i);
+            return -1;
+        }
+
+        plan_size = ex.memory_plan_size();
+    }
+
+    if (plan_size == 0)
+    {
+        fprintf(stderr, "test_interop_1 not planned inter_op_threads=%d\n", inter_op_threads);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_interop_0(1)
+           || test_interop_0(2)
+           || test_interop_0(4)
+           || test_interop_1(2);
+}
@@ -37,9 +37,18 @@ static int test_inversespectrogram_0()
            || test_inversespectrogram(124, 28, 55, 2, 12, 55, 1, 1, 2);
 }
 
+static int test_inversespectrogram_1()
+{
+    return 0
+           || test_inversespectrogram(40, 257, 512, 0, 128, 400, 1, 1, 0)
+           || test_inversespectrogram(21, 400, 400, 1, 160, 400, 2, 0, 1)
+           || test_inversespectrogram(35, 49, 96, 2, 24, 90, 1, 1, 2)
+           || test_inversespectrogram(57, 63, 63, 0, 5, 63, 2, 1, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_inversespectrogram_0();
+    return test_inversespectrogram_0() || test_inversespectrogram_1();
 }
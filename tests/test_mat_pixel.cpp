@@ -428,6 +428,100 @@ static int test_mat_pixel_6()
            || test_mat_pixel_yuv420sp2rgb(6, 6);
 }
 
+static int test_mat_pixel_threads(int w, int h, int type, int cn, int outcn)
+{
+    ncnn::Option opt;
+    opt.num_threads = 4;
+
+    ncnn::Mat a = RandomMat(w, h, cn);
+
+    ncnn::Mat m = ncnn::Mat::from_pixels(a, type, w, h, w * cn);
+    ncnn::Mat m2 = ncnn::Mat::from_pixels(a, type, w, h, w * cn, opt);
+
+    for (int q = 0; q < m.c; q++)
+    {
+        if (m2.c != m.c || memcmp(m.channel(q), m2.channel(q), w * h * sizeof(float)) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_threads from_pixels failed w=%d h=%d type=%x\n", w, h, type);
+            return -1;
+        }
+    }
+
+    const int type_to = (type & ncnn::Mat::PIXEL_CONVERT_MASK) ? (type >> ncnn::Mat::PIXEL_CONVERT_SHIFT) : type;
+
+    ncnn::Mat b(w, h, (size_t)outcn, outcn);
+    ncnn::Mat b2(w, h, (size_t)outcn, outcn);
+    m.to_pixels(b, type_to, w * outcn);
+    m.to_pixels(b2, type_to, w * outcn, opt);
+
+    if (memcmp(b, b2, w * h * outcn) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_threads to_pixels failed w=%d h=%d type=%x\n", w, h, type_to);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_yuv420sp2rgb_threads(int w, int h)
+{
+    ncnn::Option opt;
+    opt.num_threads = 4;
+
+    ncnn::Mat yuv = RandomMat(w, h / 2 * 3, 1);
+
+    ncnn::Mat rgb(w, h, (size_t)3u, 3);
+    ncnn::Mat rgb2(w, h, (size_t)3u, 3);
+
+    yuv420sp2rgb(yuv, w, h, rgb);
+    yuv420sp2rgb(yuv, w, h, rgb2, opt);
+
+    if (memcmp(rgb, rgb2, w * h * 3) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_yuv420sp2rgb_threads failed w=%d h=%d\n", w, h);
+        return -1;
+    }
+
+    yuv420sp2rgb_nv12(yuv, w, h, rgb);
+    yuv420sp2rgb_nv12(yuv, w, h, rgb2, opt);
+
+    if (memcmp(rgb, rgb2, w * h * 3) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_yuv420sp2rgb_threads nv12 failed w=%d h=%d\n", w, h);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_7()
+{
+    const int sizes[3][2] = {{5, 3}, {33, 17}, {64, 50}};
+
+    for (int i = 0; i < 3; i++)
+    {
+        const int w = sizes[i][0];
+        const int h = sizes[i][1];
+
+        int ret = 0
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_GRAY, 1, 1)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_GRAY2RGB, 1, 3)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_RGB, 3, 3)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_BGR2RGB, 3, 3)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_RGB2GRAY, 3, 1)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_RGB2RGBA, 3, 4)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_RGBA, 4, 4)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_RGBA2BGR, 4, 3)
+                  || test_mat_pixel_threads(w, h, ncnn::Mat::PIXEL_BGRA2RGBA, 4, 4)
+                  || test_mat_pixel_yuv420sp2rgb_threads(w + (w & 1), h + (h & 1));
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
@@ -439,5 +533,6 @@ int main()
            || test_mat_pixel_3()
            || test_mat_pixel_4()
            || test_mat_pixel_5()
-           || test_mat_pixel_6();
+           || test_mat_pixel_6()
+           || test_mat_pixel_7();
 }
@@ -487,9 +487,63 @@ static int test_mat_pixel_affine_1()
            || test_mat_pixel_affine_yuv420sp(220, 340);
 }
 
+static int test_mat_pixel_affine_threads(int w, int h, int cn)
+{
+    ncnn::Mat a0 = RandomMat(w, h, cn);
+
+    float tm[6];
+    ncnn::get_rotation_matrix(20.f, 1.3f, w / 2, h / 2, tm);
+    tm[2] -= w / 5;
+
+    ncnn::Option opt;
+    opt.num_threads = 4;
+
+    for (int type = 0; type <= 1; type++)
+    {
+        ncnn::Mat a1(w, h, (size_t)cn, cn);
+        ncnn::Mat a2(w, h, (size_t)cn, cn);
+        memset(a1, 0, w * h * cn);
+        memset(a2, 0, w * h * cn);
+
+        if (cn == 1) ncnn::warpaffine_bilinear_c1(a0, w, h, w * cn, a1, w, h, w * cn, tm, type, 0x33221100);
+        if (cn == 2) ncnn::warpaffine_bilinear_c2(a0, w, h, w * cn, a1, w, h, w * cn, tm, type, 0x33221100);
+        if (cn == 3) ncnn::warpaffine_bilinear_c3(a0, w, h, w * cn, a1, w, h, w * cn, tm, type, 0x33221100);
+        if (cn == 4) ncnn::warpaffine_bilinear_c4(a0, w, h, w * cn, a1, w, h, w * cn, tm, type, 0x33221100);
+
+        if (cn == 1) ncnn::warpaffine_bilinear_c1(a0, w, h, w * cn, a2, w, h, w * cn, tm, type, 0x33221100, opt);
+        if (cn == 2) ncnn::warpaffine_bilinear_c2(a0, w, h, w * cn, a2, w, h, w * cn, tm, type, 0x33221100, opt);
+        if (cn == 3) ncnn::warpaffine_bilinear_c3(a0, w, h, w * cn, a2, w, h, w * cn, tm, type, 0x33221100, opt);
+        if (cn == 4) ncnn::warpaffine_bilinear_c4(a0, w, h, w * cn, a2, w, h, w * cn, tm, type, 0x33221100, opt);
+
+        if (memcmp(a1, a2, w * h * cn) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_affine_threads failed w=%d h=%d cn=%d type=%d\n", w, h, cn, type);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_affine_2()
+{
+    for (int cn = 1; cn <= 4; cn++)
+    {
+        int ret = 0
+                  || test_mat_pixel_affine_threads(7, 5, cn)
+                  || test_mat_pixel_affine_threads(60, 70, cn)
+                  || test_mat_pixel_affine_threads(121, 97, cn);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1();
+    return test_mat_pixel_affine_0() || test_mat_pixel_affine_1() || test_mat_pixel_affine_2();
 }
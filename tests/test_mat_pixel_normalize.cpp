@@ -0,0 +1,179 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "mat.h"
+#include "prng.h"
+
+#include <math.h>
+#include <stdio.h>
+
+static struct prng_rand_t g_prng_rand_state;
+#define SRAND(seed) prng_srand(seed, &g_prng_rand_state)
+#define RAND()      prng_rand(&g_prng_rand_state)
+
+static int pixel_type_channels(int type)
+{
+    if (type == ncnn::Mat::PIXEL_GRAY)
+        return 1;
+    if (type == ncnn::Mat::PIXEL_RGB || type == ncnn::Mat::PIXEL_BGR)
+        return 3;
+    return 4;
+}
+
+static ncnn::Mat RandomPixels(int w, int h, int cn)
+{
+    ncnn::Mat m(w * h * cn, (size_t)1u, 1);
+
+    unsigned char* p = m;
+    for (int i = 0; i < w * h * cn; i++)
+    {
+        p[i] = RAND() % 256;
+    }
+
+    return m;
+}
+
+static int Compare(const ncnn::Mat& a, const ncnn::Mat& b, float epsilon)
+{
+    if (a.w != b.w || a.h != b.h || a.c != b.c || a.elempack != b.elempack)
+    {
+        fprintf(stderr, "shape not match    expect %d %d %d @%d but got %d %d %d @%d\n", a.w, a.h, a.c, a.elempack, b.w, b.h, b.c, b.elempack);
+        return -1;
+    }
+
+    for (int q = 0; q < a.c; q++)
+    {
+        const float* pa = a.channel(q);
+        const float* pb = b.channel(q);
+        for (int i = 0; i < a.w * a.h; i++)
+        {
+            if (fabs(pa[i] - pb[i]) > epsilon)
+            {
+                fprintf(stderr, "value not match  at c:%d i:%d    expect %f but got %f\n", q, i, pa[i], pb[i]);
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+// the resized u8 image of from_pixels_resize rounds, so allow a couple of pixel levels after normalize
+static int test_mat_pixel_letterbox(int w, int h, int type, int target_width, int target_height, int resize_width, int resize_height, int left, int top, int elempack)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    const int type_from = type & ncnn::Mat::PIXEL_FORMAT_MASK;
+    const int type_to = (type & ncnn::Mat::PIXEL_CONVERT_MASK) ? (type >> ncnn::Mat::PIXEL_CONVERT_SHIFT) : type_from;
+    const int cn = pixel_type_channels(type_from);
+    const int outc = pixel_type_channels(type_to);
+
+    const float mean_vals[4] = {104.f, 117.f, 123.f, 127.5f};
+    const float norm_vals[4] = {0.017f, 0.0175f, 0.0174f, 1 / 127.5f};
+    const float pad_value = 114.f;
+
+    ncnn::Mat a = RandomPixels(w, h, cn);
+
+    ncnn::Mat b = ncnn::Mat::from_pixels_letterbox_normalize(a, type, w, h, w * cn, target_width, target_height, resize_width, resize_height, left, top, pad_value, mean_vals, norm_vals, elempack);
+
+    ncnn::Mat b2;
+    ncnn::convert_packing(b, b2, 1, opt);
+
+    ncnn::Mat c = ncnn::Mat::from_pixels_resize(a, type, w, h, resize_width, resize_height);
+
+    ncnn::Mat d;
+    ncnn::copy_make_border(c, d, top, target_height - top - resize_height, left, target_width - left - resize_width, ncnn::BORDER_CONSTANT, pad_value, opt);
+    d.substract_mean_normalize(mean_vals, norm_vals);
+
+    const float epsilon = outc == 1 && cn != 1 ? 0.04f : 0.03f;
+    if (b.elempack != elempack || Compare(d, b2, epsilon) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_letterbox failed w=%d h=%d type=%x target=%d %d resize=%d %d left=%d top=%d elempack=%d\n", w, h, type, target_width, target_height, resize_width, resize_height, left, top, elempack);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_resize_normalize(int w, int h, int type, int target_width, int target_height, int elempack)
+{
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    const int type_from = type & ncnn::Mat::PIXEL_FORMAT_MASK;
+    const int cn = pixel_type_channels(type_from);
+
+    const float mean_vals[4] = {0.f, 128.f, 64.f, 32.f};
+
+    ncnn::Mat a = RandomPixels(w, h, cn);
+
+    ncnn::Mat b = ncnn::Mat::from_pixels_resize_normalize(a, type, w, h, w * cn, target_width, target_height, mean_vals, 0, elempack);
+
+    ncnn::Mat b2;
+    ncnn::convert_packing(b, b2, 1, opt);
+
+    ncnn::Mat d = ncnn::Mat::from_pixels_resize(a, type, w, h, target_width, target_height);
+    d.substract_mean_normalize(mean_vals, 0);
+
+    // same size skips resampling in both
+    const float epsilon = w == target_width && h == target_height ? 1.01f : 2.01f;
+    if (b.elempack != elempack || Compare(d, b2, epsilon) != 0)
+    {
+        fprintf(stderr, "test_mat_pixel_resize_normalize failed w=%d h=%d type=%x target=%d %d elempack=%d\n", w, h, type, target_width, target_height, elempack);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_0()
+{
+    const int types[] = {
+        ncnn::Mat::PIXEL_RGB,
+        ncnn::Mat::PIXEL_BGR2RGB,
+        ncnn::Mat::PIXEL_GRAY,
+        ncnn::Mat::PIXEL_GRAY2RGB,
+        ncnn::Mat::PIXEL_RGB2GRAY,
+        ncnn::Mat::PIXEL_BGR2GRAY,
+        ncnn::Mat::PIXEL_RGBA2BGR,
+        ncnn::Mat::PIXEL_BGRA2RGB,
+        ncnn::Mat::PIXEL_RGBA2GRAY
+    };
+
+    for (int i = 0; i < (int)(sizeof(types) / sizeof(int)); i++)
+    {
+        int ret = 0
+                  || test_mat_pixel_resize_normalize(24, 24, types[i], 24, 24, 1)
+                  || test_mat_pixel_resize_normalize(37, 29, types[i], 16, 16, 1)
+                  || test_mat_pixel_resize_normalize(15, 20, types[i], 31, 45, 1)
+                  || test_mat_pixel_resize_normalize(1, 1, types[i], 3, 2, 1)
+                  || test_mat_pixel_letterbox(40, 30, types[i], 32, 32, 32, 24, 0, 4, 1)
+                  || test_mat_pixel_letterbox(17, 33, types[i], 32, 32, 16, 32, 8, 0, 1)
+                  || test_mat_pixel_letterbox(64, 48, types[i], 40, 36, 33, 21, 3, 7, 1);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_1()
+{
+    return 0
+           || test_mat_pixel_resize_normalize(31, 17, ncnn::Mat::PIXEL_RGBA, 16, 16, 4)
+           || test_mat_pixel_resize_normalize(20, 20, ncnn::Mat::PIXEL_BGR2RGBA, 13, 9, 4)
+           || test_mat_pixel_resize_normalize(9, 11, ncnn::Mat::PIXEL_GRAY2BGRA, 30, 20, 4)
+           || test_mat_pixel_letterbox(50, 20, ncnn::Mat::PIXEL_BGRA2RGBA, 24, 24, 24, 10, 0, 7, 4)
+           || test_mat_pixel_letterbox(12, 20, ncnn::Mat::PIXEL_RGB2BGRA, 24, 24, 14, 24, 5, 0, 4);
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_mat_pixel_0()
+           || test_mat_pixel_1();
+}
@@ -203,11 +203,64 @@ static int test_mat_pixel_rotate_1()
            || test_mat_pixel_rotate_yuv420sp(22, 34);
 }
 
+static int test_mat_pixel_rotate_threads(int w, int h, int cn)
+{
+    ncnn::Mat a0 = RandomMat(w, h, cn);
+
+    ncnn::Option opt;
+    opt.num_threads = 4;
+
+    for (int type = 1; type <= 8; type++)
+    {
+        const int outw = type >= 5 ? h : w;
+        const int outh = type >= 5 ? w : h;
+
+        ncnn::Mat a1(outw, outh, (size_t)cn, cn);
+        ncnn::Mat a2(outw, outh, (size_t)cn, cn);
+
+        if (cn == 1) ncnn::kanna_rotate_c1(a0, w, h, w * cn, a1, outw, outh, outw * cn, type);
+        if (cn == 2) ncnn::kanna_rotate_c2(a0, w, h, w * cn, a1, outw, outh, outw * cn, type);
+        if (cn == 3) ncnn::kanna_rotate_c3(a0, w, h, w * cn, a1, outw, outh, outw * cn, type);
+        if (cn == 4) ncnn::kanna_rotate_c4(a0, w, h, w * cn, a1, outw, outh, outw * cn, type);
+
+        if (cn == 1) ncnn::kanna_rotate_c1(a0, w, h, w * cn, a2, outw, outh, outw * cn, type, opt);
+        if (cn == 2) ncnn::kanna_rotate_c2(a0, w, h, w * cn, a2, outw, outh, outw * cn, type, opt);
+        if (cn == 3) ncnn::kanna_rotate_c3(a0, w, h, w * cn, a2, outw, outh, outw * cn, type, opt);
+        if (cn == 4) ncnn::kanna_rotate_c4(a0, w, h, w * cn, a2, outw, outh, outw * cn, type, opt);
+
+        if (memcmp(a1, a2, w * h * cn) != 0)
+        {
+            fprintf(stderr, "test_mat_pixel_rotate_threads failed w=%d h=%d cn=%d type=%d\n", w, h, cn, type);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_mat_pixel_rotate_2()
+{
+    for (int cn = 1; cn <= 4; cn++)
+    {
+        int ret = 0
+                  || test_mat_pixel_rotate_threads(6, 7, cn)
+                  || test_mat_pixel_rotate_threads(33, 17, cn)
+                  || test_mat_pixel_rotate_threads(64, 40, cn)
+                  || test_mat_pixel_rotate_threads(101, 75, cn);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+
 int main()
 {
     SRAND(7767517);
 
     return 0
            || test_mat_pixel_rotate_0()
-           || test_mat_pixel_rotate_1();
+           || test_mat_pixel_rotate_1()
+           || test_mat_pixel_rotate_2();
 }
@@ -0,0 +1,187 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+static const char* param_str = "7767517\n"
+                               "5 5\n"
+                               "Input data 0 1 data\n"
+                               "Convolution conv3x3 1 1 data conv0 0=16 1=3 4=1 5=1 6=1152 9=1\n"
+                               "Pooling pool 1 1 conv0 pool0 0=0 1=2 2=2\n"
+                               "Convolution conv1x1 1 1 pool0 conv1 0=24 1=1 5=1 6=384\n"
+                               "Pooling gap 1 1 conv1 output 0=1 4=1\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+static int run_extractor(const ncnn::Net& net, const ncnn::Mat& in, bool memory_planning, ncnn::Mat& out, size_t& plan_size)
+{
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_memory_planning(memory_planning);
+
+    ex.input("data", in);
+    int ret = ex.extract("output", out);
+
+    plan_size = ex.memory_plan_size();
+
+    return ret;
+}
+
+static int test_memoryplan_0(int cache_size)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.opt.memory_plan_cache_size = cache_size;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat inputs[3] = {
+        RandomMat(16, 12, 8),
+        RandomMat(20, 20, 8),
+        RandomMat(10, 14, 8)
+    };
+
+    // a b c a b c a, one fresh extractor per frame
+    static const int frames[7] = {0, 1, 2, 0, 1, 2, 0};
+
+    for (int i = 0; i < 7; i++)
+    {
+        const ncnn::Mat& in = inputs[frames[i]];
+
+        ncnn::Mat out_ref;
+        size_t plan_size_ref = 0;
+        if (run_extractor(net, in, false, out_ref, plan_size_ref) != 0)
+            return -1;
+
+        ncnn::Mat out;
+        size_t plan_size = 0;
+        if (run_extractor(net, in, true, out, plan_size) != 0)
+            return -1;
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_memoryplan_0 output mismatch cache_size=%d frame=%d\n", cache_size, i);
+            return -1;
+        }
+
+        // the shapes recorded at frame i - 3 are still cached when three shapes fit
+        const bool expect_planned = i >= 3 && cache_size >= 3;
+        if ((plan_size != 0) != expect_planned)
+        {
+            fprintf(stderr, "test_memoryplan_0 plan size %zu cache_size=%d frame=%d\n", plan_size, cache_size, i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int test_memoryplan_1()
+{
+    // one extractor reused across passes with changing shapes
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.opt.memory_plan_cache_size = 2;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat a = RandomMat(16, 12, 8);
+    ncnn::Mat b = RandomMat(20, 20, 8);
+
+    ncnn::Mat out_a_ref;
+    ncnn::Mat out_b_ref;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", a);
+        ex.extract("output", out_a_ref);
+    }
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", b);
+        ex.extract("output", out_b_ref);
+    }
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_memory_planning(true);
+
+    for (int i = 0; i < 6; i++)
+    {
+        const bool use_a = i % 2 == 0;
+
+        ex.clear();
+        ex.input("data", use_a ? a : b);
+
+        ncnn::Mat out;
+        if (ex.extract("output", out) != 0)
+            return -1;
+
+        if (CompareMat(out, use_a ? out_a_ref : out_b_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_memoryplan_1 output mismatch pass=%d\n", i);
+            return -1;
+        }
+
+        // both shapes planned after their first pass
+        if (i >= 2 && ex.memory_plan_size() == 0)
+        {
+            fprintf(stderr, "test_memoryplan_1 not planned pass=%d\n", i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_memoryplan_0(0)
+           || test_memoryplan_0(2)
+           || test_memoryplan_0(4)
+           || test_memoryplan_1();
+}
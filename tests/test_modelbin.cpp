@@ -0,0 +1,77 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "modelbin.h"
+
+// tagged sparse record, nonzero bitmask followed by the nonzero values
+static int test_modelbin_sparse(int w, int keep_percent)
+{
+    ncnn::Mat a = RandomMat(w);
+    for (int i = 0; i < w; i++)
+    {
+        if (RAND() % 100 >= keep_percent)
+            a[i] = 0.f;
+    }
+
+    std::vector<unsigned int> buf;
+    buf.push_back(0x0B5A25E0);
+
+    std::vector<unsigned int> mask((w + 31) / 32, 0);
+    std::vector<float> values;
+    for (int i = 0; i < w; i++)
+    {
+        if (a[i] == 0.f)
+            continue;
+
+        mask[i / 32] |= 1u << (i % 32);
+        values.push_back(a[i]);
+    }
+    buf.insert(buf.end(), mask.begin(), mask.end());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        unsigned int v;
+        memcpy(&v, &values[i], sizeof(float));
+        buf.push_back(v);
+    }
+
+    // a dense record follows to check the read position
+    ncnn::Mat b = RandomMat(7);
+    buf.push_back(0);
+    for (int i = 0; i < 7; i++)
+    {
+        unsigned int v;
+        memcpy(&v, &b[i], sizeof(float));
+        buf.push_back(v);
+    }
+
+    const unsigned char* mem = (const unsigned char*)buf.data();
+    ncnn::DataReaderFromMemory dr(mem);
+    ncnn::ModelBinFromDataReader mb(dr);
+
+    ncnn::Mat a2 = mb.load(w, 0);
+    ncnn::Mat b2 = mb.load(7, 0);
+
+    if (a2.w != w || b2.w != 7 || CompareMat(a, a2, 0.0001) != 0 || CompareMat(b, b2, 0.0001) != 0)
+    {
+        fprintf(stderr, "test_modelbin_sparse failed w=%d keep_percent=%d\n", w, keep_percent);
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_modelbin_sparse(1, 0)
+           || test_modelbin_sparse(31, 50)
+           || test_modelbin_sparse(32, 25)
+           || test_modelbin_sparse(100, 10)
+           || test_modelbin_sparse(1000, 40)
+           || test_modelbin_sparse(64, 100);
+}
@@ -0,0 +1,287 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+static int test_multiheadattention_kvcache(const ncnn::Mat& q, const ncnn::Mat& k, const ncnn::Mat& v, int past_seqlen, int embed_dim, int num_heads, int attn_mask)
+{
+    const int qdim = q.w;
+    const int kdim = k.w;
+    const int vdim = v.w;
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(3, kdim);
+    pd.set(4, vdim);
+    pd.set(5, attn_mask);
+    pd.set(7, 1); // kv_cache
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * kdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * vdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    std::vector<ncnn::Mat> as(3);
+    as[0] = q;
+    as[1] = k;
+    as[2] = v;
+
+    if (attn_mask)
+    {
+        as.push_back(RandomMat(past_seqlen + k.h, q.h));
+    }
+
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+
+    float epsilon = 0.005;
+
+    int ret = test_layer("MultiHeadAttention", pd, weights, as, 3, epsilon);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache failed q=(%d %d) k=(%d %d) v=(%d %d) past_seqlen=%d embed_dim=%d num_heads=%d attn_mask=%d\n", q.w, q.h, k.w, k.h, v.w, v.h, past_seqlen, embed_dim, num_heads, attn_mask);
+    }
+
+    return ret;
+}
+
+#if NCNN_INT8
+static int test_multiheadattention_kvcache_int8(const ncnn::Mat& q, const ncnn::Mat& k, const ncnn::Mat& v, int past_seqlen, int embed_dim, int num_heads, int attn_mask)
+{
+    const int qdim = q.w;
+    const int kdim = k.w;
+    const int vdim = v.w;
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(3, kdim);
+    pd.set(4, vdim);
+    pd.set(5, attn_mask);
+    pd.set(6, 1.f / sqrtf(embed_dim / num_heads));
+    pd.set(7, 1);  // kv_cache
+    pd.set(18, 2); // int8_scale_term
+
+    std::vector<ncnn::Mat> weights(12);
+    weights[0] = RandomS8Mat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomS8Mat(embed_dim * kdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomS8Mat(embed_dim * vdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomS8Mat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+    weights[8] = RandomMat(embed_dim, 160.f, 200.f);
+    weights[9] = RandomMat(embed_dim, 160.f, 200.f);
+    weights[10] = RandomMat(embed_dim, 160.f, 200.f);
+    weights[11] = RandomMat(1, 160.f, 200.f);
+
+    std::vector<ncnn::Mat> as(3);
+    as[0] = q;
+    as[1] = k;
+    as[2] = v;
+
+    if (attn_mask)
+    {
+        as.push_back(RandomMat(past_seqlen + k.h, q.h));
+    }
+
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+    as.push_back(RandomMat(past_seqlen, embed_dim));
+
+    float epsilon = 0.1;
+
+    int ret = test_layer("MultiHeadAttention", pd, weights, as, 3, epsilon);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_multiheadattention_kvcache_int8 failed q=(%d %d) k=(%d %d) v=(%d %d) past_seqlen=%d embed_dim=%d num_heads=%d attn_mask=%d\n", q.w, q.h, k.w, k.h, v.w, v.h, past_seqlen, embed_dim, num_heads, attn_mask);
+    }
+
+    return ret;
+}
+#endif // NCNN_INT8
+
+static ncnn::Mat causal_mask(int past_seqlen, int seqlen)
+{
+    ncnn::Mat mask(past_seqlen + seqlen, seqlen);
+    for (int i = 0; i < seqlen; i++)
+    {
+        float* ptr = mask.row(i);
+        for (int j = 0; j < past_seqlen + seqlen; j++)
+        {
+            ptr[j] = j <= past_seqlen + i ? 0.f : -10000.f;
+        }
+    }
+    return mask;
+}
+
+static int forward_mha(const ncnn::ParamDict& pd, const std::vector<ncnn::Mat>& weights, const ncnn::Option& opt, const std::vector<ncnn::Mat>& bottom_blobs, std::vector<ncnn::Mat>& top_blobs, bool naive)
+{
+    ncnn::Layer* op = naive ? ncnn::create_layer_naive("MultiHeadAttention") : ncnn::create_layer_cpu("MultiHeadAttention");
+
+    op->load_param(pd);
+
+    ncnn::ModelBinFromMatArray mb(weights.data());
+    op->load_model(mb);
+
+    op->create_pipeline(opt);
+
+    int ret = op->forward(bottom_blobs, top_blobs, opt);
+
+    op->destroy_pipeline(opt);
+
+    delete op;
+
+    return ret;
+}
+
+// prefill and decode token by token with kv cache must match one causal pass over the whole sequence
+static int test_multiheadattention_decode(int seqlen, int prefill_seqlen, int embed_dim, int num_heads, bool use_packing_layout, bool naive)
+{
+    const int qdim = embed_dim;
+
+    std::vector<ncnn::Mat> weights(8);
+    weights[0] = RandomMat(embed_dim * qdim);
+    weights[1] = RandomMat(embed_dim);
+    weights[2] = RandomMat(embed_dim * qdim);
+    weights[3] = RandomMat(embed_dim);
+    weights[4] = RandomMat(embed_dim * qdim);
+    weights[5] = RandomMat(embed_dim);
+    weights[6] = RandomMat(qdim * embed_dim);
+    weights[7] = RandomMat(qdim);
+
+    ncnn::Mat x = RandomMat(qdim, seqlen);
+
+    ncnn::Option opt;
+    opt.num_threads = 1;
+    opt.use_packing_layout = use_packing_layout;
+    opt.use_fp16_storage = false;
+    opt.use_bf16_storage = false;
+
+    ncnn::ParamDict pd;
+    pd.set(0, embed_dim);
+    pd.set(1, num_heads);
+    pd.set(2, embed_dim * qdim);
+    pd.set(5, 1); // attn_mask
+
+    // reference
+    ncnn::Mat ref;
+    {
+        std::vector<ncnn::Mat> bottom_blobs(2);
+        bottom_blobs[0] = x;
+        bottom_blobs[1] = causal_mask(0, seqlen);
+        std::vector<ncnn::Mat> top_blobs(1);
+        int ret = forward_mha(pd, weights, opt, bottom_blobs, top_blobs, naive);
+        if (ret != 0)
+            return ret;
+
+        ref = top_blobs[0];
+        if (ref.elempack != 1)
+        {
+            ncnn::Mat ref_unpacked;
+            ncnn::convert_packing(ref, ref_unpacked, 1, opt);
+            ref = ref_unpacked;
+        }
+    }
+
+    pd.set(7, 1); // kv_cache
+
+    ncnn::Mat cache_k(0, embed_dim);
+    ncnn::Mat cache_v(0, embed_dim);
+
+    int past_seqlen = 0;
+    while (past_seqlen < seqlen)
+    {
+        const int cur_seqlen = past_seqlen == 0 ? prefill_seqlen : 1;
+
+        ncnn::Mat xcur = x.row_range(past_seqlen, cur_seqlen).clone();
+
+        std::vector<ncnn::Mat> bottom_blobs(4);
+        bottom_blobs[0] = xcur;
+        bottom_blobs[1] = causal_mask(past_seqlen, cur_seqlen);
+        bottom_blobs[2] = cache_k;
+        bottom_blobs[3] = cache_v;
+        std::vector<ncnn::Mat> top_blobs(3);
+        int ret = forward_mha(pd, weights, opt, bottom_blobs, top_blobs, naive);
+        if (ret != 0)
+            return ret;
+
+        ncnn::Mat out = top_blobs[0];
+        if (out.elempack != 1)
+        {
+            ncnn::Mat out_unpacked;
+            ncnn::convert_packing(out, out_unpacked, 1, opt);
+            out = out_unpacked;
+        }
+
+        cache_k = top_blobs[1];
+        cache_v = top_blobs[2];
+
+        if (cache_k.w != past_seqlen + cur_seqlen || cache_v.w != past_seqlen + cur_seqlen || cache_k.h != embed_dim)
+        {
+            fprintf(stderr, "test_multiheadattention_decode cache shape mismatch %d x %d at %d\n", cache_k.w, cache_k.h, past_seqlen);
+            return -1;
+        }
+
+        if (CompareMat(ref.row_range(past_seqlen, cur_seqlen), out, 0.005) != 0)
+        {
+            fprintf(stderr, "test_multiheadattention_decode failed seqlen=%d prefill_seqlen=%d embed_dim=%d num_heads=%d use_packing_layout=%d naive=%d at %d\n", seqlen, prefill_seqlen, embed_dim, num_heads, use_packing_layout, naive, past_seqlen);
+            return -1;
+        }
+
+        past_seqlen += cur_seqlen;
+    }
+
+    return 0;
+}
+
+static int test_multiheadattention_0()
+{
+    return 0
+           || test_multiheadattention_kvcache(RandomMat(62, 1), RandomMat(32, 1), RandomMat(20, 1), 17, 62, 2, 0)
+           || test_multiheadattention_kvcache(RandomMat(64, 1), RandomMat(64, 1), RandomMat(64, 1), 31, 64, 4, 0)
+           || test_multiheadattention_kvcache(RandomMat(64, 5), RandomMat(64, 5), RandomMat(64, 5), 16, 64, 4, 1)
+           || test_multiheadattention_kvcache(RandomMat(32, 8), RandomMat(48, 8), RandomMat(24, 8), 24, 32, 8, 1)
+           || test_multiheadattention_kvcache(RandomMat(28, 3), RandomMat(28, 3), RandomMat(28, 3), 1, 28, 7, 0);
+}
+
+static int test_multiheadattention_1()
+{
+    return 0
+           || test_multiheadattention_decode(12, 5, 32, 4, false, true)
+           || test_multiheadattention_decode(12, 5, 32, 4, false, false)
+           || test_multiheadattention_decode(12, 5, 32, 4, true, false)
+           || test_multiheadattention_decode(9, 1, 64, 8, true, false)
+           || test_multiheadattention_decode(20, 16, 48, 3, true, false)
+           || test_multiheadattention_decode(150, 100, 32, 2, true, true)
+           || test_multiheadattention_decode(150, 100, 32, 2, true, false);
+}
+
+static int test_multiheadattention_2()
+{
+#if NCNN_INT8
+    return 0
+           || test_multiheadattention_kvcache_int8(RandomMat(64, 1), RandomMat(64, 1), RandomMat(64, 1), 23, 64, 4, 0)
+           || test_multiheadattention_kvcache_int8(RandomMat(32, 6), RandomMat(48, 6), RandomMat(24, 6), 10, 32, 8, 1);
+#else
+    return 0;
+#endif // NCNN_INT8
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    return 0
+           || test_multiheadattention_0()
+           || test_multiheadattention_1()
+           || test_multiheadattention_2();
+}
@@ -0,0 +1,226 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+#include "packedweightcache.h"
+
+static const char* param_str = "7767517\n"
+                               "5 5\n"
+                               "Input data 0 1 data 0=12 1=12 2=16\n"
+                               "Convolution conv3x3 1 1 data conv0 0=24 1=3 4=1 5=1 6=3456\n"
+                               "Convolution conv1x1 1 1 conv0 conv1 0=32 1=1 5=1 6=768 9=1\n"
+                               "Convolution conv3x3s2 1 1 conv1 conv2 0=8 1=3 3=2 5=1 6=2304\n"
+                               "InnerProduct fc 1 1 conv2 output 0=20 1=1 2=4000\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+static int run_net(ncnn::PackedWeightCache* cache, const ncnn::Option& opt, ncnn::Mat& out)
+{
+    ncnn::Net net;
+    net.opt = opt;
+    net.opt.packed_weight_cache = cache;
+
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    int ret = net.load_model(dr);
+    if (ret != 0)
+    {
+        fprintf(stderr, "load_model failed %d\n", ret);
+        return -1;
+    }
+
+    ncnn::Mat in = RandomMat(12, 12, 16);
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.input("data", in);
+    return ex.extract("output", out);
+}
+
+static int test_packedweightcache_0(const ncnn::Option& opt)
+{
+    SRAND(7767517);
+    ncnn::Mat out_ref;
+    if (run_net(0, opt, out_ref) != 0)
+        return -1;
+
+    // populate on first load
+    ncnn::PackedWeightCache cache;
+    SRAND(7767517);
+    ncnn::Mat out_miss;
+    if (run_net(&cache, opt, out_miss) != 0)
+        return -1;
+
+    const int entry_count = cache.size();
+
+    // hit on second load, nothing added
+    SRAND(7767517);
+    ncnn::Mat out_hit;
+    if (run_net(&cache, opt, out_hit) != 0)
+        return -1;
+
+    if (cache.size() != entry_count)
+    {
+        fprintf(stderr, "test_packedweightcache cache grew %d -> %d on reload\n", entry_count, cache.size());
+        return -1;
+    }
+
+    // round trip through file
+    ncnn::PackedWeightCache cache2;
+    {
+        FILE* fp = tmpfile();
+        if (!fp)
+        {
+            fprintf(stderr, "tmpfile failed\n");
+            return -1;
+        }
+
+        int ret = cache.save(fp);
+        rewind(fp);
+        if (ret == 0)
+            ret = cache2.load(fp);
+        fclose(fp);
+
+        if (ret != 0 || cache2.size() != entry_count)
+        {
+            fprintf(stderr, "test_packedweightcache save/load failed %d %d\n", ret, cache2.size());
+            return -1;
+        }
+    }
+
+    SRAND(7767517);
+    ncnn::Mat out_file;
+    if (run_net(&cache2, opt, out_file) != 0)
+        return -1;
+
+    if (cache2.size() != entry_count)
+    {
+        fprintf(stderr, "test_packedweightcache loaded cache missed %d -> %d\n", entry_count, cache2.size());
+        return -1;
+    }
+
+    if (CompareMat(out_ref, out_miss, 0.001) != 0 || CompareMat(out_ref, out_hit, 0.001) != 0 || CompareMat(out_ref, out_file, 0.001) != 0)
+    {
+        fprintf(stderr, "test_packedweightcache output mismatch\n");
+        return -1;
+    }
+
+    // different thread count must not reuse the packed layout
+    ncnn::Option opt2 = opt;
+    opt2.num_threads = opt.num_threads + 1;
+    SRAND(7767517);
+    ncnn::Mat out_threads;
+    if (run_net(&cache, opt2, out_threads) != 0)
+        return -1;
+
+    if (entry_count > 0 && cache.size() == entry_count)
+    {
+        fprintf(stderr, "test_packedweightcache reused entries across thread count\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_packedweightcache_1()
+{
+    // a hit is trusted without rereading the source weights, any content change must miss
+    ncnn::Option opt;
+    opt.num_threads = 1;
+
+    std::vector<ncnn::Mat> weights(1);
+    weights[0] = RandomMat(64, 48);
+
+    std::vector<int> params(1, 64);
+
+    std::vector<ncnn::Mat> packed(1);
+    packed[0] = RandomMat(48, 64);
+
+    ncnn::PackedWeightCache cache;
+    cache.put("test", weights, params, opt, packed);
+
+    std::vector<ncnn::Mat> packed_hit;
+    if (cache.get("test", weights, params, opt, packed_hit) != 0 || packed_hit.size() != 1 || packed_hit[0].data != packed[0].data)
+    {
+        fprintf(stderr, "test_packedweightcache_1 expect hit\n");
+        return -1;
+    }
+
+    // flip the lowest mantissa bit of a single value
+    std::vector<ncnn::Mat> weights2(1);
+    weights2[0] = weights[0].clone();
+    ((unsigned int*)weights2[0].data)[64 * 48 - 1] ^= 1;
+
+    // same bytes in another shape
+    std::vector<ncnn::Mat> weights3(1);
+    weights3[0] = weights[0].reshape(48, 64);
+
+    std::vector<ncnn::Mat> packed_miss;
+    if (cache.get("test", weights2, params, opt, packed_miss) == 0 || cache.get("test", weights3, params, opt, packed_miss) == 0)
+    {
+        fprintf(stderr, "test_packedweightcache_1 expect miss\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    ncnn::Option opts[3];
+
+    opts[0].use_packing_layout = false;
+    opts[0].num_threads = 1;
+
+    opts[1].use_packing_layout = true;
+    opts[1].num_threads = 1;
+
+    opts[2].use_packing_layout = true;
+    opts[2].use_winograd_convolution = false;
+    opts[2].use_sgemm_convolution = false;
+    opts[2].num_threads = 2;
+
+    for (int i = 0; i < 3; i++)
+    {
+        int ret = test_packedweightcache_0(opts[i]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_packedweightcache failed use_packing_layout=%d num_threads=%d\n", opts[i].use_packing_layout, opts[i].num_threads);
+            return ret;
+        }
+    }
+
+    return test_packedweightcache_1();
+}
@@ -287,6 +287,7 @@ static int test_padding_5()
            || test_padding_int8(c, 0, 0, 0, 0, 0, 0, 0, 0.f, 0)
 
            || test_padding_int8(a, 2, 2, 2, 2, 0, 0, 0, 1.f, 0)
+           || test_padding_int8(a, 2, 2, 2, 2, 0, 0, 0, -128.f, 0)
            || test_padding_int8(b, 2, 2, 2, 2, 0, 0, 0, 2.f, 0)
            || test_padding_int8(c, 2, 2, 2, 2, 0, 0, 0, -3.f, 0)
 
@@ -359,6 +360,7 @@ static int test_padding_6()
            || test_padding_int8(c, 0, 0, 3, 2, 0, 0, 2, 0.f, 0)
 
            || test_padding_int8(a, 2, 2, 2, 2, 0, 0, 0, 1.f, 0)
+           || test_padding_int8(a, 2, 2, 2, 2, 0, 0, 0, -128.f, 0)
            || test_padding_int8(b, 2, 2, 2, 2, 0, 0, 0, 2.f, 0)
            || test_padding_int8(c, 2, 2, 2, 2, 0, 0, 0, -3.f, 0)
 
@@ -0,0 +1,183 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "allocator.h"
+
+#include <stdio.h>
+#include <string.h>
+
+// a is freed before c is allocated, b lives across both
+static int run_pass(ncnn::PlannedAllocator& allocator, size_t size_c, void** ptrs)
+{
+    unsigned char* a = (unsigned char*)allocator.fastMalloc(100);
+    unsigned char* b = (unsigned char*)allocator.fastMalloc(200);
+    memset(a, 1, 100);
+    memset(b, 2, 200);
+    allocator.fastFree(a);
+
+    unsigned char* c = (unsigned char*)allocator.fastMalloc(size_c);
+    memset(c, 3, size_c);
+
+    // b must be untouched by c
+    for (int i = 0; i < 200; i++)
+    {
+        if (b[i] != 2)
+        {
+            fprintf(stderr, "planned allocator block b overwritten at %d\n", i);
+            return -1;
+        }
+    }
+
+    allocator.fastFree(b);
+    allocator.fastFree(c);
+
+    ptrs[0] = a;
+    ptrs[1] = b;
+    ptrs[2] = c;
+
+    return 0;
+}
+
+static bool in_arena(const void* ptr, const void* base, size_t size)
+{
+    return (const unsigned char*)ptr >= (const unsigned char*)base && (const unsigned char*)ptr < (const unsigned char*)base + size;
+}
+
+static int test_plannedallocator_0()
+{
+    ncnn::PlannedAllocator allocator;
+
+    void* ptrs[3];
+
+    // record
+    allocator.begin();
+    if (run_pass(allocator, 100, ptrs) != 0)
+        return -1;
+
+    if (allocator.peak_size() != 0)
+    {
+        fprintf(stderr, "test_plannedallocator_0 planned while recording\n");
+        return -1;
+    }
+
+    // replay from the arena twice, a and c share memory
+    void* replay_ptrs[3];
+    for (int i = 0; i < 2; i++)
+    {
+        allocator.begin();
+        if (run_pass(allocator, 100, ptrs) != 0)
+            return -1;
+
+        const size_t peak_size = allocator.peak_size();
+        if (peak_size == 0 || peak_size >= 100 + 200 + 100)
+        {
+            fprintf(stderr, "test_plannedallocator_0 peak_size %zu\n", peak_size);
+            return -1;
+        }
+
+        if (ptrs[0] != ptrs[2])
+        {
+            fprintf(stderr, "test_plannedallocator_0 lifetime disjoint blocks not shared\n");
+            return -1;
+        }
+
+        if (i == 1 && (ptrs[0] != replay_ptrs[0] || ptrs[1] != replay_ptrs[1]))
+        {
+            fprintf(stderr, "test_plannedallocator_0 replay moved blocks\n");
+            return -1;
+        }
+
+        memcpy(replay_ptrs, ptrs, sizeof(ptrs));
+    }
+
+    return 0;
+}
+
+static int test_plannedallocator_1()
+{
+    ncnn::PlannedAllocator allocator;
+
+    void* ptrs[3];
+
+    allocator.begin();
+    if (run_pass(allocator, 100, ptrs) != 0)
+        return -1;
+
+    allocator.begin();
+    if (run_pass(allocator, 100, ptrs) != 0)
+        return -1;
+
+    const size_t peak_size = allocator.peak_size();
+    const void* arena = ptrs[1] < ptrs[0] ? ptrs[1] : ptrs[0];
+
+    // c grows, the pass diverges at c and falls back to heap from there on
+    allocator.begin();
+    if (run_pass(allocator, 400, ptrs) != 0)
+        return -1;
+
+    if (!in_arena(ptrs[0], arena, peak_size) || !in_arena(ptrs[1], arena, peak_size) || in_arena(ptrs[2], arena, peak_size))
+    {
+        fprintf(stderr, "test_plannedallocator_1 diverged pass served c from arena\n");
+        return -1;
+    }
+
+    // the diverged plan is dropped and the new sequence recorded
+    allocator.begin();
+    if (allocator.peak_size() != 0)
+    {
+        fprintf(stderr, "test_plannedallocator_1 plan kept after divergence\n");
+        return -1;
+    }
+    if (run_pass(allocator, 400, ptrs) != 0)
+        return -1;
+
+    // and replayed
+    allocator.begin();
+    if (run_pass(allocator, 400, ptrs) != 0)
+        return -1;
+
+    if (allocator.peak_size() <= peak_size)
+    {
+        fprintf(stderr, "test_plannedallocator_1 replanned peak_size %zu\n", allocator.peak_size());
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_plannedallocator_2()
+{
+    // a pass starting while the arena is still referenced comes from heap
+    ncnn::PlannedAllocator allocator;
+
+    void* ptrs[3];
+
+    allocator.begin();
+    if (run_pass(allocator, 100, ptrs) != 0)
+        return -1;
+
+    allocator.begin();
+    void* held = allocator.fastMalloc(100);
+
+    allocator.begin();
+    if (run_pass(allocator, 100, ptrs) != 0)
+        return -1;
+
+    if (ptrs[0] == held || ptrs[1] == held || ptrs[2] == held)
+    {
+        fprintf(stderr, "test_plannedallocator_2 arena handed out twice\n");
+        return -1;
+    }
+
+    allocator.fastFree(held);
+
+    return 0;
+}
+
+int main()
+{
+    return 0
+           || test_plannedallocator_0()
+           || test_plannedallocator_1()
+           || test_plannedallocator_2();
+}
@@ -242,14 +242,84 @@ static int test_pooling_4()
            || test_pooling(13, 11, 16, 0, 1, 1, 0, 0, 0, 1, 0, 12);
 }
 
+#if NCNN_INT8
+static int test_pooling_int8(int w, int h, int c, int pooling_type, int kernel, int stride, int pad, int global_pooling, int pad_mode, int avgpool_count_include_pad)
+{
+    ncnn::Mat a = RandomS8Mat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, pooling_type);              // pooling_type
+    pd.set(1, kernel);                    // kernel_w
+    pd.set(2, stride);                    // stride_w
+    pd.set(3, pad);                       // pad_w
+    pd.set(4, global_pooling);            // global_pooling
+    pd.set(5, pad_mode);                  // pad_mode
+    pd.set(6, avgpool_count_include_pad); // avgpool_count_include_pad
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Pooling", pd, weights, a, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_pooling_int8 failed w=%d h=%d c=%d pooling_type=%d kernel=%d stride=%d pad=%d global_pooling=%d pad_mode=%d avgpool_count_include_pad=%d\n", w, h, c, pooling_type, kernel, stride, pad, global_pooling, pad_mode, avgpool_count_include_pad);
+    }
+
+    return ret;
+}
+
+static int test_pooling_5()
+{
+    static const int ksp[6][3] = {
+        {2, 1, 0},
+        {2, 2, 0},
+        {3, 1, 1},
+        {3, 2, 1},
+        {5, 2, 2},
+        {7, 3, 2},
+    };
+
+    for (int i = 0; i < 6; i++)
+    {
+        int ret = 0
+                  || test_pooling_int8(9, 7, 1, 0, ksp[i][0], ksp[i][1], ksp[i][2], 0, 0, 0)
+                  || test_pooling_int8(9, 7, 3, 1, ksp[i][0], ksp[i][1], ksp[i][2], 0, 0, 0)
+                  || test_pooling_int8(9, 7, 8, 0, ksp[i][0], ksp[i][1], ksp[i][2], 0, 1, 0)
+                  || test_pooling_int8(9, 7, 8, 1, ksp[i][0], ksp[i][1], ksp[i][2], 0, 0, 1)
+                  || test_pooling_int8(9, 7, 16, 0, ksp[i][0], ksp[i][1], ksp[i][2], 0, 2, 0)
+                  || test_pooling_int8(9, 7, 16, 1, ksp[i][0], ksp[i][1], ksp[i][2], 0, 3, 0)
+                  || test_pooling_int8(9, 7, 24, 1, ksp[i][0], ksp[i][1], ksp[i][2], 0, 0, 0);
+
+        if (ret != 0)
+            return -1;
+    }
+
+    return 0
+           || test_pooling_int8(11, 13, 3, 0, 1, 1, 0, 1, 0, 0)
+           || test_pooling_int8(11, 13, 8, 1, 1, 1, 0, 1, 0, 0)
+           || test_pooling_int8(13, 11, 16, 0, 1, 1, 0, 1, 0, 0)
+           || test_pooling_int8(13, 11, 24, 1, 1, 1, 0, 1, 0, 0);
+}
+#endif // NCNN_INT8
+
 int main()
 {
     SRAND(7767517);
 
+#if NCNN_INT8
+    return 0
+           || test_pooling_0()
+           || test_pooling_1()
+           || test_pooling_2()
+           || test_pooling_3()
+           || test_pooling_4()
+           || test_pooling_5();
+#else
     return 0
            || test_pooling_0()
            || test_pooling_1()
            || test_pooling_2()
            || test_pooling_3()
            || test_pooling_4();
+#endif
 }
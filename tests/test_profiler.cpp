@@ -0,0 +1,202 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "net.h"
+#include "profiler.h"
+
+static const char* param_str = "7767517\n"
+                               "5 6\n"
+                               "Input data 0 1 data 0=12 1=12 2=16\n"
+                               "Split splitncnn_0 1 2 data data_0 data_1\n"
+                               "ReLU relu 1 1 data_0 relu0\n"
+                               "Sigmoid sigmoid 1 1 data_1 sigmoid0\n"
+                               "BinaryOp add 2 1 relu0 sigmoid0 output\n";
+
+// count events instead of storing them
+class CountingProfiler : public ncnn::Profiler
+{
+public:
+    CountingProfiler()
+        : count(0)
+    {
+    }
+
+    virtual void on_layer(const ncnn::ProfilerEvent& /*event*/)
+    {
+        count++;
+    }
+
+    int count;
+};
+
+static int test_profiler_0(const ncnn::Option& opt)
+{
+    ncnn::Net net;
+    net.opt = opt;
+
+    net.load_param_mem(param_str);
+    net.load_model((const unsigned char*)"");
+
+    ncnn::Mat in = RandomMat(12, 12, 16);
+
+    ncnn::Profiler profiler;
+
+    for (int i = 0; i < 2; i++)
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_profiler(&profiler);
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        int ret = ex.extract("output", out);
+        if (ret != 0)
+        {
+            fprintf(stderr, "extract failed %d\n", ret);
+            return -1;
+        }
+    }
+
+    // Input is not forwarded
+    const std::vector<ncnn::ProfilerEvent> events = profiler.events();
+    if (events.size() != 4 * 2)
+    {
+        fprintf(stderr, "test_profiler expect 8 events but got %d\n", (int)events.size());
+        return -1;
+    }
+
+    for (size_t i = 0; i < events.size(); i++)
+    {
+        const ncnn::ProfilerEvent& e = events[i];
+        if (e.end < e.start || e.top_shapes.empty() || e.top_shapes[0].dims == 0 || e.bottom_shapes.empty())
+        {
+            fprintf(stderr, "test_profiler bad event %d\n", (int)i);
+            return -1;
+        }
+
+        if (strcmp(e.name, net.layers()[e.layer_index]->name.c_str()) != 0)
+        {
+            fprintf(stderr, "test_profiler event %d name mismatch %s\n", (int)i, e.name);
+            return -1;
+        }
+
+        if (strcmp(e.type, "BinaryOp") == 0)
+        {
+            if (e.top_shapes[0].c * e.top_shapes[0].elempack != 16 || e.bottom_shapes.size() != 2)
+            {
+                fprintf(stderr, "test_profiler binaryop shape mismatch\n");
+                return -1;
+            }
+        }
+    }
+
+    // exports
+    {
+        FILE* fp = tmpfile();
+        if (!fp)
+        {
+            fprintf(stderr, "tmpfile failed\n");
+            return -1;
+        }
+
+        int ret = profiler.save_chrome_trace(fp);
+
+        long size = ftell(fp);
+        rewind(fp);
+
+        char head[16] = {0};
+        size_t nread = fread(head, 1, 15, fp);
+        fclose(fp);
+
+        if (ret != 0 || size <= 0 || nread != 15 || strncmp(head, "{\"traceEvents\":", 15) != 0)
+        {
+            fprintf(stderr, "test_profiler save_chrome_trace failed\n");
+            return -1;
+        }
+    }
+    {
+        FILE* fp = tmpfile();
+        if (!fp)
+        {
+            fprintf(stderr, "tmpfile failed\n");
+            return -1;
+        }
+
+        profiler.print_summary(fp);
+
+        long size = ftell(fp);
+        fclose(fp);
+
+        if (size <= 0)
+        {
+            fprintf(stderr, "test_profiler print_summary failed\n");
+            return -1;
+        }
+    }
+
+    profiler.clear();
+    if (!profiler.events().empty())
+    {
+        fprintf(stderr, "test_profiler clear failed\n");
+        return -1;
+    }
+
+    // overridden callback
+    CountingProfiler counting_profiler;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.set_profiler(&counting_profiler);
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        ex.extract("output", out);
+    }
+
+    if (counting_profiler.count != 4 || !counting_profiler.events().empty())
+    {
+        fprintf(stderr, "test_profiler on_layer override failed %d\n", counting_profiler.count);
+        return -1;
+    }
+
+    // not recorded without profiler
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+
+        ncnn::Mat out;
+        ex.extract("output", out);
+    }
+
+    if (counting_profiler.count != 4)
+    {
+        fprintf(stderr, "test_profiler recorded without profiler\n");
+        return -1;
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    ncnn::Option opts[2];
+
+    opts[0].use_packing_layout = false;
+
+    opts[1].use_packing_layout = true;
+    opts[1].lightmode = false;
+
+    for (int i = 0; i < 2; i++)
+    {
+        int ret = test_profiler_0(opts[i]);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_profiler failed use_packing_layout=%d lightmode=%d\n", opts[i].use_packing_layout, opts[i].lightmode);
+            return ret;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include <stdio.h>
+
+#include "net.h"
+#include "session.h"
+
+static const char* param_str = "7767517\n"
+                               "2 2\n"
+                               "Input data 0 1 data 0=4 1=3 2=2\n"
+                               "AbsVal absval 1 1 data output\n";
+
+struct Request
+{
+    float value;
+    float result;
+    int ret;
+};
+
+static void run_request(ncnn::Extractor& ex, void* userdata)
+{
+    Request* r = (Request*)userdata;
+
+    ncnn::Mat in(4, 3, 2);
+    in.fill(-r->value);
+
+    ex.input("data", in);
+
+    ncnn::Mat out;
+    r->ret = ex.extract("output", out);
+    r->result = r->ret == 0 ? out.channel(1).row(2)[3] : 0.f;
+}
+
+static int test_session_0(int worker_count, int queue_size)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.load_param_mem(param_str);
+    net.load_model((const unsigned char*)param_str);
+
+    const int request_count = 50;
+    std::vector<Request> requests(request_count);
+
+    {
+        ncnn::InferenceSession session(&net, worker_count, queue_size);
+
+        for (int i = 0; i < request_count; i++)
+        {
+            requests[i].value = (float)i;
+            requests[i].result = -1.f;
+            requests[i].ret = -1;
+
+            if (i % 2 == 0)
+            {
+                session.submit(run_request, &requests[i]);
+            }
+            else
+            {
+                while (session.try_submit(run_request, &requests[i]) != 0)
+                {
+                    session.wait_idle();
+                }
+            }
+
+            if (session.queue_depth() > queue_size)
+            {
+                fprintf(stderr, "test_session queue depth %d exceeds %d\n", session.queue_depth(), queue_size);
+                return -1;
+            }
+        }
+
+        session.wait_idle();
+
+        if (session.request_count() != request_count)
+        {
+            fprintf(stderr, "test_session request count %d != %d\n", session.request_count(), request_count);
+            return -1;
+        }
+
+        if (session.max_latency() < session.average_latency())
+        {
+            fprintf(stderr, "test_session latency max %f < average %f\n", session.max_latency(), session.average_latency());
+            return -1;
+        }
+    }
+
+    for (int i = 0; i < request_count; i++)
+    {
+        if (requests[i].ret != 0 || requests[i].result != requests[i].value)
+        {
+            fprintf(stderr, "test_session request %d failed ret=%d %f != %f\n", i, requests[i].ret, requests[i].result, requests[i].value);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    return 0
+           || test_session_0(1, 1)
+           || test_session_0(2, 4)
+           || test_session_0(4, 16);
+}
@@ -74,9 +74,48 @@ static int test_shufflechannel_1()
            || test_shufflechannel(3, 7, 64, 4, 1);
 }
 
+#if NCNN_INT8
+static int test_shufflechannel_int8(int w, int h, int c, int group, int reverse)
+{
+    ncnn::Mat a = RandomS8Mat(w, h, c);
+
+    ncnn::ParamDict pd;
+    pd.set(0, group);
+    pd.set(1, reverse);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("ShuffleChannel", pd, weights, a, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_shufflechannel_int8 failed w=%d h=%d c=%d group=%d reverse=%d\n", w, h, c, group, reverse);
+    }
+
+    return ret;
+}
+
+static int test_shufflechannel_2()
+{
+    return 0
+           || test_shufflechannel_int8(5, 7, 4, 2, 0)
+           || test_shufflechannel_int8(3, 7, 12, 3, 1)
+           || test_shufflechannel_int8(5, 9, 16, 4, 0)
+           || test_shufflechannel_int8(3, 7, 16, 8, 1)
+           || test_shufflechannel_int8(5, 7, 24, 2, 0)
+           || test_shufflechannel_int8(3, 7, 24, 3, 1)
+           || test_shufflechannel_int8(3, 7, 32, 8, 0)
+           || test_shufflechannel_int8(5, 7, 48, 3, 1);
+}
+#endif // NCNN_INT8
+
 int main()
 {
     SRAND(7767517);
 
+#if NCNN_INT8
+    return test_shufflechannel_0() || test_shufflechannel_1() || test_shufflechannel_2();
+#else
     return test_shufflechannel_0() || test_shufflechannel_1();
+#endif
 }
@@ -225,6 +225,66 @@ static int test_slice_3()
     return 0;
 }
 
+#if NCNN_INT8
+static int test_slice_int8(const ncnn::Mat& a, const std::vector<int>& slices_array, int axis)
+{
+    ncnn::Mat slices(slices_array.size());
+    {
+        int* p = slices;
+        for (size_t i = 0; i < slices_array.size(); i++)
+        {
+            p[i] = slices_array[i];
+        }
+    }
+
+    ncnn::ParamDict pd;
+    pd.set(0, slices);
+    pd.set(1, axis);
+
+    std::vector<ncnn::Mat> weights(0);
+
+    std::vector<ncnn::Mat> a0(1);
+    a0[0] = a;
+
+    int flag = TEST_LAYER_DISABLE_AUTO_INPUT_CASTING | TEST_LAYER_DISABLE_GPU_TESTING;
+    int ret = test_layer("Slice", pd, weights, a0, slices.w, 0.001, 0, flag);
+    if (ret != 0)
+    {
+        fprintf(stderr, "test_slice_int8 failed a.dims=%d a=(%d %d %d %d)", a.dims, a.w, a.h, a.d, a.c);
+        fprintf(stderr, " slices=");
+        print_int_array(slices_array);
+        fprintf(stderr, " axis=%d\n", axis);
+    }
+
+    return ret;
+}
+
+static int test_slice_4()
+{
+    ncnn::Mat a[] = {
+        RandomS8Mat(9, 7, 24),
+        RandomS8Mat(9, 8, 32),
+        RandomS8Mat(9, 9, 13)
+    };
+
+    for (int i = 0; i < sizeof(a) / sizeof(a[0]); i++)
+    {
+        int ret = 0
+                  || test_slice_int8(a[i], IntArray(-233, -233, -233), 0)
+                  || test_slice_int8(a[i], IntArray(8, -233), 0)
+                  || test_slice_int8(a[i], IntArray(3, 5, -233), 0)
+                  || test_slice_int8(a[i], IntArray(2, -233), 1)
+                  || test_slice_int8(a[i], IntArray(4, 3, -233), 2)
+                  || test_slice_int8(a[i], IntArray(-233, -233), -1);
+
+        if (ret != 0)
+            return ret;
+    }
+
+    return 0;
+}
+#endif // NCNN_INT8
+
 int main()
 {
     SRAND(7767517);
@@ -233,5 +293,9 @@ int main()
            || test_slice_0()
            || test_slice_1()
            || test_slice_2()
-           || test_slice_3();
+           || test_slice_3()
+#if NCNN_INT8
+           || test_slice_4()
+#endif
+           ;
 }
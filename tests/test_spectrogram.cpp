@@ -39,9 +39,18 @@ static int test_spectrogram_0()
            || test_spectrogram(124, 55, 2, 12, 55, 1, 1, 2, 2, 0);
 }
 
+static int test_spectrogram_1()
+{
+    return 0
+           || test_spectrogram(2048, 512, 0, 128, 400, 1, 1, 2, 0, 1)
+           || test_spectrogram(1600, 400, 2, 160, 400, 2, 0, 0, 1, 1)
+           || test_spectrogram(777, 96, 1, 24, 90, 1, 1, 1, 2, 0)
+           || test_spectrogram(300, 63, 0, 5, 63, 2, 1, 2, 1, 1);
+}
+
 int main()
 {
     SRAND(7767517);
 
-    return test_spectrogram_0();
+    return test_spectrogram_0() || test_spectrogram_1();
 }
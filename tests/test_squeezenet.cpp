@@ -200,6 +200,12 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
         squeezenet.load_param((const unsigned char*)param_data);
         squeezenet.load_model((const unsigned char*)model_data);
     }
+    if (load_model_type == 4)
+    {
+        // reference weight data from mapped model file
+        squeezenet.load_param(MODEL_DIR "/squeezenet_v1.1.param");
+        squeezenet.load_model_mmap(MODEL_DIR "/squeezenet_v1.1.bin");
+    }
 
     ncnn::Mat in = generate_ncnn_logo(ncnn::Mat::PIXEL_BGR, 227, 227);
 
@@ -209,7 +215,7 @@ static int test_squeezenet(const ncnn::Option& opt, int load_model_type, float e
     ncnn::Extractor ex = squeezenet.create_extractor();
 
     ncnn::Mat out;
-    if (load_model_type == 0 || load_model_type == 1)
+    if (load_model_type == 0 || load_model_type == 1 || load_model_type == 4)
     {
         ex.input("data", in);
         ex.extract("prob", out);
@@ -503,5 +509,21 @@ int main()
 #endif // NCNN_VULKAN
     }
 
+    for (int i = 0; i < 4; i++)
+    {
+        const ncnn::Option& opt = opts[i];
+
+        float epsilon = i == 0 ? 0.01 : 0.1;
+
+        ncnn::Option opt_cpu = opt;
+        opt_cpu.use_vulkan_compute = false;
+        int ret = test_squeezenet(opt_cpu, 4, epsilon);
+        if (ret != 0)
+        {
+            fprintf(stderr, "test_squeezenet mmap cpu failed use_packing_layout=%d use_fp16_packed=%d use_fp16_storage=%d\n", opt.use_packing_layout, opt.use_fp16_packed, opt.use_fp16_storage);
+            return ret;
+        }
+    }
+
     return 0;
 }
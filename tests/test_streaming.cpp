@@ -0,0 +1,278 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+#include "testutil.h"
+
+#include "datareader.h"
+#include "net.h"
+
+// input w=16 h=time
+static const char* recurrent_param_str = "7767517\n"
+                                         "4 4\n"
+                                         "Input data 0 1 data\n"
+                                         "LSTM lstm 1 1 data lstm0 0=24 1=1536 2=0\n"
+                                         "GRU gru 1 1 lstm0 gru0 0=20 1=1440 2=0\n"
+                                         "RNN rnn 1 1 gru0 output 0=12 1=240 2=0\n";
+
+// input w=time h=8, causal convolutions pad on the left only
+static const char* convolution_param_str = "7767517\n"
+                                           "3 3\n"
+                                           "Input data 0 1 data\n"
+                                           "Convolution1D conv0 1 1 data conv0 0=16 1=3 2=2 4=4 15=0 5=1 6=384 9=1\n"
+                                           "Convolution1D conv1 1 1 conv0 output 0=12 1=5 4=4 15=0 5=1 6=960\n";
+
+// left padding shorter than the receptive field is not causal, these layers stay stateless
+static const char* padded_convolution_param_str = "7767517\n"
+                                                  "3 3\n"
+                                                  "Input data 0 1 data\n"
+                                                  "Convolution1D conv0 1 1 data conv0 0=16 1=3 2=2 4=2 15=0 5=1 6=384 9=1\n"
+                                                  "Convolution1D conv1 1 1 conv0 output 0=12 1=5 4=1 15=0 5=1 6=960\n";
+
+// deterministic weights, raw fp32 tag for every weight blob
+class DataReaderFromRandom : public ncnn::DataReader
+{
+public:
+    DataReaderFromRandom()
+        : seed(7767517)
+    {
+    }
+
+    virtual size_t read(void* buf, size_t size) const
+    {
+        if (size == 4)
+        {
+            // weight tag
+            memset(buf, 0, 4);
+            return 4;
+        }
+
+        float* p = (float*)buf;
+        for (size_t i = 0; i < size / 4; i++)
+        {
+            seed = seed * 1103515245 + 12345;
+            p[i] = ((int)((seed >> 8) % 2001) - 1000) / 5000.f;
+        }
+
+        return size;
+    }
+
+    mutable unsigned int seed;
+};
+
+// time steps [t, t + n) of m, time along h or w
+static ncnn::Mat slice_time(const ncnn::Mat& m, int t, int n, bool time_on_h)
+{
+    if (time_on_h)
+        return m.row_range(t, n).clone();
+
+    ncnn::Mat out(n, m.h);
+    for (int y = 0; y < m.h; y++)
+    {
+        memcpy(out.row(y), m.row(y) + t, n * sizeof(float));
+    }
+    return out;
+}
+
+static ncnn::Mat concat_time(const std::vector<ncnn::Mat>& chunks, bool time_on_h)
+{
+    int total = 0;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        total += time_on_h ? chunks[i].h : chunks[i].w;
+    }
+
+    ncnn::Mat out = time_on_h ? ncnn::Mat(chunks[0].w, total) : ncnn::Mat(total, chunks[0].h);
+
+    int t = 0;
+    for (size_t i = 0; i < chunks.size(); i++)
+    {
+        const ncnn::Mat& m = chunks[i];
+        if (time_on_h)
+        {
+            memcpy(out.row(t), m.data, m.w * m.h * sizeof(float));
+            t += m.h;
+        }
+        else
+        {
+            for (int y = 0; y < m.h; y++)
+            {
+                memcpy(out.row(y) + t, m.row(y), m.w * sizeof(float));
+            }
+            t += m.w;
+        }
+    }
+
+    return out;
+}
+
+static int run_chunk(ncnn::Extractor& ex, const ncnn::Mat& in, ncnn::Mat& out)
+{
+    ex.clear();
+    ex.input("data", in);
+    return ex.extract("output", out);
+}
+
+static int test_streaming(const char* param_str, const ncnn::Mat& in, bool time_on_h, bool use_packing_layout)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.opt.use_packing_layout = use_packing_layout;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Mat out_ref;
+    {
+        ncnn::Extractor ex = net.create_extractor();
+        ex.input("data", in);
+        if (ex.extract("output", out_ref) != 0)
+            return -1;
+    }
+
+    // the third chunk is shorter than the convolution context
+    static const int chunk_sizes[4] = {7, 13, 1, 19};
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_streaming(true);
+
+    std::vector<ncnn::Mat> outs;
+    std::vector<ncnn::Mat> saved_states;
+    int t = 0;
+    for (int i = 0; i < 4; i++)
+    {
+        ncnn::Mat chunk = slice_time(in, t, chunk_sizes[i], time_on_h);
+        t += chunk_sizes[i];
+
+        if (i == 1)
+        {
+            ex.save_state(saved_states);
+        }
+
+        ncnn::Mat out;
+        if (run_chunk(ex, chunk, out) != 0)
+            return -1;
+
+        if (i == 1)
+        {
+            // replay the chunk from the saved state
+            ncnn::Mat out_replay;
+            if (ex.restore_state(saved_states) != 0 || run_chunk(ex, chunk, out_replay) != 0)
+                return -1;
+
+            if (CompareMat(out, out_replay, 0.001) != 0)
+            {
+                fprintf(stderr, "test_streaming replay mismatch time_on_h=%d\n", time_on_h);
+                return -1;
+            }
+        }
+
+        outs.push_back(out.clone());
+    }
+
+    if (CompareMat(concat_time(outs, time_on_h), out_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_streaming chunked output mismatch time_on_h=%d use_packing_layout=%d\n", time_on_h, use_packing_layout);
+        return -1;
+    }
+
+    // a new stream after reset starts from scratch
+    ex.reset_state();
+
+    ncnn::Mat out_first;
+    if (run_chunk(ex, slice_time(in, 0, chunk_sizes[0], time_on_h), out_first) != 0)
+        return -1;
+
+    if (CompareMat(out_first, outs[0], 0.001) != 0)
+    {
+        fprintf(stderr, "test_streaming reset mismatch time_on_h=%d\n", time_on_h);
+        return -1;
+    }
+
+    // a stateless extractor of the same net is unaffected
+    ncnn::Mat out_stateless;
+    {
+        ncnn::Extractor ex2 = net.create_extractor();
+        if (run_chunk(ex2, in, out_stateless) != 0)
+            return -1;
+    }
+
+    if (CompareMat(out_stateless, out_ref, 0.001) != 0)
+    {
+        fprintf(stderr, "test_streaming stateless mismatch time_on_h=%d\n", time_on_h);
+        return -1;
+    }
+
+    return 0;
+}
+
+static int test_streaming_stateless(const char* param_str, const ncnn::Mat& in)
+{
+    ncnn::Net net;
+    net.opt.num_threads = 1;
+    net.load_param_mem(param_str);
+
+    DataReaderFromRandom dr;
+    if (net.load_model(dr) != 0)
+    {
+        fprintf(stderr, "load_model failed\n");
+        return -1;
+    }
+
+    ncnn::Extractor ex = net.create_extractor();
+    ex.set_streaming(true);
+
+    std::vector<ncnn::Mat> states;
+    ex.save_state(states);
+    if (!states.empty())
+    {
+        fprintf(stderr, "test_streaming_stateless expect no state but got %d\n", (int)states.size());
+        return -1;
+    }
+
+    // every chunk is computed on its own, as if streaming were off
+    static const int chunk_sizes[3] = {11, 6, 23};
+
+    int t = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        ncnn::Mat chunk = slice_time(in, t, chunk_sizes[i], false);
+        t += chunk_sizes[i];
+
+        ncnn::Mat out;
+        if (run_chunk(ex, chunk, out) != 0)
+            return -1;
+
+        ncnn::Mat out_ref;
+        {
+            ncnn::Extractor ex2 = net.create_extractor();
+            if (run_chunk(ex2, chunk, out_ref) != 0)
+                return -1;
+        }
+
+        if (CompareMat(out, out_ref, 0.001) != 0)
+        {
+            fprintf(stderr, "test_streaming_stateless chunk %d mismatch\n", i);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int main()
+{
+    SRAND(7767517);
+
+    const int length = 40;
+
+    return 0
+           || test_streaming(recurrent_param_str, RandomMat(16, length), true, true)
+           || test_streaming(convolution_param_str, RandomMat(length, 8), false, true)
+           || test_streaming(convolution_param_str, RandomMat(length, 8), false, false)
+           || test_streaming_stateless(padded_convolution_param_str, RandomMat(length, 8));
+}
@@ -162,6 +162,44 @@ ncnn::Mat RandomS8Mat(int w, int h, int d, int c)
     return m;
 }
 
+ncnn::Mat RandomPrunedWeight(int num_input, int num_output, int block, int keep_percent)
+{
+    ncnn::Mat weight = RandomMat(num_input * num_output);
+
+    float* ptr = weight;
+    if (block == 0)
+    {
+        for (int q = 0; q < num_output; q++)
+        {
+            for (int k = 0; k + 3 < num_input; k += 4)
+            {
+                // drop two distinct positions
+                int i0 = RAND() % 4;
+                int i1 = (i0 + 1 + RAND() % 3) % 4;
+                ptr[q * num_input + k + i0] = 0.f;
+                ptr[q * num_input + k + i1] = 0.f;
+            }
+        }
+        return weight;
+    }
+
+    for (int q = 0; q + block - 1 < num_output; q += block)
+    {
+        for (int k = 0; k < num_input; k++)
+        {
+            if (RAND() % 100 < keep_percent)
+                continue;
+
+            for (int n = 0; n < block; n++)
+            {
+                ptr[(q + n) * num_input + k] = 0.f;
+            }
+        }
+    }
+
+    return weight;
+}
+
 ncnn::Mat scales_mat(const ncnn::Mat& mat, int m, int k, int ldx)
 {
     ncnn::Mat weight_scales(m);
@@ -1412,6 +1450,7 @@ int test_layer(const char* layer_type, const ncnn::ParamDict& pd, const std::vec
         opt.use_fp16_arithmetic = options[i][3];
         opt.use_bf16_storage = options[i][4];
         opt.use_shader_pack8 = options[i][5];
+        opt.use_sparse_weight = (flag & TEST_LAYER_ENABLE_SPARSE_WEIGHT) != 0;
 
         int ret = test_layer_opt(layer_type, pd, weights, opt, a, top_blob_count, epsilon, func, flag);
         if (ret != 0)
@@ -1447,6 +1486,7 @@ int test_layer(const char* layer_type, const ncnn::ParamDict& pd, const std::vec
         opt.use_fp16_arithmetic = options[i][3];
         opt.use_bf16_storage = options[i][4];
         opt.use_shader_pack8 = options[i][5];
+        opt.use_sparse_weight = (flag & TEST_LAYER_ENABLE_SPARSE_WEIGHT) != 0;
 
         int ret = test_layer_opt(layer_type, pd, weights, opt, a, epsilon, func, flag);
         if (ret != 0)
@@ -16,6 +16,7 @@
 #define TEST_LAYER_DISABLE_AUTO_INPUT_CASTING (1 << 1)
 #define TEST_LAYER_DISABLE_GPU_TESTING        (1 << 2)
 #define TEST_LAYER_ENABLE_FORCE_INPUT_PACK8   (1 << 3)
+#define TEST_LAYER_ENABLE_SPARSE_WEIGHT       (1 << 4)
 
 void SRAND(int seed);
 
@@ -57,6 +58,9 @@ ncnn::Mat RandomS8Mat(int w, int h, int c);
 
 ncnn::Mat RandomS8Mat(int w, int h, int d, int c);
 
+// pruned weight, block > 0 zeros 1xblock output groups, block == 0 keeps 2 of every 4 inputs
+ncnn::Mat RandomPrunedWeight(int num_input, int num_output, int block, int keep_percent);
+
 ncnn::Mat scales_mat(const ncnn::Mat& mat, int m, int k, int ldx);
 
 bool NearlyEqual(float a, float b, float epsilon);
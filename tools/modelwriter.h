@@ -218,6 +218,12 @@ public:
     // 0=fp32 1=fp16
     int storage_type;
 
+    // align tagged weight data to this file offset, 0=no alignment
+    int weight_align;
+
+    // write fp32 weight with at least half zeros as nonzero bitmask and values
+    int sparse_weight;
+
     int gen_random_weight;
 
     // Cut param and bin -1=no cut
@@ -246,6 +252,8 @@ ModelWriter::ModelWriter()
     opt.lightmode = false;
     has_custom_layer = false;
     gen_random_weight = false;
+    weight_align = 0;
+    sparse_weight = 0;
     cutstart = -1;
     cutend = -1;
 
@@ -605,13 +613,61 @@ static void Randomize(ncnn::Mat& m, float a = -1.2f, float b = 1.2f)
 
 int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
+    if (weight_align > 0 && (ftell(bp) + 4) % weight_align != 0)
+    {
+        // padding record so that the data after the next tag lands on aligned offset
+        const int tag = 0x01A16A40; // padding magic
+        int padding_size = (int)(alignSize(ftell(bp) + 12, weight_align) - (ftell(bp) + 12));
+        fwrite(&tag, sizeof(int), 1, bp);
+        fwrite(&padding_size, sizeof(int), 1, bp);
+
+        std::vector<unsigned char> padding(padding_size, 0x00);
+        if (padding_size > 0)
+            fwrite(padding.data(), sizeof(unsigned char), padding_size, bp);
+    }
+
     int p0 = ftell(bp);
 
     ncnn::Mat data_flattened = data.reshape(data.w * data.h * data.d * data.c);
     if (gen_random_weight)
         Randomize(data_flattened, a, b);
 
-    if (data_flattened.elemsize == 4)
+    int nzero = 0;
+    if (sparse_weight && data_flattened.elemsize == 4)
+    {
+        const float* ptr = data_flattened;
+        for (int i = 0; i < data_flattened.w; i++)
+        {
+            if (ptr[i] == 0.f)
+                nzero++;
+        }
+    }
+
+    if (data_flattened.elemsize == 4 && sparse_weight && nzero * 2 >= data_flattened.w)
+    {
+        const int tag = 0x0B5A25E0; // sparse magic
+        fwrite(&tag, sizeof(int), 1, bp);
+
+        replace_denormals_with_zero(data_flattened, data_flattened.w);
+
+        const float* ptr = data_flattened;
+
+        std::vector<unsigned int> mask((data_flattened.w + 31) / 32, 0);
+        std::vector<float> values;
+        for (int i = 0; i < data_flattened.w; i++)
+        {
+            if (ptr[i] == 0.f)
+                continue;
+
+            mask[i / 32] |= 1u << (i % 32);
+            values.push_back(ptr[i]);
+        }
+
+        fwrite(mask.data(), sizeof(unsigned int), mask.size(), bp);
+        if (!values.empty())
+            fwrite(values.data(), sizeof(float), values.size(), bp);
+    }
+    else if (data_flattened.elemsize == 4)
     {
         if (storage_type == 1)
         {
@@ -657,6 +713,10 @@ int ModelWriter::fwrite_weight_tag_data(const ncnn::Mat& data, FILE* bp, float a
 
 int ModelWriter::fwrite_weight_data(const ncnn::Mat& data, FILE* bp, float a, float b)
 {
+    // optional weight such as top_blob_int8_scales without requantize
+    if (data.empty())
+        return 0;
+
     int p0 = ftell(bp);
 
     ncnn::Mat data_flattened = data.reshape(data.w * data.h * data.d * data.c);
@@ -1279,6 +1339,7 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             }
             fprintf_param_value(" 5=%d", bias_term)
             fprintf_param_value(" 6=%d", weight_data_size)
+            fprintf_param_value(" 8=%d", int8_scale_term)
             fprintf_param_value(" 9=%d", activation_type)
             {
                 if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
@@ -1289,6 +1350,15 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             {
                 fwrite_weight_tag_data(op->weight_data, bp);
                 fwrite_weight_data(op->bias_data, bp);
+
+#if NCNN_INT8
+                // write int8_scale data
+                if (op->int8_scale_term)
+                {
+                    fwrite_weight_data(op->weight_data_int8_scales, bp, 90, 100);
+                    fwrite_weight_data(op->bottom_blob_int8_scales, bp, 0.001, 1);
+                }
+#endif // NCNN_INT8
             }
 
             if (shape_ready)
@@ -1444,6 +1514,7 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 5=%d", bias_term)
             fprintf_param_value(" 6=%d", weight_data_size)
             fprintf_param_value(" 7=%d", group)
+            fprintf_param_value(" 8=%d", int8_scale_term)
             fprintf_param_value(" 9=%d", activation_type)
             {
                 if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
@@ -1454,6 +1525,15 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             {
                 fwrite_weight_tag_data(op->weight_data, bp);
                 fwrite_weight_data(op->bias_data, bp);
+
+#if NCNN_INT8
+                // write int8_scale data
+                if (op->int8_scale_term)
+                {
+                    fwrite_weight_data(op->weight_data_int8_scales, bp, 90, 100);
+                    fwrite_weight_data(op->bottom_blob_int8_scales, bp, 0.001, 1);
+                }
+#endif // NCNN_INT8
             }
 
             if (shape_ready)
@@ -1675,11 +1755,18 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 1=%d", input_dim)
             fprintf_param_value(" 2=%d", bias_term)
             fprintf_param_value(" 3=%d", weight_data_size)
+            fprintf_param_value(" 16=%d", weight_quant_bits)
+            fprintf_param_value(" 17=%d", weight_quant_group_size)
             fprintf_param_value(" 18=%d", int8_scale_term)
 
             fwrite_weight_tag_data(op->weight_data, bp);
             fwrite_weight_data(op->bias_data, bp);
 
+            if (op->weight_quant_bits)
+            {
+                fwrite_weight_data(op->weight_data_quant_scales, bp, 0.001, 0.01);
+            }
+
 #if NCNN_INT8
             // write int8_scale data
             if (op->int8_scale_term)
@@ -1771,6 +1858,8 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             fprintf_param_value(" 12=%d", output_elempack)
             fprintf_param_value(" 13=%d", output_elemtype)
             fprintf_param_value(" 14=%d", output_transpose)
+            fprintf_param_value(" 16=%d", weight_quant_bits)
+            fprintf_param_value(" 17=%d", weight_quant_group_size)
             fprintf_param_value(" 18=%d", int8_scale_term)
             fprintf_param_value(" 20=%d", constant_TILE_M)
             fprintf_param_value(" 21=%d", constant_TILE_N)
@@ -1789,6 +1878,11 @@ int ModelWriter::save(const char* parampath, const char* binpath)
                 fwrite_weight_tag_data(op->C_data, bp);
             }
 
+            if (op->weight_quant_bits)
+            {
+                fwrite_weight_data(op->B_data_quant_scales, bp, 0.001, 0.01);
+            }
+
 #if NCNN_INT8
             // write int8_scale data
             if (op->int8_scale_term)
@@ -1888,10 +1982,17 @@ int ModelWriter::save(const char* parampath, const char* binpath)
             {
                 if (!op->activation_params.empty()) fprintf_param_float_array(10, op->activation_params, pp);
             }
+            fprintf_param_value(" 16=%d", weight_quant_bits)
+            fprintf_param_value(" 17=%d", weight_quant_group_size)
 
             fwrite_weight_tag_data(op->weight_data, bp);
             fwrite_weight_data(op->bias_data, bp);
 
+            if (op->weight_quant_bits)
+            {
+                fwrite_weight_data(op->weight_data_quant_scales, bp, 0.001, 0.01);
+            }
+
 #if NCNN_INT8
             // write int8_scale data
             if (op->int8_scale_term)
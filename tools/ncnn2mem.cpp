@@ -428,7 +428,8 @@ static int write_memcpp(const char* parambinpath, const char* modelpath, const c
         return -1;
     }
 
-    fprintf(cppfp, "\n#ifdef _MSC_VER\n__declspec(align(4))\n#else\n__attribute__((aligned(4)))\n#endif\n");
+    // 64-byte aligned so that weights written with ncnnoptimize aligned flag are referenced aligned
+    fprintf(cppfp, "\n#ifdef _MSC_VER\n__declspec(align(64))\n#else\n__attribute__((aligned(64)))\n#endif\n");
     fprintf(cppfp, "static const unsigned char %s[] = {\n", model_var.c_str());
 
     i = 0;
@@ -75,6 +75,8 @@ public:
     int replace_prelu_with_leaky_relu();
     int replace_convolution_with_innerproduct_after_global_pooling();
     int replace_convolution_with_innerproduct_after_innerproduct();
+
+    int detect_sparse_weight();
 };
 
 NetOptimize::NetOptimize()
@@ -2748,11 +2750,60 @@ int NetOptimize::replace_convolution_with_innerproduct_after_innerproduct()
     return 0;
 }
 
+int NetOptimize::detect_sparse_weight()
+{
+    const size_t layer_count = layers.size();
+    for (size_t i = 0; i < layer_count; i++)
+    {
+        ncnn::Mat weight_data;
+        if (layers[i]->type == "Convolution")
+        {
+            ncnn::Convolution* convolution = (ncnn::Convolution*)layers[i];
+
+            // runtime sparse kernels cover 1x1 stride 1 only
+            if (convolution->kernel_w != 1 || convolution->kernel_h != 1 || convolution->stride_w != 1 || convolution->stride_h != 1)
+                continue;
+
+            weight_data = convolution->weight_data;
+        }
+        else if (layers[i]->type == "InnerProduct")
+        {
+            weight_data = ((ncnn::InnerProduct*)layers[i])->weight_data;
+        }
+        else
+        {
+            continue;
+        }
+
+        if (weight_data.elemsize != 4)
+            continue;
+
+        const float* ptr = weight_data;
+        const int size = (int)weight_data.total();
+
+        int nzero = 0;
+        for (int j = 0; j < size; j++)
+        {
+            if (ptr[j] == 0.f)
+                nzero++;
+        }
+
+        if (nzero * 2 < size)
+            continue;
+
+        fprintf(stderr, "detect_sparse_weight %s %.1f%% zeros\n", layers[i]->name.c_str(), nzero * 100.f / size);
+    }
+
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
     if (argc < 6)
     {
         fprintf(stderr, "usage: %s [inparam] [inbin] [outparam] [outbin] [flag] [cutstart] [cutend]\n", argv[0]);
+        fprintf(stderr, "  flag 0=fp32 1=fp16, add 2 to align weights to 64 bytes for load_model_mmap\n");
+        fprintf(stderr, "  add 4 to store weights with at least half zeros in sparse format\n");
         return -1;
     }
 
@@ -2776,7 +2827,7 @@ int main(int argc, char** argv)
 
     NetOptimize optimizer;
 
-    if (flag == 65536 || flag == 1)
+    if (flag == 65536 || (flag & 1))
     {
         optimizer.storage_type = 1;
     }
@@ -2785,6 +2836,18 @@ int main(int argc, char** argv)
         optimizer.storage_type = 0;
     }
 
+    if (flag != 65536 && (flag & 2))
+    {
+        // align weights to 64 bytes for zero-copy Net::load_model_mmap
+        optimizer.weight_align = 64;
+    }
+
+    if (flag != 65536 && (flag & 4))
+    {
+        // pruned weights as nonzero bitmask and values
+        optimizer.sparse_weight = 1;
+    }
+
     optimizer.load_param(inparam);
 
     if (strcmp(inbin, "null") == 0)
@@ -2841,6 +2904,11 @@ int main(int argc, char** argv)
     optimizer.eliminate_flatten_after_innerproduct();
     optimizer.eliminate_orphaned_memorydata();
 
+    if (optimizer.sparse_weight)
+    {
+        optimizer.detect_sparse_weight();
+    }
+
     optimizer.shape_inference();
 
     optimizer.estimate_memory_footprint();
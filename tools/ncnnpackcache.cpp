@@ -0,0 +1,49 @@
+// Copyright 2026 Tencent
+// SPDX-License-Identifier: BSD-3-Clause
+
+// produce the packed weight cache of a model offline
+// run it on the same machine class as the deployment, the cache is isa and thread count specific
+
+#include "cpu.h"
+#include "net.h"
+#include "packedweightcache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+int main(int argc, char** argv)
+{
+    if (argc < 4)
+    {
+        fprintf(stderr, "Usage: %s [ncnnparam] [ncnnbin] [cachepath] [num_threads]\n", argv[0]);
+        fprintf(stderr, "  num_threads must match net.opt.num_threads at runtime, other options are the defaults\n");
+        return -1;
+    }
+
+    const char* parampath = argv[1];
+    const char* modelpath = argv[2];
+    const char* cachepath = argv[3];
+    const int num_threads = argc > 4 ? atoi(argv[4]) : ncnn::get_physical_big_cpu_count();
+
+    ncnn::PackedWeightCache cache;
+
+    ncnn::Net net;
+    net.opt.num_threads = num_threads;
+    net.opt.packed_weight_cache = &cache;
+
+    if (net.load_param(parampath))
+        return -1;
+
+    if (net.load_model(modelpath))
+        return -1;
+
+    if (cache.save(cachepath))
+    {
+        fprintf(stderr, "save %s failed\n", cachepath);
+        return -1;
+    }
+
+    fprintf(stderr, "%d packed weights written to %s for %d threads\n", cache.size(), cachepath, num_threads);
+
+    return 0;
+}
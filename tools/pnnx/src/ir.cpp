@@ -163,6 +163,97 @@ bool operator==(const Parameter& lhs, const Parameter& rhs)
     return false;
 }
 
+struct attribute_data_deleter
+{
+    void operator()(const char* p) const
+    {
+        delete[] p;
+    }
+};
+
+static std::shared_ptr<const char> new_attribute_storage(size_t size)
+{
+    if (size == 0)
+        return std::shared_ptr<const char>();
+
+    return std::shared_ptr<const char>(new char[size], attribute_data_deleter());
+}
+
+AttributeData::AttributeData()
+    : nbytes(0), owned(true)
+{
+}
+
+AttributeData::AttributeData(const std::vector<char>& v)
+    : storage(new_attribute_storage(v.size())), nbytes(v.size()), owned(true)
+{
+    if (nbytes > 0)
+        memcpy((void*)storage.get(), (const void*)v.data(), nbytes);
+}
+
+AttributeData::AttributeData(const std::initializer_list<char>& v)
+    : storage(new_attribute_storage(v.size())), nbytes(v.size()), owned(true)
+{
+    if (nbytes > 0)
+        memcpy((void*)storage.get(), (const void*)v.begin(), nbytes);
+}
+
+AttributeData::AttributeData(const std::shared_ptr<const char>& ptr, size_t size)
+    : storage(ptr), nbytes(size), owned(false)
+{
+}
+
+char* AttributeData::data()
+{
+    if (!owned || storage.use_count() > 1)
+    {
+        // copy on write
+        std::shared_ptr<const char> copy = new_attribute_storage(nbytes);
+        if (nbytes > 0)
+            memcpy((void*)copy.get(), (const void*)storage.get(), nbytes);
+
+        storage = copy;
+        owned = true;
+    }
+
+    return (char*)storage.get();
+}
+
+void AttributeData::resize(size_t size)
+{
+    if (size == nbytes)
+        return;
+
+    std::shared_ptr<const char> newstorage = new_attribute_storage(size);
+    if (size > 0)
+    {
+        const size_t copysize = std::min(size, nbytes);
+        if (copysize > 0)
+            memcpy((void*)newstorage.get(), (const void*)storage.get(), copysize);
+        memset((void*)(newstorage.get() + copysize), 0, size - copysize);
+    }
+
+    storage = newstorage;
+    nbytes = size;
+    owned = true;
+}
+
+bool operator==(const AttributeData& lhs, const AttributeData& rhs)
+{
+    if (lhs.size() != rhs.size())
+        return false;
+
+    if (lhs.data() == rhs.data())
+        return true;
+
+    return memcmp(lhs.data(), rhs.data(), lhs.size()) == 0;
+}
+
+bool operator!=(const AttributeData& lhs, const AttributeData& rhs)
+{
+    return !(lhs == rhs);
+}
+
 Attribute::Attribute(const std::initializer_list<int>& _shape, const std::vector<float>& t)
 {
     type = 1;
@@ -680,10 +771,14 @@ static void load_attribute(Operator* op, const std::string& key, const std::stri
     if (filesize != bytesize)
     {
         fprintf(stderr, "file size not match expect %lu but got %lu\n", bytesize, filesize);
+
+        a.data.resize(bytesize);
+        szr.read_file(filename, (char*)a.data.data());
+        return;
     }
 
-    a.data.resize(bytesize);
-    szr.read_file(filename, (char*)a.data.data());
+    // weights stay in the mapped file until a pass writes them
+    a.data = AttributeData(szr.map_file(filename), bytesize);
 }
 
 int Graph::load(const std::string& parampath, const std::string& binpath)
@@ -9,6 +9,7 @@
 #include <initializer_list>
 #include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -212,6 +213,68 @@ public:
 
 bool operator==(const Parameter& lhs, const Parameter& rhs);
 
+// weight bytes of an Attribute, copies share the same storage
+// the storage is either owned memory or a read-only view into data kept alive elsewhere,
+// such as a mapped pnnx.bin entry or a torch tensor, so loading and copying weights costs no memory
+// const access never copies, non-const access takes a private owned copy first unless it already has one
+class AttributeData
+{
+public:
+    AttributeData();
+    AttributeData(const std::vector<char>& v);
+    AttributeData(const std::initializer_list<char>& v);
+
+    // view size bytes at ptr, ptr keeps whatever owns the bytes alive
+    AttributeData(const std::shared_ptr<const char>& ptr, size_t size);
+
+    size_t size() const
+    {
+        return nbytes;
+    }
+    bool empty() const
+    {
+        return nbytes == 0;
+    }
+    bool is_view() const
+    {
+        return !owned;
+    }
+
+    const char* data() const
+    {
+        return storage.get();
+    }
+    char* data();
+
+    const char* begin() const
+    {
+        return storage.get();
+    }
+    const char* end() const
+    {
+        return storage.get() + nbytes;
+    }
+
+    const char& operator[](size_t i) const
+    {
+        return storage.get()[i];
+    }
+    char& operator[](size_t i)
+    {
+        return data()[i];
+    }
+
+    void resize(size_t size);
+
+private:
+    std::shared_ptr<const char> storage;
+    size_t nbytes;
+    bool owned;
+};
+
+bool operator==(const AttributeData& lhs, const AttributeData& rhs);
+bool operator!=(const AttributeData& lhs, const AttributeData& rhs);
+
 class Attribute
 {
 public:
@@ -244,7 +307,7 @@ public:
     int type;
     std::vector<int> shape;
 
-    std::vector<char> data;
+    AttributeData data;
 
     std::map<std::string, Parameter> params;
 };
@@ -357,8 +357,9 @@ Attribute::Attribute(const at::Tensor& t)
 
     if (shape.size() > 0)
     {
-        data.resize(elemcount() * type_to_elemsize(type));
-        memcpy((void*)data.data(), (const void*)t.cpu().contiguous().data_ptr(), data.size());
+        // hold the contiguous cpu tensor instead of copying its bytes
+        std::shared_ptr<at::Tensor> tc = std::make_shared<at::Tensor>(t.cpu().contiguous());
+        data = AttributeData(std::shared_ptr<const char>(tc, (const char*)tc->data_ptr()), elemcount() * type_to_elemsize(type));
     }
 }
 
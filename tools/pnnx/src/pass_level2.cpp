@@ -790,202 +790,290 @@ static bool match(const Operator* anchor, const Operator* pattern, std::map<std:
     return true;
 }
 
-void pnnx_graph_rewrite(Graph& graph, const GraphRewriterPass* pass, int& opindex)
+// find a match by scanning down from the end of the graph, every pattern output picks the last anchor that fits the others
+static bool match_by_scan(const Graph& graph, const GraphRewriterPass* pass, const std::vector<const Operator*>& pattern_graph_output_operators, std::map<std::string, const Operator*>& matched_operators, std::map<std::string, const Operand*>& matched_inputs, std::map<std::string, const Operand*>& matched_outputs, std::map<std::string, Parameter>& captured_params, std::map<std::string, Attribute>& captured_attrs)
 {
-    Graph pattern_graph;
-    pattern_graph.parse(pass->match_pattern_graph());
+    const int graph_op_count = (int)graph.ops.size();
 
-    // collect pattern inputs and outputs order
-    std::vector<std::string> pattern_graph_inputs;
-    std::vector<std::string> pattern_graph_outputs;
-    std::vector<const Operator*> pattern_graph_output_operators;
-    for (const auto& x : pattern_graph.ops)
-    {
-        if (x->type == "pnnx.Input")
-        {
-            for (const auto& y : x->outputs)
-                pattern_graph_inputs.push_back(y->name);
-        }
-        if (x->type == "pnnx.Output")
-        {
-            pattern_graph_output_operators.push_back(x);
-            for (const auto& y : x->inputs)
-                pattern_graph_outputs.push_back(y->name);
-        }
-    }
-
-    std::vector<Operator*> new_ops;
+    bool matched = true;
 
-    while (1)
+    // pattern match from end to beginning
+    int q = graph_op_count - 1;
+    for (; q >= 1; q--)
     {
-        const int graph_op_count = (int)graph.ops.size();
-
-        bool matched = true;
+        matched = true;
 
-        // lets match from output
-        std::map<std::string, const Operator*> matched_operators;
-        std::map<std::string, const Operand*> matched_inputs;
-        std::map<std::string, const Operand*> matched_outputs;
-        std::map<std::string, Parameter> captured_params;
-        std::map<std::string, Attribute> captured_attrs;
-
-        // pattern match from end to beginning
-        int q = graph_op_count - 1;
-        for (; q >= 1; q--)
+        for (const Operator* pattern : pattern_graph_output_operators)
         {
-            matched = true;
-
-            for (const Operator* pattern : pattern_graph_output_operators)
+            for (size_t i = 0; i < pattern->inputs.size(); i++)
             {
-                for (size_t i = 0; i < pattern->inputs.size(); i++)
-                {
-                    const Operator* pattern2 = pattern->inputs[i]->producer;
+                const Operator* pattern2 = pattern->inputs[i]->producer;
 
-                    int j = q;
-                    for (; j >= 0; j--)
+                int j = q;
+                for (; j >= 0; j--)
+                {
+                    const Operator* anchor = graph.ops[j];
+
+                    std::map<std::string, const Operator*> matched_operators2;
+                    std::map<std::string, const Operand*> matched_inputs2;
+                    std::map<std::string, const Operand*> matched_outputs2;
+                    std::map<std::string, Parameter> captured_params2;
+                    std::map<std::string, Attribute> captured_attrs2;
+                    if (!match(anchor, pattern2, matched_operators2, matched_inputs2, matched_outputs2, captured_params2, captured_attrs2))
+                        continue;
+
+                    bool submatch_matched = true;
+                    for (auto x : matched_operators2)
                     {
-                        const Operator* anchor = graph.ops[j];
-
-                        std::map<std::string, const Operator*> matched_operators2;
-                        std::map<std::string, const Operand*> matched_inputs2;
-                        std::map<std::string, const Operand*> matched_outputs2;
-                        std::map<std::string, Parameter> captured_params2;
-                        std::map<std::string, Attribute> captured_attrs2;
-                        if (!match(anchor, pattern2, matched_operators2, matched_inputs2, matched_outputs2, captured_params2, captured_attrs2))
-                            continue;
-
-                        bool submatch_matched = true;
-                        for (auto x : matched_operators2)
-                        {
-                            // check these matched operators are same with previous matched ones
-                            if (matched_operators.find(x.first) != matched_operators.end())
-                            {
-                                if (matched_operators[x.first] != x.second)
-                                {
-                                    // unmatched two sub-matches
-                                    submatch_matched = false;
-                                    break;
-                                }
-                            }
-                            else
-                            {
-                                matched_operators[x.first] = x.second;
-                            }
-                        }
-
-                        if (!submatch_matched)
-                            continue;
-
-                        for (auto x : matched_inputs2)
+                        // check these matched operators are same with previous matched ones
+                        if (matched_operators.find(x.first) != matched_operators.end())
                         {
-                            if (matched_inputs.find(x.first) == matched_inputs.end())
+                            if (matched_operators[x.first] != x.second)
                             {
-                                matched_inputs[x.first] = x.second;
+                                // unmatched two sub-matches
+                                submatch_matched = false;
+                                break;
                             }
                         }
-                        for (auto x : matched_outputs2)
+                        else
                         {
-                            if (matched_outputs.find(x.first) == matched_outputs.end())
-                            {
-                                matched_outputs[x.first] = x.second;
-                            }
+                            matched_operators[x.first] = x.second;
                         }
-                        for (auto x : captured_params2)
+                    }
+
+                    if (!submatch_matched)
+                        continue;
+
+                    for (auto x : matched_inputs2)
+                    {
+                        if (matched_inputs.find(x.first) == matched_inputs.end())
                         {
-                            captured_params[x.first] = x.second;
+                            matched_inputs[x.first] = x.second;
                         }
-                        for (auto x : captured_attrs2)
+                    }
+                    for (auto x : matched_outputs2)
+                    {
+                        if (matched_outputs.find(x.first) == matched_outputs.end())
                         {
-                            captured_attrs[x.first] = x.second;
+                            matched_outputs[x.first] = x.second;
                         }
-
-                        // match !
-                        break;
                     }
-
-                    if (j == -1)
+                    for (auto x : captured_params2)
                     {
-                        matched = false;
-                        break;
+                        captured_params[x.first] = x.second;
+                    }
+                    for (auto x : captured_attrs2)
+                    {
+                        captured_attrs[x.first] = x.second;
                     }
+
+                    // match !
+                    break;
+                }
+
+                if (j == -1)
+                {
+                    matched = false;
+                    break;
                 }
+            }
+
+            if (!matched)
+                break;
+        }
+
+        if (matched && !pass->match(matched_operators, captured_params, captured_attrs))
+        {
+            matched_operators.clear();
+            matched_inputs.clear();
+            matched_outputs.clear();
+            captured_params.clear();
+            captured_attrs.clear();
+            matched = false;
+            continue;
+        }
+
+        break;
+    }
+
+    return matched;
+}
 
-                if (!matched)
+// unlink the matched operators and wire up the replacement, positions in graph.ops are left to the caller
+// the replacement operators are appended to graph.ops and also returned in graph order in replace_ops
+// the operands living only inside the matched subgraph are returned in dead_operands, they stay in graph.operands
+static void replace_matched(Graph& graph, const GraphRewriterPass* pass, const std::vector<std::string>& pattern_graph_inputs, const std::vector<std::string>& pattern_graph_outputs, const std::map<std::string, const Operator*>& matched_operators, const std::map<std::string, const Operand*>& matched_inputs, const std::map<std::string, const Operand*>& matched_outputs, const std::map<std::string, Parameter>& captured_params, const std::map<std::string, Attribute>& captured_attrs, std::vector<Operator*>& replace_ops, std::vector<Operand*>& dead_operands, std::vector<Operator*>& new_ops)
+{
+    // remove all operands inside matched graph
+    std::map<std::string, Operand*> operands_to_remove;
+    for (auto& _x : matched_operators)
+    {
+        Operator* x = (Operator*)_x.second;
+        for (auto& r : x->inputs)
+        {
+            r->remove_consumer(x);
+
+            bool is_input = false;
+            for (auto& r2 : matched_inputs)
+            {
+                if (r2.second == r)
+                {
+                    is_input = true;
                     break;
+                }
             }
 
-            if (matched && !pass->match(matched_operators, captured_params, captured_attrs))
+            if (!is_input)
+                operands_to_remove[r->name] = r;
+        }
+
+        x->inputs.clear();
+
+        for (auto& r : x->outputs)
+        {
+            r->producer = 0;
+
+            bool is_output = false;
+            for (auto& r2 : matched_outputs)
             {
-                matched_operators.clear();
-                matched_inputs.clear();
-                matched_outputs.clear();
-                captured_params.clear();
-                captured_attrs.clear();
-                matched = false;
-                continue;
+                if (r2.second == r)
+                {
+                    is_output = true;
+                    break;
+                }
             }
 
-            break;
+            if (!is_output)
+                operands_to_remove[r->name] = r;
         }
 
-        if (!matched)
-            break;
+        x->outputs.clear();
+    }
+    for (auto& _x : operands_to_remove)
+    {
+        dead_operands.push_back(_x.second);
+    }
 
-        //         fprintf(stderr, "matched !\n");
+    if (pass->replace_pattern_graph() == 0)
+    {
+        // insert single
+        Operator* op = graph.new_operator(pass->type_str(), std::string(pass->name_str()));
 
-        // lets replace
+        for (const auto& k : pattern_graph_inputs)
+        {
+            Operand* r = (Operand*)matched_inputs.at(k);
+            r->consumers.push_back(op);
+            op->inputs.push_back(r);
 
-        // remove all operands inside matched graph
-        std::map<std::string, Operand*> operands_to_remove;
-        for (auto& _x : matched_operators)
+            op->inputnames.push_back(k);
+        }
+
+        for (const auto& k : pattern_graph_outputs)
         {
-            Operator* x = (Operator*)_x.second;
-            for (auto& r : x->inputs)
+            Operand* r = (Operand*)matched_outputs.at(k);
+            r->producer = op;
+            op->outputs.push_back(r);
+        }
+
+        pass->write(op, captured_params, captured_attrs);
+
+        replace_ops.push_back(op);
+        new_ops.push_back(op);
+    }
+    else
+    {
+        // insert multiple
+        Graph replace_graph;
+        replace_graph.parse(pass->replace_pattern_graph());
+
+        // move operators and operands from replace_graph to graph except input and output
+        std::map<std::string, Operator*> ops;
+        for (size_t i = 0; i < replace_graph.ops.size(); i++)
+        {
+            Operator* op = replace_graph.ops[i];
+            if (op->type == "pnnx.Input" || op->type == "pnnx.Output")
+                continue;
+
+            graph.ops.push_back(op);
+            replace_graph.ops[i] = 0;
+            replace_ops.push_back(op);
+            ops[op->name] = op;
+        }
+
+        for (size_t i = 0; i < replace_graph.operands.size(); i++)
+        {
+            Operand* r = replace_graph.operands[i];
+            if (r->producer->type == "pnnx.Input" || (r->consumers.size() == 1 && r->consumers[0]->type == "pnnx.Output"))
+                continue;
+
+            graph.operands.push_back(r);
+            replace_graph.operands[i] = 0;
+        }
+
+        replace_graph.ops.erase(std::remove(replace_graph.ops.begin(), replace_graph.ops.end(), (Operator*)0), replace_graph.ops.end());
+        replace_graph.operands.erase(std::remove(replace_graph.operands.begin(), replace_graph.operands.end(), (Operand*)0), replace_graph.operands.end());
+
+        for (size_t i = 0; i < pattern_graph_inputs.size(); i++)
+        {
+            const std::string& k = pattern_graph_inputs[i];
+            Operand* r = (Operand*)matched_inputs.at(k);
+            const Operand* rr = replace_graph.get_operand(k);
+
+            for (auto x : rr->consumers)
             {
-                r->remove_consumer(x);
+                r->consumers.push_back(x);
 
-                bool is_input = false;
-                for (auto& r2 : matched_inputs)
+                x->inputnames.resize(x->inputs.size());
+                for (size_t j = 0; j < x->inputs.size(); j++)
                 {
-                    if (r2.second == r)
+                    if (x->inputs[j]->name == k)
                     {
-                        is_input = true;
+                        x->inputs[j] = r;
+                        x->inputnames[j] = k;
                         break;
                     }
                 }
-
-                if (!is_input)
-                    operands_to_remove[r->name] = r;
             }
+        }
 
-            x->inputs.clear();
+        for (size_t i = 0; i < pattern_graph_outputs.size(); i++)
+        {
+            const std::string& k = pattern_graph_outputs[i];
+            Operand* r = (Operand*)matched_outputs.at(k);
+            const Operand* rr = replace_graph.get_operand(k);
 
-            for (auto& r : x->outputs)
-            {
-                r->producer = 0;
+            r->producer = rr->producer;
 
-                bool is_output = false;
-                for (auto& r2 : matched_outputs)
+            for (size_t j = 0; j < r->producer->outputs.size(); j++)
+            {
+                if (r->producer->outputs[j]->name == k)
                 {
-                    if (r2.second == r)
-                    {
-                        is_output = true;
-                        break;
-                    }
+                    r->producer->outputs[j] = r;
+                    break;
                 }
-
-                if (!is_output)
-                    operands_to_remove[r->name] = r;
             }
-
-            x->outputs.clear();
         }
-        for (auto& _x : operands_to_remove)
+
+        pass->write(ops, captured_params, captured_attrs);
+
+        for (auto x : ops)
         {
-            Operand* r = _x.second;
-            graph.operands.erase(std::find(graph.operands.begin(), graph.operands.end(), r));
-            delete r;
+            new_ops.push_back(x.second);
         }
+    }
+}
+
+static void rewrite_by_scan(Graph& graph, const GraphRewriterPass* pass, const std::vector<std::string>& pattern_graph_inputs, const std::vector<std::string>& pattern_graph_outputs, const std::vector<const Operator*>& pattern_graph_output_operators, std::vector<Operator*>& new_ops)
+{
+    while (1)
+    {
+        std::map<std::string, const Operator*> matched_operators;
+        std::map<std::string, const Operand*> matched_inputs;
+        std::map<std::string, const Operand*> matched_outputs;
+        std::map<std::string, Parameter> captured_params;
+        std::map<std::string, Attribute> captured_attrs;
+        if (!match_by_scan(graph, pass, pattern_graph_output_operators, matched_operators, matched_inputs, matched_outputs, captured_params, captured_attrs))
+            break;
 
         // insert new operator at the last matched one
         const Operator* cur = 0;
@@ -1001,11 +1089,23 @@ void pnnx_graph_rewrite(Graph& graph, const GraphRewriterPass* pass, int& opinde
             cur = graph.ops[cur_index];
         }
 
+        const size_t graph_op_count = graph.ops.size();
+
+        std::vector<Operator*> replace_ops;
+        std::vector<Operand*> dead_operands;
+        replace_matched(graph, pass, pattern_graph_inputs, pattern_graph_outputs, matched_operators, matched_inputs, matched_outputs, captured_params, captured_attrs, replace_ops, dead_operands, new_ops);
+
+        graph.ops.resize(graph_op_count);
+
+        for (Operand* r : dead_operands)
+        {
+            graph.operands.erase(std::find(graph.operands.begin(), graph.operands.end(), r));
+            delete r;
+        }
+
         // remove all matched_operators
         for (auto& _x : matched_operators)
         {
-            //             fprintf(stderr, "remove %s\n", _x.second->name.c_str());
-
             Operator* x = (Operator*)_x.second;
 
             graph.ops.erase(std::find(graph.ops.begin(), graph.ops.end(), x));
@@ -1013,111 +1113,250 @@ void pnnx_graph_rewrite(Graph& graph, const GraphRewriterPass* pass, int& opinde
             delete _x.second;
         }
 
-        if (pass->replace_pattern_graph() == 0)
+        graph.ops.insert(std::find(graph.ops.begin(), graph.ops.end(), cur), replace_ops.begin(), replace_ops.end());
+    }
+}
+
+struct operator_order_less
+{
+    const std::unordered_map<const Operator*, double>* order;
+
+    bool operator()(const Operator* a, const Operator* b) const
+    {
+        return order->at(a) < order->at(b);
+    }
+};
+
+// single output patterns take the same matches as rewrite_by_scan without rescanning the graph after every rewrite
+// only operators of the anchor type can match, they sit in a worklist ordered by graph position and the last one is tried first
+// an anchor that fails leaves the worklist, a rewrite puts back the anchors downstream of it as those are the only ones it can affect
+// graph.ops is kept as an ordered map during the rewrites and written back once at the end
+static void rewrite_by_worklist(Graph& graph, const GraphRewriterPass* pass, const Graph& pattern_graph, const std::vector<std::string>& pattern_graph_inputs, const std::vector<std::string>& pattern_graph_outputs, const Operator* pattern_anchor, std::vector<Operator*>& new_ops)
+{
+    // most patterns find no anchor at all, leave before building anything
+    std::vector<const Operator*> anchors;
+    for (const Operator* op : graph.ops)
+    {
+        if (op->type == pattern_anchor->type)
+            anchors.push_back(op);
+    }
+
+    if (anchors.empty())
+        return;
+
+    // a match never reaches further downstream than the pattern size
+    int pattern_op_count = 0;
+    for (const auto& x : pattern_graph.ops)
+    {
+        if (x->type != "pnnx.Input" && x->type != "pnnx.Output")
+            pattern_op_count++;
+    }
+
+    // order keys follow graph position, inserted operators take keys between their neighbours
+    std::map<double, Operator*> sequence;
+    std::unordered_map<const Operator*, double> order;
+    for (size_t i = 0; i < graph.ops.size(); i++)
+    {
+        sequence[(double)i] = graph.ops[i];
+        order[graph.ops[i]] = (double)i;
+    }
+
+    operator_order_less less = {&order};
+    std::set<const Operator*, operator_order_less> candidates(anchors.begin(), anchors.end(), less);
+
+    std::vector<Operand*> dead_operands;
+
+    while (!candidates.empty())
+    {
+        const Operator* anchor = *candidates.rbegin();
+        candidates.erase(anchor);
+
+        std::map<std::string, const Operator*> matched_operators;
+        std::map<std::string, const Operand*> matched_inputs;
+        std::map<std::string, const Operand*> matched_outputs;
+        std::map<std::string, Parameter> captured_params;
+        std::map<std::string, Attribute> captured_attrs;
+        if (!match(anchor, pattern_anchor, matched_operators, matched_inputs, matched_outputs, captured_params, captured_attrs))
+            continue;
+
+        if (!pass->match(matched_operators, captured_params, captured_attrs))
+            continue;
+
+        std::unordered_set<const Operator*> matched_set;
+        for (const auto& x : matched_operators)
+        {
+            matched_set.insert(x.second);
+        }
+
+        // the consumers of matched inputs change, so do the anchors reading them through the producer
+        std::vector<const Operator*> touched;
+        for (const auto& x : matched_inputs)
         {
-            // insert single
-            Operator* op = graph.new_operator_before(pass->type_str(), std::string(pass->name_str()), cur);
+            const Operator* producer = x.second->producer;
+            if (producer && matched_set.find(producer) == matched_set.end())
+                touched.push_back(producer);
+        }
 
-            for (const auto& k : pattern_graph_inputs)
-            {
-                Operand* r = (Operand*)matched_inputs.at(k);
-                r->consumers.push_back(op);
-                op->inputs.push_back(r);
+        // insert new operator before the one following the last matched one
+        double last_key = order.at(anchor);
+        for (const Operator* x : matched_set)
+        {
+            last_key = std::max(last_key, order.at(x));
+        }
 
-                op->inputnames.push_back(k);
-            }
+        std::map<double, Operator*>::iterator cur = sequence.upper_bound(last_key);
 
-            for (const auto& k : pattern_graph_outputs)
-            {
-                Operand* r = (Operand*)matched_outputs.at(k);
-                r->producer = op;
-                op->outputs.push_back(r);
-            }
+        for (const Operator* x : matched_set)
+        {
+            candidates.erase(x);
+            sequence.erase(order.at(x));
+            order.erase(x);
+        }
 
-            pass->write(op, captured_params, captured_attrs);
+        std::vector<Operator*> replace_ops;
+        replace_matched(graph, pass, pattern_graph_inputs, pattern_graph_outputs, matched_operators, matched_inputs, matched_outputs, captured_params, captured_attrs, replace_ops, dead_operands, new_ops);
 
-            new_ops.push_back(op);
+        for (const Operator* x : matched_set)
+        {
+            delete x;
+        }
+
+        const int replace_op_count = (int)replace_ops.size();
+
+        double key0;
+        double key1;
+        if (cur == sequence.end())
+        {
+            key0 = sequence.empty() ? 0.0 : sequence.rbegin()->first;
+            key1 = key0 + replace_op_count + 1;
+        }
+        else if (cur == sequence.begin())
+        {
+            key1 = cur->first;
+            key0 = key1 - replace_op_count - 1;
         }
         else
         {
-            // insert multiple
-            Graph replace_graph;
-            replace_graph.parse(pass->replace_pattern_graph());
+            std::map<double, Operator*>::iterator prev = cur;
+            --prev;
+            key0 = prev->first;
+            key1 = cur->first;
+        }
 
-            // move operators and operands from replace_graph to graph except input and output
-            std::map<std::string, Operator*> ops;
-            for (size_t i = 0; i < replace_graph.ops.size(); i++)
+        const double step = (key1 - key0) / (replace_op_count + 1);
+        if (step > 1e-6)
+        {
+            for (int i = 0; i < replace_op_count; i++)
             {
-                Operator* op = replace_graph.ops[i];
-                if (op->type == "pnnx.Input" || op->type == "pnnx.Output")
-                    continue;
-
-                graph.ops.insert(std::find(graph.ops.begin(), graph.ops.end(), cur), op);
-                replace_graph.ops[i] = 0;
-                ops[op->name] = op;
+                const double key = key0 + step * (i + 1);
+                sequence[key] = replace_ops[i];
+                order[replace_ops[i]] = key;
             }
-
-            for (size_t i = 0; i < replace_graph.operands.size(); i++)
+        }
+        else
+        {
+            // renumber before the gaps between keys run out of precision
+            std::vector<Operator*> ops;
+            for (std::map<double, Operator*>::iterator it = sequence.begin(); it != sequence.end(); ++it)
             {
-                Operand* r = replace_graph.operands[i];
-                if (r->producer->type == "pnnx.Input" || (r->consumers.size() == 1 && r->consumers[0]->type == "pnnx.Output"))
-                    continue;
+                if (it == cur)
+                    ops.insert(ops.end(), replace_ops.begin(), replace_ops.end());
+                ops.push_back(it->second);
+            }
+            if (cur == sequence.end())
+                ops.insert(ops.end(), replace_ops.begin(), replace_ops.end());
 
-                graph.operands.push_back(r);
-                replace_graph.operands[i] = 0;
+            sequence.clear();
+            for (size_t i = 0; i < ops.size(); i++)
+            {
+                sequence[(double)i] = ops[i];
+                order[ops[i]] = (double)i;
             }
+        }
 
-            replace_graph.ops.erase(std::remove(replace_graph.ops.begin(), replace_graph.ops.end(), (Operator*)0), replace_graph.ops.end());
-            replace_graph.operands.erase(std::remove(replace_graph.operands.begin(), replace_graph.operands.end(), (Operand*)0), replace_graph.operands.end());
+        touched.insert(touched.end(), replace_ops.begin(), replace_ops.end());
 
-            for (size_t i = 0; i < pattern_graph_inputs.size(); i++)
+        std::unordered_set<const Operator*> visited;
+        for (int depth = 0; depth <= pattern_op_count && !touched.empty(); depth++)
+        {
+            std::vector<const Operator*> next;
+            for (const Operator* op : touched)
             {
-                const std::string& k = pattern_graph_inputs[i];
-                Operand* r = (Operand*)matched_inputs.at(k);
-                const Operand* rr = replace_graph.get_operand(k);
+                if (!visited.insert(op).second)
+                    continue;
 
-                for (auto x : rr->consumers)
-                {
-                    r->consumers.push_back(x);
+                if (op->type == pattern_anchor->type)
+                    candidates.insert(op);
 
-                    x->inputnames.resize(x->inputs.size());
-                    for (size_t j = 0; j < x->inputs.size(); j++)
-                    {
-                        if (x->inputs[j]->name == k)
-                        {
-                            x->inputs[j] = r;
-                            x->inputnames[j] = k;
-                            break;
-                        }
-                    }
+                for (const Operand* r : op->outputs)
+                {
+                    for (const Operator* c : r->consumers)
+                        next.push_back(c);
                 }
             }
+            touched.swap(next);
+        }
+    }
 
-            for (size_t i = 0; i < pattern_graph_outputs.size(); i++)
-            {
-                const std::string& k = pattern_graph_outputs[i];
-                Operand* r = (Operand*)matched_outputs.at(k);
-                const Operand* rr = replace_graph.get_operand(k);
+    graph.ops.clear();
+    for (const auto& x : sequence)
+    {
+        graph.ops.push_back(x.second);
+    }
 
-                r->producer = rr->producer;
+    if (!dead_operands.empty())
+    {
+        std::unordered_set<const Operand*> dead_set(dead_operands.begin(), dead_operands.end());
+        size_t j = 0;
+        for (size_t i = 0; i < graph.operands.size(); i++)
+        {
+            if (dead_set.find(graph.operands[i]) == dead_set.end())
+                graph.operands[j++] = graph.operands[i];
+        }
+        graph.operands.resize(j);
 
-                for (size_t j = 0; j < r->producer->outputs.size(); j++)
-                {
-                    if (r->producer->outputs[j]->name == k)
-                    {
-                        r->producer->outputs[j] = r;
-                        break;
-                    }
-                }
-            }
+        for (Operand* r : dead_operands)
+        {
+            delete r;
+        }
+    }
+}
 
-            pass->write(ops, captured_params, captured_attrs);
+void pnnx_graph_rewrite(Graph& graph, const GraphRewriterPass* pass, int& opindex)
+{
+    Graph pattern_graph;
+    pattern_graph.parse(pass->match_pattern_graph());
 
-            for (auto x : ops)
-            {
-                new_ops.push_back(x.second);
-            }
+    // collect pattern inputs and outputs order
+    std::vector<std::string> pattern_graph_inputs;
+    std::vector<std::string> pattern_graph_outputs;
+    std::vector<const Operator*> pattern_graph_output_operators;
+    for (const auto& x : pattern_graph.ops)
+    {
+        if (x->type == "pnnx.Input")
+        {
+            for (const auto& y : x->outputs)
+                pattern_graph_inputs.push_back(y->name);
         }
+        if (x->type == "pnnx.Output")
+        {
+            pattern_graph_output_operators.push_back(x);
+            for (const auto& y : x->inputs)
+                pattern_graph_outputs.push_back(y->name);
+        }
+    }
+
+    std::vector<Operator*> new_ops;
+
+    if (pattern_graph_outputs.size() == 1)
+    {
+        const Operator* pattern_anchor = pattern_graph_output_operators[0]->inputs[0]->producer;
+
+        rewrite_by_worklist(graph, pass, pattern_graph, pattern_graph_inputs, pattern_graph_outputs, pattern_anchor, new_ops);
+    }
+    else
+    {
+        rewrite_by_scan(graph, pass, pattern_graph_inputs, pattern_graph_outputs, pattern_graph_output_operators, new_ops);
     }
 
     // assign new op name number
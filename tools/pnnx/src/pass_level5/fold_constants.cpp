@@ -38,8 +38,7 @@ void fold_constants(Graph& graph, const std::set<std::string>& foldable_constant
         t2.type = operand->type;
         t2.shape = operand->shape;
         size_t size = zip.get_file_size(name);
-        t2.data.resize(size);
-        zip.read_file(name, t2.data.data());
+        t2.data = AttributeData(zip.map_file(name), size);
 
         op_new->outputs.push_back(operand);
         operand->producer = op_new;
@@ -1313,7 +1313,7 @@ pnnx.Output             output      1 0 out
         op_attr->attrs["data"].shape = {size, size};
 
         // hack attn_mask value
-        std::vector<char>& data = op_attr->attrs["data"].data;
+        AttributeData& data = op_attr->attrs["data"].data;
         size_t len = data.size();
         data.resize(len * size);
         for (int i = 1; i < size; i++)
@@ -1374,7 +1374,7 @@ pnnx.Output             output      1 0 out
         op_attr->attrs["data"].shape = {batch * num_heads, size, size};
 
         // hack attn_mask value
-        std::vector<char>& data = op_attr->attrs["data"].data;
+        AttributeData& data = op_attr->attrs["data"].data;
         size_t len = data.size();
         data.resize(len * batch);
         for (int i = 1; i < batch; i++)
@@ -1466,7 +1466,7 @@ pnnx.Output             output      1 0 out
         op_attr->attrs["data"].shape = {batch * num_heads, size, size};
 
         // hack attn_mask value
-        std::vector<char>& data = op_attr->attrs["data"].data;
+        AttributeData& data = op_attr->attrs["data"].data;
         size_t len = data.size();
         data.resize(len * batch);
         for (int i = 1; i < batch; i++)
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 
 #include "save_ncnn.h"
+#include <algorithm>
 #include <cstdint>
 
 namespace pnnx {
@@ -109,10 +110,9 @@ static unsigned short float32_to_float16(float value)
     return fp16;
 }
 
-static size_t alignSize(size_t sz, int n)
-{
-    return (sz + n - 1) & -n;
-}
+// converted weights are written out in pieces of this many elements,
+// so the temporary buffer stays small however large the weight is
+#define WRITE_CHUNK_SIZE 65536
 
 static int32_t safe_int64_to_int32(int64_t value)
 {
@@ -284,25 +284,29 @@ int save_ncnn(const Graph& g, const std::string& parampath, const std::string& b
 
             if (fp16 && is_type_flag_fp32)
             {
-                // fp32 -> fp16
+                // fp32 -> fp16, converted and written chunk by chunk
                 const float* p = (const float*)attr.data.data();
                 int len = attr.data.size() / 4;
-                std::vector<char> data_fp16(alignSize(len * 2, 4));
-                unsigned short* p_fp16 = (unsigned short*)data_fp16.data();
-                for (int i = 0; i < len; i++)
+                std::vector<unsigned short> data_fp16(std::min(len, WRITE_CHUNK_SIZE));
+                for (int i = 0; i < len; i += WRITE_CHUNK_SIZE)
                 {
-                    p_fp16[i] = float32_to_float16(p[i]);
+                    const int n = std::min(len - i, WRITE_CHUNK_SIZE);
+                    for (int j = 0; j < n; j++)
+                    {
+                        data_fp16[j] = float32_to_float16(p[i + j]);
+                    }
+
+                    fwrite(data_fp16.data(), n * sizeof(unsigned short), 1, binfp);
                 }
 
                 // pad size to 4bytes
                 if (len % 2 == 1)
                 {
                     // pad with fixed value for model hash consistency
-                    p_fp16[len] = 0x2283;
+                    unsigned short pad = 0x2283;
+                    fwrite((const char*)&pad, sizeof(pad), 1, binfp);
                 }
 
-                fwrite(data_fp16.data(), data_fp16.size(), 1, binfp);
-
                 is_type_flag_fp32 = false;
                 continue;
             }
@@ -322,14 +326,17 @@ int save_ncnn(const Graph& g, const std::string& parampath, const std::string& b
                 const int64_t* p = (const int64_t*)attr.data.data();
                 int len = attr.data.size() / sizeof(int64_t);
 
-                std::vector<int32_t> data_int32(len);
-
-                for (int i = 0; i < len; i++)
+                std::vector<int32_t> data_int32(std::min(len, WRITE_CHUNK_SIZE));
+                for (int i = 0; i < len; i += WRITE_CHUNK_SIZE)
                 {
-                    data_int32[i] = safe_int64_to_int32(p[i]);
-                }
+                    const int n = std::min(len - i, WRITE_CHUNK_SIZE);
+                    for (int j = 0; j < n; j++)
+                    {
+                        data_int32[j] = safe_int64_to_int32(p[i + j]);
+                    }
 
-                fwrite(data_int32.data(), data_int32.size() * sizeof(int32_t), 1, binfp);
+                    fwrite(data_int32.data(), n * sizeof(int32_t), 1, binfp);
+                }
                 continue;
             }
 
@@ -6,9 +6,15 @@
 #include <stdio.h>
 #include <stdint.h>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
+#if !defined(_WIN32)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace pnnx {
 
 // https://stackoverflow.com/questions/1537964/visual-c-equivalent-of-gccs-attribute-packed
@@ -85,6 +91,12 @@ PACK(struct end_of_central_directory_record {
     uint16_t comment_length;
 });
 
+// stored data starts at this boundary, so entries can be used in place from a mapped file
+#define STOREZIP_DATA_ALIGNMENT 64
+
+// extra field id for the alignment padding, the same one pytorch serialization uses
+#define STOREZIP_PADDING_EXTRA_ID 0x4246
+
 static uint32_t CRC32_TABLE[256];
 
 static void CRC32_TABLE_INIT()
@@ -118,6 +130,31 @@ static uint32_t CRC32_buffer(const unsigned char* data, uint64_t len)
     return x ^ 0xffffffff;
 }
 
+struct storezip_free
+{
+    void operator()(const char* p) const
+    {
+        delete[] p;
+    }
+};
+
+#if !defined(_WIN32)
+struct storezip_munmap
+{
+    storezip_munmap(size_t _size)
+        : size(_size)
+    {
+    }
+
+    void operator()(const char* p) const
+    {
+        munmap((void*)p, size);
+    }
+
+    size_t size;
+};
+#endif
+
 StoreZipReader::StoreZipReader()
 {
     fp = 0;
@@ -260,6 +297,19 @@ int StoreZipReader::open(const std::string& path)
         }
     }
 
+#if !defined(_WIN32)
+    struct stat st;
+    if (fstat(fileno(fp), &st) == 0 && st.st_size > 0 && (uint64_t)st.st_size == (uint64_t)(size_t)st.st_size)
+    {
+        const size_t mapsize = (size_t)st.st_size;
+        void* ptr = mmap(0, mapsize, PROT_READ, MAP_PRIVATE, fileno(fp), 0);
+        if (ptr != MAP_FAILED)
+        {
+            mapped = std::shared_ptr<const char>((const char*)ptr, storezip_munmap(mapsize));
+        }
+    }
+#endif
+
     return 0;
 }
 
@@ -302,8 +352,36 @@ int StoreZipReader::read_file(const std::string& name, char* data)
     return 0;
 }
 
+std::shared_ptr<const char> StoreZipReader::map_file(const std::string& name)
+{
+    if (filemetas.find(name) == filemetas.end())
+    {
+        fprintf(stderr, "no such file %s\n", name.c_str());
+        return std::shared_ptr<const char>();
+    }
+
+    uint64_t offset = filemetas[name].offset;
+    uint64_t size = filemetas[name].size;
+
+    // 16 byte alignment is enough for every element type, entries written by StoreZipWriter always have it
+    if (mapped && offset % 16 == 0)
+    {
+        // share ownership of the whole mapping
+        return std::shared_ptr<const char>(mapped, mapped.get() + offset);
+    }
+
+    std::shared_ptr<const char> data(new char[size], storezip_free());
+
+    fseek(fp, offset, SEEK_SET);
+    fread((char*)data.get(), size, 1, fp);
+
+    return data;
+}
+
 int StoreZipReader::close()
 {
+    mapped.reset();
+
     if (!fp)
         return 0;
 
@@ -329,6 +407,11 @@ int StoreZipWriter::open(const std::string& path)
 {
     close();
 
+#if !defined(_WIN32)
+    // start a new file rather than truncating, a reader may still have the old one mapped
+    remove(path.c_str());
+#endif
+
     fp = fopen(path.c_str(), "wb");
     if (!fp)
     {
@@ -369,7 +452,15 @@ int StoreZipWriter::write_file(const std::string& name, const char* data, uint64
     uint16_t extra_id = 0x0001;
     uint16_t extra_size = sizeof(zip64_eef);
 
-    lfh.extra_field_length = sizeof(extra_id) + sizeof(extra_size) + sizeof(zip64_eef);
+    // padding extra field after zip64, aligns the data start
+    uint16_t padding_id = STOREZIP_PADDING_EXTRA_ID;
+    uint16_t padding_size = 0;
+    {
+        const uint64_t data_offset = offset + sizeof(signature) + sizeof(lfh) + name.size() + sizeof(extra_id) + sizeof(extra_size) + sizeof(zip64_eef) + sizeof(padding_id) + sizeof(padding_size);
+        padding_size = (STOREZIP_DATA_ALIGNMENT - data_offset % STOREZIP_DATA_ALIGNMENT) % STOREZIP_DATA_ALIGNMENT;
+    }
+
+    lfh.extra_field_length = sizeof(extra_id) + sizeof(extra_size) + sizeof(zip64_eef) + sizeof(padding_id) + sizeof(padding_size) + padding_size;
 
     fwrite((char*)&lfh, sizeof(lfh), 1, fp);
 
@@ -379,6 +470,11 @@ int StoreZipWriter::write_file(const std::string& name, const char* data, uint64
     fwrite((char*)&extra_size, sizeof(extra_size), 1, fp);
     fwrite((char*)&zip64_eef, sizeof(zip64_eef), 1, fp);
 
+    const char padding[STOREZIP_DATA_ALIGNMENT] = {0};
+    fwrite((char*)&padding_id, sizeof(padding_id), 1, fp);
+    fwrite((char*)&padding_size, sizeof(padding_size), 1, fp);
+    fwrite(padding, padding_size, 1, fp);
+
     fwrite(data, size, 1, fp);
 
     StoreZipMeta szm;
@@ -6,6 +6,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -25,10 +26,15 @@ public:
 
     int read_file(const std::string& name, char* data);
 
+    // read-only view of the stored file backed by the mapped zip, it stays valid after close()
+    // falls back to a private copy for unaligned entries or where the file cannot be mapped
+    std::shared_ptr<const char> map_file(const std::string& name);
+
     int close();
 
 private:
     FILE* fp;
+    std::shared_ptr<const char> mapped;
 
     struct StoreZipMeta
     {
@@ -6,6 +6,7 @@
 #endif
 
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
 #include <map>
 #include <set>
@@ -19,6 +20,7 @@
 
 // ncnn private header
 #include "../modelwriter.h"
+#include "layer/weight_quant.h"
 
 class DataReaderFromEmpty : public ncnn::DataReader
 {
@@ -116,6 +118,8 @@ public:
 public:
     int quantize_convolution();
     int quantize_convolutiondepthwise();
+    int quantize_deconvolution();
+    int quantize_deconvolutiondepthwise();
     int quantize_innerproduct();
 
     int quantize_rnn();
@@ -127,6 +131,12 @@ public:
     int quantize_multiheadattention();
 
     int fuse_requantize();
+    int fuse_requantize_passthrough();
+
+    // weight only quantization, activations stay in floating point
+    int quantize_innerproduct_weight_only(int bits, int group_size);
+    int quantize_gemm_weight_only(int bits, int group_size);
+    int quantize_embed_weight_only(int bits, int group_size);
 };
 
 NetQuantize::NetQuantize()
@@ -254,6 +264,126 @@ int NetQuantize::quantize_convolutiondepthwise()
     return 0;
 }
 
+int NetQuantize::quantize_deconvolution()
+{
+    const int layer_count = static_cast<int>(layers.size());
+    for (int i = 0; i < layer_count; i++)
+    {
+        // find deconvolution layer
+        if (layers[i]->type != "Deconvolution")
+            continue;
+
+        // find deconvolution layer
+        std::map<std::string, ncnn::Mat>::iterator iter_data = blob_int8scale_table.find(layers[i]->name);
+        if (iter_data == blob_int8scale_table.end())
+            continue;
+
+        char key[256];
+        sprintf(key, "%s_param_0", layers[i]->name.c_str());
+
+        std::map<std::string, ncnn::Mat>::iterator iter = weight_int8scale_table.find(key);
+        if (iter == weight_int8scale_table.end())
+        {
+            fprintf(stderr, "this layer need to be quantized, but no scale param!\n");
+            return -1;
+        }
+
+        // Deconvolution - quantize weight from fp32 to int8
+        ncnn::Deconvolution* deconvolution = (ncnn::Deconvolution*)layers[i];
+
+        ncnn::Mat bottom_blob_int8_scales = iter_data->second;
+        ncnn::Mat weight_data_int8_scales = iter->second;
+
+        fprintf(stderr, "quantize_deconvolution %s\n", deconvolution->name.c_str());
+
+        {
+            const int maxk = deconvolution->kernel_w * deconvolution->kernel_h;
+            const int num_input = deconvolution->weight_data_size / deconvolution->num_output / maxk;
+
+            ncnn::Mat weight_data_r2 = deconvolution->weight_data.reshape(maxk, num_input, deconvolution->num_output);
+
+            ncnn::Mat weight_data_int8;
+
+            ncnn::Option opt_q = opt;
+            opt_q.blob_allocator = deconvolution->weight_data.allocator;
+            opt_q.use_packing_layout = false;
+            ncnn::quantize_to_int8(weight_data_r2, weight_data_int8, weight_data_int8_scales, opt_q);
+            if (weight_data_int8.empty())
+                return -100;
+
+            deconvolution->weight_data = weight_data_int8.reshape(deconvolution->weight_data_size);
+        }
+
+        deconvolution->int8_scale_term = 1;
+        deconvolution->weight_data_int8_scales = weight_data_int8_scales;
+        deconvolution->bottom_blob_int8_scales = bottom_blob_int8_scales;
+    }
+
+    return 0;
+}
+
+int NetQuantize::quantize_deconvolutiondepthwise()
+{
+    const int layer_count = static_cast<int>(layers.size());
+    for (int i = 0; i < layer_count; i++)
+    {
+        // find deconvolutiondepthwise layer
+        if (layers[i]->type != "DeconvolutionDepthWise")
+            continue;
+
+        // find deconvolutiondepthwise layer
+        std::map<std::string, ncnn::Mat>::iterator iter_data = blob_int8scale_table.find(layers[i]->name);
+        if (iter_data == blob_int8scale_table.end())
+            continue;
+
+        char key[256];
+        sprintf(key, "%s_param_0", layers[i]->name.c_str());
+
+        std::map<std::string, ncnn::Mat>::iterator iter = weight_int8scale_table.find(key);
+        if (iter == weight_int8scale_table.end())
+        {
+            fprintf(stderr, "this layer need to be quantized, but no scale param!\n");
+            return -1;
+        }
+
+        // DeconvolutionDepthWise - quantize weight from fp32 to int8
+        ncnn::DeconvolutionDepthWise* deconvdw = (ncnn::DeconvolutionDepthWise*)layers[i];
+
+        ncnn::Mat bottom_blob_int8_scales = iter_data->second;
+        ncnn::Mat weight_data_int8_scales = iter->second;
+
+        fprintf(stderr, "quantize_deconvolutiondepthwise %s\n", deconvdw->name.c_str());
+
+        {
+            ncnn::Mat int8_weight_data(deconvdw->weight_data_size, (size_t)1u);
+            if (int8_weight_data.empty())
+                return -100;
+
+            const int weight_data_size_g = deconvdw->weight_data_size / deconvdw->group;
+
+            for (int g = 0; g < deconvdw->group; g++)
+            {
+                ncnn::Option opt_q = opt;
+                opt_q.blob_allocator = int8_weight_data.allocator;
+                opt_q.use_packing_layout = false;
+
+                const ncnn::Mat weight_data_g = deconvdw->weight_data.range(weight_data_size_g * g, weight_data_size_g);
+                ncnn::Mat int8_weight_data_g = int8_weight_data.range(weight_data_size_g * g, weight_data_size_g);
+                const ncnn::Mat weight_data_int8_scales_g = weight_data_int8_scales.range(g, 1);
+                ncnn::quantize_to_int8(weight_data_g, int8_weight_data_g, weight_data_int8_scales_g, opt_q);
+            }
+
+            deconvdw->weight_data = int8_weight_data;
+        }
+
+        deconvdw->int8_scale_term = 1;
+        deconvdw->weight_data_int8_scales = weight_data_int8_scales;
+        deconvdw->bottom_blob_int8_scales = bottom_blob_int8_scales;
+    }
+
+    return 0;
+}
+
 int NetQuantize::quantize_innerproduct()
 {
     const int layer_count = static_cast<int>(layers.size());
@@ -309,6 +439,167 @@ int NetQuantize::quantize_innerproduct()
     return 0;
 }
 
+// symmetric per group quantization of row-major weight [rows][K], weight = q * scale
+static int quantize_weight_rows(const ncnn::Mat& weight, int rows, int K, int bits, int group_size, ncnn::Mat& weight_quant, ncnn::Mat& scales)
+{
+    const int row_bytes = weight_quant_row_bytes(K, bits);
+    const int groups = weight_quant_group_count(K, group_size);
+    const int gs = group_size > 0 ? group_size : K;
+    const int qmax = bits == 4 ? 7 : 127;
+
+    weight_quant.create(row_bytes * rows, (size_t)1u);
+    scales.create(groups * rows);
+    if (weight_quant.empty() || scales.empty())
+        return -100;
+
+    memset(weight_quant.data, 0, row_bytes * rows);
+
+    for (int i = 0; i < rows; i++)
+    {
+        const float* ptr = (const float*)weight + i * K;
+        unsigned char* qptr = (unsigned char*)weight_quant + i * row_bytes;
+
+        for (int g = 0; g < groups; g++)
+        {
+            const int k0 = g * gs;
+            const int k1 = std::min(k0 + gs, K);
+
+            float absmax = 0.f;
+            for (int k = k0; k < k1; k++)
+            {
+                absmax = std::max(absmax, (float)fabs(ptr[k]));
+            }
+
+            scales[i * groups + g] = absmax / qmax;
+
+            const float inv_scale = absmax == 0.f ? 0.f : qmax / absmax;
+            for (int k = k0; k < k1; k++)
+            {
+                int q = (int)round(ptr[k] * inv_scale);
+                q = std::min(std::max(q, -qmax), qmax);
+
+                if (bits == 8)
+                    qptr[k] = (unsigned char)(signed char)q;
+                else
+                    qptr[k / 2] |= (unsigned char)((q + 8) << (k % 2 * 4));
+            }
+        }
+    }
+
+    return 0;
+}
+
+int NetQuantize::quantize_innerproduct_weight_only(int bits, int group_size)
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->type != "InnerProduct")
+            continue;
+
+        ncnn::InnerProduct* fc = (ncnn::InnerProduct*)layers[i];
+        if (fc->int8_scale_term || fc->weight_quant_bits)
+            continue;
+
+        fprintf(stderr, "quantize_innerproduct_weight_only %s\n", fc->name.c_str());
+
+        const int num_input = fc->weight_data_size / fc->num_output;
+
+        ncnn::Mat weight_data_quant;
+        ncnn::Mat weight_data_quant_scales;
+        int ret = quantize_weight_rows(fc->weight_data, fc->num_output, num_input, bits, group_size, weight_data_quant, weight_data_quant_scales);
+        if (ret != 0)
+            return ret;
+
+        fc->weight_data = weight_data_quant;
+        fc->weight_data_quant_scales = weight_data_quant_scales;
+        fc->weight_quant_bits = bits;
+        fc->weight_quant_group_size = group_size;
+    }
+
+    return 0;
+}
+
+int NetQuantize::quantize_gemm_weight_only(int bits, int group_size)
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->type != "Gemm")
+            continue;
+
+        // only the activation x weight form
+        ncnn::Gemm* gemm = (ncnn::Gemm*)layers[i];
+        if (gemm->constantA || !gemm->constantB || gemm->int8_scale_term || gemm->weight_quant_bits)
+            continue;
+
+        fprintf(stderr, "quantize_gemm_weight_only %s\n", gemm->name.c_str());
+
+        if (gemm->transB == 0)
+        {
+            // transpose so that every output column is one row of K weights
+            ncnn::Mat B_data_transposed(gemm->constantK * gemm->constantN);
+            for (int i = 0; i < gemm->constantN; i++)
+            {
+                float* ptr = (float*)B_data_transposed + i * gemm->constantK;
+                for (int j = 0; j < gemm->constantK; j++)
+                {
+                    ptr[j] = gemm->B_data[j * gemm->constantN + i];
+                }
+            }
+            gemm->B_data = B_data_transposed;
+            gemm->transB = 1;
+        }
+
+        ncnn::Mat B_data_quant;
+        ncnn::Mat B_data_quant_scales;
+        int ret = quantize_weight_rows(gemm->B_data, gemm->constantN, gemm->constantK, bits, group_size, B_data_quant, B_data_quant_scales);
+        if (ret != 0)
+            return ret;
+
+        gemm->B_data = B_data_quant;
+        gemm->B_data_quant_scales = B_data_quant_scales;
+        gemm->weight_quant_bits = bits;
+        gemm->weight_quant_group_size = group_size;
+    }
+
+    return 0;
+}
+
+int NetQuantize::quantize_embed_weight_only(int bits, int group_size)
+{
+    for (size_t i = 0; i < layers.size(); i++)
+    {
+        if (layers[i]->type != "Embed")
+            continue;
+
+        // one row of num_output weights per word, each row with its own scales
+        ncnn::Embed* embed = (ncnn::Embed*)layers[i];
+        if (embed->int8_scale_term || embed->weight_quant_bits)
+            continue;
+
+        fprintf(stderr, "quantize_embed_weight_only %s\n", embed->name.c_str());
+
+        if (embed->weight_data.elemsize == 2)
+        {
+            ncnn::Mat weight_data_fp32;
+            ncnn::cast_float16_to_float32(embed->weight_data, weight_data_fp32);
+            embed->weight_data = weight_data_fp32;
+        }
+
+        ncnn::Mat weight_data_quant;
+        ncnn::Mat weight_data_quant_scales;
+        int ret = quantize_weight_rows(embed->weight_data, embed->input_dim, embed->num_output, bits, group_size, weight_data_quant, weight_data_quant_scales);
+        if (ret != 0)
+            return ret;
+
+        embed->weight_data = weight_data_quant;
+        embed->weight_data_quant_scales = weight_data_quant_scales;
+        embed->weight_quant_bits = bits;
+        embed->weight_quant_group_size = group_size;
+    }
+
+    return 0;
+}
+
 int NetQuantize::quantize_rnn()
 {
     for (size_t i = 0; i < layers.size(); i++)
@@ -564,9 +855,18 @@ int NetQuantize::quantize_embed()
 
         // Embed - quantize weight from fp32 to int8
         ncnn::Embed* embed = (ncnn::Embed*)layers[i];
+        if (embed->weight_quant_bits)
+            continue;
 
         fprintf(stderr, "quantize_embed %s\n", embed->name.c_str());
 
+        if (embed->weight_data.elemsize == 2)
+        {
+            ncnn::Mat weight_data_fp32;
+            ncnn::cast_float16_to_float32(embed->weight_data, weight_data_fp32);
+            embed->weight_data = weight_data_fp32;
+        }
+
         // TODO move to ncnn2table
 
         const int num_output = embed->num_output;
@@ -1045,11 +1345,235 @@ int NetQuantize::fuse_requantize()
     return 0;
 }
 
+// layers that forward int8 blobs on cpu without touching the scale
+static bool is_int8_passthrough(const ncnn::Layer* layer)
+{
+    if (layer->type == "Split" || layer->type == "Concat" || layer->type == "Slice" || layer->type == "ShuffleChannel" || layer->type == "ReLU")
+        return true;
+
+    if (layer->type == "Crop")
+        return true;
+
+    if (layer->type == "Pooling")
+    {
+        const ncnn::Pooling* pooling = (const ncnn::Pooling*)layer;
+        return pooling->adaptive_pooling == 0;
+    }
+
+    if (layer->type == "Padding")
+    {
+        // a non-zero constant would need the blob scale
+        const ncnn::Padding* padding = (const ncnn::Padding*)layer;
+        return layer->bottoms.size() == 1 && padding->per_channel_pad_data_size == 0 && (padding->type != 0 || padding->value == 0.f);
+    }
+
+    return false;
+}
+
+// crop takes its offsets from the other bottoms, only the first one carries data
+static bool is_int8_passthrough_bottom(const ncnn::Layer* layer, int bottom_blob_index)
+{
+    if (layer->type == "Crop")
+        return layer->bottoms[0] == bottom_blob_index;
+
+    return true;
+}
+
+static bool is_int8_producer(const ncnn::Layer* layer)
+{
+    if (layer->tops.size() != 1)
+        return false;
+
+    if (layer->type == "Convolution")
+    {
+        const ncnn::Convolution* convolution = (const ncnn::Convolution*)layer;
+        return convolution->weight_data.elemsize == 1u && convolution->int8_scale_term < 100;
+    }
+    if (layer->type == "ConvolutionDepthWise")
+    {
+        const ncnn::ConvolutionDepthWise* convolutiondepthwise = (const ncnn::ConvolutionDepthWise*)layer;
+        return convolutiondepthwise->weight_data.elemsize == 1u && convolutiondepthwise->int8_scale_term < 100;
+    }
+
+    return false;
+}
+
+static bool is_int8_consumer(const ncnn::Layer* layer)
+{
+    if (layer->bottoms.size() != 1)
+        return false;
+
+    if (layer->type == "Convolution")
+        return ((const ncnn::Convolution*)layer)->weight_data.elemsize == 1u;
+    if (layer->type == "ConvolutionDepthWise")
+        return ((const ncnn::ConvolutionDepthWise*)layer)->weight_data.elemsize == 1u;
+    if (layer->type == "Deconvolution")
+        return ((const ncnn::Deconvolution*)layer)->weight_data.elemsize == 1u;
+
+    return false;
+}
+
+static int find_blob_region(std::vector<int>& region, int i)
+{
+    while (region[i] != i)
+    {
+        region[i] = region[region[i]];
+        i = region[i];
+    }
+    return i;
+}
+
+int NetQuantize::fuse_requantize_passthrough()
+{
+    const int blob_count = static_cast<int>(blobs.size());
+    const int layer_count = static_cast<int>(layers.size());
+
+    // blobs connected by passthrough layers must share one int8 scale
+    std::vector<int> region(blob_count);
+    for (int i = 0; i < blob_count; i++)
+    {
+        region[i] = i;
+    }
+
+    for (int i = 0; i < layer_count; i++)
+    {
+        const ncnn::Layer* layer = layers[i];
+        if (!is_int8_passthrough(layer))
+            continue;
+
+        const int root = find_blob_region(region, layer->bottoms[0]);
+        for (size_t j = 1; j < layer->bottoms.size(); j++)
+        {
+            if (is_int8_passthrough_bottom(layer, layer->bottoms[j]))
+                region[find_blob_region(region, layer->bottoms[j])] = root;
+        }
+        for (size_t j = 0; j < layer->tops.size(); j++)
+        {
+            region[find_blob_region(region, layer->tops[j])] = find_blob_region(region, root);
+        }
+    }
+
+    // a region stays int8 only if every producer can requantize and every consumer reads int8
+    std::vector<char> region_ok(blob_count, 1);
+    std::vector<char> region_passthrough(blob_count, 0);
+    for (int i = 0; i < blob_count; i++)
+    {
+        const int root = find_blob_region(region, i);
+
+        const int producer = blobs[i].producer;
+        const int consumer = blobs[i].consumer;
+
+        if (producer < 0 || consumer < 0)
+        {
+            // network input or output
+            region_ok[root] = 0;
+            continue;
+        }
+
+        if (is_int8_passthrough(layers[producer]))
+            region_passthrough[root] = 1;
+        else if (!is_int8_producer(layers[producer]))
+            region_ok[root] = 0;
+
+        if (is_int8_passthrough(layers[consumer]) && is_int8_passthrough_bottom(layers[consumer], i))
+            region_passthrough[root] = 1;
+        else if (!is_int8_consumer(layers[consumer]))
+            region_ok[root] = 0;
+    }
+
+    for (int r = 0; r < blob_count; r++)
+    {
+        // plain conv-conv and conv-split-conv are handled by fuse_requantize
+        if (find_blob_region(region, r) != r || !region_ok[r] || !region_passthrough[r])
+            continue;
+
+        // the widest range among consumers avoids clipping any of them
+        float scale = 0.f;
+        for (int i = 0; i < blob_count; i++)
+        {
+            if (find_blob_region(region, i) != r)
+                continue;
+
+            const ncnn::Layer* consumer = layers[blobs[i].consumer];
+            if (!is_int8_consumer(consumer))
+                continue;
+
+            float consumer_scale = 0.f;
+            if (consumer->type == "Convolution")
+                consumer_scale = ((const ncnn::Convolution*)consumer)->bottom_blob_int8_scales[0];
+            if (consumer->type == "ConvolutionDepthWise")
+                consumer_scale = ((const ncnn::ConvolutionDepthWise*)consumer)->bottom_blob_int8_scales[0];
+            if (consumer->type == "Deconvolution")
+                consumer_scale = ((const ncnn::Deconvolution*)consumer)->bottom_blob_int8_scales[0];
+
+            if (scale == 0.f || consumer_scale < scale)
+                scale = consumer_scale;
+        }
+
+        if (scale == 0.f)
+            continue;
+
+        for (int i = 0; i < blob_count; i++)
+        {
+            if (find_blob_region(region, i) != r)
+                continue;
+
+            ncnn::Layer* producer = layers[blobs[i].producer];
+            ncnn::Layer* consumer = layers[blobs[i].consumer];
+
+            if (is_int8_producer(producer))
+            {
+                fprintf(stderr, "fuse_requantize_passthrough %s %s\n", producer->name.c_str(), blobs[i].name.c_str());
+
+                ncnn::Mat top_blob_int8_scales(1);
+                top_blob_int8_scales[0] = scale;
+
+                if (producer->type == "Convolution")
+                {
+                    ncnn::Convolution* convolution = (ncnn::Convolution*)producer;
+                    convolution->int8_scale_term += 100;
+                    convolution->top_blob_int8_scales = top_blob_int8_scales;
+                }
+                if (producer->type == "ConvolutionDepthWise")
+                {
+                    ncnn::ConvolutionDepthWise* convolutiondepthwise = (ncnn::ConvolutionDepthWise*)producer;
+                    convolutiondepthwise->int8_scale_term += 100;
+                    convolutiondepthwise->top_blob_int8_scales = top_blob_int8_scales;
+                }
+            }
+
+            if (is_int8_consumer(consumer))
+            {
+                // the consumer skips quantize and dequantizes with the region scale
+                ncnn::Mat bottom_blob_int8_scales;
+                if (consumer->type == "Convolution")
+                    bottom_blob_int8_scales = ((ncnn::Convolution*)consumer)->bottom_blob_int8_scales.clone();
+                if (consumer->type == "ConvolutionDepthWise")
+                    bottom_blob_int8_scales = ((ncnn::ConvolutionDepthWise*)consumer)->bottom_blob_int8_scales.clone();
+                if (consumer->type == "Deconvolution")
+                    bottom_blob_int8_scales = ((ncnn::Deconvolution*)consumer)->bottom_blob_int8_scales.clone();
+
+                bottom_blob_int8_scales.fill(scale);
+
+                if (consumer->type == "Convolution")
+                    ((ncnn::Convolution*)consumer)->bottom_blob_int8_scales = bottom_blob_int8_scales;
+                if (consumer->type == "ConvolutionDepthWise")
+                    ((ncnn::ConvolutionDepthWise*)consumer)->bottom_blob_int8_scales = bottom_blob_int8_scales;
+                if (consumer->type == "Deconvolution")
+                    ((ncnn::Deconvolution*)consumer)->bottom_blob_int8_scales = bottom_blob_int8_scales;
+            }
+        }
+    }
+
+    return 0;
+}
+
 int main(int argc, char** argv)
 {
-    if (argc != 5 && argc != 6)
+    if (argc < 5)
     {
-        fprintf(stderr, "usage: %s [inparam] [inbin] [outparam] [outbin] [calibration table]\n", argv[0]);
+        fprintf(stderr, "usage: %s [inparam] [inbin] [outparam] [outbin] [calibration table] [int8_passthrough=1]\n", argv[0]);
+        fprintf(stderr, "       %s [inparam] [inbin] [outparam] [outbin] weight_only=int8/int4 [group_size=N]\n", argv[0]);
         return -1;
     }
 
@@ -1057,7 +1581,57 @@ int main(int argc, char** argv)
     const char* inbin = argv[2];
     const char* outparam = argv[3];
     const char* outbin = argv[4];
-    const char* int8scale_table_path = argc == 6 ? argv[5] : NULL;
+    const char* int8scale_table_path = NULL;
+    int weight_only_bits = 0;
+    int weight_only_group_size = 0;
+    int int8_passthrough = 0;
+
+    for (int i = 5; i < argc; i++)
+    {
+        if (strcmp(argv[i], "weight_only=int8") == 0)
+        {
+            weight_only_bits = 8;
+        }
+        else if (strcmp(argv[i], "weight_only=int4") == 0)
+        {
+            weight_only_bits = 4;
+        }
+        else if (strncmp(argv[i], "group_size=", 11) == 0)
+        {
+            weight_only_group_size = atoi(argv[i] + 11);
+        }
+        else if (strncmp(argv[i], "int8_passthrough=", 17) == 0)
+        {
+            int8_passthrough = atoi(argv[i] + 17);
+        }
+        else if (!int8scale_table_path && !strchr(argv[i], '='))
+        {
+            int8scale_table_path = argv[i];
+        }
+        else
+        {
+            fprintf(stderr, "unrecognized option %s\n", argv[i]);
+            return -1;
+        }
+    }
+
+    if (weight_only_bits && int8scale_table_path)
+    {
+        fprintf(stderr, "weight_only does not take a calibration table\n");
+        return -1;
+    }
+
+    if (weight_only_group_size < 0 || (weight_only_group_size && !weight_only_bits))
+    {
+        fprintf(stderr, "group_size must be non-negative and used with weight_only\n");
+        return -1;
+    }
+
+    if (int8_passthrough && (weight_only_bits || !int8scale_table_path))
+    {
+        fprintf(stderr, "int8_passthrough requires a calibration table\n");
+        return -1;
+    }
 
     NetQuantize quantizer;
     quantizer.storage_type = 1; // use fp16 where int8 not applied
@@ -1083,8 +1657,21 @@ int main(int argc, char** argv)
     else
         quantizer.load_model(inbin);
 
+    if (weight_only_bits)
+    {
+        quantizer.quantize_innerproduct_weight_only(weight_only_bits, weight_only_group_size);
+        quantizer.quantize_gemm_weight_only(weight_only_bits, weight_only_group_size);
+        quantizer.quantize_embed_weight_only(weight_only_bits, weight_only_group_size);
+
+        quantizer.save(outparam, outbin);
+
+        return 0;
+    }
+
     quantizer.quantize_convolution();
     quantizer.quantize_convolutiondepthwise();
+    quantizer.quantize_deconvolution();
+    quantizer.quantize_deconvolutiondepthwise();
     quantizer.quantize_innerproduct();
 
     quantizer.quantize_rnn();
@@ -1096,6 +1683,12 @@ int main(int argc, char** argv)
 
     quantizer.fuse_requantize();
 
+    // only the x86 layers take int8 blobs through pooling, concat, crop, slice and shufflechannel
+    if (int8_passthrough)
+    {
+        quantizer.fuse_requantize_passthrough();
+    }
+
     quantizer.save(outparam, outbin);
 
     return 0;
@@ -37,6 +37,8 @@
 // ncnn private header
 #include "layer/convolution.h"
 #include "layer/convolutiondepthwise.h"
+#include "layer/deconvolution.h"
+#include "layer/deconvolutiondepthwise.h"
 #include "layer/innerproduct.h"
 
 class QuantBlobStat
@@ -120,7 +122,7 @@ int QuantNet::init()
     for (int i = 0; i < (int)layers.size(); i++)
     {
         const ncnn::Layer* layer = layers[i];
-        if (layer->type == "Convolution" || layer->type == "ConvolutionDepthWise" || layer->type == "InnerProduct")
+        if (layer->type == "Convolution" || layer->type == "ConvolutionDepthWise" || layer->type == "Deconvolution" || layer->type == "DeconvolutionDepthWise" || layer->type == "InnerProduct")
         {
             conv_layers.push_back(i);
             conv_bottom_blobs.push_back(layer->bottoms[0]);
@@ -383,6 +385,52 @@ int QuantNet::quantize_KL()
             }
         }
 
+        if (layer->type == "Deconvolution")
+        {
+            const ncnn::Deconvolution* deconvolution = (const ncnn::Deconvolution*)layer;
+
+            const int num_output = deconvolution->num_output;
+            const int weight_data_size_output = deconvolution->weight_data_size / num_output;
+
+            weight_scales[i].create(num_output);
+
+            for (int n = 0; n < num_output; n++)
+            {
+                const ncnn::Mat weight_data_n = deconvolution->weight_data.range(weight_data_size_output * n, weight_data_size_output);
+
+                float absmax = 0.f;
+                for (int k = 0; k < weight_data_size_output; k++)
+                {
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
+                }
+
+                weight_scales[i][n] = 127 / absmax;
+            }
+        }
+
+        if (layer->type == "DeconvolutionDepthWise")
+        {
+            const ncnn::DeconvolutionDepthWise* deconvolutiondepthwise = (const ncnn::DeconvolutionDepthWise*)layer;
+
+            const int group = deconvolutiondepthwise->group;
+            const int weight_data_size_output = deconvolutiondepthwise->weight_data_size / group;
+
+            weight_scales[i].create(group);
+
+            for (int n = 0; n < group; n++)
+            {
+                const ncnn::Mat weight_data_n = deconvolutiondepthwise->weight_data.range(weight_data_size_output * n, weight_data_size_output);
+
+                float absmax = 0.f;
+                for (int k = 0; k < weight_data_size_output; k++)
+                {
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
+                }
+
+                weight_scales[i][n] = 127 / absmax;
+            }
+        }
+
         if (layer->type == "InnerProduct")
         {
             const ncnn::InnerProduct* innerproduct = (const ncnn::InnerProduct*)layer;
@@ -862,6 +910,54 @@ int QuantNet::quantize_ACIQ()
             }
         }
 
+        if (layer->type == "Deconvolution")
+        {
+            const ncnn::Deconvolution* deconvolution = (const ncnn::Deconvolution*)layer;
+
+            const int num_output = deconvolution->num_output;
+            const int weight_data_size_output = deconvolution->weight_data_size / num_output;
+
+            weight_scales[i].create(num_output);
+
+            for (int n = 0; n < num_output; n++)
+            {
+                const ncnn::Mat weight_data_n = deconvolution->weight_data.range(weight_data_size_output * n, weight_data_size_output);
+
+                float absmax = 0.f;
+                for (int k = 0; k < weight_data_size_output; k++)
+                {
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
+                }
+
+                const float threshold = compute_aciq_gaussian_clip(absmax, weight_data_size_output);
+                weight_scales[i][n] = 127 / threshold;
+            }
+        }
+
+        if (layer->type == "DeconvolutionDepthWise")
+        {
+            const ncnn::DeconvolutionDepthWise* deconvolutiondepthwise = (const ncnn::DeconvolutionDepthWise*)layer;
+
+            const int group = deconvolutiondepthwise->group;
+            const int weight_data_size_output = deconvolutiondepthwise->weight_data_size / group;
+
+            weight_scales[i].create(group);
+
+            for (int n = 0; n < group; n++)
+            {
+                const ncnn::Mat weight_data_n = deconvolutiondepthwise->weight_data.range(weight_data_size_output * n, weight_data_size_output);
+
+                float absmax = 0.f;
+                for (int k = 0; k < weight_data_size_output; k++)
+                {
+                    absmax = std::max(absmax, (float)fabs(weight_data_n[k]));
+                }
+
+                const float threshold = compute_aciq_gaussian_clip(absmax, weight_data_size_output);
+                weight_scales[i][n] = 127 / threshold;
+            }
+        }
+
         if (layer->type == "InnerProduct")
         {
             const ncnn::InnerProduct* innerproduct = (const ncnn::InnerProduct*)layer;
@@ -1049,6 +1145,57 @@ static int get_layer_param(const ncnn::Layer* layer, ncnn::ParamDict& pd)
         pd.set(9, convolutiondepthwise->activation_type);
         pd.set(10, convolutiondepthwise->activation_params);
     }
+    else if (layer->type == "Deconvolution")
+    {
+        ncnn::Deconvolution* deconvolution = (ncnn::Deconvolution*)layer;
+
+        pd.set(0, deconvolution->num_output);
+        pd.set(1, deconvolution->kernel_w);
+        pd.set(11, deconvolution->kernel_h);
+        pd.set(2, deconvolution->dilation_w);
+        pd.set(12, deconvolution->dilation_h);
+        pd.set(3, deconvolution->stride_w);
+        pd.set(13, deconvolution->stride_h);
+        pd.set(4, deconvolution->pad_left);
+        pd.set(15, deconvolution->pad_right);
+        pd.set(14, deconvolution->pad_top);
+        pd.set(16, deconvolution->pad_bottom);
+        pd.set(18, deconvolution->output_pad_right);
+        pd.set(19, deconvolution->output_pad_bottom);
+        pd.set(20, deconvolution->output_w);
+        pd.set(21, deconvolution->output_h);
+        pd.set(5, deconvolution->bias_term);
+        pd.set(6, deconvolution->weight_data_size);
+        pd.set(8, deconvolution->int8_scale_term);
+        pd.set(9, deconvolution->activation_type);
+        pd.set(10, deconvolution->activation_params);
+    }
+    else if (layer->type == "DeconvolutionDepthWise")
+    {
+        ncnn::DeconvolutionDepthWise* deconvolutiondepthwise = (ncnn::DeconvolutionDepthWise*)layer;
+
+        pd.set(0, deconvolutiondepthwise->num_output);
+        pd.set(1, deconvolutiondepthwise->kernel_w);
+        pd.set(11, deconvolutiondepthwise->kernel_h);
+        pd.set(2, deconvolutiondepthwise->dilation_w);
+        pd.set(12, deconvolutiondepthwise->dilation_h);
+        pd.set(3, deconvolutiondepthwise->stride_w);
+        pd.set(13, deconvolutiondepthwise->stride_h);
+        pd.set(4, deconvolutiondepthwise->pad_left);
+        pd.set(15, deconvolutiondepthwise->pad_right);
+        pd.set(14, deconvolutiondepthwise->pad_top);
+        pd.set(16, deconvolutiondepthwise->pad_bottom);
+        pd.set(18, deconvolutiondepthwise->output_pad_right);
+        pd.set(19, deconvolutiondepthwise->output_pad_bottom);
+        pd.set(20, deconvolutiondepthwise->output_w);
+        pd.set(21, deconvolutiondepthwise->output_h);
+        pd.set(5, deconvolutiondepthwise->bias_term);
+        pd.set(6, deconvolutiondepthwise->weight_data_size);
+        pd.set(7, deconvolutiondepthwise->group);
+        pd.set(8, deconvolutiondepthwise->int8_scale_term);
+        pd.set(9, deconvolutiondepthwise->activation_type);
+        pd.set(10, deconvolutiondepthwise->activation_params);
+    }
     else if (layer->type == "InnerProduct")
     {
         ncnn::InnerProduct* innerproduct = (ncnn::InnerProduct*)layer;
@@ -1085,6 +1232,20 @@ static int get_layer_weights(const ncnn::Layer* layer, std::vector<ncnn::Mat>& w
         if (convolutiondepthwise->bias_term)
             weights.push_back(convolutiondepthwise->bias_data);
     }
+    else if (layer->type == "Deconvolution")
+    {
+        ncnn::Deconvolution* deconvolution = (ncnn::Deconvolution*)layer;
+        weights.push_back(deconvolution->weight_data);
+        if (deconvolution->bias_term)
+            weights.push_back(deconvolution->bias_data);
+    }
+    else if (layer->type == "DeconvolutionDepthWise")
+    {
+        ncnn::DeconvolutionDepthWise* deconvolutiondepthwise = (ncnn::DeconvolutionDepthWise*)layer;
+        weights.push_back(deconvolutiondepthwise->weight_data);
+        if (deconvolutiondepthwise->bias_term)
+            weights.push_back(deconvolutiondepthwise->bias_data);
+    }
     else if (layer->type == "InnerProduct")
     {
         ncnn::InnerProduct* innerproduct = (ncnn::InnerProduct*)layer;